@@ -160,12 +160,18 @@ macro(write_configtable)
   string(APPEND out "GtkConfigStore                : ")
   check_on_or_off("NS3_GTK3" "GTK3_FOUND")
 
+  string(APPEND out "Integer Time conversions      : ")
+  check_on_or_off("NS3_FAST_TIME" "TIME_USE_FAST_PATH")
+
   string(APPEND out "LibXml2 support               : ")
   check_on_or_off("ON" "LIBXML2_FOUND")
 
   string(APPEND out "MPI Support                   : ")
   check_on_or_off("NS3_MPI" "MPI_FOUND")
 
+  string(APPEND out "Multithreaded simulation      : ")
+  check_on_or_off("NS3_MTP" "ENABLE_MTP")
+
   string(APPEND out "ns-3 Click Integration        : ")
   check_on_or_off("ON" "NS3_CLICK")
 
@@ -835,6 +835,12 @@ macro(process_options)
     endif()
   endif()
 
+  set(ENABLE_MTP FALSE)
+  if(${NS3_MTP})
+    add_definitions(-DNS3_MTP)
+    set(ENABLE_MTP TRUE)
+  endif()
+
   mark_as_advanced(Boost_INCLUDE_DIR)
   find_package(Boost)
   if(${Boost_FOUND})
@@ -1106,6 +1112,14 @@ macro(process_options)
     set(INT64X64_USE_CAIRO TRUE)
   endif()
 
+  # The Time fast paths reproduce the INT128 arithmetic
+  set(TIME_USE_FAST_PATH FALSE)
+  if(${NS3_FAST_TIME} AND INT64X64_USE_128)
+    set(TIME_USE_FAST_PATH TRUE)
+  else()
+    set(TIME_USE_FAST_PATH_REASON "requires INT128")
+  endif()
+
   # Check for required headers and functions, set flags if they're found or warn
   # if they're not found
   check_include_file("stdint.h" "HAVE_STDINT_H")
@@ -232,7 +232,7 @@ class CallbackImpl : public CallbackImplBase
      * \param components the callback components (callable object and bound arguments)
      */
     CallbackImpl(std::function<R(UArgs...)> func, const CallbackComponentVector& components)
-        : m_func(func),
+        : m_func(std::move(func)),
           m_components(components)
     {
     }
@@ -492,11 +492,19 @@ class Callback : public CallbackBase
             {std::make_shared<CallbackComponent<T, isComp>>(func),
              std::make_shared<CallbackComponent<std::decay_t<BArgs>>>(bargs)...});
 
-        m_impl = Create<CallbackImpl<R, UArgs...>>(
-            [f, bargs...](auto&&... uargs) -> R {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        if constexpr (sizeof...(BArgs) == 0)
+        {
+            // nothing to bind: do not wrap the function once more
+            m_impl = Create<CallbackImpl<R, UArgs...>>(std::move(f), components);
+        }
+        else
+        {
+            m_impl = Create<CallbackImpl<R, UArgs...>>(
+                [f, bargs...](auto&&... uargs) -> R {
+                    return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
+                },
+                components);
+        }
     }
 
   private:
@@ -13,9 +13,14 @@
 #include "object-ptr-container.h"
 #include "object.h"
 #include "pointer.h"
+#include "simulation-context.h"
 #include "singleton.h"
 
+#include <algorithm>
+#include <limits>
+#include <optional>
 #include <sstream>
+#include <unordered_map>
 
 /**
  * \file
@@ -190,10 +195,15 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, into the ranges of matching indexes.
  */
 class ArrayMatcher
 {
   public:
+    /** An inclusive range of indexes. */
+    typedef std::pair<std::size_t, std::size_t> Range;
+
     /**
      * Construct from a Config path specification.
      *
@@ -207,8 +217,20 @@ class ArrayMatcher
      * \returns \c true if the index matches the Config Path.
      */
     bool Matches(std::size_t i) const;
+    /**
+     * Get the indexes matching the Config Path.
+     *
+     * \returns The sorted, disjoint ranges of matching indexes.
+     */
+    const std::vector<Range>& GetRanges() const;
 
   private:
+    /**
+     * Parse one alternative of the Config path specification.
+     *
+     * \param [in] element The alternative: "*", an index or "[min-max]".
+     */
+    void Parse(std::string element);
     /**
      * Convert a string to an \c uint32_t.
      *
@@ -219,6 +241,8 @@ class ArrayMatcher
     bool StringToUint32(std::string str, uint32_t* value) const;
     /** The Config path element. */
     std::string m_element;
+    /** The matching indexes. */
+    std::vector<Range> m_ranges;
 
 }; // class ArrayMatcher
 
@@ -226,70 +250,89 @@ ArrayMatcher::ArrayMatcher(std::string element)
     : m_element(element)
 {
     NS_LOG_FUNCTION(this << element);
-}
 
-bool
-ArrayMatcher::Matches(std::size_t i) const
-{
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
+    std::string::size_type start = 0;
+    std::string::size_type bar = element.find('|');
+    while (bar != std::string::npos)
     {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
+        Parse(element.substr(start, bar - start));
+        start = bar + 1;
+        bar = element.find('|', start);
     }
-    std::string::size_type tmp;
-    tmp = m_element.find('|');
-    if (tmp != std::string::npos)
+    Parse(element.substr(start));
+
+    // merge the overlapping alternatives
+    std::sort(m_ranges.begin(), m_ranges.end());
+    std::vector<Range> ranges;
+    for (const auto& range : m_ranges)
     {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
+        if (!ranges.empty() && range.first <= ranges.back().second)
         {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
+            ranges.back().second = std::max(ranges.back().second, range.second);
         }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
+        else
         {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
+            ranges.push_back(range);
         }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
     }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
+    m_ranges.swap(ranges);
+}
+
+void
+ArrayMatcher::Parse(std::string element)
+{
+    NS_LOG_FUNCTION(this << element);
+    if (element == "*")
+    {
+        m_ranges.emplace_back(0, std::numeric_limits<std::size_t>::max());
+        return;
+    }
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
         dash < rightBracket)
     {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
+        std::string lowerBound = element.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = element.substr(dash + 1, rightBracket - (dash + 1));
         uint32_t min;
         uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-            return true;
-        }
-        else
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && min <= max)
         {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
-            return false;
+            m_ranges.emplace_back(min, max);
         }
+        return;
     }
     uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
+    if (StringToUint32(element, &value))
+    {
+        m_ranges.emplace_back(value, value);
+    }
+}
+
+bool
+ArrayMatcher::Matches(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    for (const auto& range : m_ranges)
     {
-        NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-        return true;
+        if (i >= range.first && i <= range.second)
+        {
+            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+            return true;
+        }
     }
     NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
     return false;
 }
 
+const std::vector<ArrayMatcher::Range>&
+ArrayMatcher::GetRanges() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_ranges;
+}
+
 bool
 ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 {
@@ -300,9 +343,151 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
     return !iss.bad() && !iss.fail();
 }
 
+/**
+ * \ingroup config-impl
+ * Index of the attributes through which a Config path reaches other
+ * objects, by TypeId and Config path element.
+ *
+ * Without it, each element of a Config path is resolved by comparing
+ * the names of all the attributes of the TypeId and of its parents,
+ * for each object matched by the previous elements.
+ */
+class AttributeIndex
+{
+  public:
+    /** An attribute holding a pointer to an object, or a container of objects. */
+    struct Entry
+    {
+        std::string name;                      //!< The attribute name.
+        Ptr<const AttributeAccessor> accessor; //!< The attribute accessor.
+        bool container; //!< Whether the attribute holds a container of objects.
+        /** Whether the value can be read from the accessor, without further checks. */
+        bool direct;
+        /**
+         * The accessor of a container indexed by position, to read only the
+         * matching objects, or \c nullptr.
+         */
+        const ObjectPtrContainerAccessor* items;
+    };
+
+    /**
+     * Get the attributes matching a Config path element.
+     *
+     * \param [in] tid The TypeId of the object.
+     * \param [in] item The Config path element: an attribute name, or "*".
+     * \returns The matching attributes, those of \pname{tid} first,
+     *          then those of its parents.
+     */
+    const std::vector<Entry>& Lookup(TypeId tid, const std::string& item);
+
+  private:
+    /** The indexed attributes of one TypeId. */
+    struct Type
+    {
+        /** The number of attributes of the TypeId and of its parents. */
+        std::size_t attributes{0};
+        /** The matching attributes, by Config path element. */
+        std::unordered_map<std::string, std::vector<Entry>> items;
+    };
+
+    /**
+     * Count the attributes of a TypeId and of its parents.
+     *
+     * \param [in] tid The TypeId.
+     * \returns The number of attributes.
+     */
+    static std::size_t CountAttributes(TypeId tid);
+
+    /** The indexed TypeIds, by uid. */
+    std::unordered_map<uint16_t, Type> m_types;
+
+}; // class AttributeIndex
+
+std::size_t
+AttributeIndex::CountAttributes(TypeId tid)
+{
+    std::size_t attributes = 0;
+    TypeId nextTid = tid;
+    do
+    {
+        tid = nextTid;
+        attributes += tid.GetAttributeN();
+        nextTid = tid.GetParent();
+    } while (nextTid != tid);
+    return attributes;
+}
+
+const std::vector<AttributeIndex::Entry>&
+AttributeIndex::Lookup(TypeId tid, const std::string& item)
+{
+    NS_LOG_FUNCTION(this << tid << item);
+
+    Type& type = m_types[tid.GetUid()];
+    std::size_t attributes = CountAttributes(tid);
+    if (type.attributes != attributes)
+    {
+        // attributes were added since the last lookup
+        type.items.clear();
+        type.attributes = attributes;
+    }
+    auto [it, inserted] = type.items.try_emplace(item);
+    if (!inserted)
+    {
+        return it->second;
+    }
+
+    std::vector<Entry>& entries = it->second;
+    TypeId nextTid = tid;
+    do
+    {
+        tid = nextTid;
+
+        for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info = tid.GetAttribute(i);
+            if (info.name != item && item != "*")
+            {
+                continue;
+            }
+            // deprecated or unreadable attributes are read through
+            // ObjectBase::GetAttribute(), which reports them.
+            bool direct = (info.flags & TypeId::ATTR_GET) && info.accessor->HasGetter() &&
+                          info.supportLevel == TypeId::SUPPORTED;
+            if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+            {
+                entries.push_back({info.name, info.accessor, false, direct, nullptr});
+            }
+            else if (dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                     nullptr)
+            {
+                const auto items =
+                    dynamic_cast<const ObjectPtrContainerAccessor*>(PeekPointer(info.accessor));
+                if (!direct || items == nullptr || !items->IsIndexedByPosition())
+                {
+                    entries.push_back({info.name, info.accessor, true, direct, nullptr});
+                }
+                else
+                {
+                    entries.push_back({info.name, info.accessor, true, direct, items});
+                }
+            }
+            // this could be anything else and we don't know what to do with it.
+            // So, we just ignore it.
+        }
+
+        nextTid = tid.GetParent();
+    } while (nextTid != tid);
+
+    return entries;
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
+ *
+ * The Config path is split into its elements once, when the Resolver
+ * is constructed, and the objects matching each element are found through
+ * an AttributeIndex.
  */
 class Resolver
 {
@@ -311,8 +496,9 @@ class Resolver
      * Construct from a base Config path.
      *
      * \param [in] path The Config path.
+     * \param [in] attributes The index of the attributes to follow.
      */
-    Resolver(std::string path);
+    Resolver(std::string path, AttributeIndex& attributes);
     /** Destructor. */
     virtual ~Resolver();
 
@@ -326,23 +512,72 @@ class Resolver
     void Resolve(Ptr<Object> root);
 
   private:
+    /** One element of the Config path. */
+    struct Element
+    {
+        /**
+         * Constructor.
+         *
+         * \param [in] item The Config path element.
+         */
+        Element(std::string item)
+            : item(item),
+              matcher(item)
+        {
+        }
+
+        std::string item;     //!< The Config path element.
+        ArrayMatcher matcher; //!< The element, as a container index.
+        /** The TypeId of a "$TypeId" element, looked up when first needed. */
+        std::optional<TypeId> tid;
+    };
+
     /** Ensure the Config path starts and ends with a '/'. */
     void Canonicalize();
+    /** Split the Config path into its elements. */
+    void Split();
     /**
      * Parse the next element in the Config path.
      *
-     * \param [in] path The remaining portion of the Config path.
+     * \param [in] element The index of the next element.
      * \param [in] root The object corresponding to the current position
      *                  in the Config path.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoResolve(std::size_t element, Ptr<Object> root);
     /**
      * Parse an index on the Config path.
      *
-     * \param [in] path The remaining Config path.
-     * \param [in,out] vector The resulting list of matching objects.
+     * \param [in] element The index of the next element.
+     * \param [in] root The object holding the container.
+     * \param [in] attribute The container attribute.
+     */
+    void DoArrayResolve(std::size_t element,
+                        Ptr<Object> root,
+                        const AttributeIndex::Entry& attribute);
+    /**
+     * Get the matching objects of a container indexed by position,
+     * without copying the whole container.
+     *
+     * \param [in] root The object holding the container.
+     * \param [in] attribute The container attribute.
+     * \param [in] matcher The container indexes to match.
+     * \param [out] objects The matching objects, by index.
+     * \returns \c false if the container must be copied instead.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    bool GetMatchingItems(Ptr<Object> root,
+                          const AttributeIndex::Entry& attribute,
+                          const ArrayMatcher& matcher,
+                          std::vector<std::pair<std::size_t, Ptr<Object>>>& objects) const;
+    /**
+     * Get the value of an attribute.
+     *
+     * \param [in] root The object holding the attribute.
+     * \param [in] attribute The attribute.
+     * \param [out] value The value.
+     */
+    void GetAttribute(Ptr<Object> root,
+                      const AttributeIndex::Entry& attribute,
+                      AttributeValue& value) const;
     /**
      * Handle one object found on the path.
      *
@@ -367,14 +602,20 @@ class Resolver
     std::vector<std::string> m_workStack;
     /** The Config path. */
     std::string m_path;
+    /** The elements of the Config path. */
+    std::vector<Element> m_elements;
+    /** The index of the attributes to follow. */
+    AttributeIndex& m_attributes;
 
 }; // class Resolver
 
-Resolver::Resolver(std::string path)
-    : m_path(path)
+Resolver::Resolver(std::string path, AttributeIndex& attributes)
+    : m_path(path),
+      m_attributes(attributes)
 {
-    NS_LOG_FUNCTION(this << path);
+    NS_LOG_FUNCTION(this << path << &attributes);
     Canonicalize();
+    Split();
 }
 
 Resolver::~Resolver()
@@ -402,12 +643,27 @@ Resolver::Canonicalize()
     }
 }
 
+void
+Resolver::Split()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::string::size_type start = 1;
+    std::string::size_type next = m_path.find('/', start);
+    while (next != std::string::npos)
+    {
+        m_elements.emplace_back(m_path.substr(start, next - start));
+        start = next + 1;
+        next = m_path.find('/', start);
+    }
+}
+
 void
 Resolver::Resolve(Ptr<Object> root)
 {
     NS_LOG_FUNCTION(this << root);
 
-    DoResolve(m_path, root);
+    DoResolve(0, root);
 }
 
 std::string
@@ -433,13 +689,23 @@ Resolver::DoResolveOne(Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+Resolver::GetAttribute(Ptr<Object> root,
+                       const AttributeIndex::Entry& attribute,
+                       AttributeValue& value) const
+{
+    NS_LOG_FUNCTION(this << root << attribute.name << &value);
+    if (!attribute.direct || !attribute.accessor->Get(PeekPointer(root), value))
+    {
+        root->GetAttribute(attribute.name, value);
+    }
+}
+
+void
+Resolver::DoResolve(std::size_t element, Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    NS_LOG_FUNCTION(this << element << root);
 
-    if (next == std::string::npos)
+    if (element == m_elements.size())
     {
         //
         // If root is zero, we're beginning to see if we can use the object name
@@ -455,8 +721,8 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         }
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    Element& current = m_elements[element];
+    const std::string& item = current.item;
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -467,11 +733,10 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     //
     if (!root)
     {
-        std::string::size_type offset = path.find("/Names");
-        if (offset == 0)
+        if (item.compare(0, 5, "Names") == 0)
         {
             m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
+            DoResolve(element + 1, root);
             m_workStack.pop_back();
             return;
         }
@@ -488,7 +753,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
         m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
+        DoResolve(element + 1, namedObject);
         m_workStack.pop_back();
         return;
     }
@@ -510,81 +775,57 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         // This is a call to GetObject
         std::string tidString = item.substr(1, item.size() - 1);
         NS_LOG_DEBUG("GetObject=" << tidString << " on path=" << GetResolvedPath());
-        TypeId tid = TypeId::LookupByName(tidString);
-        Ptr<Object> object = root->GetObject<Object>(tid);
+        if (!current.tid)
+        {
+            current.tid = TypeId::LookupByName(tidString);
+        }
+        Ptr<Object> object = root->GetObject<Object>(*current.tid);
         if (!object)
         {
             NS_LOG_DEBUG("GetObject (" << tidString << ") failed on path=" << GetResolvedPath());
             return;
         }
         m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
+        DoResolve(element + 1, object);
         m_workStack.pop_back();
     }
     else
     {
         // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
-        bool foundMatch = false;
-
-        do
+        const std::vector<AttributeIndex::Entry>& attributes =
+            m_attributes.Lookup(root->GetInstanceTypeId(), item);
+        for (const auto& attribute : attributes)
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            if (!attribute.container)
             {
-                TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
+                NS_LOG_DEBUG("GetAttribute(ptr)=" << attribute.name
+                                                  << " on path=" << GetResolvedPath());
+                PointerValue pValue;
+                GetAttribute(root, attribute, pValue);
+                Ptr<Object> object = pValue.Get<Object>();
+                if (!object)
                 {
+                    NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
+                                                            << GetResolvedPath()
+                                                            << "\""
+                                                               " but is null.");
                     continue;
                 }
-                // attempt to cast to a pointer checker.
-                const auto pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
-                    root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
-                }
-                // attempt to cast to an object vector.
-                const auto vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
-                }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
+                m_workStack.push_back(attribute.name);
+                DoResolve(element + 1, object);
+                m_workStack.pop_back();
             }
+            else
+            {
+                NS_LOG_DEBUG("GetAttribute(vector)=" << attribute.name
+                                                     << " on path=" << GetResolvedPath());
+                m_workStack.push_back(attribute.name);
+                DoArrayResolve(element + 1, root, attribute);
+                m_workStack.pop_back();
+            }
+        }
 
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
-
-        if (!foundMatch)
+        if (attributes.empty())
         {
             NS_LOG_DEBUG("Requested item=" << item
                                            << " does not exist on path=" << GetResolvedPath());
@@ -593,33 +834,63 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     }
 }
 
+bool
+Resolver::GetMatchingItems(Ptr<Object> root,
+                           const AttributeIndex::Entry& attribute,
+                           const ArrayMatcher& matcher,
+                           std::vector<std::pair<std::size_t, Ptr<Object>>>& objects) const
+{
+    NS_LOG_FUNCTION(this << root << attribute.name);
+
+    std::size_t n;
+    if (attribute.items == nullptr || !attribute.items->GetN(PeekPointer(root), &n))
+    {
+        return false;
+    }
+    for (const auto& range : matcher.GetRanges())
+    {
+        for (std::size_t i = range.first; i < n && i <= range.second; i++)
+        {
+            std::size_t index;
+            Ptr<Object> object = attribute.items->GetItem(PeekPointer(root), i, &index);
+            NS_ASSERT(index == i);
+            objects.emplace_back(index, object);
+        }
+    }
+    return true;
+}
+
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+Resolver::DoArrayResolve(std::size_t element,
+                         Ptr<Object> root,
+                         const AttributeIndex::Entry& attribute)
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << element << root << attribute.name);
+    if (element == m_elements.size())
     {
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
 
-    ArrayMatcher matcher = ArrayMatcher(item);
-    ObjectPtrContainerValue::Iterator it;
-    for (it = container.Begin(); it != container.End(); ++it)
+    const ArrayMatcher& matcher = m_elements[element].matcher;
+    std::vector<std::pair<std::size_t, Ptr<Object>>> objects;
+    if (!GetMatchingItems(root, attribute, matcher, objects))
     {
-        if (matcher.Matches((*it).first))
+        ObjectPtrContainerValue container;
+        GetAttribute(root, attribute, container);
+        for (auto it = container.Begin(); it != container.End(); ++it)
         {
-            std::ostringstream oss;
-            oss << (*it).first;
-            m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
-            m_workStack.pop_back();
+            if (matcher.Matches((*it).first))
+            {
+                objects.emplace_back(*it);
+            }
         }
     }
+    for (const auto& [index, object] : objects)
+    {
+        m_workStack.push_back(std::to_string(index));
+        DoResolve(element + 1, object);
+        m_workStack.pop_back();
+    }
 }
 
 /**
@@ -629,6 +900,13 @@ Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& contai
 class ConfigImpl : public Singleton<ConfigImpl>
 {
   public:
+    /**
+     * Get the Config namespace of the current SimulationContext, or the
+     * process-wide instance.
+     * \returns The ConfigImpl instance.
+     */
+    static ConfigImpl* Get();
+
     // Keep Set and SetFailSafe since their errors are triggered
     // by the underlying ObjectBase functions.
     /** \copydoc ns3::Config::Set() */
@@ -671,9 +949,22 @@ class ConfigImpl : public Singleton<ConfigImpl>
 
     /** The list of Config path roots. */
     Roots m_roots;
+    /** The index of the attributes followed by the Config paths. */
+    AttributeIndex m_attributes;
 
 }; // class ConfigImpl
 
+ConfigImpl*
+ConfigImpl::Get()
+{
+    SimulationContext* context = SimulationContext::GetCurrent();
+    if (context != nullptr)
+    {
+        return context->GetSingleton<ConfigImpl>();
+    }
+    return Singleton<ConfigImpl>::Get();
+}
+
 void
 ConfigImpl::ParsePath(std::string path, std::string* root, std::string* leaf) const
 {
@@ -778,8 +1069,8 @@ ConfigImpl::LookupMatches(std::string path)
     class LookupMatchesResolver : public Resolver
     {
       public:
-        LookupMatchesResolver(std::string path)
-            : Resolver(path)
+        LookupMatchesResolver(std::string path, AttributeIndex& attributes)
+            : Resolver(path, attributes)
         {
         }
 
@@ -791,7 +1082,7 @@ ConfigImpl::LookupMatches(std::string path)
 
         std::vector<Ptr<Object>> m_objects;
         std::vector<std::string> m_contexts;
-    } resolver = LookupMatchesResolver(path);
+    } resolver = LookupMatchesResolver(path, m_attributes);
 
     for (auto i = m_roots.begin(); i != m_roots.end(); i++)
     {
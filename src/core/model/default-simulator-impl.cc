@@ -9,9 +9,11 @@
 #include "default-simulator-impl.h"
 
 #include "assert.h"
+#include "enum.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
 
 #include <cmath>
 
@@ -37,11 +39,31 @@ DefaultSimulatorImpl::GetTypeId()
     static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
                             .SetParent<SimulatorImpl>()
                             .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+                            .AddConstructor<DefaultSimulatorImpl>()
+                            .AddAttribute("EventProfile",
+                                          "Format of the wall clock profile of the events, "
+                                          "written at Simulator::Destroy().",
+                                          EnumValue(EventProfiler::NONE),
+                                          MakeEnumAccessor<EventProfiler::Format>(
+                                              &DefaultSimulatorImpl::m_profileFormat),
+                                          MakeEnumChecker(EventProfiler::NONE,
+                                                          "None",
+                                                          EventProfiler::REPORT,
+                                                          "Report",
+                                                          EventProfiler::FOLDED,
+                                                          "Folded"))
+                            .AddAttribute("EventProfileFile",
+                                          "Event profile file name, or empty for the "
+                                          "standard output.",
+                                          StringValue(""),
+                                          MakeStringAccessor(&DefaultSimulatorImpl::m_profileFile),
+                                          MakeStringChecker());
     return tid;
 }
 
 DefaultSimulatorImpl::DefaultSimulatorImpl()
+    : m_eventsWithContext(EVENTS_WITH_CONTEXT_CAPACITY),
+      m_eventsWithContextOverflowing(false)
 {
     NS_LOG_FUNCTION(this);
     m_stop = false;
@@ -51,8 +73,8 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
-    m_eventsWithContextEmpty = true;
     m_mainThreadId = std::this_thread::get_id();
+    m_profileFormat = EventProfiler::NONE;
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl()
@@ -89,6 +111,11 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+    if (m_profileFormat != EventProfiler::NONE)
+    {
+        m_profiler.Write(m_profileFile, m_profileFormat);
+        m_profiler.Clear();
+    }
 }
 
 void
@@ -130,7 +157,14 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profileFormat == EventProfiler::NONE)
+    {
+        next.impl->Invoke();
+    }
+    else
+    {
+        m_profiler.Invoke(next.impl, m_currentContext);
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -142,33 +176,41 @@ DefaultSimulatorImpl::IsFinished() const
     return m_events->IsEmpty() || m_stop;
 }
 
+void
+DefaultSimulatorImpl::InsertEventWithContext(const EventWithContext& event)
+{
+    Scheduler::Event ev;
+    ev.impl = event.event;
+    ev.key.m_ts = m_currentTs + event.timestamp;
+    ev.key.m_context = event.context;
+    ev.key.m_uid = m_uid;
+    m_uid++;
+    m_unscheduledEvents++;
+    m_events->Insert(ev);
+}
+
 void
 DefaultSimulatorImpl::ProcessEventsWithContext()
 {
-    if (m_eventsWithContextEmpty)
+    auto insert = [this](const EventWithContext& event) { InsertEventWithContext(event); };
+    m_eventsWithContext.Drain(insert);
+    if (!m_eventsWithContextOverflowing.load(std::memory_order_acquire))
     {
         return;
     }
 
-    // swap queues
     EventsWithContext eventsWithContext;
     {
         std::unique_lock lock{m_eventsWithContextMutex};
-        m_eventsWithContext.swap(eventsWithContext);
-        m_eventsWithContextEmpty = true;
+        // the events a thread pushed to the queue before overflowing are
+        // visible now, and must be inserted before its overflowed events
+        m_eventsWithContext.Drain(insert);
+        m_eventsWithContextOverflow.swap(eventsWithContext);
+        m_eventsWithContextOverflowing.store(false, std::memory_order_release);
     }
-    while (!eventsWithContext.empty())
+    for (const auto& event : eventsWithContext)
     {
-        EventWithContext event = eventsWithContext.front();
-        eventsWithContext.pop_front();
-        Scheduler::Event ev;
-        ev.impl = event.event;
-        ev.key.m_ts = m_currentTs + event.timestamp;
-        ev.key.m_context = event.context;
-        ev.key.m_uid = m_uid;
-        m_uid++;
-        m_unscheduledEvents++;
-        m_events->Insert(ev);
+        InsertEventWithContext(event);
     }
 }
 
@@ -253,10 +295,12 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         // Current time added in ProcessEventsWithContext()
         ev.timestamp = delay.GetTimeStep();
         ev.event = event;
+        if (m_eventsWithContextOverflowing.load(std::memory_order_acquire) ||
+            !m_eventsWithContext.Push(ev))
         {
             std::unique_lock lock{m_eventsWithContextMutex};
-            m_eventsWithContext.push_back(ev);
-            m_eventsWithContextEmpty = false;
+            m_eventsWithContextOverflow.push_back(ev);
+            m_eventsWithContextOverflowing.store(true, std::memory_order_release);
         }
     }
 }
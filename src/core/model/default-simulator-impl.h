@@ -9,8 +9,11 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "event-profiler.h"
+#include "mpsc-queue.h"
 #include "simulator-impl.h"
 
+#include <atomic>
 #include <list>
 #include <mutex>
 #include <thread>
@@ -86,16 +89,29 @@ class DefaultSimulatorImpl : public SimulatorImpl
         EventImpl* event;
     };
 
+    /**
+     * Insert an event from a different context into the main event queue.
+     *
+     * \param [in] event The event.
+     */
+    void InsertEventWithContext(const EventWithContext& event);
+
+    /** Capacity of the lock-free queue of events from a different context. */
+    static constexpr std::size_t EVENTS_WITH_CONTEXT_CAPACITY = 4096;
+    /** The lock-free queue of events from a different context. */
+    MpscQueue<EventWithContext> m_eventsWithContext;
+
     /** Container type for the events from a different context. */
     typedef std::list<EventWithContext> EventsWithContext;
-    /** The container of events from a different context. */
-    EventsWithContext m_eventsWithContext;
     /**
-     * Flag \c true if all events with context have been moved to the
-     * primary event queue.
+     * The events from a different context which did not fit in the
+     * lock-free queue.  While it is not empty, the other threads append
+     * to it, so that the events of each thread stay in order.
      */
-    bool m_eventsWithContextEmpty;
-    /** Mutex to control access to the list of events with context. */
+    EventsWithContext m_eventsWithContextOverflow;
+    /** Flag \c true if the overflow list is not empty. */
+    std::atomic<bool> m_eventsWithContextOverflowing;
+    /** Mutex to control access to the overflow list. */
     std::mutex m_eventsWithContextMutex;
 
     /** Container type for the events to run at Simulator::Destroy() */
@@ -125,6 +141,13 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** Event profile output format, or EventProfiler::NONE if disabled. */
+    EventProfiler::Format m_profileFormat;
+    /** Event profile output file name, or empty for the standard output. */
+    std::string m_profileFile;
+    /** The event profile. */
+    EventProfiler m_profiler;
 };
 
 } // namespace ns3
@@ -10,6 +10,9 @@
 
 #include "log.h"
 
+#include <cstring>
+#include <new>
+
 /**
  * \file
  * \ingroup events
@@ -21,13 +24,154 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+namespace
+{
+
+/**
+ * \ingroup events
+ * Free lists of released events, one per size class.
+ *
+ * Each free event is a separate allocation, so that an event allocated
+ * by one thread can be released to the pool of another thread.
+ * This structure is trivially destructible: it remains usable by the
+ * events released after the destruction of the thread local objects,
+ * which are then returned to the system allocator.
+ */
+struct EventPool
+{
+    /** A free event, linked in the list of its size class. */
+    struct Block
+    {
+        Block* next; //!< The next free event.
+    };
+
+    /** Size difference between two size classes. */
+    static constexpr std::size_t GRANULARITY = 16;
+    /** Number of size classes; larger events are not pooled. */
+    static constexpr std::size_t CLASSES = 16;
+    /** Maximum number of free events kept in each size class. */
+    static constexpr uint32_t MAX_LENGTH = 4096;
+
+    Block* head[CLASSES];            //!< Free lists.
+    uint32_t length[CLASSES];        //!< Free list lengths.
+    EventImpl::PoolStatistics stats; //!< Counters.
+    bool registered;                 //!< Whether the guard has been created.
+    bool closed;                     //!< Whether the thread is exiting.
+};
+
+/** The event pool of each thread. */
+thread_local EventPool g_eventPool;
+
+/**
+ * \ingroup events
+ * Release the free events of a thread at its exit.
+ */
+struct EventPoolGuard
+{
+    EventPool* pool{nullptr}; //!< The pool of the thread.
+
+    ~EventPoolGuard()
+    {
+        if (pool == nullptr)
+        {
+            return;
+        }
+        for (std::size_t i = 0; i < EventPool::CLASSES; ++i)
+        {
+            while (pool->head[i] != nullptr)
+            {
+                EventPool::Block* block = pool->head[i];
+                pool->head[i] = block->next;
+                ::operator delete(block);
+            }
+            pool->length[i] = 0;
+        }
+        pool->stats.pooled = 0;
+        pool->closed = true;
+    }
+};
+
+/** Created by the first event released by a thread. */
+thread_local EventPoolGuard g_eventPoolGuard;
+
+} // namespace
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+    EventPool& pool = g_eventPool;
+    pool.stats.allocations++;
+    pool.stats.live++;
+    pool.stats.bytes += size;
+    std::size_t index = (size - 1) / EventPool::GRANULARITY;
+    if (index >= EventPool::CLASSES)
+    {
+        return ::operator new(size);
+    }
+    // allocate the whole size class even when the pool is closed: the
+    // event may be released to the pool of another thread, and reused
+    // for any event of its size class
+    EventPool::Block* block = pool.closed ? nullptr : pool.head[index];
+    if (block == nullptr)
+    {
+        return ::operator new((index + 1) * EventPool::GRANULARITY);
+    }
+    pool.head[index] = block->next;
+    pool.length[index]--;
+    pool.stats.pooled--;
+    pool.stats.hits++;
+    return block;
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    EventPool& pool = g_eventPool;
+    pool.stats.releases++;
+    pool.stats.live--;
+    pool.stats.bytes -= size;
+    std::size_t index = (size - 1) / EventPool::GRANULARITY;
+    if (index >= EventPool::CLASSES || pool.closed || pool.length[index] >= EventPool::MAX_LENGTH)
+    {
+        ::operator delete(p);
+        return;
+    }
+    if (!pool.registered)
+    {
+        pool.registered = true;
+        g_eventPoolGuard.pool = &pool;
+    }
+    auto block = static_cast<EventPool::Block*>(p);
+    block->next = pool.head[index];
+    pool.head[index] = block;
+    pool.length[index]++;
+    pool.stats.pooled++;
+}
+
+EventImpl::PoolStatistics
+EventImpl::GetPoolStatistics()
+{
+    return g_eventPool.stats;
+}
+
+void
+EventImpl::ResetPoolStatistics()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    EventPool& pool = g_eventPool;
+    pool.stats.allocations = 0;
+    pool.stats.hits = 0;
+    pool.stats.releases = 0;
+}
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
 }
 
 EventImpl::EventImpl()
-    : m_cancel(false)
+    : m_cancel(false),
+      m_schedulerIndex(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -56,4 +200,45 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+const void*
+EventImpl::GetHandlerAddress() const
+{
+    return nullptr;
+}
+
+const void*
+EventImpl::GetMethodAddress(const void* method, std::size_t size, const void* object)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    // Itanium C++ ABI: a function pointer, or one plus the offset of the
+    // function in the vtable, followed by the adjustment of the object
+    // pointer.  The ARM variant flags the virtual functions in the lowest
+    // bit of the adjustment instead.
+    uintptr_t words[2];
+    if (size != sizeof(words) || object == nullptr)
+    {
+        return nullptr;
+    }
+    std::memcpy(words, method, sizeof(words));
+#if defined(__arm__) || defined(__aarch64__)
+    bool isVirtual = (words[1] & 1) != 0;
+    auto adjustment = static_cast<intptr_t>(words[1]) >> 1;
+    uintptr_t offset = words[0];
+#else
+    bool isVirtual = (words[0] & 1) != 0;
+    auto adjustment = static_cast<intptr_t>(words[1]);
+    uintptr_t offset = words[0] - 1;
+#endif
+    if (!isVirtual)
+    {
+        return reinterpret_cast<const void*>(words[0]);
+    }
+    const char* self = static_cast<const char*>(object) + adjustment;
+    const char* vtable = *reinterpret_cast<const char* const*>(self);
+    return *reinterpret_cast<const void* const*>(vtable + offset);
+#else
+    return nullptr;
+#endif
+}
+
 } // namespace ns3
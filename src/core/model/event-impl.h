@@ -10,8 +10,13 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 /**
  * \file
  * \ingroup events
@@ -56,6 +61,55 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /**
+     * Get the function called by this event, to tell apart the events
+     * of the same type in the profiles, see EventProfiler.
+     *
+     * \returns The address of the function or method bound by
+     * MakeEvent(), or \c nullptr if the event calls a function object,
+     * e.g., a lambda, or if the address is not known.
+     */
+    virtual const void* GetHandlerAddress() const;
+
+    /**
+     * Allocate an event from the event pool of the calling thread.
+     *
+     * Events are created and destroyed at a very high rate, so released
+     * events are kept in per-thread free lists, one per size class, and
+     * reused by the next allocation of the same size class.
+     *
+     * \param [in] size The size of the event object.
+     * \returns The memory for the event.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Release an event to the event pool of the calling thread.
+     *
+     * \param [in] p The memory of the event.
+     * \param [in] size The size of the event object.
+     */
+    static void operator delete(void* p, std::size_t size);
+
+    /** Event pool counters, for the calling thread. */
+    struct PoolStatistics
+    {
+        uint64_t allocations; //!< Number of events allocated.
+        uint64_t hits;        //!< Number of allocations served by the pool.
+        uint64_t releases;    //!< Number of events released.
+        uint64_t pooled;      //!< Number of free events currently in the pool.
+        int64_t live;         //!< Number of events allocated minus the ones released.
+        int64_t bytes;        //!< Size of the events allocated minus the ones released.
+    };
+
+    /**
+     * \returns The event pool counters of the calling thread.
+     */
+    static PoolStatistics GetPoolStatistics();
+    /**
+     * Reset the allocation, hit and release counters of the calling thread.
+     */
+    static void ResetPoolStatistics();
+
   protected:
     /**
      * Implementation for Invoke().
@@ -65,8 +119,39 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     virtual void Notify() = 0;
 
+    /**
+     * Resolve a pointer to member function into the address of the
+     * function it calls on an object, including for virtual functions.
+     *
+     * This depends on the representation of the pointers to member
+     * functions of the C++ ABI, and is only supported by the Itanium
+     * C++ ABI (and its ARM variant) used by GCC and Clang.
+     *
+     * \param [in] method The pointer to member function.
+     * \param [in] size The size of the pointer to member function.
+     * \param [in] object The object the method is called on.
+     * \returns The address of the function, or \c nullptr if unknown.
+     */
+    static const void* GetMethodAddress(const void* method, std::size_t size, const void* object);
+
   private:
-    bool m_cancel; /**< Has this event been cancelled. */
+    friend class QuadHeapScheduler;
+
+    /**
+     * Has this event been cancelled.  When built with multithreaded
+     * simulation support (NS3_MTP) the flag is atomic, since an event
+     * may be cancelled by another worker thread than the one executing it.
+     */
+#ifdef NS3_MTP
+    std::atomic<bool> m_cancel;
+#else
+    bool m_cancel;
+#endif
+    /**
+     * Position of the event in the array of the scheduler holding it,
+     * for the schedulers which support constant time removal.
+     */
+    uint32_t m_schedulerIndex;
 };
 
 } // namespace ns3
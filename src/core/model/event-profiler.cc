@@ -0,0 +1,155 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "event-profiler.h"
+
+#include "demangle.h"
+#include "event-impl.h"
+#include "fatal-error.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define NS3_EVENT_PROFILER_DLADDR
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+namespace
+{
+/**
+ * \ingroup simulator
+ * \param [in] context An execution context.
+ * \returns A printable name of the context.
+ */
+std::string
+ContextName(uint32_t context)
+{
+    if (context == Simulator::NO_CONTEXT)
+    {
+        return "no context";
+    }
+    return "node " + std::to_string(context);
+}
+} // namespace
+
+void
+EventProfiler::Invoke(EventImpl* event, uint32_t context)
+{
+    // Resolve the handler first: it may destroy the object it is called on.
+    Key key{typeid(*event), event->GetHandlerAddress(), context};
+    auto start = std::chrono::steady_clock::now();
+    event->Invoke();
+    auto end = std::chrono::steady_clock::now();
+    Stats& stats = m_stats[key];
+    stats.count++;
+    stats.time += end - start;
+}
+
+std::vector<EventProfiler::Entry>
+EventProfiler::GetEntries() const
+{
+    std::vector<Entry> entries;
+    entries.reserve(m_stats.size());
+    for (const auto& [key, stats] : m_stats)
+    {
+        entries.push_back({GetHandlerName(key), key.context, stats.count, stats.time.count()});
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.time > b.time;
+    });
+    return entries;
+}
+
+void
+EventProfiler::Write(std::ostream& os, Format format) const
+{
+    auto entries = GetEntries();
+    if (format == FOLDED)
+    {
+        for (const auto& entry : entries)
+        {
+            os << ContextName(entry.context) << ";" << entry.handler << " " << entry.time
+               << std::endl;
+        }
+        return;
+    }
+
+    uint64_t count = 0;
+    int64_t time = 0;
+    for (const auto& entry : entries)
+    {
+        count += entry.count;
+        time += entry.time;
+    }
+    os << "Event profile: " << count << " events, " << time * 1e-9 << " s" << std::endl;
+    os << std::left << std::setw(12) << "Time (s)" << std::setw(8) << "Share" << std::setw(12)
+       << "Count" << std::setw(12) << "Mean (us)" << std::setw(12) << "Context"
+       << "Event handler" << std::endl;
+    for (const auto& entry : entries)
+    {
+        os << std::setw(12) << entry.time * 1e-9 << std::setw(8)
+           << std::to_string(time > 0 ? entry.time * 100 / time : 0) + "%" << std::setw(12)
+           << entry.count << std::setw(12) << entry.time * 1e-3 / entry.count << std::setw(12)
+           << ContextName(entry.context) << entry.handler << std::endl;
+    }
+}
+
+void
+EventProfiler::Write(const std::string& filename, Format format) const
+{
+    if (filename.empty())
+    {
+        Write(std::cout, format);
+        return;
+    }
+    std::ofstream os(filename);
+    if (!os.is_open())
+    {
+        NS_FATAL_ERROR("Cannot open the event profile file " << filename);
+    }
+    Write(os, format);
+}
+
+std::string
+EventProfiler::GetHandlerName(const Key& key)
+{
+    if (key.handler == nullptr)
+    {
+        return Demangle(key.type.name());
+    }
+#ifdef NS3_EVENT_PROFILER_DLADDR
+    Dl_info info;
+    if (dladdr(key.handler, &info) != 0 && info.dli_sname != nullptr &&
+        info.dli_saddr == key.handler)
+    {
+        return Demangle(info.dli_sname);
+    }
+#endif
+    // the symbol is not exported, e.g., a function of the program itself
+    // without -rdynamic: the event type gives its signature
+    std::ostringstream oss;
+    oss << Demangle(key.type.name()) << " at " << key.handler;
+    return oss.str();
+}
+
+void
+EventProfiler::Clear()
+{
+    m_stats.clear();
+}
+
+} // namespace ns3
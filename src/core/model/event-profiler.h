@@ -0,0 +1,160 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <chrono>
+#include <iostream>
+#include <stdint.h>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Wall clock profile of the events executed by a simulator.
+ *
+ * Where DesMetrics traces when each event is scheduled, the
+ * EventProfiler measures the wall clock time spent executing each event,
+ * and aggregates it in memory by event handler and execution context.
+ * The handler of the events created by MakeEvent() from a function or a
+ * method is the function or method called (for a virtual method, the
+ * override of the object, see EventImpl::GetHandlerAddress()), named by
+ * its symbol when the dynamic linker finds it.  The other events, e.g.,
+ * the lambdas, are told apart by the dynamic type of the EventImpl,
+ * which identifies where the lambda is defined.
+ *
+ * The DefaultSimulatorImpl and the RealtimeSimulatorImpl profile their
+ * events when their \c EventProfile attribute is not \c None, and write
+ * the profile at Simulator::Destroy() to the file given by their
+ * \c EventProfileFile attribute, or to the standard output:
+ * \verbatim
+   $ ./ns3 run "my-script --ns3::DefaultSimulatorImpl::EventProfile=Report" \endverbatim
+ *
+ * The \c Report format is a table sorted by decreasing time.  The
+ * \c Folded format gives one line per event handler and context, with
+ * the total time in nanoseconds, which can be fed to \c flamegraph.pl:
+ * \verbatim
+   node 3;ns3::TcpSocketBase::SendPendingData(bool) 125000 \endverbatim
+ *
+ * When the profile is disabled, the simulators only test the attribute
+ * before executing each event.
+ */
+class EventProfiler
+{
+  public:
+    /** Output format of the profile. */
+    enum Format
+    {
+        NONE,   //!< Profiling disabled.
+        REPORT, //!< Table sorted by decreasing time.
+        FOLDED  //!< Folded stacks, for flame graphs.
+    };
+
+    /** The profile of one event handler in one context. */
+    struct Entry
+    {
+        std::string handler; //!< The name of the event handler.
+        uint32_t context; //!< The execution context.
+        uint64_t count;   //!< The number of events executed.
+        int64_t time;     //!< The cumulative wall clock time, in nanoseconds.
+    };
+
+    /**
+     * Execute an event, and add its execution time to the profile.
+     *
+     * \param [in] event The event.
+     * \param [in] context The execution context of the event.
+     */
+    void Invoke(EventImpl* event, uint32_t context);
+
+    /** \returns The profile entries, sorted by decreasing time. */
+    std::vector<Entry> GetEntries() const;
+
+    /**
+     * Write the profile.
+     *
+     * \param [in] os The output stream.
+     * \param [in] format The output format.
+     */
+    void Write(std::ostream& os, Format format) const;
+
+    /**
+     * Write the profile to a file, or to the standard output.
+     *
+     * \param [in] filename The file name, or empty for the standard output.
+     * \param [in] format The output format.
+     */
+    void Write(const std::string& filename, Format format) const;
+
+    /** Discard the profile. */
+    void Clear();
+
+  private:
+    /** Profile key: event handler and context. */
+    struct Key
+    {
+        std::type_index type; //!< The event type.
+        const void* handler;  //!< The address of the function called, if known.
+        uint32_t context;     //!< The execution context.
+
+        /**
+         * Equality operator.
+         * \param [in] other The other key.
+         * \returns \c true if the keys are equal.
+         */
+        bool operator==(const Key& other) const
+        {
+            return type == other.type && handler == other.handler && context == other.context;
+        }
+    };
+
+    /** Hash function for Key. */
+    struct KeyHash
+    {
+        /**
+         * \param [in] key The key.
+         * \returns The hash of the key.
+         */
+        std::size_t operator()(const Key& key) const
+        {
+            return key.type.hash_code() ^ (std::hash<const void*>()(key.handler) << 1) ^
+                   (std::hash<uint32_t>()(key.context) << 2);
+        }
+    };
+
+    /** Accumulated statistics of a key. */
+    struct Stats
+    {
+        uint64_t count{0};                //!< The number of events.
+        std::chrono::nanoseconds time{0}; //!< The cumulative time.
+    };
+
+    /**
+     * \param [in] key A profile key.
+     * \returns The name of the event handler.
+     */
+    static std::string GetHandlerName(const Key& key);
+
+    /** The profile. */
+    std::unordered_map<Key, Stats, KeyHash> m_stats;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
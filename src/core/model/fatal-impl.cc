@@ -176,6 +176,9 @@ void
 FlushStreams()
 {
     NS_LOG_FUNCTION_NOARGS();
+    // Write the log messages pending in the background thread, if any
+    LogSetAsync(false);
+
     std::list<std::ostream*>** pl = PeekStreamList();
     if (*pl == nullptr)
     {
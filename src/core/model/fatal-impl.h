@@ -79,6 +79,9 @@ void UnregisterStream(std::ostream* stream);
  * skip the bad \c ostream* and continue to flush the next stream.
  * The function will then terminate raising \c SIGIOT (aka \c SIGABRT)
  *
+ * The log messages pending in the background thread of LogSetAsync()
+ * are written first.
+ *
  * DO NOT call this function until the program is ready to crash.
  */
 void FlushStreams();
@@ -0,0 +1,267 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ladder-queue-scheduler.h"
+
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderQueueScheduler class implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderQueueScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderQueueScheduler);
+
+namespace
+{
+/**
+ * \ingroup scheduler
+ * Buckets with more events than this are split into a new rung
+ * instead of being sorted into the bottom.
+ */
+constexpr std::size_t SPAWN_THRESHOLD = 50;
+/** \ingroup scheduler Maximum number of rungs. */
+constexpr std::size_t MAX_RUNGS = 8;
+} // namespace
+
+TypeId
+LadderQueueScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LadderQueueScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<LadderQueueScheduler>();
+    return tid;
+}
+
+LadderQueueScheduler::LadderQueueScheduler()
+    : m_topMin(std::numeric_limits<uint64_t>::max()),
+      m_topMax(0),
+      m_topStart(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderQueueScheduler::~LadderQueueScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+LadderQueueScheduler::Rung::CurrentStart() const
+{
+    return start + current * width;
+}
+
+std::size_t
+LadderQueueScheduler::FindRung(uint64_t ts) const
+{
+    // each rung spans the interval between its current bucket and the
+    // current bucket of the rung above it
+    for (std::size_t i = 0; i < m_rungs.size(); ++i)
+    {
+        if (ts >= m_rungs[i].CurrentStart())
+        {
+            return i;
+        }
+    }
+    return m_rungs.size();
+}
+
+void
+LadderQueueScheduler::InsertBottom(const Scheduler::Event& ev)
+{
+    // new events are usually later than the ones already there
+    auto it = std::upper_bound(m_bottom.begin(), m_bottom.end(), ev);
+    m_bottom.insert(it, ev);
+}
+
+void
+LadderQueueScheduler::SpawnRung(Bucket& events, uint64_t start, uint64_t end)
+{
+    NS_LOG_FUNCTION(this << events.size() << start << end);
+    std::size_t n = events.size();
+    Rung rung;
+    rung.start = start;
+    rung.width = std::max<uint64_t>(1, (end - start + n - 1) / n);
+    rung.current = 0;
+    rung.buckets.resize(n);
+    for (const auto& ev : events)
+    {
+        std::size_t index = (ev.key.m_ts - start) / rung.width;
+        NS_ASSERT(index < n);
+        rung.buckets[index].push_back(ev);
+    }
+    events.clear();
+    m_rungs.push_back(std::move(rung));
+}
+
+void
+LadderQueueScheduler::MoveToBottom(Bucket& events)
+{
+    std::sort(events.begin(), events.end());
+    m_bottom.insert(m_bottom.end(), events.begin(), events.end());
+    events.clear();
+}
+
+void
+LadderQueueScheduler::Refill()
+{
+    while (m_bottom.empty())
+    {
+        if (m_rungs.empty())
+        {
+            if (m_top.empty())
+            {
+                return;
+            }
+            // spread the top over a first rung, with one bucket per event
+            uint64_t end = m_topMax + 1;
+            SpawnRung(m_top, m_topMin, end);
+            const Rung& first = m_rungs.front();
+            m_topStart = first.start + first.buckets.size() * first.width;
+            m_topMin = std::numeric_limits<uint64_t>::max();
+            m_topMax = 0;
+            continue;
+        }
+        Rung& rung = m_rungs.back();
+        while (rung.current < rung.buckets.size() && rung.buckets[rung.current].empty())
+        {
+            rung.current++;
+        }
+        if (rung.current == rung.buckets.size())
+        {
+            m_rungs.pop_back();
+            continue;
+        }
+        Bucket& bucket = rung.buckets[rung.current];
+        uint64_t bucketStart = rung.CurrentStart();
+        uint64_t bucketEnd = bucketStart + rung.width;
+        // the bucket is consumed: later events in its span go below this rung
+        rung.current++;
+        if (bucket.size() > SPAWN_THRESHOLD && rung.width > 1 && m_rungs.size() < MAX_RUNGS)
+        {
+            Bucket events;
+            events.swap(bucket);
+            SpawnRung(events, bucketStart, bucketEnd);
+        }
+        else
+        {
+            MoveToBottom(bucket);
+        }
+    }
+}
+
+void
+LadderQueueScheduler::Insert(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart)
+    {
+        m_top.push_back(ev);
+        m_topMin = std::min(m_topMin, ts);
+        m_topMax = std::max(m_topMax, ts);
+        Refill();
+        return;
+    }
+    std::size_t index = FindRung(ts);
+    if (index < m_rungs.size())
+    {
+        Rung& rung = m_rungs[index];
+        std::size_t bucket = (ts - rung.start) / rung.width;
+        NS_ASSERT(bucket < rung.buckets.size());
+        rung.buckets[bucket].push_back(ev);
+        return;
+    }
+    InsertBottom(ev);
+    if (m_bottom.size() > SPAWN_THRESHOLD && m_rungs.size() < MAX_RUNGS)
+    {
+        // too many events for an ordered list: move them back to the ladder
+        uint64_t start = m_bottom.front().key.m_ts;
+        uint64_t end = m_rungs.empty() ? m_topStart : m_rungs.back().CurrentStart();
+        // events with a single timestamp cannot be spread over buckets
+        if (m_bottom.back().key.m_ts > start && end - start > 1)
+        {
+            Bucket events(m_bottom.begin(), m_bottom.end());
+            m_bottom.clear();
+            SpawnRung(events, start, end);
+            Refill();
+        }
+    }
+}
+
+bool
+LadderQueueScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_bottom.empty();
+}
+
+Scheduler::Event
+LadderQueueScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return m_bottom.front();
+}
+
+Scheduler::Event
+LadderQueueScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    Scheduler::Event next = m_bottom.front();
+    m_bottom.pop_front();
+    Refill();
+    return next;
+}
+
+void
+LadderQueueScheduler::Remove(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    uint64_t ts = ev.key.m_ts;
+    Bucket* events = nullptr;
+    if (ts >= m_topStart)
+    {
+        events = &m_top;
+    }
+    else
+    {
+        std::size_t index = FindRung(ts);
+        if (index < m_rungs.size())
+        {
+            Rung& rung = m_rungs[index];
+            events = &rung.buckets[(ts - rung.start) / rung.width];
+        }
+    }
+    if (events != nullptr)
+    {
+        auto it = std::find(events->begin(), events->end(), ev);
+        NS_ASSERT_MSG(it != events->end(), "Event not found in the scheduler");
+        *it = events->back();
+        events->pop_back();
+        // the top bounds are not shrunk: they only need to include its events
+    }
+    else
+    {
+        auto it = std::lower_bound(m_bottom.begin(), m_bottom.end(), ev);
+        NS_ASSERT_MSG(it != m_bottom.end() && *it == ev, "Event not found in the scheduler");
+        m_bottom.erase(it);
+    }
+    Refill();
+}
+
+} // namespace ns3
@@ -0,0 +1,150 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef LADDER_QUEUE_SCHEDULER_H
+#define LADDER_QUEUE_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <deque>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderQueueScheduler class declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue described in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * The events are split in three tiers:
+ *  - the top, an unsorted array of the events later than the ladder;
+ *  - the ladder, a stack of rungs made of buckets of equal width, each
+ *    rung spanning one bucket of the rung above it;
+ *  - the bottom, a sorted list of the earliest events.
+ *
+ * Events are dequeued from the bottom.  When it is empty, the first
+ * non-empty bucket of the lowest rung is sorted into the bottom, or
+ * split into a new rung if it holds more than a threshold of events.
+ * When the ladder is empty, the top is spread over a new first rung
+ * with as many buckets as events.  Unlike the CalendarScheduler, the
+ * bucket widths adapt to the local density of events without ever
+ * redistributing the whole event set, which keeps the operations
+ * cheap when timestamps are bursty or span several time scales.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to top or bucket; ordered insert in the bottom
+ * IsEmpty()    | Constant        | The bottom is empty only if the queue is empty
+ * PeekNext()   | Constant        | First event of the bottom
+ * Remove()     | Linear          | Search within the top, a bucket or the bottom
+ * RemoveNext() | ~Constant       | Refill of the bottom from the ladder
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | ~1 `std::vector` per bucket      | Buckets of each rung
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderQueueScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderQueueScheduler();
+    /** Destructor. */
+    ~LadderQueueScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Container type for the unsorted event sets. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** A rung of the ladder. */
+    struct Rung
+    {
+        uint64_t start;              //!< Timestamp of the start of the first bucket.
+        uint64_t width;              //!< Bucket width.
+        std::size_t current;         //!< Index of the first bucket not yet dequeued.
+        std::vector<Bucket> buckets; //!< The buckets.
+
+        /** \returns The start of the first bucket not yet dequeued. */
+        uint64_t CurrentStart() const;
+    };
+
+    /**
+     * Move a set of events to a new rung spanning a time interval.
+     *
+     * \param [in,out] events The events, emptied on return.
+     * \param [in] start The start of the interval.
+     * \param [in] end The end of the interval, after every event.
+     */
+    void SpawnRung(Bucket& events, uint64_t start, uint64_t end);
+    /**
+     * Sort a set of events into the bottom.
+     *
+     * \param [in,out] events The events, emptied on return.
+     */
+    void MoveToBottom(Bucket& events);
+    /** Refill the bottom, if empty, from the ladder or the top. */
+    void Refill();
+    /**
+     * Find the rung which holds or would hold an event.
+     *
+     * \param [in] ts The event timestamp, earlier than the top.
+     * \returns The rung index, or the number of rungs if the event
+     *          belongs to the bottom.
+     */
+    std::size_t FindRung(uint64_t ts) const;
+    /**
+     * Insert an event in the bottom, keeping it sorted.
+     *
+     * \param [in] ev The event.
+     */
+    void InsertBottom(const Scheduler::Event& ev);
+
+    /** Events later than the ladder. */
+    Bucket m_top;
+    /** Earliest timestamp in the top. */
+    uint64_t m_topMin;
+    /** Latest timestamp in the top. */
+    uint64_t m_topMax;
+    /** Events with this timestamp or later go to the top. */
+    uint64_t m_topStart;
+    /** The rungs, from the coarsest to the finest. */
+    std::vector<Rung> m_rungs;
+    /** The earliest events, sorted. */
+    std::deque<Scheduler::Event> m_bottom;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_QUEUE_SCHEDULER_H */
@@ -171,7 +171,7 @@
     NS_LOG_CONDITION                                                                               \
     do                                                                                             \
     {                                                                                              \
-        if (g_log.IsEnabled(level))                                                                \
+        if (ns3::LogComponent::IsAnyEnabled() && g_log.IsEnabled(level)) [[unlikely]]             \
         {                                                                                          \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
@@ -196,7 +196,7 @@
     NS_LOG_CONDITION                                                                               \
     do                                                                                             \
     {                                                                                              \
-        if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
+        if (ns3::LogComponent::IsAnyEnabled() && g_log.IsEnabled(ns3::LOG_FUNCTION)) [[unlikely]]  \
         {                                                                                          \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
@@ -230,7 +230,7 @@
     NS_LOG_CONDITION                                                                               \
     do                                                                                             \
     {                                                                                              \
-        if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
+        if (ns3::LogComponent::IsAnyEnabled() && g_log.IsEnabled(ns3::LOG_FUNCTION)) [[unlikely]]  \
         {                                                                                          \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
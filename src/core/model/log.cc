@@ -15,13 +15,18 @@
 #include "ns3/core-config.h"
 
 #include <algorithm> // transform
-#include <cstring>   // strlen
+#include <condition_variable>
+#include <cstring> // strlen
 #include <iostream>
 #include <list>
 #include <locale> // toupper
 #include <map>
+#include <memory>
+#include <mutex>
 #include <numeric> // accumulate
 #include <stdexcept>
+#include <streambuf>
+#include <thread>
 #include <utility>
 
 /**
@@ -104,6 +109,165 @@ static TimePrinter g_logTimePrinter = nullptr;
  */
 static NodePrinter g_logNodePrinter = nullptr;
 
+std::atomic<uint32_t> LogComponent::m_enabledCount = 0;
+
+/**
+ * \ingroup logging
+ * The buffer of std::clog when the log messages are written by a
+ * background thread.
+ *
+ * Each thread writes its characters in its own buffer, and hands the
+ * message to the background thread when std::clog is flushed.  There is
+ * no put area, so that the threads share no buffer pointer.
+ *
+ * This is private to the logging implementation.
+ */
+class AsyncLogBuffer : public std::streambuf
+{
+  public:
+    /**
+     * Constructor: starts the background thread.
+     * \param [in] output The buffer to write the messages to.
+     */
+    AsyncLogBuffer(std::streambuf* output);
+    /** Destructor: writes the pending messages and stops the background thread. */
+    ~AsyncLogBuffer() override;
+
+    /**
+     * Get the buffer the messages are written to.
+     * \returns The output buffer.
+     */
+    std::streambuf* GetOutput() const;
+
+  protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+    int sync() override;
+
+  private:
+    /** Write the pending messages until the buffer is destroyed. */
+    void Write();
+
+    /** The characters written by each thread since its last flush. */
+    static thread_local std::string m_message;
+
+    std::streambuf* m_output;      //!< The buffer to write the messages to.
+    std::mutex m_mutex;            //!< Protects m_pending and m_stop.
+    std::condition_variable m_cv;  //!< Wakes up the background thread.
+    std::string m_pending;         //!< The messages not written yet.
+    bool m_stop{false};            //!< Whether the background thread must stop.
+    std::thread m_thread;          //!< The background thread.
+};
+
+thread_local std::string AsyncLogBuffer::m_message;
+
+AsyncLogBuffer::AsyncLogBuffer(std::streambuf* output)
+    : m_output(output),
+      m_thread(&AsyncLogBuffer::Write, this)
+{
+}
+
+AsyncLogBuffer::~AsyncLogBuffer()
+{
+    sync();
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+}
+
+std::streambuf*
+AsyncLogBuffer::GetOutput() const
+{
+    return m_output;
+}
+
+AsyncLogBuffer::int_type
+AsyncLogBuffer::overflow(int_type c)
+{
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        m_message.push_back(traits_type::to_char_type(c));
+    }
+    return traits_type::not_eof(c);
+}
+
+std::streamsize
+AsyncLogBuffer::xsputn(const char* s, std::streamsize n)
+{
+    m_message.append(s, n);
+    return n;
+}
+
+int
+AsyncLogBuffer::sync()
+{
+    if (m_message.empty())
+    {
+        return 0;
+    }
+    {
+        std::lock_guard lock(m_mutex);
+        m_pending.append(m_message);
+    }
+    m_message.clear();
+    m_cv.notify_one();
+    return 0;
+}
+
+void
+AsyncLogBuffer::Write()
+{
+    std::string messages;
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        m_cv.wait(lock, [this]() { return m_stop || !m_pending.empty(); });
+        if (m_pending.empty())
+        {
+            break;
+        }
+        messages.swap(m_pending);
+        lock.unlock();
+        m_output->sputn(messages.data(), messages.size());
+        m_output->pubsync();
+        messages.clear();
+        lock.lock();
+    }
+}
+
+/**
+ * \ingroup logging
+ * Get the buffer of std::clog when the log messages are written by a
+ * background thread.
+ * This is private to the logging implementation.
+ *
+ * \returns The buffer, or \c nullptr if the log messages are written
+ *          by the logging threads.
+ */
+static std::unique_ptr<AsyncLogBuffer>&
+GetAsyncLogBuffer()
+{
+    /** Restores the buffer of std::clog at the end of the program. */
+    struct Holder
+    {
+        std::unique_ptr<AsyncLogBuffer> buffer; //!< The buffer of std::clog.
+
+        ~Holder()
+        {
+            if (buffer)
+            {
+                std::clog.rdbuf(buffer->GetOutput());
+            }
+        }
+    };
+
+    static Holder holder;
+    return holder.buffer;
+}
+
 /**
  * \ingroup logging
  * Handler for the undocumented \c print-list token in NS_LOG
@@ -232,19 +396,6 @@ LogComponent::EnvVarCheck()
     Enable((LogLevel)level);
 }
 
-bool
-LogComponent::IsEnabled(const LogLevel level) const
-{
-    //  LogComponentEnableEnvVar ();
-    return level & m_levels;
-}
-
-bool
-LogComponent::IsNoneEnabled() const
-{
-    return m_levels == 0;
-}
-
 void
 LogComponent::SetMask(const LogLevel level)
 {
@@ -254,13 +405,32 @@ LogComponent::SetMask(const LogLevel level)
 void
 LogComponent::Enable(const LogLevel level)
 {
+    int32_t levels = m_levels;
     m_levels |= (level & ~m_mask);
+    CountEnabled(levels);
 }
 
 void
 LogComponent::Disable(const LogLevel level)
 {
+    int32_t levels = m_levels;
     m_levels &= ~level;
+    CountEnabled(levels);
+}
+
+void
+LogComponent::CountEnabled(int32_t levels)
+{
+    bool wasEnabled = (levels & LOG_LEVEL_ALL) != 0;
+    bool isEnabled = (m_levels & LOG_LEVEL_ALL) != 0;
+    if (isEnabled && !wasEnabled)
+    {
+        m_enabledCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (wasEnabled && !isEnabled)
+    {
+        m_enabledCount.fetch_sub(1, std::memory_order_relaxed);
+    }
 }
 
 std::string
@@ -507,6 +677,24 @@ LogGetNodePrinter()
     return g_logNodePrinter;
 }
 
+void
+LogSetAsync(bool async)
+{
+    std::unique_ptr<AsyncLogBuffer>& buffer = GetAsyncLogBuffer();
+    if (async && !buffer)
+    {
+        std::clog.flush();
+        buffer = std::make_unique<AsyncLogBuffer>(std::clog.rdbuf());
+        std::clog.rdbuf(buffer.get());
+    }
+    else if (!async && buffer)
+    {
+        std::clog.flush();
+        std::clog.rdbuf(buffer->GetOutput());
+        buffer.reset();
+    }
+}
+
 ParameterLogger::ParameterLogger(std::ostream& os)
     : m_os(os)
 {
@@ -14,6 +14,7 @@
 #include "node-printer.h"
 #include "time-printer.h"
 
+#include <atomic>
 #include <iostream>
 #include <stdint.h>
 #include <string>
@@ -310,6 +311,25 @@ void LogSetNodePrinter(NodePrinter np);
  */
 NodePrinter LogGetNodePrinter();
 
+/**
+ * Set whether the log messages are written by a background thread.
+ *
+ * When enabled, each thread formats its log messages in its own buffer,
+ * and hands each complete message to a background thread which writes
+ * it to the previous buffer of std::clog.  The logging threads thus do
+ * not wait for the output, nor for each other, and the messages of each
+ * thread keep their order.  Disabling it writes the pending messages
+ * before returning; so does NS_FATAL_ERROR().
+ *
+ * Only complete messages, ending with a flush of std::clog, such as
+ * the std::endl of the NS_LOG macros, are written.  This should be
+ * called while no other thread is logging.
+ *
+ * \param [in] async \c true to write the log messages from a
+ *             background thread.
+ */
+void LogSetAsync(bool async);
+
 /**
  * A single log component configuration.
  */
@@ -339,6 +359,17 @@ class LogComponent
      * \return \c true if all levels are disabled.
      */
     bool IsNoneEnabled() const;
+    /**
+     * Check if any LogComponent is enabled at a log level (not only
+     * for prefixes).
+     *
+     * The logging macros test this before the level of their component,
+     * so that a log statement costs a single test of a global flag when
+     * no logging is enabled.
+     *
+     * \return \c true if any LogComponent is enabled at a log level.
+     */
+    static bool IsAnyEnabled();
     /**
      * Enable this LogComponent at \c level
      *
@@ -405,6 +436,17 @@ class LogComponent
      */
     void EnvVarCheck();
 
+    /**
+     * Update the count of components enabled at a log level after
+     * a change of the enabled LogLevels.
+     *
+     * \param [in] levels The enabled LogLevels before the change.
+     */
+    void CountEnabled(int32_t levels);
+
+    /** The number of LogComponents enabled at a log level. */
+    static std::atomic<uint32_t> m_enabledCount;
+
     int32_t m_levels;   //!< Enabled LogLevels.
     int32_t m_mask;     //!< Blocked LogLevels.
     std::string m_name; //!< LogComponent name.
@@ -460,6 +502,24 @@ class ParameterLogger
     std::ostream& m_os; //!< Underlying output stream.
 };
 
+inline bool
+LogComponent::IsEnabled(const LogLevel level) const
+{
+    return level & m_levels;
+}
+
+inline bool
+LogComponent::IsNoneEnabled() const
+{
+    return m_levels == 0;
+}
+
+inline bool
+LogComponent::IsAnyEnabled()
+{
+    return m_enabledCount.load(std::memory_order_relaxed) != 0;
+}
+
 template <typename T>
 ParameterLogger&
 ParameterLogger::operator<<(const T& param)
@@ -11,6 +11,7 @@
 #include "warnings.h"
 
 #include <functional>
+#include <memory>
 #include <tuple>
 #include <type_traits>
 
@@ -138,7 +139,9 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
         EventMemberImpl() = delete;
 
         EventMemberImpl(OBJ obj, MEM function, Ts... args)
-            : m_function(std::bind(function, obj, args...))
+            : m_obj(obj),
+              m_function(function),
+              m_arguments(args...)
         {
         }
 
@@ -150,10 +153,22 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
       private:
         void Notify() override
         {
-            m_function();
+            std::apply([this](auto&... args) { std::invoke(m_function, m_obj, args...); },
+                       m_arguments);
+        }
+
+        const void* GetHandlerAddress() const override
+        {
+            if constexpr (std::is_member_function_pointer_v<MEM> && requires { *m_obj; })
+            {
+                return GetMethodAddress(&m_function, sizeof(MEM), std::addressof(*m_obj));
+            }
+            return nullptr;
         }
 
-        std::function<void()> m_function;
+        OBJ m_obj;
+        MEM m_function;
+        std::tuple<std::remove_reference_t<Ts>...> m_arguments;
     }* ev = new EventMemberImpl(obj, mem_ptr, args...);
 
     return ev;
@@ -183,6 +198,11 @@ MakeEvent(void (*f)(Us...), Ts... args)
             std::apply([this](Ts... args) { (*m_function)(args...); }, m_arguments);
         }
 
+        const void* GetHandlerAddress() const override
+        {
+            return reinterpret_cast<const void*>(m_function);
+        }
+
         void (*m_function)(Us...);
         std::tuple<std::remove_reference_t<Ts>...> m_arguments;
     }* ev = new EventFunctionImpl(f, args...);
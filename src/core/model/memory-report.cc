@@ -0,0 +1,285 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "memory-report.h"
+
+#include "event-impl.h"
+#include "log.h"
+#include "object-ptr-container.h"
+#include "pointer.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup object
+ * ns3::MemoryReport implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MemoryReport");
+
+namespace
+{
+
+/**
+ * \ingroup object
+ * Get the collectors registered with MemoryReport::AddCollector().
+ * \returns The collectors.
+ */
+std::vector<MemoryReport::Collector>&
+GetCollectors()
+{
+    static std::vector<MemoryReport::Collector> collectors;
+    return collectors;
+}
+
+/**
+ * \ingroup object
+ * Collect a report, and print it.
+ * \param [in] os The output stream.
+ */
+void
+PrintReport(std::ostream* os)
+{
+    MemoryReport::Collect().Print(*os, true);
+}
+
+} // namespace
+
+void
+MemoryReport::AddCollector(Collector collector)
+{
+    NS_LOG_FUNCTION(&collector);
+    GetCollectors().push_back(collector);
+}
+
+MemoryReport
+MemoryReport::Collect()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    MemoryReport report;
+    // The events allocated by the calling thread: the events scheduled,
+    // and the events cancelled but still referenced by an EventId.
+    EventImpl::PoolStatistics events = EventImpl::GetPoolStatistics();
+    report.Add(Simulator::NO_CONTEXT,
+               "ns3::EventImpl",
+               std::max<int64_t>(events.bytes, 0),
+               std::max<int64_t>(events.live, 0));
+    for (auto& collector : GetCollectors())
+    {
+        collector(report);
+    }
+    return report;
+}
+
+void
+MemoryReport::PrintAtDestroy(std::ostream& os)
+{
+    NS_LOG_FUNCTION(&os);
+    Simulator::ScheduleDestroy(&PrintReport, &os);
+}
+
+uint64_t
+MemoryReport::GetObjectBytes(Ptr<const Object> object)
+{
+    NS_LOG_FUNCTION(object);
+    TypeId tid = object->GetInstanceTypeId();
+    std::size_t size = tid.GetSize();
+    Callback<std::size_t, const ObjectBase*> estimator = tid.GetMemoryEstimator();
+    // The size and the estimator of an unregistered type are those of its
+    // closest parent.
+    TypeId parent = tid;
+    while ((size == std::size_t(-1) || estimator.IsNull()) && parent.HasParent())
+    {
+        parent = parent.GetParent();
+        if (size == std::size_t(-1))
+        {
+            size = parent.GetSize();
+        }
+        if (estimator.IsNull())
+        {
+            estimator = parent.GetMemoryEstimator();
+        }
+    }
+    uint64_t bytes = size == std::size_t(-1) ? 0 : size;
+    if (!estimator.IsNull())
+    {
+        bytes += estimator(PeekPointer(object));
+    }
+    return bytes;
+}
+
+void
+MemoryReport::AddObjects(uint32_t context, Ptr<const Object> root)
+{
+    NS_LOG_FUNCTION(this << context << root);
+    std::vector<Ptr<const Object>> pending{root};
+    while (!pending.empty())
+    {
+        Ptr<const Object> object = pending.back();
+        pending.pop_back();
+        if (!m_accounted.insert(PeekPointer(object)).second)
+        {
+            continue;
+        }
+        AddObject(context, object);
+
+        Object::AggregateIterator aggregates = object->GetAggregateIterator();
+        while (aggregates.HasNext())
+        {
+            Ptr<const Object> aggregate = aggregates.Next();
+            if (m_accounted.count(PeekPointer(aggregate)) == 0)
+            {
+                pending.push_back(aggregate);
+            }
+        }
+
+        TypeId tid = object->GetInstanceTypeId();
+        TypeId nextTid = tid;
+        do
+        {
+            tid = nextTid;
+            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            {
+                TypeId::AttributeInformation info = tid.GetAttribute(i);
+                // deprecated or unreadable attributes are not followed, as
+                // reading them would report them.
+                if (!(info.flags & TypeId::ATTR_GET) || !info.accessor->HasGetter() ||
+                    info.supportLevel != TypeId::SUPPORTED)
+                {
+                    continue;
+                }
+                if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+                {
+                    PointerValue value;
+                    if (info.accessor->Get(PeekPointer(object), value) && value.GetObject() &&
+                        m_accounted.count(PeekPointer(value.GetObject())) == 0)
+                    {
+                        pending.emplace_back(value.GetObject());
+                    }
+                }
+                else if (dynamic_cast<const ObjectPtrContainerChecker*>(
+                             PeekPointer(info.checker)) != nullptr)
+                {
+                    ObjectPtrContainerValue value;
+                    if (!info.accessor->Get(PeekPointer(object), value))
+                    {
+                        continue;
+                    }
+                    for (auto it = value.Begin(); it != value.End(); ++it)
+                    {
+                        if (it->second && m_accounted.count(PeekPointer(it->second)) == 0)
+                        {
+                            pending.emplace_back(it->second);
+                        }
+                    }
+                }
+            }
+            nextTid = tid.GetParent();
+        } while (nextTid != tid);
+    }
+}
+
+void
+MemoryReport::Exclude(Ptr<const Object> object)
+{
+    NS_LOG_FUNCTION(this << object);
+    m_accounted.insert(PeekPointer(object));
+}
+
+void
+MemoryReport::AddObject(uint32_t context, Ptr<const Object> object)
+{
+    NS_LOG_FUNCTION(this << context << object);
+    Add(context, object->GetInstanceTypeId().GetName(), GetObjectBytes(object));
+}
+
+void
+MemoryReport::Add(uint32_t context, const std::string& name, uint64_t bytes, uint64_t count)
+{
+    NS_LOG_FUNCTION(this << context << name << bytes << count);
+    for (Usage* usage : {&m_types[name], &m_contexts[context], &m_total})
+    {
+        usage->count += count;
+        usage->bytes += bytes;
+    }
+}
+
+MemoryReport::Usage
+MemoryReport::GetTotal() const
+{
+    return m_total;
+}
+
+MemoryReport::Usage
+MemoryReport::GetType(const std::string& name) const
+{
+    auto it = m_types.find(name);
+    return it == m_types.end() ? Usage() : it->second;
+}
+
+MemoryReport::Usage
+MemoryReport::GetContext(uint32_t context) const
+{
+    auto it = m_contexts.find(context);
+    return it == m_contexts.end() ? Usage() : it->second;
+}
+
+const std::map<std::string, MemoryReport::Usage>&
+MemoryReport::GetTypes() const
+{
+    return m_types;
+}
+
+const std::map<uint32_t, MemoryReport::Usage>&
+MemoryReport::GetContexts() const
+{
+    return m_contexts;
+}
+
+void
+MemoryReport::Print(std::ostream& os, bool contexts) const
+{
+    NS_LOG_FUNCTION(this << &os << contexts);
+    std::vector<std::pair<std::string, Usage>> types(m_types.begin(), m_types.end());
+    std::stable_sort(types.begin(), types.end(), [](const auto& a, const auto& b) {
+        return a.second.bytes > b.second.bytes;
+    });
+    os << std::setw(14) << "bytes" << std::setw(12) << "count"
+       << "  type" << std::endl;
+    for (const auto& [name, usage] : types)
+    {
+        os << std::setw(14) << usage.bytes << std::setw(12) << usage.count << "  " << name
+           << std::endl;
+    }
+    os << std::setw(14) << m_total.bytes << std::setw(12) << m_total.count << "  total"
+       << std::endl;
+    if (!contexts)
+    {
+        return;
+    }
+    os << std::setw(14) << "bytes" << std::setw(12) << "count"
+       << "  context" << std::endl;
+    for (const auto& [context, usage] : m_contexts)
+    {
+        os << std::setw(14) << usage.bytes << std::setw(12) << usage.count << "  ";
+        if (context == Simulator::NO_CONTEXT)
+        {
+            os << "global";
+        }
+        else
+        {
+            os << "node " << context;
+        }
+        os << std::endl;
+    }
+}
+
+} // namespace ns3
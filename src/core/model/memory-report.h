@@ -0,0 +1,197 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+#include "callback.h"
+#include "object.h"
+#include "ptr.h"
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+
+/**
+ * \file
+ * \ingroup object
+ * ns3::MemoryReport declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup object
+ *
+ * \brief The memory held by the objects of a simulation, per type and per
+ * node.
+ *
+ * A report accounts for the objects of the simulation, each with its size
+ * (see TypeId::GetSize()) and the memory it allocates, as estimated by
+ * the memory estimator of its type, or of its closest parent type with
+ * one (see TypeId::SetMemoryEstimator()).  The objects are found from the
+ * roots given to AddObjects(), by following their aggregates and the
+ * objects of their Pointer and ObjectPtrContainer attributes, and are
+ * accounted for once, in the context of the first root reaching them.
+ * The memory not held by objects, such as the packet buffers and the
+ * pending events, is added by name with Add().
+ *
+ * The modules register collectors, which add their objects to the
+ * reports made by Collect(): e.g., the network module adds each node,
+ * in the context of its id, and the packet buffers and metadata.  A
+ * report can be collected at any time during the simulation:
+ * \code
+ *   MemoryReport report = MemoryReport::Collect();
+ *   std::cout << report.GetContext(0).bytes << " bytes held by node 0" << std::endl;
+ *   report.Print(std::cout);
+ * \endcode
+ *
+ * The estimates only cover the memory the estimators know about: the
+ * sizes of the objects, and the dynamic memory of the types with an
+ * estimator.  They are meant to compare the footprints of the types and
+ * of the nodes, not to match the memory used by the process.  The bytes
+ * of the packets are only counted by the packet buffers, with the size of
+ * their storage, which excludes the zero-filled bytes not stored: the
+ * queues and the TCP buffers count their entries.  The events and the
+ * packet buffers are counted by thread: with MultithreadedSimulatorImpl, a report collected by the
+ * main thread only includes its own.
+ */
+class MemoryReport
+{
+  public:
+    /** The memory held by a set of objects. */
+    struct Usage
+    {
+        uint64_t count{0}; //!< The number of objects, or of items.
+        uint64_t bytes{0}; //!< The number of bytes.
+    };
+
+    /** A collector, adding its objects to a report. */
+    using Collector = Callback<void, MemoryReport&>;
+
+    /**
+     * Register a collector, called by Collect().
+     *
+     * The collectors are called in the order they are registered.
+     *
+     * \param [in] collector The collector.
+     */
+    static void AddCollector(Collector collector);
+
+    /**
+     * Make a report of the current memory usage, with the registered collectors.
+     *
+     * \returns The report.
+     */
+    static MemoryReport Collect();
+
+    /**
+     * Print the report collected when Simulator::Destroy() is called.
+     *
+     * The report is collected by an event scheduled with
+     * Simulator::ScheduleDestroy().  The destroy events run in the order
+     * they are scheduled, and the nodes are destroyed by such an event,
+     * scheduled when the first node is created: call this function before
+     * creating the nodes for the report to include them.
+     *
+     * \param [in] os The output stream, which must outlive the simulation.
+     */
+    static void PrintAtDestroy(std::ostream& os);
+
+    /**
+     * Estimate the memory held by an object: its size and the estimate
+     * of the memory estimator of its type, without the objects of its
+     * attributes and aggregates.
+     *
+     * \param [in] object The object.
+     * \returns The number of bytes.
+     */
+    static uint64_t GetObjectBytes(Ptr<const Object> object);
+
+    /**
+     * Account for an object, its aggregates, and the objects of their
+     * attributes, recursively.  The objects already accounted for are
+     * skipped.
+     *
+     * \param [in] context The context of the objects, e.g., a node id, or
+     *             Simulator::NO_CONTEXT.
+     * \param [in] root The object.
+     */
+    void AddObjects(uint32_t context, Ptr<const Object> root);
+
+    /**
+     * Mark an object as accounted for, so that AddObjects() skips it.
+     *
+     * \param [in] object The object.
+     */
+    void Exclude(Ptr<const Object> object);
+
+    /**
+     * Account for memory not held by an object.
+     *
+     * \param [in] context The context of the memory, e.g., a node id, or
+     *             Simulator::NO_CONTEXT.
+     * \param [in] name The name the memory is reported under.
+     * \param [in] bytes The number of bytes.
+     * \param [in] count The number of items.
+     */
+    void Add(uint32_t context, const std::string& name, uint64_t bytes, uint64_t count = 1);
+
+    /**
+     * \returns The memory accounted for.
+     */
+    Usage GetTotal() const;
+
+    /**
+     * Get the memory of a type.
+     * \param [in] name The TypeId name, or the name given to Add().
+     * \returns The memory of the type.
+     */
+    Usage GetType(const std::string& name) const;
+
+    /**
+     * Get the memory of a context.
+     * \param [in] context The context, e.g., a node id.
+     * \returns The memory of the context.
+     */
+    Usage GetContext(uint32_t context) const;
+
+    /**
+     * \returns The memory of each type, by name.
+     */
+    const std::map<std::string, Usage>& GetTypes() const;
+
+    /**
+     * \returns The memory of each context.
+     */
+    const std::map<uint32_t, Usage>& GetContexts() const;
+
+    /**
+     * Print the memory of the types, from the largest, and the total.
+     *
+     * \param [in] os The output stream.
+     * \param [in] contexts Whether to also print the memory of each context.
+     */
+    void Print(std::ostream& os, bool contexts = false) const;
+
+  private:
+    /**
+     * Account for an object.
+     * \param [in] context The context of the object.
+     * \param [in] object The object.
+     */
+    void AddObject(uint32_t context, Ptr<const Object> object);
+
+    std::map<std::string, Usage> m_types;          //!< The memory by type.
+    std::map<uint32_t, Usage> m_contexts;          //!< The memory by context.
+    Usage m_total;                                 //!< The memory accounted for.
+    std::unordered_set<const Object*> m_accounted; //!< The objects accounted for.
+};
+
+} // namespace ns3
+
+#endif /* MEMORY_REPORT_H */
@@ -0,0 +1,207 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include "assert.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MpscQueue declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ *
+ * \brief A bounded lock-free multiple producer, single consumer queue.
+ *
+ * The queue is a ring of cells, each with a sequence number telling
+ * whether it is free for the producer of a given position, or full for
+ * the consumer (D. Vyukov's bounded queue).  Producers claim a position
+ * with a compare-and-swap on the tail, so concurrent producers never
+ * block each other, and the single consumer pops without any
+ * read-modify-write operation.
+ *
+ * Push() fails instead of blocking when the queue is full: the caller
+ * decides how to handle the overflow.  The elements pushed by one
+ * producer are popped in the order they were pushed.
+ *
+ * \tparam T \explicit The element type, which must be copyable.
+ */
+template <typename T>
+class MpscQueue
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] capacity The number of elements, a power of 2.
+     */
+    MpscQueue(std::size_t capacity);
+
+    /**
+     * Push an element; safe to call from any thread.
+     *
+     * \param [in] value The element.
+     * \returns \c false if the queue is full.
+     */
+    bool Push(const T& value);
+
+    /**
+     * Pop the oldest element; only called by the consumer thread.
+     *
+     * \param [out] value The element.
+     * \returns \c false if the queue is empty.
+     */
+    bool Pop(T& value);
+
+    /**
+     * Pop all the elements available, in order; only called by the
+     * consumer thread.
+     *
+     * \tparam F \deduced The function type.
+     * \param [in] f The function called with each element.
+     * \returns The number of elements popped.
+     */
+    template <typename F>
+    std::size_t Drain(F f);
+
+    /**
+     * Check if an element is ready to be popped; only called by the
+     * consumer thread.
+     *
+     * \returns \c true if the queue is empty.
+     */
+    bool IsEmpty() const;
+
+  private:
+    /** A cell of the ring. */
+    struct Cell
+    {
+        /**
+         * Equal to the position for which the cell is free, or to the
+         * position + 1 when it holds the element of that position.
+         */
+        std::atomic<std::size_t> sequence;
+        T value; //!< The element.
+    };
+
+    /** Cache line size, to keep the producer and consumer positions apart. */
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    std::unique_ptr<Cell[]> m_cells; //!< The ring.
+    std::size_t m_mask;              //!< Capacity - 1.
+    /** Next position to push. */
+    alignas(CACHE_LINE) std::atomic<std::size_t> m_tail;
+    /** Next position to pop. */
+    alignas(CACHE_LINE) std::size_t m_head;
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3
+{
+
+template <typename T>
+MpscQueue<T>::MpscQueue(std::size_t capacity)
+    : m_cells(new Cell[capacity]),
+      m_mask(capacity - 1),
+      m_tail(0),
+      m_head(0)
+{
+    NS_ASSERT_MSG(capacity >= 2 && (capacity & m_mask) == 0, "Capacity must be a power of 2");
+    for (std::size_t i = 0; i < capacity; ++i)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool
+MpscQueue<T>::Push(const T& value)
+{
+    std::size_t position = m_tail.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true)
+    {
+        cell = &m_cells[position & m_mask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(sequence - position);
+        if (diff == 0)
+        {
+            if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+            // position reloaded by the failed compare_exchange
+        }
+        else if (diff < 0)
+        {
+            // the cell still holds the element of the previous lap
+            return false;
+        }
+        else
+        {
+            position = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+    cell->value = value;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool
+MpscQueue<T>::Pop(T& value)
+{
+    Cell* cell = &m_cells[m_head & m_mask];
+    if (cell->sequence.load(std::memory_order_acquire) != m_head + 1)
+    {
+        return false;
+    }
+    value = cell->value;
+    // free the cell for the producer of the next lap
+    cell->sequence.store(m_head + m_mask + 1, std::memory_order_release);
+    m_head++;
+    return true;
+}
+
+template <typename T>
+template <typename F>
+std::size_t
+MpscQueue<T>::Drain(F f)
+{
+    std::size_t count = 0;
+    T value;
+    while (Pop(value))
+    {
+        f(value);
+        count++;
+    }
+    return count;
+}
+
+template <typename T>
+bool
+MpscQueue<T>::IsEmpty() const
+{
+    return m_cells[m_head & m_mask].sequence.load(std::memory_order_acquire) != m_head + 1;
+}
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
@@ -10,6 +10,7 @@
 #include "assert.h"
 #include "log.h"
 #include "object.h"
+#include "simulation-context.h"
 #include "singleton.h"
 
 #include <map>
@@ -120,6 +121,13 @@ class NamesPriv : public Singleton<NamesPriv>
     /** Destructor. */
     ~NamesPriv() override;
 
+    /**
+     * Get the Names of the current SimulationContext, or the
+     * process-wide instance.
+     * \returns The NamesPriv instance.
+     */
+    static NamesPriv* Get();
+
     // Doxygen \copydoc bug: won't copy these docs, so we repeat them.
 
     /**
@@ -277,6 +285,17 @@ NamesPriv::NamesPriv()
     m_root.m_object = nullptr;
 }
 
+NamesPriv*
+NamesPriv::Get()
+{
+    SimulationContext* context = SimulationContext::GetCurrent();
+    if (context != nullptr)
+    {
+        return context->GetSingleton<NamesPriv>();
+    }
+    return Singleton<NamesPriv>::Get();
+}
+
 NamesPriv::~NamesPriv()
 {
     NS_LOG_FUNCTION(this);
@@ -513,6 +513,13 @@ class Time
 
         NS_ASSERT_MSG(info->isValid, "Attempted a conversion from an unavailable unit.");
 
+#if defined(TIME_USE_FAST_PATH) && !defined(PYTHON_SCAN)
+        const bool negative = value.GetHigh() < 0;
+        uint128_t v = static_cast<uint64_t>(value.GetHigh());
+        v = (v << 64) | value.GetLow();
+        const int64_t retval = ConvertFrom(negative ? -v : v, info);
+        return Time(negative ? -retval : retval);
+#else
         // DO NOT REMOVE this temporary variable. It's here
         // to work around a compiler bug in gcc 3.4
         int64x64_t retval = value;
@@ -525,6 +532,39 @@ class Time
             retval.MulByInvert(info->timeFrom);
         }
         return Time(retval);
+#endif
+    }
+
+    /**
+     * Create a Time equal to \pname{numerator} / \pname{denominator}
+     * in unit \c unit.
+     *
+     * The result is the same as
+     * \code
+     *   From(int64x64_t(numerator) / int64x64_t(denominator), unit)
+     * \endcode
+     * which is how transmission times are computed from data rates,
+     * but is computed with integer arithmetic when available.
+     *
+     * \param [in] numerator The numerator, less than 2^63.
+     * \param [in] denominator The denominator, less than 2^63.
+     * \param [in] unit The unit of the ratio
+     * \return The Time representing the ratio in \c unit
+     */
+    inline static Time FromRatio(uint64_t numerator, uint64_t denominator, Unit unit)
+    {
+#if defined(TIME_USE_FAST_PATH) && !defined(PYTHON_SCAN)
+        Information* info = PeekInformation(unit);
+
+        NS_ASSERT_MSG(info->isValid, "Attempted a conversion from an unavailable unit.");
+
+        // int64x64_t::Udiv() computes exactly this quotient when both
+        // operands are integers
+        const uint128_t ratio = (static_cast<uint128_t>(numerator) << 64) / denominator;
+        return Time(ConvertFrom(ratio, info));
+#else
+        return From(int64x64_t(numerator) / int64x64_t(denominator), unit);
+#endif
     }
 
     /**@}*/ // Create Times from Values and Units
@@ -561,7 +601,29 @@ class Time
 
     inline double ToDouble(Unit unit) const
     {
+#if defined(TIME_USE_FAST_PATH) && !defined(PYTHON_SCAN)
+        Information* info = PeekInformation(unit);
+
+        NS_ASSERT_MSG(info->isValid, "Attempted a conversion to an unavailable unit.");
+
+        // Same operations as To(unit).GetDouble()
+        const bool negative = m_data < 0;
+        const uint128_t v = negative ? -static_cast<uint128_t>(m_data) : m_data;
+        long double retval;
+        if (info->toMul)
+        {
+            retval = v * info->factor;
+        }
+        else
+        {
+            const uint128_t q = MulByInvert(v << 64, info->timeTo);
+            retval = q >> 64;
+            retval += (q & 0xffffffffffffffffULL) / int64x64_t::HP_MAX_64;
+        }
+        return negative ? -retval : retval;
+#else
         return To(unit).GetDouble();
+#endif
     }
 
     inline int64x64_t To(Unit unit) const
@@ -658,6 +720,49 @@ class Time
         return &(PeekResolution()->info[timeUnit]);
     }
 
+#if defined(TIME_USE_FAST_PATH) && !defined(PYTHON_SCAN)
+    /**
+     * Multiply a non-negative Q64.64 value by the Q0.128 inverse held
+     * by an int64x64_t, as int64x64_t::MulByInvert() does.
+     *
+     * \param [in] value The Q64.64 value.
+     * \param [in] invert The inverse, from int64x64_t::Invert().
+     * \return The Q64.64 product.
+     */
+    static inline uint128_t MulByInvert(const uint128_t value, const int64x64_t& invert)
+    {
+        const uint128_t lo = value & 0xffffffffffffffffULL;
+        const uint128_t hi = value >> 64;
+        const uint128_t invertLo = invert.GetLow();
+        const uint128_t invertHi = static_cast<uint64_t>(invert.GetHigh());
+        return hi * invertHi + ((hi * invertLo + lo * invertHi) >> 64);
+    }
+
+    /**
+     * Convert a non-negative Q64.64 value in some unit to the current
+     * unit, rounded to the nearest integer.
+     *
+     * This performs the same operations as From(const int64x64_t&, Unit)
+     * on the raw representation, without the int64x64_t calls.
+     *
+     * \param [in] value The Q64.64 value.
+     * \param [in] info The Information of the unit of \pname{value}.
+     * \return The value in the current unit.
+     */
+    static inline int64_t ConvertFrom(uint128_t value, const Information* info)
+    {
+        if (info->fromMul)
+        {
+            value *= info->factor;
+        }
+        else
+        {
+            value = MulByInvert(value, info->timeFrom);
+        }
+        return static_cast<int64_t>((value + (static_cast<uint128_t>(1) << 63)) >> 64);
+    }
+#endif
+
     /**
      *  Set the default resolution
      *
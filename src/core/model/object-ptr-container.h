@@ -245,6 +245,33 @@ class ObjectPtrContainerAccessor : public AttributeAccessor
     bool HasGetter() const override;
     bool HasSetter() const override;
 
+    /**
+     * Get the number of instances in the container.
+     *
+     * \param [in] object The container object.
+     * \param [out] n The number of instances in the container.
+     * \returns true if the value could be obtained successfully.
+     */
+    bool GetN(const ObjectBase* object, std::size_t* n) const;
+    /**
+     * Get one instance from the container, without copying the
+     * whole container as Get() does.
+     *
+     * \param [in] object The container object, for which GetN() succeeded.
+     * \param [in] i The position of the instance, less than the number
+     *               of instances.
+     * \param [out] index The index of the instance.
+     * \returns The instance.
+     */
+    Ptr<Object> GetItem(const ObjectBase* object, std::size_t i, std::size_t* index) const;
+    /**
+     * Check whether the index of each instance is its position in the
+     * container, as in an ObjectVector.
+     *
+     * \returns true if the instances are indexed by position.
+     */
+    virtual bool IsIndexedByPosition() const;
+
   private:
     /**
      * Get the number of instances in the container.
@@ -293,6 +320,11 @@ MakeObjectPtrContainerAccessor(Ptr<U> (T::*get)(INDEX) const, INDEX (T::*getN)()
             return (obj->*m_get)(i);
         }
 
+        bool IsIndexedByPosition() const override
+        {
+            return true;
+        }
+
         Ptr<U> (T::*m_get)(INDEX) const;
         INDEX (T::*m_getN)() const;
     }* spec = new MemberGetters();
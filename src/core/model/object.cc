@@ -97,11 +97,11 @@ Object::Object()
     : m_tid(Object::GetTypeId()),
       m_disposed(false),
       m_initialized(false),
-      m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
-      m_getObjectCount(0)
+      m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates)))
 {
     NS_LOG_FUNCTION(this);
     m_aggregates->n = 1;
+    m_aggregates->index = nullptr;
     m_aggregates->buffer[0] = this;
 }
 
@@ -121,11 +121,14 @@ Object::~Object()
             m_aggregates->n--;
         }
     }
+    // the lookup table may point to this object
+    delete m_aggregates->index;
+    m_aggregates->index = nullptr;
     // finally, if all objects have been removed from the list,
     // delete the aggregate list
     if (m_aggregates->n == 0)
     {
-        std::free(m_aggregates);
+        FreeAggregates(m_aggregates);
     }
     m_aggregates = nullptr;
     m_unidirectionalAggregates.clear();
@@ -135,10 +138,10 @@ Object::Object(const Object& o)
     : m_tid(o.m_tid),
       m_disposed(false),
       m_initialized(false),
-      m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
-      m_getObjectCount(0)
+      m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates)))
 {
     m_aggregates->n = 1;
+    m_aggregates->index = nullptr;
     m_aggregates->buffer[0] = this;
 }
 
@@ -156,34 +159,27 @@ Object::DoGetObject(TypeId tid) const
     NS_ASSERT(CheckLoose());
 
     // First check if the object is in the normal aggregates.
-    uint32_t n = m_aggregates->n;
-    TypeId objectTid = Object::GetTypeId();
-    for (uint32_t i = 0; i < n; i++)
+    if (m_aggregates->index == nullptr)
     {
-        Object* current = m_aggregates->buffer[i];
-        TypeId cur = current->GetInstanceTypeId();
-        while (cur != tid && cur != objectTid)
+        m_aggregates->index = BuildIndex(m_aggregates);
+    }
+    const Index* index = m_aggregates->index;
+    uint16_t uid = tid.GetUid();
+    for (uint32_t i = uid & index->mask;; i = (i + 1) & index->mask)
+    {
+        const Index::Entry& entry = index->entries[i];
+        if (entry.uid == uid)
         {
-            cur = cur.GetParent();
+            return entry.object;
         }
-        if (cur == tid)
+        if (entry.uid == 0)
         {
-            // This is an attempt to 'cache' the result of this lookup.
-            // the idea is that if we perform a lookup for a TypeId on this object,
-            // we are likely to perform the same lookup later so, we make sure
-            // that the aggregate array is sorted by the number of accesses
-            // to each object.
-
-            // first, increment the access count
-            current->m_getObjectCount++;
-            // then, update the sort
-            UpdateSortedArray(m_aggregates, i);
-            // finally, return the match
-            return const_cast<Object*>(current);
+            break;
         }
     }
 
     // Next check if it's a unidirectional aggregate
+    TypeId objectTid = Object::GetTypeId();
     for (auto& uniItem : m_unidirectionalAggregates)
     {
         TypeId cur = uniItem->GetInstanceTypeId();
@@ -280,18 +276,59 @@ restart:
     }
 }
 
-void
-Object::UpdateSortedArray(Aggregates* aggregates, uint32_t j) const
+Object::Index*
+Object::BuildIndex(const Aggregates* aggregates)
 {
-    NS_LOG_FUNCTION(this << aggregates << j);
-    while (j > 0 &&
-           aggregates->buffer[j]->m_getObjectCount > aggregates->buffer[j - 1]->m_getObjectCount)
+    NS_LOG_FUNCTION(aggregates);
+    // the TypeIds of each object, from its own to Object's
+    TypeId objectTid = Object::GetTypeId();
+    std::vector<Index::Entry> types;
+    for (uint32_t i = 0; i < aggregates->n; i++)
     {
-        Object* tmp = aggregates->buffer[j - 1];
-        aggregates->buffer[j - 1] = aggregates->buffer[j];
-        aggregates->buffer[j] = tmp;
-        j--;
+        Object* current = aggregates->buffer[i];
+        TypeId cur = current->GetInstanceTypeId();
+        while (true)
+        {
+            types.push_back({cur.GetUid(), current});
+            TypeId parent = cur.GetParent();
+            if (cur == objectTid || parent == cur)
+            {
+                break;
+            }
+            cur = parent;
+        }
+    }
+
+    auto index = new Index;
+    uint32_t size = 4;
+    while (size < 2 * types.size())
+    {
+        size *= 2;
     }
+    index->mask = size - 1;
+    index->entries.assign(size, {0, nullptr});
+    for (const auto& type : types)
+    {
+        uint32_t i = type.uid & index->mask;
+        while (index->entries[i].uid != 0 && index->entries[i].uid != type.uid)
+        {
+            i = (i + 1) & index->mask;
+        }
+        // a parent shared by several objects maps to the first one
+        if (index->entries[i].uid == 0)
+        {
+            index->entries[i] = type;
+        }
+    }
+    return index;
+}
+
+void
+Object::FreeAggregates(Aggregates* aggregates)
+{
+    NS_LOG_FUNCTION(aggregates);
+    delete aggregates->index;
+    std::free(aggregates);
 }
 
 void
@@ -308,6 +345,7 @@ Object::AggregateObject(Ptr<Object> o)
     uint32_t total = m_aggregates->n + other->m_aggregates->n;
     auto aggregates = (Aggregates*)std::malloc(sizeof(Aggregates) + (total - 1) * sizeof(Object*));
     aggregates->n = total;
+    aggregates->index = nullptr;
 
     // copy our buffer to the new buffer
     std::memcpy(&aggregates->buffer[0],
@@ -327,7 +365,6 @@ Object::AggregateObject(Ptr<Object> o)
                            << other->GetInstanceTypeId() << " on objects of type "
                            << GetInstanceTypeId());
         }
-        UpdateSortedArray(aggregates, m_aggregates->n + i);
     }
 
     // keep track of the old aggregate buffers for the iteration
@@ -360,8 +397,8 @@ Object::AggregateObject(Ptr<Object> o)
     }
 
     // Now that we are done with them, we can free our old aggregate buffers
-    std::free(a);
-    std::free(b);
+    FreeAggregates(a);
+    FreeAggregates(b);
 }
 
 void
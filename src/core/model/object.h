@@ -360,6 +360,27 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
 
     /**@}*/
 
+    /**
+     * Hash table from the TypeId of each aggregated Object, and of each
+     * of its parents, to the first Object in \c buffer having it.
+     *
+     * The TypeId uids are small consecutive integers, so the table uses
+     * the low bits of the uid as the index, with linear probing, and is
+     * kept at most half full: a lookup is usually a single load.
+     */
+    struct Index
+    {
+        /** An entry of the table. */
+        struct Entry
+        {
+            uint16_t uid;   //!< The TypeId uid, or 0 if the entry is free.
+            Object* object; //!< The Object.
+        };
+
+        uint32_t mask;              //!< Size of the table - 1.
+        std::vector<Entry> entries; //!< The table.
+    };
+
     /**
      * The list of Objects aggregated to this one.
      *
@@ -376,10 +397,29 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
     {
         /** The number of entries in \c buffer. */
         uint32_t n;
-        /** The array of Objects. */
+        /**
+         * The lookup table of the Objects by TypeId, or \c nullptr until
+         * the first lookup.
+         */
+        Index* index;
+        /** The array of Objects, in aggregation order. */
         Object* buffer[1];
     };
 
+    /**
+     * Build the lookup table of a list of aggregates.
+     *
+     * \param [in] aggregates The list of aggregated Objects.
+     * \returns The lookup table.
+     */
+    static Index* BuildIndex(const Aggregates* aggregates);
+    /**
+     * Free a list of aggregates, and its lookup table.
+     *
+     * \param [in] aggregates The list of aggregated Objects.
+     */
+    static void FreeAggregates(Aggregates* aggregates);
+
     /**
      * Find an Object of TypeId tid in the aggregates of this Object.
      *
@@ -427,13 +467,6 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      */
     void Construct(const AttributeConstructionList& attributes);
 
-    /**
-     * Keep the list of aggregates in most-recently-used order
-     *
-     * \param [in,out] aggregates The list of aggregated Objects.
-     * \param [in] i The most recently used entry in the list.
-     */
-    void UpdateSortedArray(Aggregates* aggregates, uint32_t i) const;
     /**
      * Attempt to delete this Object.
      *
@@ -463,6 +496,8 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      * A pointer to each Object aggregated to this Object is stored in this
      * array.  The array is shared by all aggregated Objects
      * so the size of the array is indirectly a reference count.
+     * The array and its lookup table are replaced whenever an Object
+     * is aggregated.
      */
     Aggregates* m_aggregates;
 
@@ -475,15 +510,6 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      * Aggregation would create an issue.
      */
     std::vector<Ptr<Object>> m_unidirectionalAggregates;
-
-    /**
-     * The number of times the Object was accessed with a
-     * call to GetObject().
-     *
-     * This integer is used to implement a heuristic to sort
-     * the array of aggregates in most-frequently accessed order.
-     */
-    uint32_t m_getObjectCount;
 };
 
 template <typename T>
@@ -510,19 +536,23 @@ template <typename T>
 Ptr<T>
 Object::GetObject() const
 {
-    // This is an optimization: if the cast works (which is likely),
-    // things will be pretty fast.
-    T* result = dynamic_cast<T*>(m_aggregates->buffer[0]);
-    if (result != nullptr)
+    if (m_aggregates->n == 1 && m_unidirectionalAggregates.empty())
     {
-        return Ptr<T>(result);
+        // a lone object: the cast is cheaper than the lookup
+        return Ptr<T>(dynamic_cast<T*>(const_cast<Object*>(this)));
     }
-    // if the cast does not work, we try to do a full type check.
     Ptr<Object> found = DoGetObject(T::GetTypeId());
     if (found)
     {
         return Ptr<T>(static_cast<T*>(PeekPointer(found)));
     }
+    // The TypeId of objects which were not created by CreateObject()
+    // may not be the one of their class.
+    T* result = dynamic_cast<T*>(m_aggregates->buffer[0]);
+    if (result != nullptr)
+    {
+        return Ptr<T>(result);
+    }
     return nullptr;
 }
 
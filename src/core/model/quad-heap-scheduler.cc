@@ -0,0 +1,201 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "quad-heap-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::QuadHeapScheduler class.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("QuadHeapScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(QuadHeapScheduler);
+
+TypeId
+QuadHeapScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::QuadHeapScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<QuadHeapScheduler>();
+    return tid;
+}
+
+QuadHeapScheduler::QuadHeapScheduler()
+    : m_removed(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+QuadHeapScheduler::~QuadHeapScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+QuadHeapScheduler::Place(std::size_t index, const Scheduler::Event& ev)
+{
+    m_heap[index] = ev;
+    // removed events have no implementation left to update
+    if (ev.impl != nullptr)
+    {
+        ev.impl->m_schedulerIndex = index;
+    }
+}
+
+void
+QuadHeapScheduler::SiftUp(std::size_t index)
+{
+    Scheduler::Event ev = m_heap[index];
+    while (index > 0)
+    {
+        std::size_t parent = (index - 1) / 4;
+        if (!(ev.key < m_heap[parent].key))
+        {
+            break;
+        }
+        Place(index, m_heap[parent]);
+        index = parent;
+    }
+    Place(index, ev);
+}
+
+void
+QuadHeapScheduler::SiftDown(std::size_t index)
+{
+    Scheduler::Event ev = m_heap[index];
+    std::size_t size = m_heap.size();
+    while (true)
+    {
+        std::size_t first = 4 * index + 1;
+        if (first >= size)
+        {
+            break;
+        }
+        std::size_t last = std::min(first + 4, size);
+        std::size_t smallest = first;
+        for (std::size_t child = first + 1; child < last; ++child)
+        {
+            if (m_heap[child].key < m_heap[smallest].key)
+            {
+                smallest = child;
+            }
+        }
+        if (!(m_heap[smallest].key < ev.key))
+        {
+            break;
+        }
+        Place(index, m_heap[smallest]);
+        index = smallest;
+    }
+    Place(index, ev);
+}
+
+void
+QuadHeapScheduler::PopRoot()
+{
+    while (true)
+    {
+        Scheduler::Event last = m_heap.back();
+        m_heap.pop_back();
+        if (m_heap.empty())
+        {
+            return;
+        }
+        m_heap[0] = last;
+        SiftDown(0);
+        if (m_heap[0].impl != nullptr)
+        {
+            return;
+        }
+        // the entry of a removed event reached the root: discard it
+        m_removed--;
+    }
+}
+
+void
+QuadHeapScheduler::Compact()
+{
+    NS_LOG_FUNCTION(this << m_heap.size() << m_removed);
+    m_heap.erase(std::remove_if(m_heap.begin(),
+                                m_heap.end(),
+                                [](const Scheduler::Event& ev) { return ev.impl == nullptr; }),
+                 m_heap.end());
+    m_removed = 0;
+    for (std::size_t i = 0; i < m_heap.size(); ++i)
+    {
+        m_heap[i].impl->m_schedulerIndex = i;
+    }
+    // heapify, starting from the parent of the last entry
+    for (std::size_t i = m_heap.size() / 4 + 1; i-- > 0;)
+    {
+        SiftDown(i);
+    }
+}
+
+void
+QuadHeapScheduler::Insert(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << &ev);
+    m_heap.push_back(ev);
+    SiftUp(m_heap.size() - 1);
+}
+
+bool
+QuadHeapScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_heap.empty();
+}
+
+Scheduler::Event
+QuadHeapScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return m_heap.front();
+}
+
+Scheduler::Event
+QuadHeapScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    Scheduler::Event next = m_heap.front();
+    PopRoot();
+    return next;
+}
+
+void
+QuadHeapScheduler::Remove(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << &ev);
+    std::size_t index = ev.impl->m_schedulerIndex;
+    NS_ASSERT_MSG(index < m_heap.size() && m_heap[index].impl == ev.impl,
+                  "Event not found in the scheduler");
+    if (index == 0)
+    {
+        PopRoot();
+        return;
+    }
+    m_heap[index].impl = nullptr;
+    m_removed++;
+    if (m_removed > m_heap.size() / 2)
+    {
+        Compact();
+    }
+}
+
+} // namespace ns3
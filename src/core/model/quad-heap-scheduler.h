@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef QUAD_HEAP_SCHEDULER_H
+#define QUAD_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::QuadHeapScheduler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ * \brief a 4-ary heap event scheduler with constant time removal
+ *
+ * The events are stored by value in a 4-ary heap laid out in a
+ * contiguous `std::vector`.  Compared with a binary heap, a 4-ary heap
+ * is half as deep and the four children of a node are adjacent in
+ * memory, which reduces the number of cache misses of each operation.
+ *
+ * Each event keeps its position in the array (see
+ * EventImpl::m_schedulerIndex), so that Remove() does not need to
+ * search the heap.  Removal is lazy: the entry of a removed event is
+ * only marked as empty, and is discarded when it reaches the root of
+ * the heap.  When empty entries make up more than half of the array,
+ * the heap is rebuilt without them.  The root of the heap is never
+ * an empty entry.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | Logarithmic     | Heapify
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Heap kept sorted
+ * Remove()     | Constant        | Index stored in the event, lazy removal
+ * RemoveNext() | Logarithmic     | Heapify
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 4 x `sizeof (*)`<br/>(32 bytes)  | `std::vector` and empty entry count
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class QuadHeapScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    QuadHeapScheduler();
+    /** Destructor. */
+    ~QuadHeapScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /**
+     * Store an event at a given position, updating its index.
+     *
+     * \param [in] index The position in the array.
+     * \param [in] ev The event.
+     */
+    inline void Place(std::size_t index, const Scheduler::Event& ev);
+    /**
+     * Move an event towards the root until the heap order is restored.
+     *
+     * \param [in] index The position of the event.
+     */
+    void SiftUp(std::size_t index);
+    /**
+     * Move an event towards the leaves until the heap order is restored.
+     *
+     * \param [in] index The position of the event.
+     */
+    void SiftDown(std::size_t index);
+    /** Remove the root of the heap, then the empty entries reaching the root. */
+    void PopRoot();
+    /** Rebuild the heap without the empty entries. */
+    void Compact();
+
+    /** Event list type:  vector of Events, managed as a 4-ary heap. */
+    typedef std::vector<Scheduler::Event> QuadHeap;
+    /** The event array. */
+    QuadHeap m_heap;
+    /** Number of entries of removed events still in the array. */
+    std::size_t m_removed;
+};
+
+} // namespace ns3
+
+#endif /* QUAD_HEAP_SCHEDULER_H */
@@ -25,6 +25,7 @@
 #include "uinteger.h"
 
 #include <algorithm> // upper_bound
+#include <array>
 #include <cmath>
 #include <iostream>
 #include <numbers>
@@ -134,6 +135,16 @@ RandomVariableStream::GetStream() const
     return m_stream;
 }
 
+void
+RandomVariableStream::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    for (auto& value : values)
+    {
+        value = GetValue();
+    }
+}
+
 RngStream*
 RandomVariableStream::Peek() const
 {
@@ -210,6 +221,21 @@ UniformRandomVariable::GetValue()
     return GetValue(m_min, m_max);
 }
 
+void
+UniformRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    Peek()->RandU01(values);
+    for (auto& v : values)
+    {
+        v = m_min + v * (m_max - m_min);
+        if (IsAntithetic())
+        {
+            v = m_min + (m_max - v);
+        }
+    }
+}
+
 uint32_t
 UniformRandomVariable::GetInteger()
 {
@@ -443,6 +469,33 @@ ExponentialRandomVariable::GetValue()
     return GetValue(m_mean, m_bound);
 }
 
+void
+ExponentialRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    std::size_t done = 0;
+    while (done < values.size())
+    {
+        // Each value takes at least one uniform: draw one per missing
+        // value, in place, and keep the accepted ones.  The stream is
+        // thus never advanced past the last value.
+        auto uniforms = values.subspan(done);
+        Peek()->RandU01(uniforms);
+        for (double v : uniforms)
+        {
+            if (IsAntithetic())
+            {
+                v = (1 - v);
+            }
+            double r = -m_mean * std::log(v);
+            if (m_bound == 0 || r <= m_bound)
+            {
+                values[done++] = r;
+            }
+        }
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ParetoRandomVariable);
 
 TypeId
@@ -778,6 +831,76 @@ NormalRandomVariable::GetValue()
     return GetValue(m_mean, m_variance, m_bound);
 }
 
+void
+NormalRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    std::size_t done = 0;
+    if (m_nextValid && !values.empty())
+    { // use previously generated
+        m_nextValid = false;
+        double x2 = m_mean + m_v2 * m_y * std::sqrt(m_variance);
+        if (std::fabs(x2 - m_mean) <= m_bound)
+        {
+            values[done++] = x2;
+        }
+    }
+
+    // The same steps as GetValue(mean, variance, bound), on pairs of
+    // uniforms drawn in a batch.  A pair gives at most two values, so
+    // drawing one pair per two missing values never advances the stream
+    // past the last value.
+    std::array<double, 64> uniforms;
+    while (done < values.size())
+    {
+        std::size_t pairs = std::min(uniforms.size() / 2, (values.size() - done + 1) / 2);
+        Peek()->RandU01(std::span(uniforms.data(), 2 * pairs));
+        for (std::size_t i = 0; i < 2 * pairs; i += 2)
+        {
+            double u1 = uniforms[i];
+            double u2 = uniforms[i + 1];
+            if (IsAntithetic())
+            {
+                u1 = (1 - u1);
+                u2 = (1 - u2);
+            }
+            double v1 = 2 * u1 - 1;
+            double v2 = 2 * u2 - 1;
+            double w = v1 * v1 + v2 * v2;
+            if (w > 1.0)
+            {
+                continue;
+            }
+            double y = std::sqrt((-2 * std::log(w)) / w);
+            double x1 = m_mean + v1 * y * std::sqrt(m_variance);
+            if (std::fabs(x1 - m_mean) <= m_bound)
+            {
+                values[done++] = x1;
+                if (done == values.size())
+                {
+                    // cache v2 and y for the next call
+                    m_nextValid = true;
+                    m_y = y;
+                    m_v2 = v2;
+                    break;
+                }
+                // the next value is the one GetValue() would have cached
+                x1 = m_mean + v2 * y * std::sqrt(m_variance);
+                if (std::fabs(x1 - m_mean) <= m_bound)
+                {
+                    values[done++] = x1;
+                }
+                continue;
+            }
+            double x2 = m_mean + v2 * y * std::sqrt(m_variance);
+            if (std::fabs(x2 - m_mean) <= m_bound)
+            {
+                values[done++] = x2;
+            }
+        }
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(LogNormalRandomVariable);
 
 TypeId
@@ -1620,6 +1743,45 @@ EmpiricalRandomVariable::GetValue()
     return value;
 }
 
+void
+EmpiricalRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    if (!m_validated)
+    {
+        Validate();
+    }
+
+    // The same steps as PreSample() and GetValue(), on uniforms drawn in
+    // a batch.
+    Peek()->RandU01(values);
+    for (auto& value : values)
+    {
+        double r = value;
+        if (IsAntithetic())
+        {
+            r = (1 - r);
+        }
+
+        if (r <= m_empCdf.begin()->first)
+        {
+            value = m_empCdf.begin()->second;
+        }
+        else if (r >= m_empCdf.rbegin()->first)
+        {
+            value = m_empCdf.rbegin()->second;
+        }
+        else if (m_interpolate)
+        {
+            value = DoInterpolate(r);
+        }
+        else
+        {
+            value = DoSampleCDF(r);
+        }
+    }
+}
+
 double
 EmpiricalRandomVariable::DoSampleCDF(double r)
 {
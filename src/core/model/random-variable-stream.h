@@ -20,6 +20,7 @@
 #include "type-id.h"
 
 #include <map>
+#include <span>
 #include <stdint.h>
 
 /**
@@ -143,6 +144,18 @@ class RandomVariableStream : public Object
     // The base implementation returns `(uint32_t)GetValue()`
     virtual uint32_t GetInteger();
 
+    /**
+     * \brief Get the next random values drawn from the distribution.
+     *
+     * The values are the ones successive calls to GetValue() would
+     * return.  The base implementation calls GetValue() for each value.
+     * The distributions drawing their uniform randoms one by one
+     * override it to draw them in a batch from the RngStream.
+     *
+     * \param [out] values The random values.
+     */
+    virtual void GetValues(std::span<double> values);
+
   protected:
     /**
      * \brief Get the pointer to the underlying RngStream.
@@ -273,6 +286,8 @@ class UniformRandomVariable : public RandomVariableStream
      */
     uint32_t GetInteger() override;
 
+    void GetValues(std::span<double> values) override;
+
   private:
     /** The lower bound on values that can be returned by this RNG stream. */
     double m_min;
@@ -582,6 +597,7 @@ class ExponentialRandomVariable : public RandomVariableStream
     // Inherited
     double GetValue() override;
     using RandomVariableStream::GetInteger;
+    void GetValues(std::span<double> values) override;
 
   private:
     /** The mean value of the unbounded exponential distribution. */
@@ -1020,6 +1036,7 @@ class NormalRandomVariable : public RandomVariableStream
     // Inherited
     double GetValue() override;
     using RandomVariableStream::GetInteger;
+    void GetValues(std::span<double> values) override;
 
   private:
     /** The mean value for the normal distribution returned by this RNG stream. */
@@ -2003,6 +2020,7 @@ class EmpiricalRandomVariable : public RandomVariableStream
      */
     double GetValue() override;
     using RandomVariableStream::GetInteger;
+    void GetValues(std::span<double> values) override;
 
     /**
      * \brief Returns the next value in the empirical distribution using
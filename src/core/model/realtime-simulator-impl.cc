@@ -16,6 +16,7 @@
 #include "ptr.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
 #include "synchronizer.h"
 #include "wall-clock-synchronizer.h"
 
@@ -59,7 +60,24 @@ RealtimeSimulatorImpl::GetTypeId()
                           "SynchronizationMode=HardLimit)",
                           TimeValue(Seconds(0.1)),
                           MakeTimeAccessor(&RealtimeSimulatorImpl::m_hardLimit),
-                          MakeTimeChecker());
+                          MakeTimeChecker())
+            .AddAttribute("EventProfile",
+                          "Format of the wall clock profile of the events, "
+                          "written at Simulator::Destroy().",
+                          EnumValue(EventProfiler::NONE),
+                          MakeEnumAccessor<EventProfiler::Format>(
+                              &RealtimeSimulatorImpl::m_profileFormat),
+                          MakeEnumChecker(EventProfiler::NONE,
+                                          "None",
+                                          EventProfiler::REPORT,
+                                          "Report",
+                                          EventProfiler::FOLDED,
+                                          "Folded"))
+            .AddAttribute("EventProfileFile",
+                          "Event profile file name, or empty for the standard output.",
+                          StringValue(""),
+                          MakeStringAccessor(&RealtimeSimulatorImpl::m_profileFile),
+                          MakeStringChecker());
     return tid;
 }
 
@@ -75,6 +93,7 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
+    m_profileFormat = EventProfiler::NONE;
 
     m_main = std::this_thread::get_id();
 
@@ -125,6 +144,11 @@ RealtimeSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+    if (m_profileFormat != EventProfiler::NONE)
+    {
+        m_profiler.Write(m_profileFile, m_profileFormat);
+        m_profiler.Clear();
+    }
 }
 
 void
@@ -379,7 +403,14 @@ RealtimeSimulatorImpl::ProcessOneEvent()
 
     EventImpl* event = next.impl;
     m_synchronizer->EventStart();
-    event->Invoke();
+    if (m_profileFormat == EventProfiler::NONE)
+    {
+        event->Invoke();
+    }
+    else
+    {
+        m_profiler.Invoke(event, next.key.m_context);
+    }
     m_synchronizer->EventEnd();
     event->Unref();
 }
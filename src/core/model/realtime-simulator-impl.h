@@ -9,6 +9,7 @@
 
 #include "assert.h"
 #include "event-impl.h"
+#include "event-profiler.h"
 #include "log.h"
 #include "ptr.h"
 #include "scheduler.h"
@@ -218,6 +219,13 @@ class RealtimeSimulatorImpl : public SimulatorImpl
 
     /** Main thread. */
     std::thread::id m_main;
+
+    /** Event profile output format, or EventProfiler::NONE if disabled. */
+    EventProfiler::Format m_profileFormat;
+    /** Event profile output file name, or empty for the standard output. */
+    std::string m_profileFile;
+    /** The event profile. */
+    EventProfiler m_profiler;
 };
 
 } // namespace ns3
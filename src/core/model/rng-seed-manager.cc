@@ -11,6 +11,7 @@
 #include "config.h"
 #include "global-value.h"
 #include "log.h"
+#include "simulation-context.h"
 #include "uinteger.h"
 
 /**
@@ -30,6 +31,12 @@ NS_LOG_COMPONENT_DEFINE("RngSeedManager");
  * for automatic assignment.
  */
 static uint64_t g_nextStreamIndex = 0;
+/**
+ * \relates RngSeedManager
+ * The stream index counter set by SetStreamIndexCounter() for the
+ * calling thread, if any.
+ */
+static thread_local uint64_t* g_streamIndexCounter = nullptr;
 /**
  * \relates RngSeedManager
  * \anchor GlobalValueRngSeed
@@ -59,10 +66,50 @@ static ns3::GlobalValue g_rngRun("RngRun",
                                  ns3::UintegerValue(1),
                                  ns3::MakeUintegerChecker<uint64_t>());
 
+namespace
+{
+/**
+ * \ingroup randomvariable
+ * The random number generator state owned by a SimulationContext,
+ * initialized from the global values.
+ */
+struct ContextRng
+{
+    /** Constructor: copy the global seed and run number. */
+    ContextRng()
+    {
+        UintegerValue value;
+        g_rngSeed.GetValue(value);
+        seed = static_cast<uint32_t>(value.Get());
+        g_rngRun.GetValue(value);
+        run = value.Get();
+    }
+
+    uint32_t seed;               //!< The seed.
+    uint64_t run;                //!< The run number.
+    uint64_t nextStreamIndex{0}; //!< The next stream number.
+};
+
+/**
+ * \ingroup randomvariable
+ * \returns The state of the current SimulationContext, or \c nullptr.
+ */
+ContextRng*
+GetContextRng()
+{
+    SimulationContext* context = SimulationContext::GetCurrent();
+    return context != nullptr ? context->GetSingleton<ContextRng>() : nullptr;
+}
+} // namespace
+
 uint32_t
 RngSeedManager::GetSeed()
 {
     NS_LOG_FUNCTION_NOARGS();
+    if (ContextRng* rng = GetContextRng())
+    {
+        return rng->seed;
+    }
     UintegerValue seedValue;
     g_rngSeed.GetValue(seedValue);
     return static_cast<uint32_t>(seedValue.Get());
@@ -72,6 +119,11 @@ void
 RngSeedManager::SetSeed(uint32_t seed)
 {
     NS_LOG_FUNCTION(seed);
+    if (ContextRng* rng = GetContextRng())
+    {
+        rng->seed = seed;
+        return;
+    }
     Config::SetGlobal("RngSeed", UintegerValue(seed));
 }
 
@@ -79,6 +131,11 @@ void
 RngSeedManager::SetRun(uint64_t run)
 {
     NS_LOG_FUNCTION(run);
+    if (ContextRng* rng = GetContextRng())
+    {
+        rng->run = run;
+        return;
+    }
     Config::SetGlobal("RngRun", UintegerValue(run));
 }
 
@@ -86,6 +143,10 @@ uint64_t
 RngSeedManager::GetRun()
 {
     NS_LOG_FUNCTION_NOARGS();
+    if (ContextRng* rng = GetContextRng())
+    {
+        return rng->run;
+    }
     UintegerValue value;
     g_rngRun.GetValue(value);
     uint64_t run = value.Get();
@@ -96,15 +157,32 @@ uint64_t
 RngSeedManager::GetNextStreamIndex()
 {
     NS_LOG_FUNCTION_NOARGS();
-    uint64_t next = g_nextStreamIndex;
-    g_nextStreamIndex++;
+    if (g_streamIndexCounter != nullptr)
+    {
+        return (*g_streamIndexCounter)++;
+    }
+    ContextRng* rng = GetContextRng();
+    uint64_t& index = rng != nullptr ? rng->nextStreamIndex : g_nextStreamIndex;
+    uint64_t next = index;
+    index++;
     return next;
 }
 
 void
 RngSeedManager::ResetNextStreamIndex()
 {
+    if (ContextRng* rng = GetContextRng())
+    {
+        rng->nextStreamIndex = 0;
+        return;
+    }
     g_nextStreamIndex = 0;
 }
 
+void
+RngSeedManager::SetStreamIndexCounter(uint64_t* counter)
+{
+    g_streamIndexCounter = counter;
+}
+
 } // namespace ns3
@@ -98,6 +98,16 @@ class RngSeedManager
      * Resets the global stream index counter.
      */
     static void ResetNextStreamIndex();
+
+    /**
+     * Set the counter of the automatically assigned stream indices of
+     * the calling thread, e.g., to give each partition of a parallel
+     * simulation its own range of indices.
+     *
+     * \param [in] counter The counter, or \c nullptr to use the counter
+     *             of the simulation.
+     */
+    static void SetStreamIndexCounter(uint64_t* counter);
 };
 
 /** Alias for compatibility. */
@@ -51,6 +51,12 @@ const double m1   =       4294967087.0;
 /** Second component modulus, 2<sup>32</sup> - 22853. */
 const double m2   =       4294944443.0;
 
+/** Inverse of the first component modulus. */
+const double invm1 =      1.0 / m1;
+
+/** Inverse of the second component modulus. */
+const double invm2 =      1.0 / m2;
+
 /** Normalization to obtain randoms on [0,1). */
 const double norm =       1.0 / (m1 + 1.0);
 
@@ -364,6 +370,52 @@ RngStream::RandU01()
     return u;
 }
 
+void
+RngStream::RandU01(std::span<double> values)
+{
+    // The same recurrences as RandU01(), with the two components
+    // interleaved.  The divisions by the moduli, which bound the time
+    // per random, are replaced by multiplications by their inverses.
+    // The quotient may then be off by one, but the reduced p1 and p2
+    // are the same exact integers as in RandU01() once brought back
+    // into [0, m1) and [0, m2).
+    double s0 = m_currentState[0];
+    double s1 = m_currentState[1];
+    double s2 = m_currentState[2];
+    double s3 = m_currentState[3];
+    double s4 = m_currentState[4];
+    double s5 = m_currentState[5];
+
+    for (auto& u : values)
+    {
+        double p1 = a12 * s1 - a13n * s0;
+        double p2 = a21 * s5 - a23n * s3;
+        int32_t k1 = static_cast<int32_t>(p1 * invm1);
+        int32_t k2 = static_cast<int32_t>(p2 * invm2);
+        p1 -= k1 * m1;
+        p2 -= k2 * m2;
+        p1 += (p1 < 0.0) ? m1 : ((p1 >= m1) ? -m1 : 0.0);
+        p2 += (p2 < 0.0) ? m2 : ((p2 >= m2) ? -m2 : 0.0);
+        p1 += (p1 < 0.0) ? m1 : 0.0;
+        p2 += (p2 < 0.0) ? m2 : 0.0;
+        s0 = s1;
+        s1 = s2;
+        s2 = p1;
+        s3 = s4;
+        s4 = s5;
+        s5 = p2;
+
+        u = ((p1 > p2) ? (p1 - p2) * MRG32k3a::norm : (p1 - p2 + m1) * MRG32k3a::norm);
+    }
+
+    m_currentState[0] = s0;
+    m_currentState[1] = s1;
+    m_currentState[2] = s2;
+    m_currentState[3] = s3;
+    m_currentState[4] = s4;
+    m_currentState[5] = s5;
+}
+
 RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream)
 {
     if (seedNumber >= m1 || seedNumber >= m2 || seedNumber == 0)
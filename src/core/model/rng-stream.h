@@ -7,6 +7,7 @@
 
 #ifndef RNGSTREAM_H
 #define RNGSTREAM_H
+#include <span>
 #include <stdint.h>
 #include <string>
 
@@ -59,6 +60,15 @@ class RngStream
      * \returns The next random.
      */
     double RandU01();
+    /**
+     * Generate the next random numbers for this stream.
+     *
+     * The numbers are the ones successive calls to RandU01() would
+     * return, but the state is kept in registers across the batch.
+     *
+     * \param [out] values The next randoms.
+     */
+    void RandU01(std::span<double> values);
 
   private:
     /**
@@ -0,0 +1,142 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "simulation-checkpoint.h"
+
+#include "abort.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SimulationCheckpoint implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SimulationCheckpoint");
+
+namespace
+{
+
+/**
+ * \ingroup simulator
+ * Get the process ids of the branches not waited for yet.
+ * \returns The process ids.
+ */
+std::set<pid_t>&
+Branches()
+{
+    static std::set<pid_t> branches;
+    return branches;
+}
+
+/**
+ * \ingroup simulator
+ * Flush the standard streams, so that their buffered output is neither
+ * written twice by the branches nor lost at their exit.
+ */
+void
+FlushStandardStreams()
+{
+    std::cout.flush();
+    std::cerr.flush();
+    std::clog.flush();
+    std::fflush(nullptr);
+}
+
+} // unnamed namespace
+
+SimulationCheckpoint::SimulationCheckpoint()
+    : m_time(Simulator::Now())
+{
+    NS_LOG_FUNCTION(this << m_time);
+}
+
+Time
+SimulationCheckpoint::GetTime() const
+{
+    return m_time;
+}
+
+pid_t
+SimulationCheckpoint::Resume(std::function<int()> branch) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(Simulator::Now() != m_time,
+                    "The simulation ran past the checkpoint at " << m_time.As(Time::S));
+
+    FlushStandardStreams();
+    pid_t pid = fork();
+    NS_ABORT_MSG_IF(pid < 0, "Cannot resume the checkpoint: " << std::strerror(errno));
+    if (pid > 0)
+    {
+        NS_LOG_LOGIC("resumed the checkpoint in process " << pid);
+        Branches().insert(pid);
+        return pid;
+    }
+
+    // Branch process: never return into the caller, which would run the
+    // rest of the parent program.
+    Branches().clear();
+    int status = EXIT_FAILURE;
+    try
+    {
+        status = branch();
+        Simulator::Destroy();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Checkpoint branch failed: " << e.what() << std::endl;
+    }
+    FlushStandardStreams();
+    _exit(status);
+}
+
+int
+SimulationCheckpoint::Wait(pid_t branch)
+{
+    NS_LOG_FUNCTION(branch);
+    NS_ABORT_MSG_IF(Branches().erase(branch) == 0, "No branch in process " << branch);
+
+    int status;
+    while (waitpid(branch, &status, 0) < 0)
+    {
+        NS_ABORT_MSG_IF(errno != EINTR,
+                        "Cannot wait for process " << branch << ": " << std::strerror(errno));
+    }
+    if (WIFEXITED(status))
+    {
+        return WEXITSTATUS(status);
+    }
+    return -1;
+}
+
+uint32_t
+SimulationCheckpoint::WaitAll()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    uint32_t failures = 0;
+    while (!Branches().empty())
+    {
+        if (Wait(*Branches().begin()) != 0)
+        {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+} // namespace ns3
@@ -0,0 +1,118 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SIMULATION_CHECKPOINT_H
+#define SIMULATION_CHECKPOINT_H
+
+#include "nstime.h"
+
+#include <functional>
+#include <sys/types.h>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SimulationCheckpoint declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ *
+ * \brief A checkpoint of a running simulation, from which several
+ * branches of the simulation can be resumed.
+ *
+ * A checkpoint is taken between two calls to Simulator::Run(), typically
+ * at the end of a warm-up phase.  Each call to Resume() then continues
+ * the simulation in a copy of the process, which starts with the exact
+ * state of the simulation at the checkpoint: the simulation time, the
+ * pending events, the state of the RngStream of each random variable,
+ * the attributes and the internal state of all the objects, packets in
+ * flight included.  A parameter sweep thus runs its warm-up only once:
+ * \code
+   // create the nodes, install the applications...
+   Simulator::Stop(Seconds(60));
+   Simulator::Run();
+
+   SimulationCheckpoint checkpoint;
+   for (auto rate : rates)
+   {
+       checkpoint.Resume([rate]() {
+           Config::Set("/NodeList/0/ApplicationList/0/$ns3::OnOffApplication/DataRate",
+                       DataRateValue(rate));
+           Simulator::Stop(Seconds(100));
+           Simulator::Run();
+           // write the results for this rate...
+           return 0;
+       });
+   }
+   SimulationCheckpoint::WaitAll();
+   Simulator::Destroy();
+   \endcode
+ *
+ * The branches run concurrently with the process which took the
+ * checkpoint, and which must not run the simulation further while
+ * branches are resumed from it.  A branch only sees its own changes.
+ * The random variables continue their streams from the checkpoint, so
+ * all the branches use common random numbers; the random variables
+ * created by a branch use the run number set by the branch.
+ *
+ * The copies of the process are created with fork(), so that the
+ * checkpoint is only available on POSIX systems, with a simulator
+ * implementation which runs in the calling thread, i.e., not with
+ * MultithreadedSimulatorImpl.  The files opened before the checkpoint,
+ * such as the trace files, are shared by the branches: open the files
+ * of each branch in the branch.
+ */
+class SimulationCheckpoint
+{
+  public:
+    /** Constructor: take the checkpoint at the current simulation time. */
+    SimulationCheckpoint();
+
+    /**
+     * Resume the simulation from the checkpoint in a new process.
+     *
+     * The new process calls \p branch, destroys the simulation, and
+     * exits with the value returned by \p branch, which is thus an exit
+     * status between 0 and 255.  The calling process returns immediately.
+     *
+     * \param [in] branch The rest of the simulation.
+     * \returns The process id of the branch, for Wait().
+     */
+    pid_t Resume(std::function<int()> branch) const;
+
+    /**
+     * Get the simulation time of the checkpoint.
+     *
+     * \returns The simulation time when the checkpoint was taken.
+     */
+    Time GetTime() const;
+
+    /**
+     * Wait for the end of a branch.
+     *
+     * \param [in] branch The process id of the branch.
+     * \returns The value returned by the branch function, or -1 if the
+     *          branch was terminated by a signal, e.g., after NS_FATAL_ERROR.
+     */
+    static int Wait(pid_t branch);
+
+    /**
+     * Wait for the end of all the branches.
+     *
+     * \returns The number of branches which did not return 0.
+     */
+    static uint32_t WaitAll();
+
+  private:
+    /** The simulation time of the checkpoint. */
+    Time m_time;
+};
+
+} // namespace ns3
+
+#endif /* SIMULATION_CHECKPOINT_H */
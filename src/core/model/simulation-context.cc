@@ -0,0 +1,76 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "simulation-context.h"
+
+#include "abort.h"
+#include "assert.h"
+#include "log.h"
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SimulationContext implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SimulationContext");
+
+std::atomic<bool> SimulationContext::m_used = false;
+thread_local SimulationContext* SimulationContext::m_current = nullptr;
+
+SimulationContext::SimulationContext()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SimulationContext::~SimulationContext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_current != this, "Destroying the current simulation context");
+    for (auto it = m_created.rbegin(); it != m_created.rend(); ++it)
+    {
+        Slot& slot = m_slots[*it];
+        slot.deleter(slot.object.load(std::memory_order_relaxed));
+    }
+}
+
+void
+SimulationContext::SetCurrent(SimulationContext* context)
+{
+    NS_LOG_FUNCTION(context);
+    if (context != nullptr)
+    {
+        m_used.store(true, std::memory_order_relaxed);
+    }
+    m_current = context;
+}
+
+std::size_t
+SimulationContext::AllocateSlot()
+{
+    static std::atomic<std::size_t> next = 0;
+    std::size_t slot = next++;
+    NS_ABORT_MSG_IF(slot >= MAX_SLOTS, "Too many simulation context singletons");
+    return slot;
+}
+
+void*
+SimulationContext::Create(std::size_t slot, void* (*create)(), void (*deleter)(void*))
+{
+    std::unique_lock lock{m_mutex};
+    void* object = m_slots[slot].object.load(std::memory_order_relaxed);
+    if (object == nullptr)
+    {
+        object = create();
+        m_slots[slot].deleter = deleter;
+        m_slots[slot].object.store(object, std::memory_order_release);
+        m_created.push_back(slot);
+    }
+    return object;
+}
+
+} // namespace ns3
@@ -0,0 +1,167 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SIMULATION_CONTEXT_H
+#define SIMULATION_CONTEXT_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SimulationContext declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ *
+ * \brief The state of one simulation, to run several independent
+ * simulations concurrently in one process.
+ *
+ * By default, the Simulator, the NodeList, the ChannelList, the Names,
+ * the Config namespace, the run number of the RngSeedManager and the
+ * SimulationSingleton instances are process-wide.  When a thread makes
+ * a SimulationContext current, all these instead belong to the context,
+ * so that each thread can build, run and destroy its own simulation, for
+ * example one replica of a parameter sweep:
+ * \code
+   std::thread replica([run] {
+       SimulationContext context;
+       SimulationContext::SetCurrent(&context);
+       RngSeedManager::SetRun(run);
+       // create the nodes, install the applications...
+       Simulator::Run();
+       Simulator::Destroy();
+       SimulationContext::SetCurrent(nullptr);
+   });
+   \endcode
+ *
+ * The attribute default values, the global values, the TypeId registry
+ * and the logging configuration remain process-wide: set them before
+ * starting the threads.  The seed and the run number of a context are
+ * copied from the \c RngSeed and \c RngRun global values when the context
+ * first uses them, and are then only changed by RngSeedManager::SetSeed()
+ * and RngSeedManager::SetRun() called with the context current.
+ *
+ * A context is current in at most one thread at a time, apart from the
+ * worker threads of its own multithreaded simulator, which inherit it.
+ * Simulator::Destroy() must be called before the context is destroyed.
+ */
+class SimulationContext
+{
+  public:
+    /** Constructor. */
+    SimulationContext();
+    /** Destructor: destroys the per-context objects, newest first. */
+    ~SimulationContext();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    SimulationContext(const SimulationContext&) = delete;
+    SimulationContext& operator=(const SimulationContext&) = delete;
+
+    /**
+     * Set the context of the calling thread.
+     *
+     * \param [in] context The context, or \c nullptr to use the
+     *             process-wide simulation again.
+     */
+    static void SetCurrent(SimulationContext* context);
+
+    /**
+     * Get the context of the calling thread.
+     *
+     * \returns The context, or \c nullptr if the thread uses the
+     *          process-wide simulation.
+     */
+    static SimulationContext* GetCurrent();
+
+    /**
+     * Get the instance of a type owned by this context, creating it with
+     * its default constructor on first use.
+     *
+     * This is the per-context equivalent of a function-local static: the
+     * process-wide singletons use it when a context is current.
+     *
+     * \tparam T \explicit The type of the instance.
+     * \returns The instance.
+     */
+    template <typename T>
+    T* GetSingleton();
+
+  private:
+    /** A per-context instance. */
+    struct Slot
+    {
+        std::atomic<void*> object{nullptr}; //!< The instance, once created.
+        void (*deleter)(void*){nullptr};    //!< Deletes the instance.
+    };
+
+    /** Maximum number of singleton types. */
+    static constexpr std::size_t MAX_SLOTS = 64;
+
+    /** \returns A new slot index, unique in the process. */
+    static std::size_t AllocateSlot();
+
+    /**
+     * Create the instance of a slot, unless another thread just did.
+     *
+     * \param [in] slot The slot index.
+     * \param [in] create Creates the instance.
+     * \param [in] deleter Deletes the instance.
+     * \returns The instance.
+     */
+    void* Create(std::size_t slot, void* (*create)(), void (*deleter)(void*));
+
+    Slot m_slots[MAX_SLOTS];            //!< The instances, by slot index.
+    std::vector<std::size_t> m_created; //!< The slots, in creation order.
+    /** Serializes the creations, which may be nested. */
+    std::recursive_mutex m_mutex;
+
+    /** Whether any thread ever set a context. */
+    static std::atomic<bool> m_used;
+    /** The context of the calling thread. */
+    static thread_local SimulationContext* m_current;
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3
+{
+
+inline SimulationContext*
+SimulationContext::GetCurrent()
+{
+    // avoid the thread-local lookup in the usual single simulation case
+    return m_used.load(std::memory_order_relaxed) ? m_current : nullptr;
+}
+
+template <typename T>
+T*
+SimulationContext::GetSingleton()
+{
+    static const std::size_t slot = AllocateSlot();
+    void* object = m_slots[slot].object.load(std::memory_order_acquire);
+    if (object == nullptr)
+    {
+        object = Create(
+            slot,
+            []() -> void* { return new T(); },
+            [](void* p) { delete static_cast<T*>(p); });
+    }
+    return static_cast<T*>(object);
+}
+
+} // namespace ns3
+
+#endif /* SIMULATION_CONTEXT_H */
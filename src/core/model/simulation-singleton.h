@@ -25,6 +25,9 @@ namespace ns3
  * type will be automatically deleted upon a call
  * to Simulator::Destroy.
  *
+ * When a SimulationContext is current, each context has its own
+ * instance.
+ *
  * For a singleton with a lifetime bounded by the process,
  * not the simulation run, see Singleton.
  */
@@ -69,6 +72,7 @@ class SimulationSingleton
  *  Implementation of the templates declared above.
  ********************************************************************/
 
+#include "simulation-context.h"
 #include "simulator.h"
 
 namespace ns3
@@ -86,7 +90,9 @@ template <typename T>
 T**
 SimulationSingleton<T>::GetObject()
 {
-    static T* pobject = nullptr;
+    static T* global = nullptr;
+    SimulationContext* context = SimulationContext::GetCurrent();
+    T*& pobject = context != nullptr ? *context->GetSingleton<T*>() : global;
     if (pobject == nullptr)
     {
         pobject = new T();
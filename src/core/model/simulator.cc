@@ -16,6 +16,7 @@
 #include "object-factory.h"
 #include "ptr.h"
 #include "scheduler.h"
+#include "simulation-context.h"
 #include "simulator-impl.h"
 #include "string.h"
 
@@ -71,14 +72,33 @@ static GlobalValue g_schedTypeImpl =
                 TypeIdValue(MapScheduler::GetTypeId()),
                 MakeTypeIdChecker());
 
+namespace
+{
+/**
+ * \ingroup simulator
+ * The simulator state owned by a SimulationContext.
+ */
+struct ContextSimulator
+{
+    SimulatorImpl* impl{nullptr}; //!< The SimulatorImpl instance.
+    EventId stopEvent;            //!< The stop event.
+};
+} // namespace
+
 /**
  * \ingroup simulator
- * \brief Get the static SimulatorImpl instance.
+ * \brief Get the static SimulatorImpl instance, or the one of the
+ * current SimulationContext.
  * \return The SimulatorImpl instance pointer.
  */
 static SimulatorImpl**
 PeekImpl()
 {
+    SimulationContext* context = SimulationContext::GetCurrent();
+    if (context != nullptr)
+    {
+        return &context->GetSingleton<ContextSimulator>()->impl;
+    }
     static SimulatorImpl* impl = nullptr;
     return &impl;
 }
@@ -120,9 +140,14 @@ GetImpl()
         // framework which would call the TimePrinter function which would call
         // Simulator::Now which would call Simulator::GetImpl, and, thus, get us
         // in an infinite recursion until the stack explodes.
+        // The printers are process-wide, and left alone by the simulations
+        // running in a SimulationContext.
         //
-        LogSetTimePrinter(&DefaultTimePrinter);
-        LogSetNodePrinter(&DefaultNodePrinter);
+        if (SimulationContext::GetCurrent() == nullptr)
+        {
+            LogSetTimePrinter(&DefaultTimePrinter);
+            LogSetNodePrinter(&DefaultNodePrinter);
+        }
     }
     return *pimpl;
 }
@@ -142,8 +167,11 @@ Simulator::Destroy()
      * legal), Simulator::GetImpl will trigger again an infinite recursion until
      * the stack explodes.
      */
-    LogSetTimePrinter(nullptr);
-    LogSetNodePrinter(nullptr);
+    if (SimulationContext::GetCurrent() == nullptr)
+    {
+        LogSetTimePrinter(nullptr);
+        LogSetNodePrinter(nullptr);
+    }
     (*pimpl)->Destroy();
     (*pimpl)->Unref();
     *pimpl = nullptr;
@@ -183,13 +211,21 @@ EventId
 Simulator::Stop(const Time& delay)
 {
     NS_LOG_FUNCTION(delay);
-    m_stopEvent = GetImpl()->Stop(delay);
-    return m_stopEvent;
+    SimulationContext* context = SimulationContext::GetCurrent();
+    EventId& stopEvent =
+        context != nullptr ? context->GetSingleton<ContextSimulator>()->stopEvent : m_stopEvent;
+    stopEvent = GetImpl()->Stop(delay);
+    return stopEvent;
 }
 
 EventId
 Simulator::GetStopEvent()
 {
+    SimulationContext* context = SimulationContext::GetCurrent();
+    if (context != nullptr)
+    {
+        return context->GetSingleton<ContextSimulator>()->stopEvent;
+    }
     return m_stopEvent;
 }
 
@@ -354,8 +390,11 @@ Simulator::SetImplementation(Ptr<SimulatorImpl> impl)
     // Simulator::Now which would call Simulator::GetImpl, and, thus, get us
     // in an infinite recursion until the stack explodes.
     //
-    LogSetTimePrinter(&DefaultTimePrinter);
-    LogSetNodePrinter(&DefaultNodePrinter);
+    if (SimulationContext::GetCurrent() == nullptr)
+    {
+        LogSetTimePrinter(&DefaultTimePrinter);
+        LogSetNodePrinter(&DefaultNodePrinter);
+    }
 }
 
 Ptr<SimulatorImpl>
@@ -11,7 +11,7 @@
 
 #include "callback.h"
 
-#include <list>
+#include <vector>
 
 /**
  * \file
@@ -36,6 +36,16 @@ namespace ns3
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * Most trace sources have no sink, or a single one, and are fired
+ * for every packet.  The first Callback is thus stored inline, and
+ * invoking a TracedCallback with zero or one sink does not walk a
+ * container.  When a second Callback is connected, the chain moves
+ * to a contiguous vector.
+ *
+ * Callbacks connected while the chain is being invoked are invoked
+ * from the next invocation on if the chain had a single Callback,
+ * and from the current one otherwise.
+ *
  * \tparam Ts \explicit Types of the functor arguments.
  */
 template <typename... Ts>
@@ -97,13 +107,25 @@ class TracedCallback
     /**@}*/
 
   private:
+    /**
+     * Append a Callback to the chain.
+     *
+     * \param [in] callback Callback to add to chain.
+     */
+    void DoConnect(const Callback<void, Ts...>& callback);
+
     /**
      * Container type for holding the chain of Callbacks.
      *
      * \tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
-    /** The chain of Callbacks. */
+    typedef std::vector<Callback<void, Ts...>> CallbackList;
+    /**
+     * The only Callback of the chain, or null if the chain is empty or
+     * is held by m_callbackList.
+     */
+    Callback<void, Ts...> m_single;
+    /** The chain of Callbacks, when it is not held by m_single. */
     CallbackList m_callbackList;
 };
 
@@ -118,8 +140,26 @@ namespace ns3
 
 template <typename... Ts>
 TracedCallback<Ts...>::TracedCallback()
-    : m_callbackList()
+    : m_single(),
+      m_callbackList()
+{
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::DoConnect(const Callback<void, Ts...>& callback)
 {
+    if (m_callbackList.empty())
+    {
+        if (m_single.IsNull())
+        {
+            m_single = callback;
+            return;
+        }
+        m_callbackList.push_back(m_single);
+        m_single.Nullify();
+    }
+    m_callbackList.push_back(callback);
 }
 
 template <typename... Ts>
@@ -131,7 +171,7 @@ TracedCallback<Ts...>::ConnectWithoutContext(const CallbackBase& callback)
     {
         NS_FATAL_ERROR_NO_MSG();
     }
-    m_callbackList.push_back(cb);
+    DoConnect(cb);
 }
 
 template <typename... Ts>
@@ -144,13 +184,17 @@ TracedCallback<Ts...>::Connect(const CallbackBase& callback, std::string path)
         NS_FATAL_ERROR("when connecting to " << path);
     }
     Callback<void, Ts...> realCb = cb.Bind(path);
-    m_callbackList.push_back(realCb);
+    DoConnect(realCb);
 }
 
 template <typename... Ts>
 void
 TracedCallback<Ts...>::DisconnectWithoutContext(const CallbackBase& callback)
 {
+    if (!m_single.IsNull() && m_single.IsEqual(callback))
+    {
+        m_single.Nullify();
+    }
     for (auto i = m_callbackList.begin(); i != m_callbackList.end(); /* empty */)
     {
         if ((*i).IsEqual(callback))
@@ -181,9 +225,16 @@ template <typename... Ts>
 void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
+    if (!m_single.IsNull())
+    {
+        m_single(args...);
+        return;
+    }
+    // Index the chain, as a Callback may connect another one and
+    // reallocate the vector.
+    for (std::size_t i = 0; i < m_callbackList.size(); ++i)
     {
-        (*i)(args...);
+        m_callbackList[i](args...);
     }
 }
 
@@ -191,7 +242,7 @@ template <typename... Ts>
 bool
 TracedCallback<Ts...>::IsEmpty() const
 {
-    return m_callbackList.empty();
+    return m_single.IsNull() && m_callbackList.empty();
 }
 
 } // namespace ns3
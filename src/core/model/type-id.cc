@@ -98,6 +98,12 @@ class IidManager : public Singleton<IidManager>
      * \param [in] size The object size.
      */
     void SetSize(uint16_t uid, std::size_t size);
+    /**
+     * Set the memory estimator of the object class referred to by this id.
+     * \param [in] uid The id.
+     * \param [in] estimator The memory estimator.
+     */
+    void SetMemoryEstimator(uint16_t uid, Callback<std::size_t, const ObjectBase*> estimator);
     /**
      * Add a constructor Callback to this type id.
      * \param [in] uid The id.
@@ -157,6 +163,12 @@ class IidManager : public Singleton<IidManager>
      * \returns The size of the type id.
      */
     std::size_t GetSize(uint16_t uid) const;
+    /**
+     * Get the memory estimator of a type id.
+     * \param [in] uid The id.
+     * \returns The memory estimator of the type id.
+     */
+    Callback<std::size_t, const ObjectBase*> GetMemoryEstimator(uint16_t uid) const;
     /**
      * Get the constructor Callback of a type id.
      * \param [in] uid The id.
@@ -309,6 +321,8 @@ class IidManager : public Singleton<IidManager>
         std::string groupName;
         /** The size of the object represented by this type id. */
         std::size_t size;
+        /** The estimator of the memory held by the objects of this type. */
+        Callback<std::size_t, const ObjectBase*> memoryEstimator;
         /** \c true if a constructor Callback has been registered. */
         bool hasConstructor;
         /** The constructor Callback. */
@@ -505,6 +519,14 @@ IidManager::SetSize(uint16_t uid, std::size_t size)
     information->size = size;
 }
 
+void
+IidManager::SetMemoryEstimator(uint16_t uid, Callback<std::size_t, const ObjectBase*> estimator)
+{
+    NS_LOG_FUNCTION(IID << uid << &estimator);
+    IidInformation* information = LookupInformation(uid);
+    information->memoryEstimator = estimator;
+}
+
 void
 IidManager::HideFromDocumentation(uint16_t uid)
 {
@@ -611,6 +633,14 @@ IidManager::GetSize(uint16_t uid) const
     return size;
 }
 
+Callback<std::size_t, const ObjectBase*>
+IidManager::GetMemoryEstimator(uint16_t uid) const
+{
+    NS_LOG_FUNCTION(IID << uid);
+    IidInformation* information = LookupInformation(uid);
+    return information->memoryEstimator;
+}
+
 Callback<ObjectBase*>
 IidManager::GetConstructor(uint16_t uid) const
 {
@@ -1080,6 +1110,13 @@ TypeId::GetSize() const
     return size;
 }
 
+Callback<std::size_t, const ObjectBase*>
+TypeId::GetMemoryEstimator() const
+{
+    NS_LOG_FUNCTION(this);
+    return IidManager::Get()->GetMemoryEstimator(m_tid);
+}
+
 bool
 TypeId::HasConstructor() const
 {
@@ -1217,6 +1254,14 @@ TypeId::AddTraceSource(std::string name,
     return *this;
 }
 
+TypeId
+TypeId::SetMemoryEstimator(Callback<std::size_t, const ObjectBase*> estimator)
+{
+    NS_LOG_FUNCTION(this << &estimator);
+    IidManager::Get()->SetMemoryEstimator(m_tid, estimator);
+    return *this;
+}
+
 TypeId
 TypeId::HideFromDocumentation()
 {
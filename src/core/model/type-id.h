@@ -245,6 +245,14 @@ class TypeId
      */
     std::size_t GetSize() const;
 
+    /**
+     * Get the memory estimator of this type.
+     *
+     * \returns The callback registered with SetMemoryEstimator(), or a
+     *          null callback.
+     */
+    Callback<std::size_t, const ObjectBase*> GetMemoryEstimator() const;
+
     /**
      * Check if this TypeId has a constructor.
      *
@@ -352,6 +360,29 @@ class TypeId
      */
     TypeId SetSize(std::size_t size);
 
+    /**
+     * Set the estimator of the memory held by the instances of this type,
+     * besides their size.
+     *
+     * The estimator gets an instance of this type, or of a subclass
+     * without an estimator of its own, and returns the number of bytes
+     * allocated by the instance: the contents of its containers, the
+     * packets it holds, etc.  The objects reachable through its
+     * attributes and aggregates are accounted for separately, and must
+     * not be included.  MemoryReport uses the estimators to report the
+     * memory held by the objects of a simulation:
+     * \code
+     *   .SetMemoryEstimator([](const ObjectBase* object) {
+     *       auto cache = static_cast<const ArpCache*>(object);
+     *       return cache->m_arpCache.size() * sizeof(ArpCache::Entry);
+     *   })
+     * \endcode
+     *
+     * \param [in] estimator The memory estimator.
+     * \returns This TypeId instance.
+     */
+    TypeId SetMemoryEstimator(Callback<std::size_t, const ObjectBase*> estimator);
+
     /**
      * Record in this TypeId the fact that the default constructor
      * is accessible.
@@ -10,6 +10,7 @@
 #include "ns3/integer.h"
 #include "ns3/log.h"
 #include "ns3/names.h"
+#include "ns3/object-map.h"
 #include "ns3/object-vector.h"
 #include "ns3/object.h"
 #include "ns3/pointer.h"
@@ -281,6 +282,35 @@ DerivedConfigObject::GetTypeId()
     return tid;
 }
 
+/**
+ * \ingroup config-tests
+ * An object with a map of objects, not indexed by position.
+ */
+class MapConfigTestObject : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    std::map<uint32_t, Ptr<ConfigTestObject>> m_nodes; //!< NodesMap attribute target.
+};
+
+TypeId
+MapConfigTestObject::GetTypeId()
+{
+    static TypeId tid = TypeId("MapConfigTestObject")
+                            .SetParent<Object>()
+                            .AddAttribute("NodesMap",
+                                          "",
+                                          ObjectMapValue(),
+                                          MakeObjectMapAccessor(&MapConfigTestObject::m_nodes),
+                                          MakeObjectMapChecker<ConfigTestObject>());
+    return tid;
+}
+
 /**
  * \ingroup config-tests
  * Test for the ability to register and use a root namespace.
@@ -618,6 +648,101 @@ ObjectVectorConfigTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), -16, "Object Attribute \"A\" not set as expected");
 }
 
+/**
+ * \ingroup config-tests
+ * Test the objects matched by the container index expressions, and
+ * their order, in vectors and in maps.
+ */
+class ContainerMatchConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ContainerMatchConfigTestCase();
+
+    /** Destructor. */
+    ~ContainerMatchConfigTestCase() override
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the objects matching a Config path.
+     *
+     * \param [in] path The Config path.
+     * \param [in] contexts The expected contexts of the matches, in order.
+     */
+    void CheckMatches(std::string path, const std::vector<std::string>& contexts);
+};
+
+ContainerMatchConfigTestCase::ContainerMatchConfigTestCase()
+    : TestCase("Check the objects matched in vectors and maps of Object")
+{
+}
+
+void
+ContainerMatchConfigTestCase::CheckMatches(std::string path,
+                                           const std::vector<std::string>& contexts)
+{
+    Config::MatchContainer matches = Config::LookupMatches(path);
+    NS_TEST_ASSERT_MSG_EQ(matches.GetN(), contexts.size(), "Wrong number of matches for " << path);
+    for (std::size_t i = 0; i < matches.GetN() && i < contexts.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(matches.GetMatchedPath(i),
+                              contexts[i],
+                              "Wrong match " << i << " for " << path);
+    }
+}
+
+void
+ContainerMatchConfigTestCase::DoRun()
+{
+    //
+    // Create a root namespace object with a map of objects indexed by
+    // 1, 4 and 7, the first one with a vector of four objects.
+    //
+    Ptr<MapConfigTestObject> root = CreateObject<MapConfigTestObject>();
+    Config::RegisterRootNamespaceObject(root);
+    for (uint32_t index : {1, 4, 7})
+    {
+        root->m_nodes[index] = CreateObject<ConfigTestObject>();
+    }
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        root->m_nodes[1]->AddNodeA(CreateObject<ConfigTestObject>());
+    }
+
+    //
+    // The map indexes are not the positions in the map
+    //
+    CheckMatches("/NodesMap/4", {"/NodesMap/4/"});
+    CheckMatches("/NodesMap/2", {});
+    CheckMatches("/NodesMap/[2-7]", {"/NodesMap/4/", "/NodesMap/7/"});
+    CheckMatches("/NodesMap/7|0|1", {"/NodesMap/1/", "/NodesMap/7/"});
+    CheckMatches("/NodesMap/*", {"/NodesMap/1/", "/NodesMap/4/", "/NodesMap/7/"});
+
+    //
+    // Overlapping alternatives match each object once, in index order
+    //
+    CheckMatches("/NodesMap/1/NodesA/3|[0-1]|1",
+                 {"/NodesMap/1/NodesA/0/", "/NodesMap/1/NodesA/1/", "/NodesMap/1/NodesA/3/"});
+    CheckMatches("/NodesMap/1/NodesA/[1-2]|[2-3]",
+                 {"/NodesMap/1/NodesA/1/", "/NodesMap/1/NodesA/2/", "/NodesMap/1/NodesA/3/"});
+
+    //
+    // Indexes beyond the end of the vector, and invalid expressions
+    //
+    CheckMatches("/NodesMap/1/NodesA/[2-100]",
+                 {"/NodesMap/1/NodesA/2/", "/NodesMap/1/NodesA/3/"});
+    CheckMatches("/NodesMap/1/NodesA/4", {});
+    CheckMatches("/NodesMap/1/NodesA/[3-1]", {});
+    CheckMatches("/NodesMap/1/NodesA/x", {});
+    CheckMatches("/NodesMap/1/NodesA", {});
+
+    Config::UnregisterRootNamespaceObject(root);
+}
+
 /**
  * \ingroup config-tests
  * Test for the ability to trace configure with vectors of objects.
@@ -870,6 +995,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new RootNamespaceConfigTestCase);
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
+    AddTestCase(new ContainerMatchConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
 }
 
@@ -0,0 +1,171 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/log.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup logging
+ * \ingroup logging-tests
+ * Logging test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup logging-tests Logging tests
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LogTestSuite");
+
+namespace tests
+{
+
+/**
+ * \ingroup logging-tests
+ * Check that LogComponent::IsAnyEnabled() follows the levels enabled in
+ * the log components, and ignores the prefixes.
+ */
+class LogAnyEnabledTestCase : public TestCase
+{
+  public:
+    LogAnyEnabledTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LogAnyEnabledTestCase::LogAnyEnabledTestCase()
+    : TestCase("Check LogComponent::IsAnyEnabled()")
+{
+}
+
+void
+LogAnyEnabledTestCase::DoRun()
+{
+    // Other components may be enabled through NS_LOG
+    bool any = LogComponent::IsAnyEnabled();
+    NS_TEST_ASSERT_MSG_EQ(g_log.IsNoneEnabled(), true, "Test component enabled");
+
+    g_log.Enable(LOG_PREFIX_ALL);
+    NS_TEST_ASSERT_MSG_EQ(LogComponent::IsAnyEnabled(), any, "Prefixes enabled");
+    g_log.Enable(LOG_DEBUG);
+    NS_TEST_ASSERT_MSG_EQ(LogComponent::IsAnyEnabled(), true, "LOG_DEBUG enabled");
+    g_log.Enable(LOG_LEVEL_INFO);
+    g_log.Disable(LOG_DEBUG);
+    NS_TEST_ASSERT_MSG_EQ(LogComponent::IsAnyEnabled(), true, "LOG_LEVEL_INFO still enabled");
+    g_log.Disable(LOG_LEVEL_ALL);
+    NS_TEST_ASSERT_MSG_EQ(LogComponent::IsAnyEnabled(), any, "Only prefixes enabled");
+    g_log.Disable(LOG_PREFIX_ALL);
+    NS_TEST_ASSERT_MSG_EQ(g_log.IsNoneEnabled(), true, "Test component still enabled");
+}
+
+/**
+ * \ingroup logging-tests
+ * Check that the log messages written by a background thread keep the
+ * order of each logging thread, and are all written when disabled.
+ */
+class LogAsyncTestCase : public TestCase
+{
+  public:
+    LogAsyncTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LogAsyncTestCase::LogAsyncTestCase()
+    : TestCase("Check LogSetAsync()")
+{
+}
+
+void
+LogAsyncTestCase::DoRun()
+{
+    const int threads = 4;
+    const int messages = 1000;
+
+    std::ostringstream output;
+    std::streambuf* clog = std::clog.rdbuf(output.rdbuf());
+    LogSetAsync(true);
+
+    std::vector<std::thread> loggers;
+    for (int t = 0; t < threads; ++t)
+    {
+        loggers.emplace_back([t]() {
+            for (int i = 0; i < messages; ++i)
+            {
+                // Write as NS_LOG does, also in the builds without logging
+                std::clog << "thread " << t << " message " << i << std::endl;
+            }
+        });
+    }
+    for (auto& logger : loggers)
+    {
+        logger.join();
+    }
+    std::clog << "done" << std::endl;
+
+    LogSetAsync(false);
+    NS_TEST_ASSERT_MSG_EQ(std::clog.rdbuf(), output.rdbuf(), "Buffer of std::clog not restored");
+    std::clog.rdbuf(clog);
+
+    std::istringstream lines(output.str());
+    std::vector<int> next(threads, 0);
+    std::string line;
+    int count = 0;
+    while (std::getline(lines, line))
+    {
+        int t;
+        int i;
+        if (std::sscanf(line.c_str(), "thread %d message %d", &t, &i) == 2)
+        {
+            NS_TEST_ASSERT_MSG_EQ(i, next[t], "Message of thread " << t << " out of order");
+            next[t]++;
+        }
+        else
+        {
+            NS_TEST_ASSERT_MSG_EQ(line, "done", "Unexpected message");
+        }
+        count++;
+    }
+    NS_TEST_ASSERT_MSG_EQ(count, threads * messages + 1, "Messages lost");
+}
+
+/**
+ * \ingroup logging-tests
+ * Logging test suite.
+ */
+class LogTestSuite : public TestSuite
+{
+  public:
+    LogTestSuite();
+};
+
+LogTestSuite::LogTestSuite()
+    : TestSuite("log", Type::UNIT)
+{
+    AddTestCase(new LogAnyEnabledTestCase());
+    AddTestCase(new LogAsyncTestCase());
+}
+
+/**
+ * \ingroup logging-tests
+ * LogTestSuite instance variable.
+ */
+static LogTestSuite g_logTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
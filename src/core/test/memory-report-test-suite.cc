@@ -0,0 +1,291 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/memory-report.h"
+#include "ns3/object-vector.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <sstream>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup object
+ * \ingroup object-tests
+ * MemoryReport test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup object-tests
+ * An object holding a child, a list of items, and some data.
+ */
+class MemoryReportTestObject : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    Ptr<MemoryReportTestObject> m_child;               //!< The child.
+    std::vector<Ptr<MemoryReportTestObject>> m_items; //!< The items.
+    std::vector<uint8_t> m_data;                       //!< The data, reported by the estimator.
+};
+
+TypeId
+MemoryReportTestObject::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::tests::MemoryReportTestObject")
+            .SetParent<Object>()
+            .SetGroupName("Core")
+            .HideFromDocumentation()
+            .AddConstructor<MemoryReportTestObject>()
+            .SetMemoryEstimator([](const ObjectBase* object) -> std::size_t {
+                return static_cast<const MemoryReportTestObject*>(object)->m_data.size();
+            })
+            .AddAttribute("Child",
+                          "The child.",
+                          PointerValue(),
+                          MakePointerAccessor(&MemoryReportTestObject::m_child),
+                          MakePointerChecker<MemoryReportTestObject>())
+            .AddAttribute("Items",
+                          "The items.",
+                          ObjectVectorValue(),
+                          MakeObjectVectorAccessor(&MemoryReportTestObject::m_items),
+                          MakeObjectVectorChecker<MemoryReportTestObject>());
+    return tid;
+}
+
+NS_OBJECT_ENSURE_REGISTERED(MemoryReportTestObject);
+
+/**
+ * \ingroup object-tests
+ * A subclass of MemoryReportTestObject, without an estimator of its own.
+ */
+class MemoryReportTestDerived : public MemoryReportTestObject
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    uint64_t m_padding[4]; //!< Make the subclass larger.
+};
+
+TypeId
+MemoryReportTestDerived::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::tests::MemoryReportTestDerived")
+                            .SetParent<MemoryReportTestObject>()
+                            .SetGroupName("Core")
+                            .HideFromDocumentation()
+                            .AddConstructor<MemoryReportTestDerived>();
+    return tid;
+}
+
+NS_OBJECT_ENSURE_REGISTERED(MemoryReportTestDerived);
+
+/**
+ * \ingroup object-tests
+ * Check the objects found from the roots of a report, and the memory
+ * accounted for each of them.
+ */
+class MemoryReportObjectsTestCase : public TestCase
+{
+  public:
+    MemoryReportObjectsTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MemoryReportObjectsTestCase::MemoryReportObjectsTestCase()
+    : TestCase("Check the objects accounted for by a memory report")
+{
+}
+
+void
+MemoryReportObjectsTestCase::DoRun()
+{
+    const uint64_t size = sizeof(MemoryReportTestObject);
+    const uint64_t derivedSize = sizeof(MemoryReportTestDerived);
+
+    auto root = CreateObject<MemoryReportTestObject>();
+    root->m_data.resize(100);
+    auto child = CreateObject<MemoryReportTestDerived>();
+    child->m_data.resize(10);
+    root->m_child = child;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        auto item = CreateObject<MemoryReportTestObject>();
+        item->m_data.resize(1);
+        // a shared child, accounted for once
+        item->m_child = child;
+        root->m_items.push_back(item);
+    }
+    auto aggregate = CreateObject<MemoryReportTestDerived>();
+    root->AggregateObject(aggregate);
+
+    NS_TEST_ASSERT_MSG_EQ(MemoryReport::GetObjectBytes(root), size + 100, "Root size");
+    NS_TEST_ASSERT_MSG_EQ(MemoryReport::GetObjectBytes(child),
+                          derivedSize + 10,
+                          "The estimator of the parent type is used");
+
+    MemoryReport report;
+    report.AddObjects(7, root);
+    // the objects of the root are not accounted for twice
+    report.AddObjects(8, root->m_items[0]);
+
+    auto objects = report.GetType("ns3::tests::MemoryReportTestObject");
+    NS_TEST_ASSERT_MSG_EQ(objects.count, 4, "Root and items");
+    NS_TEST_ASSERT_MSG_EQ(objects.bytes, 4 * size + 103, "Root and items");
+    auto derived = report.GetType("ns3::tests::MemoryReportTestDerived");
+    NS_TEST_ASSERT_MSG_EQ(derived.count, 2, "Child and aggregate");
+    NS_TEST_ASSERT_MSG_EQ(derived.bytes, 2 * derivedSize + 10, "Child and aggregate");
+    auto object = report.GetType("ns3::Object");
+    NS_TEST_ASSERT_MSG_EQ(object.count, 0, "No other object");
+
+    NS_TEST_ASSERT_MSG_EQ(report.GetContext(7).count, 6, "All objects in the root context");
+    NS_TEST_ASSERT_MSG_EQ(report.GetContext(7).bytes,
+                          objects.bytes + derived.bytes,
+                          "All objects in the root context");
+    NS_TEST_ASSERT_MSG_EQ(report.GetContext(8).count, 0, "No object in the second context");
+    NS_TEST_ASSERT_MSG_EQ(report.GetTotal().bytes,
+                          report.GetContext(7).bytes,
+                          "Total of the contexts");
+
+    // Excluded objects, and the objects only reachable from them, are skipped
+    MemoryReport excluding;
+    excluding.Exclude(child);
+    excluding.Exclude(root->m_items[1]);
+    excluding.AddObjects(1, root);
+    excluding.Add(Simulator::NO_CONTEXT, "buffers", 1000, 2);
+    NS_TEST_ASSERT_MSG_EQ(excluding.GetType("ns3::tests::MemoryReportTestObject").count,
+                          3,
+                          "Root and two items");
+    NS_TEST_ASSERT_MSG_EQ(excluding.GetType("ns3::tests::MemoryReportTestDerived").count,
+                          1,
+                          "Aggregate");
+    NS_TEST_ASSERT_MSG_EQ(excluding.GetContext(Simulator::NO_CONTEXT).bytes,
+                          1000,
+                          "Memory added without a context");
+    NS_TEST_ASSERT_MSG_EQ(excluding.GetTotal().count, 6, "Objects and buffers");
+
+    std::ostringstream os;
+    excluding.Print(os, true);
+    NS_TEST_ASSERT_MSG_NE(os.str().find("ns3::tests::MemoryReportTestObject"),
+                          std::string::npos,
+                          "Types printed");
+    NS_TEST_ASSERT_MSG_NE(os.str().find("node 1"), std::string::npos, "Contexts printed");
+    NS_TEST_ASSERT_MSG_NE(os.str().find("global"), std::string::npos, "Contexts printed");
+
+    root->Dispose();
+}
+
+/**
+ * \ingroup object-tests
+ * The object added to the reports by CollectTestObject().
+ */
+static Ptr<MemoryReportTestObject> g_collectedObject;
+
+/**
+ * \ingroup object-tests
+ * Add g_collectedObject, if any, to a memory report.
+ * \param [in] report The memory report.
+ */
+static void
+CollectTestObject(MemoryReport& report)
+{
+    if (g_collectedObject)
+    {
+        report.AddObjects(3, g_collectedObject);
+    }
+}
+
+/**
+ * \ingroup object-tests
+ * Check the reports collected with the registered collectors.
+ */
+class MemoryReportCollectTestCase : public TestCase
+{
+  public:
+    MemoryReportCollectTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MemoryReportCollectTestCase::MemoryReportCollectTestCase()
+    : TestCase("Check the memory reports collected")
+{
+}
+
+void
+MemoryReportCollectTestCase::DoRun()
+{
+    g_collectedObject = CreateObject<MemoryReportTestObject>();
+    g_collectedObject->m_data.resize(42);
+    MemoryReport::AddCollector(MakeCallback(&CollectTestObject));
+
+    uint64_t events = MemoryReport::Collect().GetType("ns3::EventImpl").count;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        Simulator::Schedule(Seconds(i), []() {});
+    }
+    MemoryReport report = MemoryReport::Collect();
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(report.GetType("ns3::EventImpl").count,
+                                events + 10,
+                                "The events scheduled are accounted for");
+    NS_TEST_ASSERT_MSG_GT(report.GetType("ns3::EventImpl").bytes, 0, "Event bytes");
+    NS_TEST_ASSERT_MSG_EQ(report.GetContext(3).bytes,
+                          sizeof(MemoryReportTestObject) + 42,
+                          "Object of the registered collector");
+
+    std::ostringstream os;
+    MemoryReport::PrintAtDestroy(os);
+    Simulator::Run();
+    Simulator::Destroy();
+    NS_TEST_ASSERT_MSG_NE(os.str().find("total"), std::string::npos, "Report printed");
+    g_collectedObject = nullptr;
+}
+
+/**
+ * \ingroup object-tests
+ * MemoryReport test suite.
+ */
+class MemoryReportTestSuite : public TestSuite
+{
+  public:
+    MemoryReportTestSuite();
+};
+
+MemoryReportTestSuite::MemoryReportTestSuite()
+    : TestSuite("memory-report")
+{
+    AddTestCase(new MemoryReportObjectsTestCase());
+    AddTestCase(new MemoryReportCollectTestCase());
+}
+
+/**
+ * \ingroup object-tests
+ * MemoryReportTestSuite instance variable.
+ */
+static MemoryReportTestSuite g_memoryReportTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
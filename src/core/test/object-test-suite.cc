@@ -451,6 +451,21 @@ AggregateObjectTestCase::DoRun()
 
     baseA = baseB->GetObject<BaseA>();
     NS_TEST_ASSERT_MSG_NE(baseA, nullptr, "Unable to GetObject on released object");
+
+    //
+    // The lookup table of an aggregation is rebuilt when an Object is
+    // aggregated, so a failed lookup must not hide the new Object.
+    //
+    baseA = CreateObject<BaseA>();
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(), nullptr, "Unexpectedly found a BaseB");
+    Ptr<DerivedB> derivedB = CreateObject<DerivedB>();
+    baseA->AggregateObject(derivedB);
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(), derivedB, "Wrong BaseB through baseA");
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<DerivedB>(), derivedB, "Wrong DerivedB through baseA");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<BaseA>(), baseA, "Wrong BaseA through derivedB");
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<Object>(BaseB::GetTypeId()),
+                          derivedB,
+                          "Wrong BaseB by TypeId through baseA");
 }
 
 /**
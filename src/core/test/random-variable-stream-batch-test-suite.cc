@@ -0,0 +1,164 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+
+#include <functional>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * \ingroup rng-tests
+ * Test for the batch sampling of random variable streams.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup rng-tests
+ * Check that RandomVariableStream::GetValues() returns the values of
+ * successive GetValue() calls, and leaves the stream where they would.
+ */
+class RandomVariableStreamBatchTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param [in] name The name of the distribution.
+     * \param [in] create Create a stream of the distribution, on a fixed stream number.
+     */
+    RandomVariableStreamBatchTestCase(std::string name,
+                                      std::function<Ptr<RandomVariableStream>()> create);
+
+  private:
+    void DoRun() override;
+
+    /** Create a stream of the distribution, on a fixed stream number. */
+    std::function<Ptr<RandomVariableStream>()> m_create;
+};
+
+RandomVariableStreamBatchTestCase::RandomVariableStreamBatchTestCase(
+    std::string name,
+    std::function<Ptr<RandomVariableStream>()> create)
+    : TestCase("Check GetValues() of " + name),
+      m_create(create)
+{
+}
+
+void
+RandomVariableStreamBatchTestCase::DoRun()
+{
+    for (bool antithetic : {false, true})
+    {
+        Ptr<RandomVariableStream> scalar = m_create();
+        Ptr<RandomVariableStream> batch = m_create();
+        scalar->SetAntithetic(antithetic);
+        batch->SetAntithetic(antithetic);
+
+        // Batches of various sizes, interleaved with single values
+        for (std::size_t size : {0, 1, 2, 3, 7, 64, 65, 129, 1000, 1, 4096})
+        {
+            std::vector<double> values(size);
+            batch->GetValues(values);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                NS_TEST_ASSERT_MSG_EQ(values[i],
+                                      scalar->GetValue(),
+                                      "Value " << i << " of a batch of " << size);
+            }
+            NS_TEST_ASSERT_MSG_EQ(batch->GetValue(),
+                                  scalar->GetValue(),
+                                  "Value after a batch of " << size);
+        }
+    }
+}
+
+/**
+ * \ingroup rng-tests
+ * Test suite for the batch sampling of random variable streams.
+ */
+class RandomVariableStreamBatchTestSuite : public TestSuite
+{
+  public:
+    RandomVariableStreamBatchTestSuite();
+};
+
+RandomVariableStreamBatchTestSuite::RandomVariableStreamBatchTestSuite()
+    : TestSuite("random-variable-stream-batch", Type::UNIT)
+{
+    AddTestCase(new RandomVariableStreamBatchTestCase("UniformRandomVariable", []() {
+        auto x = CreateObject<UniformRandomVariable>();
+        x->SetAttribute("Min", DoubleValue(-3));
+        x->SetAttribute("Max", DoubleValue(7));
+        x->SetStream(1);
+        return x;
+    }));
+    AddTestCase(new RandomVariableStreamBatchTestCase("ExponentialRandomVariable", []() {
+        auto x = CreateObject<ExponentialRandomVariable>();
+        x->SetAttribute("Mean", DoubleValue(2));
+        x->SetStream(2);
+        return x;
+    }));
+    AddTestCase(new RandomVariableStreamBatchTestCase("bounded ExponentialRandomVariable", []() {
+        auto x = CreateObject<ExponentialRandomVariable>();
+        x->SetAttribute("Mean", DoubleValue(2));
+        x->SetAttribute("Bound", DoubleValue(1.5));
+        x->SetStream(3);
+        return x;
+    }));
+    AddTestCase(new RandomVariableStreamBatchTestCase("NormalRandomVariable", []() {
+        auto x = CreateObject<NormalRandomVariable>();
+        x->SetAttribute("Mean", DoubleValue(5));
+        x->SetAttribute("Variance", DoubleValue(4));
+        x->SetStream(4);
+        return x;
+    }));
+    AddTestCase(new RandomVariableStreamBatchTestCase("bounded NormalRandomVariable", []() {
+        auto x = CreateObject<NormalRandomVariable>();
+        x->SetAttribute("Mean", DoubleValue(5));
+        x->SetAttribute("Variance", DoubleValue(4));
+        x->SetAttribute("Bound", DoubleValue(1));
+        x->SetStream(5);
+        return x;
+    }));
+    for (bool interpolate : {false, true})
+    {
+        AddTestCase(new RandomVariableStreamBatchTestCase(
+            interpolate ? "interpolated EmpiricalRandomVariable" : "EmpiricalRandomVariable",
+            [interpolate]() {
+                auto x = CreateObject<EmpiricalRandomVariable>();
+                x->SetInterpolate(interpolate);
+                x->CDF(0.0, 0.1);
+                x->CDF(5.0, 0.25);
+                x->CDF(10.0, 0.9);
+                x->SetStream(6);
+                return x;
+            }));
+    }
+    // The base implementation
+    AddTestCase(new RandomVariableStreamBatchTestCase("ParetoRandomVariable", []() {
+        auto x = CreateObject<ParetoRandomVariable>();
+        x->SetStream(7);
+        return x;
+    }));
+}
+
+/**
+ * \ingroup rng-tests
+ * RandomVariableStreamBatchTestSuite instance variable.
+ */
+static RandomVariableStreamBatchTestSuite g_randomVariableStreamBatchTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
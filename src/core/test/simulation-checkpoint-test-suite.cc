@@ -0,0 +1,155 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulation-checkpoint.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <unistd.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator-tests
+ * SimulationCheckpoint test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that the branches resumed from a checkpoint continue the
+ * simulation as if it had not been interrupted.
+ */
+class SimulationCheckpointTestCase : public TestCase
+{
+  public:
+    SimulationCheckpointTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Draw a random value, and schedule the next draw after a random delay. */
+    void Draw();
+
+    /**
+     * Run the simulation for 5 seconds, and get the sum of the values drawn
+     * since the checkpoint.
+     * \returns The sum of the values.
+     */
+    double RunFromCheckpoint();
+
+    Ptr<UniformRandomVariable> m_value;    //!< The values drawn.
+    Ptr<ExponentialRandomVariable> m_wait; //!< The delays between the draws.
+    double m_sum;                          //!< The sum of the values drawn.
+};
+
+SimulationCheckpointTestCase::SimulationCheckpointTestCase()
+    : TestCase("Check that the branches continue the simulation from the checkpoint")
+{
+}
+
+void
+SimulationCheckpointTestCase::Draw()
+{
+    m_sum += m_value->GetValue();
+    Simulator::Schedule(MilliSeconds(m_wait->GetValue()),
+                        &SimulationCheckpointTestCase::Draw,
+                        this);
+}
+
+double
+SimulationCheckpointTestCase::RunFromCheckpoint()
+{
+    m_sum = 0;
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+    return m_sum;
+}
+
+void
+SimulationCheckpointTestCase::DoRun()
+{
+    m_value = CreateObject<UniformRandomVariable>();
+    m_value->SetStream(1);
+    m_wait = CreateObject<ExponentialRandomVariable>();
+    m_wait->SetAttribute("Mean", DoubleValue(10));
+    m_wait->SetStream(2);
+    m_sum = 0;
+    Simulator::ScheduleNow(&SimulationCheckpointTestCase::Draw, this);
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+
+    SimulationCheckpoint checkpoint;
+    NS_TEST_ASSERT_MSG_EQ(checkpoint.GetTime(), Seconds(5), "Checkpoint time");
+
+    // Each branch writes its sum to a pipe, and returns its index
+    int fds[2];
+    NS_TEST_ASSERT_MSG_EQ(pipe(fds), 0, "Cannot create a pipe");
+    std::vector<pid_t> branches;
+    for (int i = 0; i < 2; ++i)
+    {
+        branches.push_back(checkpoint.Resume([this, i, &fds]() {
+            double sum = RunFromCheckpoint();
+            bool written = write(fds[1], &sum, sizeof(sum)) == sizeof(sum);
+            return written ? i : 255;
+        }));
+    }
+    close(fds[1]);
+    for (int i = 0; i < 2; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(SimulationCheckpoint::Wait(branches[i]), i, "Branch exit status");
+    }
+    double sums[2];
+    NS_TEST_ASSERT_MSG_EQ(read(fds[0], sums, sizeof(sums)), sizeof(sums), "Branch results");
+    close(fds[0]);
+    NS_TEST_ASSERT_MSG_EQ(Simulator::Now(), Seconds(5), "The branches ran in this process");
+
+    // Continue the simulation without a branch
+    double sum = RunFromCheckpoint();
+    NS_TEST_ASSERT_MSG_GT(sum, 0, "No value drawn after the checkpoint");
+    NS_TEST_ASSERT_MSG_EQ(sums[0], sum, "First branch result");
+    NS_TEST_ASSERT_MSG_EQ(sums[1], sum, "Second branch result");
+
+    // A branch which fails
+    SimulationCheckpoint end;
+    end.Resume([]() { return 3; });
+    NS_TEST_ASSERT_MSG_EQ(SimulationCheckpoint::WaitAll(), 1, "Failed branches");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief SimulationCheckpoint test suite.
+ */
+class SimulationCheckpointTestSuite : public TestSuite
+{
+  public:
+    SimulationCheckpointTestSuite();
+};
+
+SimulationCheckpointTestSuite::SimulationCheckpointTestSuite()
+    : TestSuite("simulation-checkpoint", Type::UNIT)
+{
+    AddTestCase(new SimulationCheckpointTestCase());
+}
+
+/**
+ * \ingroup simulator-tests
+ * SimulationCheckpointTestSuite instance variable.
+ */
+static SimulationCheckpointTestSuite g_simulationCheckpointTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -6,13 +6,30 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/calendar-scheduler.h"
+#include "ns3/config.h"
+#include "ns3/event-profiler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-queue-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
+#include "ns3/names.h"
+#include "ns3/make-event.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/quad-heap-scheduler.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulation-context.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <thread>
+
 using namespace ns3;
 
 /**
@@ -200,6 +217,375 @@ SimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_destroy, true, "Event should have run");
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that a scheduler returns the same events as the MapScheduler
+ * under a random sequence of insertions and removals.
+ */
+class SchedulerRemoveTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param schedulerFactory Scheduler factory.
+     */
+    SchedulerRemoveTestCase(ObjectFactory schedulerFactory);
+
+  private:
+    void DoRun() override;
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerRemoveTestCase::SchedulerRemoveTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check event removal with " + schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerRemoveTestCase::DoRun()
+{
+    Ptr<Scheduler> tested = m_schedulerFactory.Create<Scheduler>();
+    Ptr<Scheduler> reference = CreateObject<MapScheduler>();
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+
+    std::map<uint32_t, Scheduler::Event> pending; // by uid
+    uint32_t uid = 0;
+    uint64_t now = 0;
+    for (uint32_t step = 0; step < 20000; ++step)
+    {
+        double op = rng->GetValue();
+        if (op < 0.5 || pending.empty())
+        {
+            Scheduler::Event ev;
+            ev.impl = MakeEvent([]() {});
+            // mostly short delays, with a few much longer ones
+            uint32_t maxDelay = rng->GetValue() < 0.9 ? 100 : 100000;
+            ev.key.m_ts = now + rng->GetInteger(0, maxDelay);
+            ev.key.m_uid = uid++;
+            ev.key.m_context = 0;
+            tested->Insert(ev);
+            reference->Insert(ev);
+            pending[ev.key.m_uid] = ev;
+        }
+        else if (op < 0.8)
+        {
+            auto it = std::next(pending.begin(), rng->GetInteger(0, pending.size() - 1));
+            tested->Remove(it->second);
+            reference->Remove(it->second);
+            it->second.impl->Unref();
+            pending.erase(it);
+        }
+        else
+        {
+            Scheduler::Event next = reference->RemoveNext();
+            NS_TEST_ASSERT_MSG_EQ(tested->PeekNext().key.m_uid,
+                                  next.key.m_uid,
+                                  "Unexpected next event");
+            NS_TEST_ASSERT_MSG_EQ(tested->RemoveNext().key.m_uid,
+                                  next.key.m_uid,
+                                  "Unexpected removed event");
+            now = next.key.m_ts;
+            next.impl->Unref();
+            pending.erase(next.key.m_uid);
+        }
+        NS_TEST_ASSERT_MSG_EQ(tested->IsEmpty(), reference->IsEmpty(), "Unexpected IsEmpty()");
+    }
+    // remove most of the remaining events, to compact the heap
+    for (auto it = pending.begin(); it != pending.end();)
+    {
+        if (rng->GetValue() < 0.9)
+        {
+            tested->Remove(it->second);
+            reference->Remove(it->second);
+            it->second.impl->Unref();
+            it = pending.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    while (!reference->IsEmpty())
+    {
+        Scheduler::Event next = reference->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ(tested->RemoveNext().key.m_uid,
+                              next.key.m_uid,
+                              "Unexpected removed event");
+        next.impl->Unref();
+    }
+    NS_TEST_EXPECT_MSG_EQ(tested->IsEmpty(), true, "Events left in the scheduler");
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that released events are reused by the event pool.
+ */
+class SimulatorEventPoolTestCase : public TestCase
+{
+  public:
+    SimulatorEventPoolTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Reschedule itself until enough events have been executed. */
+    void Chain();
+
+    /** Allocates an event when the thread exits. */
+    struct LateEventAllocator
+    {
+        void** event{nullptr}; //!< Where to store the event.
+
+        ~LateEventAllocator()
+        {
+            *event = EventImpl::operator new(17);
+        }
+    };
+
+    uint32_t m_count; //!< Number of events executed.
+};
+
+SimulatorEventPoolTestCase::SimulatorEventPoolTestCase()
+    : TestCase("Check the event pool"),
+      m_count(0)
+{
+}
+
+void
+SimulatorEventPoolTestCase::Chain()
+{
+    if (++m_count < 100)
+    {
+        Simulator::Schedule(MicroSeconds(1), &SimulatorEventPoolTestCase::Chain, this);
+    }
+}
+
+void
+SimulatorEventPoolTestCase::DoRun()
+{
+    EventImpl::ResetPoolStatistics();
+    Simulator::Schedule(MicroSeconds(1), &SimulatorEventPoolTestCase::Chain, this);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    EventImpl::PoolStatistics stats = EventImpl::GetPoolStatistics();
+    NS_TEST_EXPECT_MSG_EQ(m_count, 100, "Unexpected number of events");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(stats.allocations, 100, "Every event is allocated by the pool");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(stats.releases, 100, "Every event is released to the pool");
+    // each event is allocated while the previous one is still alive
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(stats.hits, 98, "Released events are not reused");
+    NS_TEST_EXPECT_MSG_GT(stats.pooled, 0, "No free event in the pool");
+
+    // An event allocated at the exit of a thread, after its pool is
+    // closed, then released to the pool of another thread, must be
+    // large enough for any event of its size class.
+    void* late = nullptr;
+    std::thread exiting([&late] {
+        // destroyed after the pool of the thread is closed, since the
+        // pool registers its cleanup at the first event released below
+        static thread_local LateEventAllocator allocator;
+        allocator.event = &late;
+        EventImpl::operator delete(EventImpl::operator new(24), 24);
+    });
+    exiting.join();
+    NS_TEST_ASSERT_MSG_NE(late, nullptr, "No event allocated at the thread exit");
+    void* reused = nullptr;
+    std::thread releasing([late, &reused] {
+        EventImpl::operator delete(late, 17);
+        reused = EventImpl::operator new(32);
+        // overflows the event if only 17 bytes were allocated
+        std::memset(reused, 0, 32);
+        EventImpl::operator delete(reused, 32);
+    });
+    releasing.join();
+    NS_TEST_EXPECT_MSG_EQ(reused, late, "The event is not reused");
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief A class with a virtual event handler.
+ */
+class ProfiledHandler
+{
+  public:
+    virtual ~ProfiledHandler() = default;
+    /** The event handler. */
+    virtual void Handle();
+};
+
+void
+ProfiledHandler::Handle()
+{
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief A class overriding the virtual event handler.
+ */
+class DerivedProfiledHandler : public ProfiledHandler
+{
+  public:
+    void Handle() override;
+};
+
+void
+DerivedProfiledHandler::Handle()
+{
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the event profile.
+ */
+class SimulatorEventProfileTestCase : public TestCase
+{
+  public:
+    SimulatorEventProfileTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /** Reschedule itself until enough events have been executed. */
+    void Chain();
+    /** An event handler. */
+    void First();
+    /** An event handler with the same signature. */
+    void Second();
+
+    uint32_t m_count; //!< Number of events executed.
+};
+
+SimulatorEventProfileTestCase::SimulatorEventProfileTestCase()
+    : TestCase("Check the event profile"),
+      m_count(0)
+{
+}
+
+void
+SimulatorEventProfileTestCase::Chain()
+{
+    if (++m_count < 100)
+    {
+        Simulator::Schedule(MicroSeconds(1), &SimulatorEventProfileTestCase::Chain, this);
+    }
+}
+
+void
+SimulatorEventProfileTestCase::First()
+{
+}
+
+void
+SimulatorEventProfileTestCase::Second()
+{
+}
+
+void
+SimulatorEventProfileTestCase::DoRun()
+{
+    EventProfiler profiler;
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        EventImpl* event = MakeEvent([]() {});
+        profiler.Invoke(event, i % 2);
+        event->Unref();
+    }
+    // a different lambda, so a different event type
+    EventImpl* event = MakeEvent([]() {});
+    profiler.Invoke(event, 0);
+    event->Unref();
+    auto entries = profiler.GetEntries();
+    NS_TEST_ASSERT_MSG_EQ(entries.size(), 3, "One entry per lambda and context");
+    uint64_t count = 0;
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        count += entries[i].count;
+        NS_TEST_EXPECT_MSG_EQ((entries[i].handler.find("MakeEvent") != std::string::npos),
+                              true,
+                              "Unexpected event handler " << entries[i].handler);
+        if (i > 0)
+        {
+            NS_TEST_EXPECT_MSG_GT_OR_EQ(entries[i - 1].time,
+                                        entries[i].time,
+                                        "Entries not sorted by time");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(count, 11, "Unexpected number of events");
+
+    // the methods of a same signature are told apart, and a virtual
+    // method is profiled as the override called
+    profiler.Clear();
+    DerivedProfiledHandler derived;
+    ProfiledHandler* base = &derived;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        for (EventImpl* event : {MakeEvent(&SimulatorEventProfileTestCase::First, this),
+                                 MakeEvent(&SimulatorEventProfileTestCase::Second, this),
+                                 MakeEvent(&ProfiledHandler::Handle, base)})
+        {
+            profiler.Invoke(event, 0);
+            event->Unref();
+        }
+    }
+    entries = profiler.GetEntries();
+    NS_TEST_ASSERT_MSG_EQ(entries.size(), 3, "One entry per method");
+    std::vector<std::string> handlers;
+    for (const auto& entry : entries)
+    {
+        NS_TEST_EXPECT_MSG_EQ(entry.count, 3, "Unexpected count of " << entry.handler);
+        handlers.push_back(entry.handler);
+    }
+    std::sort(handlers.begin(), handlers.end());
+#if __has_include(<dlfcn.h>)
+    NS_TEST_EXPECT_MSG_EQ(handlers[0], "DerivedProfiledHandler::Handle()", "Handler name");
+    NS_TEST_EXPECT_MSG_EQ(handlers[1], "SimulatorEventProfileTestCase::First()", "Handler name");
+    NS_TEST_EXPECT_MSG_EQ(handlers[2], "SimulatorEventProfileTestCase::Second()", "Handler name");
+#endif
+
+    // profile a simulation, written at Simulator::Destroy()
+    std::string filename = CreateTempDirFilename("event-profile.txt");
+    Config::SetDefault("ns3::DefaultSimulatorImpl::EventProfile", StringValue("Folded"));
+    Config::SetDefault("ns3::DefaultSimulatorImpl::EventProfileFile", StringValue(filename));
+    m_count = 0;
+    Simulator::ScheduleWithContext(3,
+                                   MicroSeconds(1),
+                                   &SimulatorEventProfileTestCase::Chain,
+                                   this);
+    Simulator::Schedule(MicroSeconds(1), []() {});
+    Simulator::Run();
+    Simulator::Destroy();
+
+    std::ifstream is(filename);
+    NS_TEST_ASSERT_MSG_EQ(is.is_open(), true, "Event profile not written");
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(is, line);)
+    {
+        lines.push_back(line);
+    }
+    NS_TEST_ASSERT_MSG_EQ(lines.size(), 2, "One line per event type and context");
+    std::sort(lines.begin(), lines.end());
+    NS_TEST_EXPECT_MSG_EQ(lines[0].rfind("no context;", 0), 0, "Unexpected line " << lines[0]);
+    NS_TEST_EXPECT_MSG_EQ(lines[1].rfind("node 3;", 0), 0, "Unexpected line " << lines[1]);
+    NS_TEST_EXPECT_MSG_EQ((lines[1].find("SimulatorEventProfileTestCase") != std::string::npos),
+                          true,
+                          "Unexpected line " << lines[1]);
+}
+
+void
+SimulatorEventProfileTestCase::DoTeardown()
+{
+    Config::Reset();
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -696,6 +1082,118 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that simulations running concurrently in their own
+ * SimulationContext are independent.
+ */
+class SimulatorContextTestCase : public TestCase
+{
+  public:
+    SimulatorContextTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** What a replica observed. */
+    struct Replica
+    {
+        uint64_t run{0};         //!< The run number.
+        uint32_t events{0};      //!< Number of events executed.
+        Time end;                //!< Time at the end of the simulation.
+        double value{0};         //!< First value of a random variable.
+        bool named{false};       //!< Whether the replica found its named object.
+        bool nameClash{false};   //!< Whether the name was already used.
+        uint64_t rngRunAfter{0}; //!< The run number after the simulation.
+    };
+
+    /**
+     * Run a simulation in a new context.
+     *
+     * \param [in,out] replica The replica, with its run number set.
+     * \param [in] stop The stop time.
+     */
+    static void RunReplica(Replica* replica, Time stop);
+};
+
+SimulatorContextTestCase::SimulatorContextTestCase()
+    : TestCase("Check simulations running concurrently in their own context")
+{
+}
+
+void
+SimulatorContextTestCase::RunReplica(Replica* replica, Time stop)
+{
+    SimulationContext context;
+    SimulationContext::SetCurrent(&context);
+
+    RngSeedManager::SetRun(replica->run);
+    Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable>();
+    rv->SetStream(1);
+    replica->value = rv->GetValue();
+
+    Ptr<Object> object = CreateObject<Object>();
+    replica->nameClash = Names::Find<Object>("replica") != nullptr;
+    Names::Add("replica", object);
+
+    std::function<void()> tick = [replica, &tick]() {
+        replica->events++;
+        Simulator::Schedule(MicroSeconds(1), tick);
+    };
+    Simulator::Schedule(MicroSeconds(1), tick);
+    Simulator::Stop(stop);
+    Simulator::Run();
+    replica->end = Simulator::Now();
+    replica->named = Names::Find<Object>("replica") == object;
+    replica->rngRunAfter = RngSeedManager::GetRun();
+    Simulator::Destroy();
+
+    SimulationContext::SetCurrent(nullptr);
+}
+
+void
+SimulatorContextTestCase::DoRun()
+{
+    uint64_t run = RngSeedManager::GetRun();
+    // the value expected from run 7 in the process-wide simulation
+    RngSeedManager::SetRun(7);
+    Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable>();
+    rv->SetStream(1);
+    double expected = rv->GetValue();
+    RngSeedManager::SetRun(run);
+
+    Replica replicas[2];
+    replicas[0].run = 7;
+    replicas[1].run = 8;
+    std::thread first(&SimulatorContextTestCase::RunReplica, &replicas[0], MicroSeconds(1000));
+    std::thread second(&SimulatorContextTestCase::RunReplica, &replicas[1], MicroSeconds(2000));
+    first.join();
+    second.join();
+
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        Time stop = MicroSeconds(1000 * (i + 1));
+        NS_TEST_EXPECT_MSG_EQ(replicas[i].end, stop, "Unexpected stop time of replica " << i);
+        NS_TEST_EXPECT_MSG_EQ(replicas[i].events,
+                              1000 * (i + 1) - 1,
+                              "Unexpected event count of replica " << i);
+        NS_TEST_EXPECT_MSG_EQ(replicas[i].named, true, "Name not found in replica " << i);
+        NS_TEST_EXPECT_MSG_EQ(replicas[i].nameClash, false, "Names shared by replica " << i);
+        NS_TEST_EXPECT_MSG_EQ(replicas[i].rngRunAfter,
+                              replicas[i].run,
+                              "Run number changed in replica " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(replicas[0].value, expected, "Unexpected random value of run 7");
+    NS_TEST_EXPECT_MSG_NE(replicas[1].value, expected, "Runs 7 and 8 give the same value");
+
+    // the process-wide state is untouched
+    NS_TEST_EXPECT_MSG_EQ(RngSeedManager::GetRun(), run, "Process-wide run number changed");
+    NS_TEST_EXPECT_MSG_EQ(Names::Find<Object>("replica"), nullptr, "Process-wide Names changed");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), Seconds(0), "Process-wide simulator changed");
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -719,6 +1217,15 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(QuadHeapScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new SchedulerRemoveTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderQueueScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new SchedulerRemoveTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorEventPoolTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorEventProfileTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorContextTestCase(), TestCase::Duration::QUICK);
     }
 };
 
@@ -10,6 +10,7 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
+#include "ns3/mpsc-queue.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
@@ -19,6 +20,7 @@
 #include <list>
 #include <thread> // sleep_for
 #include <utility>
+#include <vector>
 
 using namespace ns3;
 
@@ -267,6 +269,167 @@ ThreadedSimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_a, m_d, "Bad scheduling");
 }
 
+/**
+ * \ingroup threaded-tests
+ *
+ * \brief Check that the lock-free queue keeps the elements of each
+ * producer in order, while several producers push concurrently.
+ */
+class MpscQueueTestCase : public TestCase
+{
+  public:
+    MpscQueueTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** A queue element: producer and sequence number. */
+    typedef std::pair<uint32_t, uint32_t> Element;
+
+    static constexpr uint32_t PRODUCERS = 4;  //!< Number of producer threads.
+    static constexpr uint32_t COUNT = 20000; //!< Elements pushed by each producer.
+};
+
+MpscQueueTestCase::MpscQueueTestCase()
+    : TestCase("Check the lock-free multiple producer, single consumer queue")
+{
+}
+
+void
+MpscQueueTestCase::DoRun()
+{
+    // small enough for the producers to find the queue full
+    MpscQueue<Element> queue(64);
+    NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), true, "New queue not empty");
+
+    std::vector<std::thread> producers;
+    for (uint32_t producer = 0; producer < PRODUCERS; ++producer)
+    {
+        producers.emplace_back([&queue, producer]() {
+            for (uint32_t i = 0; i < COUNT; ++i)
+            {
+                while (!queue.Push(Element(producer, i)))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<uint32_t> next(PRODUCERS, 0);
+    uint32_t errors = 0;
+    uint32_t popped = 0;
+    while (popped < PRODUCERS * COUNT)
+    {
+        std::size_t count = queue.Drain([&next, &errors](const Element& element) {
+            if (element.first >= PRODUCERS || element.second != next[element.first])
+            {
+                errors++;
+                return;
+            }
+            next[element.first]++;
+        });
+        if (count == 0)
+        {
+            std::this_thread::yield();
+        }
+        popped += count;
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(errors, 0, "Elements out of order");
+    NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), true, "Elements left in the queue");
+    Element element;
+    NS_TEST_EXPECT_MSG_EQ(queue.Pop(element), false, "Pop from an empty queue");
+}
+
+/**
+ * \ingroup threaded-tests
+ *
+ * \brief Check that the events scheduled by each thread are executed
+ * in order, including when they overflow the lock-free queue of the
+ * DefaultSimulatorImpl.
+ */
+class ThreadedScheduleOrderTestCase : public TestCase
+{
+  public:
+    ThreadedScheduleOrderTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record the execution of an event.
+     *
+     * \param [in] thread The thread which scheduled the event.
+     * \param [in] sequence The sequence number of the event in the thread.
+     */
+    void Record(uint32_t thread, uint32_t sequence);
+
+    static constexpr uint32_t THREADS = 4; //!< Number of scheduling threads.
+    static constexpr uint32_t COUNT = 5000; //!< Events scheduled by each thread.
+
+    std::vector<uint32_t> m_next; //!< Next sequence number expected from each thread.
+    uint32_t m_errors;            //!< Number of events out of order.
+};
+
+ThreadedScheduleOrderTestCase::ThreadedScheduleOrderTestCase()
+    : TestCase("Check the order of the events scheduled by other threads"),
+      m_next(THREADS, 0),
+      m_errors(0)
+{
+}
+
+void
+ThreadedScheduleOrderTestCase::Record(uint32_t thread, uint32_t sequence)
+{
+    if (Simulator::GetContext() != thread || m_next[thread] != sequence)
+    {
+        m_errors++;
+    }
+    m_next[thread] = sequence + 1;
+}
+
+void
+ThreadedScheduleOrderTestCase::DoRun()
+{
+    // create the simulator in this thread, which becomes the main thread
+    Simulator::Now();
+
+    // all the events are queued before the simulation starts, more than
+    // the lock-free queue can hold
+    std::vector<std::thread> threads;
+    for (uint32_t thread = 0; thread < THREADS; ++thread)
+    {
+        threads.emplace_back([this, thread]() {
+            for (uint32_t i = 0; i < COUNT; ++i)
+            {
+                Simulator::ScheduleWithContext(thread,
+                                               Seconds(0),
+                                               &ThreadedScheduleOrderTestCase::Record,
+                                               this,
+                                               thread,
+                                               i);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_errors, 0, "Events executed out of order");
+    for (uint32_t thread = 0; thread < THREADS; ++thread)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_next[thread], COUNT, "Events lost from thread " << thread);
+    }
+}
+
 /**
  * \ingroup threaded-tests
  *
@@ -304,6 +467,8 @@ class ThreadedSimulatorTestSuite : public TestSuite
                 }
             }
         }
+        AddTestCase(new MpscQueueTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new ThreadedScheduleOrderTestCase(), TestCase::Duration::QUICK);
     }
 };
 
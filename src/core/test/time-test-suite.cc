@@ -13,11 +13,15 @@
 #include "ns3/test.h"
 
 #include <array>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <random>
 #include <sstream>
 #include <string>
 #include <tuple>
+#include <vector>
 
 using namespace ns3;
 
@@ -523,6 +527,212 @@ TimeInputOutputTestCase::DoRun()
     CheckAs(t * 1e+8, "+9.961925y");
 }
 
+/**
+ * \ingroup core-tests
+ * \brief Checks that the Time conversions between units give exactly the
+ * results of the int64x64_t operations, whichever arithmetic Time uses.
+ */
+class TimeConversionTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor for TimeConversionTestCase.
+     */
+    TimeConversionTestCase();
+
+  private:
+    /**
+     * \brief DoRun for TimeConversionTestCase.
+     */
+    void DoRun() override;
+
+    /**
+     * Get the number of nanoseconds in a unit, or of units in a nanosecond.
+     * \param [in] unit The unit.
+     * \return The factor, and whether the unit is at least a nanosecond.
+     */
+    static std::pair<int64_t, bool> GetFactor(Time::Unit unit);
+    /**
+     * Convert a value to nanoseconds with the int64x64_t operations.
+     * \param [in] value The value, in \pname{unit}.
+     * \param [in] unit The unit of \pname{value}.
+     * \return The rounded number of nanoseconds.
+     */
+    static int64_t FromReference(int64x64_t value, Time::Unit unit);
+    /**
+     * Convert nanoseconds to a unit with the int64x64_t operations.
+     * \param [in] ns The number of nanoseconds.
+     * \param [in] unit The unit to convert to.
+     * \return The value in \pname{unit}.
+     */
+    static double ToReference(int64_t ns, Time::Unit unit);
+};
+
+TimeConversionTestCase::TimeConversionTestCase()
+    : TestCase("Check the Time conversions against the int64x64_t operations")
+{
+}
+
+std::pair<int64_t, bool>
+TimeConversionTestCase::GetFactor(Time::Unit unit)
+{
+    constexpr std::array<int64_t, Time::LAST> factors{
+        365LL * 24 * 3600 * 1000000000, // Y
+        24LL * 3600 * 1000000000,       // D
+        3600LL * 1000000000,            // H
+        60LL * 1000000000,              // MIN
+        1000000000,                     // S
+        1000000,                        // MS
+        1000,                           // US
+        1,                              // NS
+        1000,                           // PS
+        1000000,                        // FS
+    };
+    return {factors[unit], unit <= Time::NS};
+}
+
+int64_t
+TimeConversionTestCase::FromReference(int64x64_t value, Time::Unit unit)
+{
+    auto [factor, coarser] = GetFactor(unit);
+    if (coarser)
+    {
+        value *= int64x64_t(factor);
+    }
+    else
+    {
+        value.MulByInvert(int64x64_t::Invert(factor));
+    }
+    return value.Round();
+}
+
+double
+TimeConversionTestCase::ToReference(int64_t ns, Time::Unit unit)
+{
+    auto [factor, coarser] = GetFactor(unit);
+    int64x64_t value(ns);
+    if (coarser && factor > 1)
+    {
+        value.MulByInvert(int64x64_t::Invert(factor));
+    }
+    else
+    {
+        value *= int64x64_t(factor);
+    }
+    return value.GetDouble();
+}
+
+void
+TimeConversionTestCase::DoRun()
+{
+    NS_TEST_ASSERT_MSG_EQ(Time::GetResolution(), Time::NS, "Unexpected resolution");
+
+    std::mt19937_64 rng(42);
+    const int64_t max = std::numeric_limits<int64_t>::max();
+
+    // Time to double
+    std::vector<int64_t> times{0,
+                               1,
+                               7,
+                               999,
+                               1000,
+                               999999999,
+                               1000000001,
+                               123456789012,
+                               (1LL << 53) + 1,
+                               1000000000000007,
+                               max / 2};
+    for (int i = 0; i < 2000; ++i)
+    {
+        times.push_back(static_cast<int64_t>(rng() >> (1 + rng() % 63)));
+    }
+    for (auto ns : times)
+    {
+        for (auto t : {ns, -ns})
+        {
+            for (int unit = Time::Y; unit < Time::LAST; ++unit)
+            {
+                auto [factor, coarser] = GetFactor(static_cast<Time::Unit>(unit));
+                if (!coarser && ns > max / factor)
+                {
+                    // out of the range of the int64x64_t operations
+                    continue;
+                }
+                NS_TEST_ASSERT_MSG_EQ(NanoSeconds(t).ToDouble(static_cast<Time::Unit>(unit)),
+                                      ToReference(t, static_cast<Time::Unit>(unit)),
+                                      "ToDouble() of " << t << "ns in unit " << unit);
+            }
+        }
+    }
+
+    // double to Time
+    std::vector<double> values{0, 0.5, 1.5, 2.5, 1e-10, 2.5e-9, 0.1, 1.0 / 3, 0.7, 1e6, 123.456};
+    std::uniform_real_distribution<double> uniform(0, 1);
+    for (int i = 0; i < 2000; ++i)
+    {
+        values.push_back(uniform(rng) * std::pow(10.0, static_cast<int>(rng() % 16) - 12));
+    }
+    for (auto value : values)
+    {
+        for (auto v : {value, -value})
+        {
+            for (int unit = Time::Y; unit < Time::LAST; ++unit)
+            {
+                auto [factor, coarser] = GetFactor(static_cast<Time::Unit>(unit));
+                if (coarser && std::abs(v) * factor > max / 2)
+                {
+                    continue;
+                }
+                NS_TEST_ASSERT_MSG_EQ(
+                    Time::FromDouble(v, static_cast<Time::Unit>(unit)).GetTimeStep(),
+                    FromReference(int64x64_t(v), static_cast<Time::Unit>(unit)),
+                    "FromDouble() of " << v << " in unit " << unit);
+            }
+        }
+    }
+
+    // ratio to Time, e.g., transmission times of packets
+    std::vector<uint64_t> denominators{1,
+                                       3,
+                                       7,
+                                       300,
+                                       9600,
+                                       56000,
+                                       1000000,
+                                       5000000,
+                                       54000000,
+                                       1000000000,
+                                       1000000007,
+                                       10000000000,
+                                       100000000000,
+                                       1000000000000};
+    for (int i = 0; i < 100; ++i)
+    {
+        denominators.push_back(1 + (rng() >> (24 + rng() % 40)));
+    }
+    for (auto denominator : denominators)
+    {
+        for (uint64_t numerator : {0U, 1U, 8U, 512U, 12000U, 524280U, 4294967295U})
+        {
+            for (auto unit : {Time::S, Time::MS, Time::NS, Time::PS})
+            {
+                NS_TEST_ASSERT_MSG_EQ(
+                    Time::FromRatio(numerator, denominator, unit).GetTimeStep(),
+                    FromReference(int64x64_t(numerator) / int64x64_t(denominator), unit),
+                    "FromRatio() of " << numerator << "/" << denominator << " in unit " << unit);
+            }
+        }
+        for (int i = 0; i < 20; ++i)
+        {
+            uint64_t numerator = rng() >> 32;
+            NS_TEST_ASSERT_MSG_EQ(
+                Time::FromRatio(numerator, denominator, Time::S).GetTimeStep(),
+                FromReference(int64x64_t(numerator) / int64x64_t(denominator), Time::S),
+                "FromRatio() of " << numerator << "/" << denominator);
+        }
+    }
+}
+
 /**
  * \ingroup core-tests
  * \brief   Time test Suite.  Runs the appropriate test cases for time
@@ -535,6 +745,7 @@ static class TimeTestSuite : public TestSuite
     {
         AddTestCase(new TimeWithSignTestCase(), TestCase::Duration::QUICK);
         AddTestCase(new TimeInputOutputTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new TimeConversionTestCase(), TestCase::Duration::QUICK);
         // This should be last, since it changes the resolution
         AddTestCase(new TimeSimpleTestCase(), TestCase::Duration::QUICK);
     }
@@ -122,6 +122,117 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * \ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check the chain as Callbacks are connected
+ * and disconnected, including while the chain is invoked.
+ */
+class ChainTracedCallbackTestCase : public TestCase
+{
+  public:
+    ChainTracedCallbackTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback adding its argument to m_sum.
+     * \param a The value to add.
+     */
+    void CbAdd(int a);
+    /**
+     * Callback adding its argument to m_sum, and connecting CbAdd to the
+     * traced callback m_trace.
+     * \param a The value to add.
+     */
+    void CbConnect(int a);
+    /**
+     * Callback adding its argument and the context length to m_sum.
+     * \param context The context.
+     * \param a The value to add.
+     */
+    void CbContext(std::string context, int a);
+
+    TracedCallback<int> m_trace; //!< The traced callback.
+    int m_sum;                   //!< Sum of the values received by the callbacks.
+};
+
+ChainTracedCallbackTestCase::ChainTracedCallbackTestCase()
+    : TestCase("Check the TracedCallback chain")
+{
+}
+
+void
+ChainTracedCallbackTestCase::CbAdd(int a)
+{
+    m_sum += a;
+}
+
+void
+ChainTracedCallbackTestCase::CbConnect(int a)
+{
+    m_sum += a;
+    m_trace.ConnectWithoutContext(MakeCallback(&ChainTracedCallbackTestCase::CbAdd, this));
+}
+
+void
+ChainTracedCallbackTestCase::CbContext(std::string context, int a)
+{
+    m_sum += a + static_cast<int>(context.size());
+}
+
+void
+ChainTracedCallbackTestCase::DoRun()
+{
+    auto add = MakeCallback(&ChainTracedCallbackTestCase::CbAdd, this);
+    auto context = MakeCallback(&ChainTracedCallbackTestCase::CbContext, this);
+
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "New traced callback not empty");
+    m_sum = 0;
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_sum, 0, "Empty traced callback invoked a callback");
+
+    // One, then three callbacks.
+    m_trace.ConnectWithoutContext(add);
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), false, "Traced callback empty");
+    m_sum = 0;
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_sum, 1, "Single callback not invoked once");
+    m_trace.Connect(context, "abc");
+    m_trace.ConnectWithoutContext(add);
+    m_sum = 0;
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_sum, 6, "Three callbacks not invoked once");
+
+    // Disconnecting removes every matching callback.
+    m_trace.DisconnectWithoutContext(add);
+    m_sum = 0;
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_sum, 4, "Callbacks not disconnected");
+    m_trace.Disconnect(context, "abc");
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "Traced callback not empty");
+    m_sum = 0;
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_sum, 0, "Disconnected callback invoked");
+
+    // A single callback connecting another one: it is invoked from the next
+    // invocation on.
+    m_trace.ConnectWithoutContext(MakeCallback(&ChainTracedCallbackTestCase::CbConnect, this));
+    m_sum = 0;
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_sum, 1, "Callback connected by the single callback invoked");
+    m_sum = 0;
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_sum, 3, "Callbacks connected during invocation not invoked");
+
+    // With several callbacks, a connected callback is invoked immediately.
+    m_trace.DisconnectWithoutContext(add);
+    m_sum = 0;
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_sum, 2, "Callback connected during invocation not invoked");
+}
+
 /**
  * \ingroup tracedcallback-tests
  *
@@ -137,6 +248,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", Type::UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new ChainTracedCallbackTestCase, TestCase::Duration::QUICK);
 }
 
 static TracedCallbackTestSuite
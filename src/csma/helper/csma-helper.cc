@@ -96,6 +96,29 @@ CsmaHelper::EnablePcapInternal(std::string prefix,
     }
 }
 
+Ptr<PcapNgFile>
+CsmaHelper::EnablePcapNg(std::string filename, NetDeviceContainer devices, bool promiscuous)
+{
+    PcapHelper pcapHelper;
+    Ptr<PcapNgFile> file = pcapHelper.CreatePcapNgFile(filename);
+    for (auto i = devices.Begin(); i != devices.End(); ++i)
+    {
+        Ptr<CsmaNetDevice> device = (*i)->GetObject<CsmaNetDevice>();
+        if (!device)
+        {
+            NS_LOG_INFO("CsmaHelper::EnablePcapNg(): Device "
+                        << *i << " not of type ns3::CsmaNetDevice");
+            continue;
+        }
+        pcapHelper.HookPcapNgSink<CsmaNetDevice>(device,
+                                                 promiscuous ? "PromiscSniffer" : "Sniffer",
+                                                 file,
+                                                 PcapHelper::DLT_EN10MB,
+                                                 pcapHelper.GetFilenameFromDevice("node", device));
+    }
+    return file;
+}
+
 void
 CsmaHelper::EnableAsciiInternal(Ptr<OutputStreamWrapper> stream,
                                 std::string prefix,
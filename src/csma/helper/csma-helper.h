@@ -199,6 +199,22 @@ class CsmaHelper : public PcapHelperForDevice, public AsciiTraceHelperForDevice
      */
     int64_t AssignStreams(NetDeviceContainer c, int64_t stream);
 
+    /**
+     * \brief Capture the packets of csma devices in a single pcapng file.
+     *
+     * Each device is an interface of the file, named after its node and
+     * device like the files of EnablePcap(), which writes a file per device.
+     * The PcapNgFile attributes select the buffering of the file.
+     *
+     * \param filename The name of the pcapng file.
+     * \param devices The devices whose packets are captured.
+     * \param promiscuous If true capture all possible packets available at the devices.
+     * \return The pcapng file.
+     */
+    Ptr<PcapNgFile> EnablePcapNg(std::string filename,
+                                 NetDeviceContainer devices,
+                                 bool promiscuous = false);
+
   private:
     /**
      * This method creates an ns3::CsmaNetDevice with the attributes configured by
@@ -32,6 +32,12 @@ ArpCache::GetTypeId()
     static TypeId tid = TypeId("ns3::ArpCache")
                             .SetParent<Object>()
                             .SetGroupName("Internet")
+                            .SetMemoryEstimator([](const ObjectBase* object) -> std::size_t {
+                                auto cache = static_cast<const ArpCache*>(object);
+                                return cache->m_arpCache.size() *
+                                       (sizeof(Cache::value_type) + 4 * sizeof(void*) +
+                                        sizeof(ArpCache::Entry));
+                            })
                             .AddAttribute("AliveTimeout",
                                           "When this timeout expires, "
                                           "the matching cache entry needs refreshing",
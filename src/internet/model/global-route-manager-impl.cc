@@ -18,14 +18,20 @@
 #include "ipv4.h"
 
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
+#include "ns3/simulation-context.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <queue>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -34,6 +40,31 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImpl");
 
+/**
+ * \relates GlobalRouteManagerImpl
+ * \anchor GlobalValueGlobalRoutingThreads
+ * \brief The number of threads computing the global routes.
+ */
+static GlobalValue g_globalRoutingThreads =
+    GlobalValue("GlobalRoutingThreads",
+                "The number of threads running the SPF calculations of the global routing, "
+                "0 for one per hardware thread",
+                UintegerValue(1),
+                MakeUintegerChecker<uint32_t>());
+
+/**
+ * \relates GlobalRouteManagerImpl
+ * \anchor GlobalValueGlobalRoutingIncremental
+ * \brief A global switch to reuse the SPF trees unaffected by the changes
+ * of the global routing database.
+ */
+static GlobalValue g_globalRoutingIncremental =
+    GlobalValue("GlobalRoutingIncremental",
+                "Keep the SPF tree of each router, to only recompute the trees affected "
+                "by the changes of the links when the global routes are recomputed",
+                BooleanValue(false),
+                MakeBooleanChecker());
+
 /**
  * \brief Stream insertion operator.
  *
@@ -458,9 +489,22 @@ GlobalRouteManagerLSDB::Insert(Ipv4Address addr, GlobalRoutingLSA* lsa)
     {
         m_extdatabase.push_back(lsa);
     }
-    else
+    else if (m_database.insert(LSDBPair_t(addr, lsa)).second)
     {
-        m_database.insert(LSDBPair_t(addr, lsa));
+        for (uint32_t i = 0; i < lsa->GetNLinkRecords(); i++)
+        {
+            GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(i);
+            if (lr->GetLinkType() != GlobalRoutingLinkRecord::TransitNetwork)
+            {
+                continue;
+            }
+            // keep the lowest address, as GetLSAByLinkData () walks the database in order
+            auto result = m_linkDataIndex.insert(std::make_pair(lr->GetLinkData(), addr));
+            if (!result.second && addr < result.first->second)
+            {
+                result.first->second = addr;
+            }
+        }
     }
 }
 
@@ -485,14 +529,8 @@ GlobalRouteManagerLSDB::GetLSA(Ipv4Address addr) const
     //
     // Look up an LSA by its address.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
-    {
-        if (i->first == addr)
-        {
-            return i->second;
-        }
-    }
-    return nullptr;
+    auto i = m_database.find(addr);
+    return i != m_database.end() ? i->second : nullptr;
 }
 
 GlobalRoutingLSA*
@@ -500,23 +538,24 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this << addr);
     //
-    // Look up an LSA by its address.
+    // Look up the first LSA with a TransitNetwork link record whose link data
+    // is the address.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_linkDataIndex.find(addr);
+    return i != m_linkDataIndex.end() ? GetLSA(i->second) : nullptr;
+}
+
+std::vector<GlobalRoutingLSA*>
+GlobalRouteManagerLSDB::GetLSAs() const
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<GlobalRoutingLSA*> lsas;
+    lsas.reserve(m_database.size());
+    for (const auto& [addr, lsa] : m_database)
     {
-        GlobalRoutingLSA* temp = i->second;
-        // Iterate among temp's Link Records
-        for (uint32_t j = 0; j < temp->GetNLinkRecords(); j++)
-        {
-            GlobalRoutingLinkRecord* lr = temp->GetLinkRecord(j);
-            if (lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork &&
-                lr->GetLinkData() == addr)
-            {
-                return temp;
-            }
-        }
+        lsas.push_back(lsa);
     }
-    return nullptr;
+    return lsas;
 }
 
 // ---------------------------------------------------------------------------
@@ -526,19 +565,38 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 // ---------------------------------------------------------------------------
 
 GlobalRouteManagerImpl::GlobalRouteManagerImpl()
-    : m_spfroot(nullptr)
+    : m_spfroot(nullptr),
+      m_manager(nullptr),
+      m_root(nullptr),
+      m_tree(nullptr),
+      m_previousLsdb(nullptr),
+      m_treesValid(false)
 {
     NS_LOG_FUNCTION(this);
     m_lsdb = new GlobalRouteManagerLSDB();
 }
 
+GlobalRouteManagerImpl::GlobalRouteManagerImpl(GlobalRouteManagerImpl* manager)
+    : m_spfroot(nullptr),
+      m_lsdb(manager->m_lsdb),
+      m_manager(manager),
+      m_root(nullptr),
+      m_tree(nullptr),
+      m_previousLsdb(nullptr),
+      m_treesValid(false)
+{
+    NS_LOG_FUNCTION(this << manager);
+}
+
 GlobalRouteManagerImpl::~GlobalRouteManagerImpl()
 {
     NS_LOG_FUNCTION(this);
-    if (m_lsdb)
+    // the LSDB of a worker is the one of its manager
+    if (m_lsdb && !m_manager)
     {
         delete m_lsdb;
     }
+    delete m_previousLsdb;
 }
 
 void
@@ -550,6 +608,10 @@ GlobalRouteManagerImpl::DebugUseLsdb(GlobalRouteManagerLSDB* lsdb)
         delete m_lsdb;
     }
     m_lsdb = lsdb;
+    delete m_previousLsdb;
+    m_previousLsdb = nullptr;
+    m_trees.clear();
+    m_treesValid = false;
 }
 
 void
@@ -580,10 +642,26 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes()
     }
     if (m_lsdb)
     {
-        NS_LOG_LOGIC("Deleting LSDB, creating new one");
-        delete m_lsdb;
+        BooleanValue incremental;
+        g_globalRoutingIncremental.GetValue(incremental);
+        delete m_previousLsdb;
+        m_previousLsdb = nullptr;
+        if (incremental.Get() && m_treesValid)
+        {
+            // The SPF trees were calculated from this LSDB: keep it to find
+            // the changes of the new one.
+            NS_LOG_LOGIC("Keeping LSDB, creating new one");
+            m_previousLsdb = m_lsdb;
+        }
+        else
+        {
+            NS_LOG_LOGIC("Deleting LSDB, creating new one");
+            delete m_lsdb;
+            m_trees.clear();
+        }
         m_lsdb = new GlobalRouteManagerLSDB();
     }
+    m_treesValid = false;
 }
 
 //
@@ -681,10 +759,12 @@ void
 GlobalRouteManagerImpl::InitializeRoutes()
 {
     NS_LOG_FUNCTION(this);
+    FindRouters();
     //
-    // Walk the list of nodes in the system.
+    // Walk the list of nodes in the system, looking for the roots of the SPF
+    // calculations.
     //
-    NS_LOG_INFO("About to start SPF calculation");
+    std::vector<Ipv4Address> roots;
     for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
     {
         Ptr<Node> node = *i;
@@ -707,10 +787,477 @@ GlobalRouteManagerImpl::InitializeRoutes()
         //
         if (rtr && rtr->GetNumLSAs())
         {
-            SPFCalculate(rtr->GetRouterId());
+            roots.push_back(rtr->GetRouterId());
+        }
+    }
+
+    BooleanValue incremental;
+    g_globalRoutingIncremental.GetValue(incremental);
+    if (incremental.Get())
+    {
+        //
+        // Keep the trees of the current roots only, and create their entries
+        // before the workers fill them.
+        //
+        std::map<Ipv4Address, SPFTree> trees;
+        for (const auto& root : roots)
+        {
+            auto tree = m_trees.find(root);
+            trees[root] = tree != m_trees.end() ? std::move(tree->second) : SPFTree();
+        }
+        m_trees.swap(trees);
+        FindLSDBChanges();
+    }
+
+    UintegerValue nThreads;
+    g_globalRoutingThreads.GetValue(nThreads);
+    std::size_t threads = nThreads.Get();
+    if (threads == 0)
+    {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, roots.size());
+
+    NS_LOG_INFO("About to start SPF calculation on " << threads << " threads");
+    if (threads <= 1)
+    {
+        for (const auto& root : roots)
+        {
+            CalculateRoutes(root);
+        }
+    }
+    else
+    {
+        //
+        // The SPF calculations only read the LSDB and write the routes of
+        // their root: each thread runs the calculations of the next root not
+        // taken yet, with a worker of its own for the state of the calculation.
+        //
+        std::atomic<std::size_t> next{0};
+        auto calculate = [&roots, &next](GlobalRouteManagerImpl* impl) {
+            for (std::size_t i = next++; i < roots.size(); i = next++)
+            {
+                impl->CalculateRoutes(roots[i]);
+            }
+        };
+        SimulationContext* context = SimulationContext::GetCurrent();
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < threads; i++)
+        {
+            workers.emplace_back([this, context, &calculate]() {
+                SimulationContext::SetCurrent(context);
+                GlobalRouteManagerImpl worker(this);
+                calculate(&worker);
+            });
+        }
+        calculate(this);
+        for (auto& worker : workers)
+        {
+            worker.join();
         }
     }
     NS_LOG_INFO("Finished SPF calculation");
+
+    delete m_previousLsdb;
+    m_previousLsdb = nullptr;
+    m_changes.clear();
+    m_treesValid = incremental.Get();
+}
+
+void
+GlobalRouteManagerImpl::FindRouters()
+{
+    NS_LOG_FUNCTION(this);
+    m_routers.clear();
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<Node> node = *i;
+        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        if (!rtr)
+        {
+            continue;
+        }
+        // the first node with a router ID is the one the routes are written to
+        m_routers.emplace(rtr->GetRouterId(),
+                          RouterInfo{node, node->GetObject<Ipv4>(), rtr->GetRoutingProtocol()});
+    }
+}
+
+const GlobalRouteManagerImpl::RouterInfo*
+GlobalRouteManagerImpl::GetRouter(Ipv4Address routerId) const
+{
+    NS_LOG_FUNCTION(this << routerId);
+    const auto& routers = (m_manager ? m_manager : this)->m_routers;
+    auto router = routers.find(routerId);
+    return router != routers.end() ? &router->second : nullptr;
+}
+
+void
+GlobalRouteManagerImpl::CalculateRoutes(Ipv4Address root)
+{
+    NS_LOG_FUNCTION(this << root);
+    GlobalRouteManagerImpl* manager = m_manager ? m_manager : this;
+    auto tree = manager->m_trees.find(root);
+    if (tree == manager->m_trees.end())
+    {
+        SPFCalculate(root);
+        return;
+    }
+    if (manager->m_previousLsdb && !tree->second.vertices.empty() &&
+        !IsSPFTreeAffected(tree->second))
+    {
+        NS_LOG_LOGIC("Reusing the SPF tree of " << root);
+        SPFReuse(tree->second);
+        return;
+    }
+    m_tree = &tree->second;
+    SPFCalculate(root);
+    m_tree = nullptr;
+}
+
+std::map<Ipv4Address,
+         std::pair<GlobalRoutingLSA*, std::vector<GlobalRouteManagerImpl::TransitLink>>>
+GlobalRouteManagerImpl::GetTransitLinks(const GlobalRouteManagerLSDB& lsdb)
+{
+    NS_LOG_FUNCTION(&lsdb);
+    std::map<Ipv4Address, std::pair<GlobalRoutingLSA*, std::vector<TransitLink>>> vertices;
+    for (GlobalRoutingLSA* lsa : lsdb.GetLSAs())
+    {
+        auto& [vertexLsa, links] = vertices[lsa->GetLinkStateId()];
+        vertexLsa = lsa;
+        //
+        // These are the links SPFNext () follows, in the same order.
+        //
+        if (lsa->GetLSType() == GlobalRoutingLSA::RouterLSA)
+        {
+            for (uint32_t i = 0; i < lsa->GetNLinkRecords(); i++)
+            {
+                GlobalRoutingLinkRecord* l = lsa->GetLinkRecord(i);
+                if (l->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint ||
+                    l->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork)
+                {
+                    links.push_back({l->GetLinkId(), l->GetLinkData(), l->GetMetric()});
+                }
+            }
+        }
+        else if (lsa->GetLSType() == GlobalRoutingLSA::NetworkLSA)
+        {
+            for (uint32_t i = 0; i < lsa->GetNAttachedRouters(); i++)
+            {
+                Ipv4Address router = lsa->GetAttachedRouter(i);
+                GlobalRoutingLSA* w_lsa = lsdb.GetLSAByLinkData(router);
+                if (w_lsa)
+                {
+                    links.push_back({w_lsa->GetLinkStateId(), router, 0});
+                }
+            }
+        }
+    }
+    return vertices;
+}
+
+void
+GlobalRouteManagerImpl::FindLSDBChanges()
+{
+    NS_LOG_FUNCTION(this);
+    m_changes.clear();
+    if (!m_previousLsdb)
+    {
+        return;
+    }
+    auto previous = GetTransitLinks(*m_previousLsdb);
+    auto current = GetTransitLinks(*m_lsdb);
+    for (const auto& [id, vertex] : previous)
+    {
+        if (current.find(id) == current.end())
+        {
+            m_changes[id].lsa = true;
+        }
+    }
+    for (const auto& [id, vertex] : current)
+    {
+        auto old = previous.find(id);
+        if (old == previous.end())
+        {
+            m_changes[id].lsa = true;
+            continue;
+        }
+        const auto& [oldLsa, oldLinks] = old->second;
+        const auto& [lsa, links] = vertex;
+        if (oldLsa->GetLSType() != lsa->GetLSType())
+        {
+            m_changes[id].lsa = true;
+            continue;
+        }
+        // the mask of a network is used by the routes to it
+        if (oldLinks == links && (lsa->GetLSType() != GlobalRoutingLSA::NetworkLSA ||
+                                  oldLsa->GetNetworkLSANetworkMask() ==
+                                      lsa->GetNetworkLSANetworkMask()))
+        {
+            continue;
+        }
+        VertexChanges& changes = m_changes[id];
+        std::vector<bool> kept(links.size(), false);
+        std::size_t last = 0;
+        for (const auto& link : oldLinks)
+        {
+            std::size_t j = 0;
+            while (j < links.size() && (kept[j] || !(links[j] == link)))
+            {
+                j++;
+            }
+            if (j == links.size())
+            {
+                changes.removed.push_back(link);
+                continue;
+            }
+            kept[j] = true;
+            // the links kept must be examined in the same order
+            changes.lsa = changes.lsa || j < last;
+            last = j;
+        }
+        for (std::size_t j = 0; j < links.size(); j++)
+        {
+            if (!kept[j])
+            {
+                changes.added.push_back(links[j]);
+            }
+        }
+    }
+    NS_LOG_LOGIC("The links of " << m_changes.size() << " vertices changed");
+}
+
+bool
+GlobalRouteManagerImpl::IsSPFTreeAffected(const SPFTree& tree) const
+{
+    NS_LOG_FUNCTION(this << tree.vertices.size());
+    const auto& changes = (m_manager ? m_manager : this)->m_changes;
+    if (changes.empty())
+    {
+        return false;
+    }
+    //
+    // The vertices are indexed in the order they joined the tree: the root
+    // first, and each vertex after its parents.
+    //
+    std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash> index;
+    for (uint32_t i = 0; i < tree.vertices.size(); i++)
+    {
+        index.emplace(tree.vertices[i].id, i);
+    }
+    auto hasRootParent = [&tree](uint32_t i) {
+        const SPFTree::Vertex& v = tree.vertices[i];
+        for (uint32_t j = v.parents; j < v.parents + v.nParents; j++)
+        {
+            if (tree.parents[j] == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for (const auto& [id, vertexChanges] : changes)
+    {
+        auto vertex = index.find(id);
+        if (vertex == index.end())
+        {
+            // the vertex was not reached: its links were not examined
+            continue;
+        }
+        uint32_t u = vertex->second;
+        const SPFTree::Vertex& v = tree.vertices[u];
+        if (vertexChanges.lsa || u == 0 || hasRootParent(u))
+        {
+            return true;
+        }
+        //
+        // The links of the root and of the first hops give the root exit
+        // directions, through SPFNexthopCalculation ().
+        //
+        for (uint32_t j = v.parents; j < v.parents + v.nParents; j++)
+        {
+            uint32_t parent = tree.parents[j];
+            if (tree.vertices[parent].network && hasRootParent(parent))
+            {
+                return true;
+            }
+        }
+        //
+        // SPFNext () ignores a link from the vertex if its destination was
+        // already in the tree, or already a candidate at a shorter distance.
+        // The first parent to join the tree gave its distance to a vertex.
+        //
+        for (const auto* links : {&vertexChanges.removed, &vertexChanges.added})
+        {
+            for (const auto& link : *links)
+            {
+                auto destination = index.find(link.to);
+                if (destination == index.end())
+                {
+                    return true;
+                }
+                uint32_t w = destination->second;
+                if (w <= u)
+                {
+                    continue;
+                }
+                const SPFTree::Vertex& wv = tree.vertices[w];
+                uint32_t firstParent = w;
+                for (uint32_t j = wv.parents; j < wv.parents + wv.nParents; j++)
+                {
+                    firstParent = std::min(firstParent, tree.parents[j]);
+                }
+                if (firstParent >= u || v.distance + link.metric <= wv.distance)
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void
+GlobalRouteManagerImpl::SPFReuse(const SPFTree& tree)
+{
+    NS_LOG_FUNCTION(this << tree.vertices.size());
+    //
+    // The SPF calculation would build the same tree, in the same order: add
+    // its vertices again, with the LSAs of the current LSDB.
+    //
+    m_root = GetRouter(tree.vertices[0].id);
+    std::vector<SPFVertex*> vertices;
+    vertices.reserve(tree.vertices.size());
+    for (const auto& vertex : tree.vertices)
+    {
+        GlobalRoutingLSA* lsa = m_lsdb->GetLSA(vertex.id);
+        NS_ASSERT(lsa);
+        auto v = new SPFVertex(lsa);
+        v->SetDistanceFromRoot(vertex.distance);
+        for (uint32_t i = 0; i < vertex.nExits; i++)
+        {
+            SPFVertex::NodeExit_t exit = tree.exits[vertex.exits + i];
+            if (i == 0)
+            {
+                v->SetRootExitDirection(exit);
+                continue;
+            }
+            SPFVertex other;
+            other.SetRootExitDirection(exit);
+            v->MergeRootExitDirections(&other);
+        }
+        for (uint32_t i = 0; i < vertex.nParents; i++)
+        {
+            SPFVertex* parent = vertices[tree.parents[vertex.parents + i]];
+            if (i == 0)
+            {
+                v->SetParent(parent);
+                continue;
+            }
+            SPFVertex other;
+            other.SetParent(parent);
+            v->MergeParent(&other);
+        }
+        vertices.push_back(v);
+        if (vertices.size() == 1)
+        {
+            m_spfroot = v;
+            continue;
+        }
+        SPFVertexAddParent(v);
+        if (v->GetVertexType() == SPFVertex::VertexRouter)
+        {
+            SPFIntraAddRouter(v);
+        }
+        else
+        {
+            SPFIntraAddTransit(v);
+        }
+    }
+    SPFSecondStage();
+}
+
+void
+GlobalRouteManagerImpl::SPFKeepTree(const std::vector<SPFVertex*>& vertices)
+{
+    NS_LOG_FUNCTION(this << vertices.size());
+    NS_ASSERT(m_tree);
+    SPFTree& tree = *m_tree;
+    tree = SPFTree();
+    tree.vertices.reserve(vertices.size());
+    std::unordered_map<const SPFVertex*, uint32_t> index;
+    for (const SPFVertex* v : vertices)
+    {
+        SPFTree::Vertex vertex;
+        vertex.id = v->GetVertexId();
+        vertex.network = v->GetVertexType() == SPFVertex::VertexNetwork;
+        vertex.distance = v->GetDistanceFromRoot();
+        vertex.parents = tree.parents.size();
+        vertex.nParents = 0;
+        for (SPFVertex* parent = v->GetParent(0); parent != nullptr;
+             parent = v->GetParent(++vertex.nParents))
+        {
+            tree.parents.push_back(index.at(parent));
+        }
+        vertex.exits = tree.exits.size();
+        vertex.nExits = v->GetNRootExitDirections();
+        for (uint32_t i = 0; i < vertex.nExits; i++)
+        {
+            tree.exits.push_back(v->GetRootExitDirection(i));
+        }
+        // most vertices have the exit directions of their first parent
+        if (vertex.nParents > 0)
+        {
+            const SPFTree::Vertex& parent = tree.vertices[tree.parents[vertex.parents]];
+            if (parent.nExits == vertex.nExits &&
+                std::equal(tree.exits.begin() + vertex.exits,
+                           tree.exits.end(),
+                           tree.exits.begin() + parent.exits))
+            {
+                tree.exits.resize(vertex.exits);
+                vertex.exits = parent.exits;
+            }
+        }
+        index.emplace(v, tree.vertices.size());
+        tree.vertices.push_back(vertex);
+    }
+}
+
+void
+GlobalRouteManagerImpl::SPFSecondStage()
+{
+    NS_LOG_FUNCTION(this);
+    SPFProcessStubs(m_spfroot);
+    for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs(); i++)
+    {
+        m_spfroot->ClearVertexProcessed();
+        GlobalRoutingLSA* extlsa = m_lsdb->GetExtLSA(i);
+        NS_LOG_LOGIC("Processing External LSA with id " << extlsa->GetLinkStateId());
+        ProcessASExternals(m_spfroot, extlsa);
+    }
+
+    //
+    // We're all done setting the routing information for the node at the root of
+    // the SPF tree.  Delete all of the vertices and corresponding resources.  Go
+    // possibly do it again for the next router.
+    //
+    delete m_spfroot;
+    m_spfroot = nullptr;
+}
+
+GlobalRoutingLSA::SPFStatus
+GlobalRouteManagerImpl::GetLSAStatus(const GlobalRoutingLSA* lsa) const
+{
+    auto status = m_lsaStatus.find(lsa);
+    return status != m_lsaStatus.end() ? status->second : GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED;
+}
+
+void
+GlobalRouteManagerImpl::SetLSAStatus(const GlobalRoutingLSA* lsa,
+                                     GlobalRoutingLSA::SPFStatus status)
+{
+    m_lsaStatus[lsa] = status;
 }
 
 //
@@ -816,7 +1363,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         // If the link is to a router that is already in the shortest path first tree
         // then we have it covered -- ignore it.
         //
-        if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
+        if (GetLSAStatus(w_lsa) == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
         {
             NS_LOG_LOGIC("Skipping ->  LSA " << w_lsa->GetLinkStateId() << " already in SPF tree");
             continue;
@@ -840,7 +1387,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         NS_LOG_LOGIC("Considering w_lsa " << w_lsa->GetLinkStateId());
 
         // Is there already vertex w in candidate list?
-        if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
+        if (GetLSAStatus(w_lsa) == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
         {
             // Calculate nexthop to w
             // We need to figure out how to actually get to the new router represented
@@ -852,7 +1399,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
             w = new SPFVertex(w_lsa);
             if (SPFNexthopCalculation(v, w, l, distance))
             {
-                w_lsa->SetStatus(GlobalRoutingLSA::LSA_SPF_CANDIDATE);
+                SetLSAStatus(w_lsa, GlobalRoutingLSA::LSA_SPF_CANDIDATE);
                 //
                 // Push this new vertex onto the priority queue (ordered by distance from the
                 // root node).
@@ -869,7 +1416,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
                                   << "return false, but it does now!");
             }
         }
-        else if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
+        else if (GetLSAStatus(w_lsa) == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
         {
             //
             // We have already considered the link represented by <w>.  What wse have to
@@ -1223,6 +1770,7 @@ void
 GlobalRouteManagerImpl::DebugSPFCalculate(Ipv4Address root)
 {
     NS_LOG_FUNCTION(this << root);
+    FindRouters();
     SPFCalculate(root);
 }
 
@@ -1292,11 +1840,8 @@ GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
                 if (lr->GetLinkId() == myRouterId)
                 {
                     // Next hop is stored in the LinkID field of lr
-                    Ptr<GlobalRouter> router = rlsa->GetNode()->GetObject<GlobalRouter>();
-                    NS_ASSERT(router);
-                    Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-                    NS_ASSERT(gr);
-                    gr->AddNetworkRouteTo(Ipv4Address("0.0.0.0"),
+                    NS_ASSERT(m_root && m_root->routing);
+                    m_root->routing->AddNetworkRouteTo(Ipv4Address("0.0.0.0"),
                                           Ipv4Mask("0.0.0.0"),
                                           lr->GetLinkData(),
                                           FindOutgoingInterfaceId(transitLink->GetLinkData()));
@@ -1320,9 +1865,11 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
 
     SPFVertex* v;
     //
-    // Initialize the Link State Database.
+    // Initialize the status of the Link State Advertisements, and find the
+    // router the routes are written to.
     //
-    m_lsdb->Initialize();
+    m_lsaStatus.clear();
+    m_root = GetRouter(root);
     //
     // The candidate queue is a priority queue of SPFVertex objects, with the top
     // of the queue being the closest vertex in terms of distance from the root
@@ -1342,7 +1889,7 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     //
     m_spfroot = v;
     v->SetDistanceFromRoot(0);
-    v->GetLSA()->SetStatus(GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+    SetLSAStatus(v->GetLSA(), GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
     NS_LOG_LOGIC("Starting SPFCalculate for node " << root);
 
     //
@@ -1352,13 +1899,27 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     // reached.  Instead, short-circuit this computation and just install
     // a default route in the CheckForStubNode() method.
     //
-    if (NodeList::GetNNodes() > 0 && CheckForStubNode(root))
+    if (m_root && CheckForStubNode(root))
     {
         NS_LOG_LOGIC("SPFCalculate truncated for stub node " << root);
         delete m_spfroot;
+        m_spfroot = nullptr;
+        if (m_tree)
+        {
+            *m_tree = SPFTree();
+        }
         return;
     }
 
+    //
+    // The vertices in the order they join the tree, to keep the tree.
+    //
+    std::vector<SPFVertex*> vertices;
+    if (m_tree)
+    {
+        vertices.push_back(v);
+    }
+
     for (;;)
     {
         //
@@ -1403,7 +1964,11 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
         // Update the status field of the vertex to indicate that it is in the SPF
         // tree.
         //
-        v->GetLSA()->SetStatus(GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+        SetLSAStatus(v->GetLSA(), GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+        if (m_tree)
+        {
+            vertices.push_back(v);
+        }
         //
         // The current vertex has a parent pointer.  By calling this rather oddly
         // named method (blame quagga) we add the current vertex to the list of
@@ -1460,23 +2025,13 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
 
     } // end for loop
 
-    // Second stage of SPF calculation procedure
-    SPFProcessStubs(m_spfroot);
-    for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs(); i++)
+    if (m_tree)
     {
-        m_spfroot->ClearVertexProcessed();
-        GlobalRoutingLSA* extlsa = m_lsdb->GetExtLSA(i);
-        NS_LOG_LOGIC("Processing External LSA with id " << extlsa->GetLinkStateId());
-        ProcessASExternals(m_spfroot, extlsa);
+        SPFKeepTree(vertices);
     }
 
-    //
-    // We're all done setting the routing information for the node at the root of
-    // the SPF tree.  Delete all of the vertices and corresponding resources.  Go
-    // possibly do it again for the next router.
-    //
-    delete m_spfroot;
-    m_spfroot = nullptr;
+    // Second stage of SPF calculation procedure
+    SPFSecondStage();
 }
 
 void
@@ -1529,107 +2084,55 @@ GlobalRouteManagerImpl::SPFAddASExternal(GlobalRoutingLSA* extlsa, SPFVertex* v)
     NS_LOG_LOGIC("External is on remote host: " << extlsa->GetAdvertisingRouter()
                                                 << "; installing");
 
-    Ipv4Address routerId = m_spfroot->GetVertexId();
-
-    NS_LOG_LOGIC("Vertex ID = " << routerId);
+    NS_LOG_LOGIC("Vertex ID = " << m_spfroot->GetVertexId());
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // The router with the router ID of the root vertex is the one we're going
+    // to write the routing information to.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    if (!m_root)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to QI for that interface.  If there's no GlobalRouter interface, the node
-        // in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-
-        if (!rtr)
+        NS_LOG_LOGIC("No router with ID " << m_spfroot->GetVertexId());
+        return;
+    }
+    NS_LOG_LOGIC("Setting routes for node " << m_root->node->GetId());
+    //
+    // Routing information is updated using the Ipv4 interface.  If the node is
+    // acting as an IP version 4 router, it should absolutely have an Ipv4 interface.
+    //
+    NS_ASSERT_MSG(m_root->ipv4,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "QI for <Ipv4> interface failed");
+    NS_ASSERT_MSG(v->GetLSA(),
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask();
+    Ipv4Address tempip = extlsa->GetLinkStateId();
+    tempip = tempip.CombineMask(tempmask);
+
+    const Ptr<Ipv4GlobalRouting>& gr = m_root->routing;
+    NS_ASSERT(gr);
+    // walk through all next-hop-IPs and out-going-interfaces for reaching
+    // the stub network gateway 'v' from the root node
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+    {
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            gr->AddASExternalRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Node " << m_root->node->GetId()
+                                   << " add external network route to " << tempip
+                                   << " using next hop " << nextHop << " via interface " << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to QI
-            // for that interface.  If the node is acting as an IP version 4 router, it
-            // should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "QI for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            NS_ASSERT_MSG(v->GetLSA(),
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask();
-            Ipv4Address tempip = extlsa->GetLinkStateId();
-            tempip = tempip.CombineMask(tempmask);
-
-            //
-            // Here's why we did all of that work.  We're going to add a host route to the
-            // host address found in the m_linkData field of the point-to-point link
-            // record.  In the case of a point-to-point link, this is the local IP address
-            // of the node connected to the link.  Each of these point-to-point links
-            // will correspond to a local interface that has an IP address to which
-            // the node at the root of the SPF tree can send packets.  The vertex <v>
-            // (corresponding to the node that has these links and interfaces) has
-            // an m_nextHop address precalculated for us that is the address to which the
-            // root node should send packets to be forwarded to these IP addresses.
-            // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-            // which the packets should be send for forwarding.
-            //
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all next-hop-IPs and out-going-interfaces for reaching
-            // the stub network gateway 'v' from the root node
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-                if (outIf >= 0)
-                {
-                    gr->AddASExternalRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add external network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative");
-                }
-            }
-            return;
-        } // if
-    }     // for
+            NS_LOG_LOGIC("(Route " << i << ") Node " << m_root->node->GetId()
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative");
+        }
+    }
 }
 
 // Processing logic from RFC 2328, page 166 and quagga ospf_spf_process_stubs ()
@@ -1686,114 +2189,61 @@ GlobalRouteManagerImpl::SPFIntraAddStub(GlobalRoutingLinkRecord* l, SPFVertex* v
         return;
     }
     NS_LOG_LOGIC("Stub is on remote host: " << v->GetVertexId() << "; installing");
+
+    NS_LOG_LOGIC("Vertex ID = " << m_spfroot->GetVertexId());
     //
     // The root of the Shortest Path First tree is the router to which we are
-    // going to write the actual routing table entries.  The vertex corresponding
-    // to this router has a vertex ID which is the router ID of that node.  We're
-    // going to use this ID to discover which node it is that we're actually going
-    // to update.
+    // going to write the actual routing table entries: the router with the
+    // router ID of the root vertex.
     //
-    Ipv4Address routerId = m_spfroot->GetVertexId();
-
-    NS_LOG_LOGIC("Vertex ID = " << routerId);
+    if (!m_root)
+    {
+        NS_LOG_LOGIC("No router with ID " << m_spfroot->GetVertexId());
+        return;
+    }
+    NS_LOG_LOGIC("Setting routes for node " << m_root->node->GetId());
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // Routing information is updated using the Ipv4 interface.  If the node is
+    // acting as an IP version 4 router, it should absolutely have an Ipv4 interface.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    NS_ASSERT_MSG(m_root->ipv4,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "QI for <Ipv4> interface failed");
+    NS_ASSERT_MSG(v->GetLSA(),
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask(l->GetLinkData().Get());
+    Ipv4Address tempip = l->GetLinkId();
+    tempip = tempip.CombineMask(tempmask);
+    //
+    // The vertex <v> has the exit directions precalculated for us: the next hop
+    // addresses to which the root node should send packets to be forwarded to
+    // the stub network, and the outbound interfaces to send them through.
+    //
+    const Ptr<Ipv4GlobalRouting>& gr = m_root->routing;
+    NS_ASSERT(gr);
+    // walk through all next-hop-IPs and out-going-interfaces for reaching
+    // the stub network gateway 'v' from the root node
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to QI for that interface.  If there's no GlobalRouter interface, the node
-        // in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-
-        if (!rtr)
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Node " << m_root->node->GetId()
+                                   << " add network route to " << tempip << " using next hop "
+                                   << nextHop << " via interface " << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to QI
-            // for that interface.  If the node is acting as an IP version 4 router, it
-            // should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "QI for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            NS_ASSERT_MSG(v->GetLSA(),
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask(l->GetLinkData().Get());
-            Ipv4Address tempip = l->GetLinkId();
-            tempip = tempip.CombineMask(tempmask);
-            //
-            // Here's why we did all of that work.  We're going to add a host route to the
-            // host address found in the m_linkData field of the point-to-point link
-            // record.  In the case of a point-to-point link, this is the local IP address
-            // of the node connected to the link.  Each of these point-to-point links
-            // will correspond to a local interface that has an IP address to which
-            // the node at the root of the SPF tree can send packets.  The vertex <v>
-            // (corresponding to the node that has these links and interfaces) has
-            // an m_nextHop address precalculated for us that is the address to which the
-            // root node should send packets to be forwarded to these IP addresses.
-            // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-            // which the packets should be send for forwarding.
-            //
-
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all next-hop-IPs and out-going-interfaces for reaching
-            // the stub network gateway 'v' from the root node
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-                if (outIf >= 0)
-                {
-                    gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative");
-                }
-            }
-            return;
-        } // if
-    }     // for
+            NS_LOG_LOGIC("(Route " << i << ") Node " << m_root->node->GetId()
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative");
+        }
+    }
 }
 
 //
@@ -1808,67 +2258,32 @@ GlobalRouteManagerImpl::FindOutgoingInterfaceId(Ipv4Address a, Ipv4Mask amask)
 {
     NS_LOG_FUNCTION(this << a << amask);
     //
-    // We have an IP address <a> and a vertex ID of the root of the SPF tree.
-    // The question is what interface index does this address correspond to.
-    // The answer is a little complicated since we have to find a pointer to
-    // the node corresponding to the vertex ID, find the Ipv4 interface on that
-    // node in order to iterate the interfaces and find the one corresponding to
-    // the address in question.
-    //
-    Ipv4Address routerId = m_spfroot->GetVertexId();
+    // We have an IP address <a> and the router at the root of the SPF tree,
+    // the node for which we are building the routing table.  The question is
+    // what interface index does this address correspond to.
     //
-    // Walk the list of nodes in the system looking for the one corresponding to
-    // the node at the root of the SPF tree.  This is the node for which we are
-    // building the routing table.
-    //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    if (!m_root)
     {
-        Ptr<Node> node = *i;
-
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
         //
-        // If the node doesn't have a GlobalRouter interface it can't be the one
-        // we're interested in.
+        // Couldn't find it.
         //
-        if (!rtr)
-        {
-            continue;
-        }
-
-        if (rtr->GetRouterId() == routerId)
-        {
-            //
-            // This is the node we're building the routing table for.  We're going to need
-            // the Ipv4 interface to look for the ipv4 interface index.  Since this node
-            // is participating in routing IP version 4 packets, it certainly must have
-            // an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Look through the interfaces on this node for one that has the IP address
-            // we're looking for.  If we find one, return the corresponding interface
-            // index, or -1 if not found.
-            //
-            int32_t interface = ipv4->GetInterfaceForPrefix(a, amask);
-
-#if 0
-          if (interface < 0)
-            {
-              NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
-                              "Expected an interface associated with address a:" << a);
-            }
-#endif
-            return interface;
-        }
+        NS_LOG_LOGIC("FindOutgoingInterfaceId():Can't find root node "
+                     << m_spfroot->GetVertexId());
+        return -1;
     }
     //
-    // Couldn't find it.
+    // Since this node is participating in routing IP version 4 packets, it
+    // certainly must have an Ipv4 interface.
+    //
+    NS_ASSERT_MSG(m_root->ipv4,
+                  "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
+                  "GetObject for <Ipv4> interface failed");
+    //
+    // Look through the interfaces on this node for one that has the IP address
+    // we're looking for.  If we find one, return the corresponding interface
+    // index, or -1 if not found.
     //
-    NS_LOG_LOGIC("FindOutgoingInterfaceId():Can't find root node " << routerId);
-    return -1;
+    return m_root->ipv4->GetInterfaceForPrefix(a, amask);
 }
 
 //
@@ -1893,139 +2308,97 @@ GlobalRouteManagerImpl::SPFIntraAddRouter(SPFVertex* v)
     NS_LOG_FUNCTION(this << v);
 
     NS_ASSERT_MSG(m_spfroot, "GlobalRouteManagerImpl::SPFIntraAddRouter (): Root pointer not set");
+    NS_LOG_LOGIC("Vertex ID = " << m_spfroot->GetVertexId());
     //
     // The root of the Shortest Path First tree is the router to which we are
-    // going to write the actual routing table entries.  The vertex corresponding
-    // to this router has a vertex ID which is the router ID of that node.  We're
-    // going to use this ID to discover which node it is that we're actually going
-    // to update.
+    // going to write the actual routing table entries: the router with the
+    // router ID of the root vertex.
     //
-    Ipv4Address routerId = m_spfroot->GetVertexId();
+    if (!m_root)
+    {
+        NS_LOG_LOGIC("No router with ID " << m_spfroot->GetVertexId());
+        return;
+    }
+    NS_LOG_LOGIC("Setting routes for node " << m_root->node->GetId());
+    //
+    // Routing information is updated using the Ipv4 interface.  If the node is
+    // acting as an IP version 4 router, it should absolutely have an Ipv4 interface.
+    //
+    NS_ASSERT_MSG(m_root->ipv4,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "GetObject for <Ipv4> interface failed");
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
+    //
+    GlobalRoutingLSA* lsa = v->GetLSA();
+    NS_ASSERT_MSG(lsa,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
 
-    NS_LOG_LOGIC("Vertex ID = " << routerId);
+    uint32_t nLinkRecords = lsa->GetNLinkRecords();
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // Iterate through the link records on the vertex to which we're going to add
+    // routes.  To make sure we're being clear, we're going to add routing table
+    // entries to the tables on the node corresponding to the root of the SPF tree.
+    // These entries will have routes to the IP addresses we find from looking at
+    // the local side of the point-to-point links found on the node described by
+    // the vertex <v>.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    NS_LOG_LOGIC(" Node " << m_root->node->GetId() << " found " << nLinkRecords
+                          << " link records in LSA " << lsa << "with LinkStateId "
+                          << lsa->GetLinkStateId());
+    const Ptr<Ipv4GlobalRouting>& gr = m_root->routing;
+    NS_ASSERT(gr);
+    for (uint32_t j = 0; j < nLinkRecords; ++j)
     {
-        Ptr<Node> node = *i;
         //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to GetObject for that interface.  If there's no GlobalRouter interface,
-        // the node in question cannot be the router we want, so we continue.
+        // We are only concerned about point-to-point links
         //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-
-        if (!rtr)
+        GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+        if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
             continue;
         }
         //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
+        // Here's why we did all of that work.  We're going to add a host route to the
+        // host address found in the m_linkData field of the point-to-point link
+        // record.  In the case of a point-to-point link, this is the local IP address
+        // of the node connected to the link.  Each of these point-to-point links
+        // will correspond to a local interface that has an IP address to which
+        // the node at the root of the SPF tree can send packets.  The vertex <v>
+        // (corresponding to the node that has these links and interfaces) has
+        // an m_nextHop address precalculated for us that is the address to which the
+        // root node should send packets to be forwarded to these IP addresses.
+        // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
+        // which the packets should be send for forwarding.
         //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        // walk through all available exit directions due to ECMP,
+        // and add host route for each of the exit direction toward
+        // the vertex 'v'
+        for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to
-            // GetObject for that interface.  If the node is acting as an IP version 4
-            // router, it should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            GlobalRoutingLSA* lsa = v->GetLSA();
-            NS_ASSERT_MSG(lsa,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-
-            uint32_t nLinkRecords = lsa->GetNLinkRecords();
-            //
-            // Iterate through the link records on the vertex to which we're going to add
-            // routes.  To make sure we're being clear, we're going to add routing table
-            // entries to the tables on the node corresponding to the root of the SPF tree.
-            // These entries will have routes to the IP addresses we find from looking at
-            // the local side of the point-to-point links found on the node described by
-            // the vertex <v>.
-            //
-            NS_LOG_LOGIC(" Node " << node->GetId() << " found " << nLinkRecords
-                                  << " link records in LSA " << lsa << "with LinkStateId "
-                                  << lsa->GetLinkStateId());
-            for (uint32_t j = 0; j < nLinkRecords; ++j)
+            SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+            Ipv4Address nextHop = exit.first;
+            int32_t outIf = exit.second;
+            if (outIf >= 0)
             {
-                //
-                // We are only concerned about point-to-point links
-                //
-                GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
-                if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
-                {
-                    continue;
-                }
-                //
-                // Here's why we did all of that work.  We're going to add a host route to the
-                // host address found in the m_linkData field of the point-to-point link
-                // record.  In the case of a point-to-point link, this is the local IP address
-                // of the node connected to the link.  Each of these point-to-point links
-                // will correspond to a local interface that has an IP address to which
-                // the node at the root of the SPF tree can send packets.  The vertex <v>
-                // (corresponding to the node that has these links and interfaces) has
-                // an m_nextHop address precalculated for us that is the address to which the
-                // root node should send packets to be forwarded to these IP addresses.
-                // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-                // which the packets should be send for forwarding.
-                //
-                Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-                if (!router)
-                {
-                    continue;
-                }
-                Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-                NS_ASSERT(gr);
-                // walk through all available exit directions due to ECMP,
-                // and add host route for each of the exit direction toward
-                // the vertex 'v'
-                for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-                {
-                    SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                    Ipv4Address nextHop = exit.first;
-                    int32_t outIf = exit.second;
-                    if (outIf >= 0)
-                    {
-                        gr->AddHostRouteTo(lr->GetLinkData(), nextHop, outIf);
-                        NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                               << " adding host route to " << lr->GetLinkData()
-                                               << " using next hop " << nextHop
-                                               << " and outgoing interface " << outIf);
-                    }
-                    else
-                    {
-                        NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                               << " NOT able to add host route to "
-                                               << lr->GetLinkData() << " using next hop " << nextHop
-                                               << " since outgoing interface id is negative "
-                                               << outIf);
-                    }
-                } // for all routes from the root the vertex 'v'
+                gr->AddHostRouteTo(lr->GetLinkData(), nextHop, outIf);
+                NS_LOG_LOGIC("(Route " << i << ") Node " << m_root->node->GetId()
+                                       << " adding host route to " << lr->GetLinkData()
+                                       << " using next hop " << nextHop
+                                       << " and outgoing interface " << outIf);
             }
-            //
-            // Done adding the routes for the selected node.
-            //
-            return;
-        }
+            else
+            {
+                NS_LOG_LOGIC("(Route " << i << ") Node " << m_root->node->GetId()
+                                       << " NOT able to add host route to " << lr->GetLinkData()
+                                       << " using next hop " << nextHop
+                                       << " since outgoing interface id is negative " << outIf);
+            }
+        } // for all routes from the root the vertex 'v'
     }
 }
 
@@ -2035,100 +2408,60 @@ GlobalRouteManagerImpl::SPFIntraAddTransit(SPFVertex* v)
     NS_LOG_FUNCTION(this << v);
 
     NS_ASSERT_MSG(m_spfroot, "GlobalRouteManagerImpl::SPFIntraAddTransit (): Root pointer not set");
+    NS_LOG_LOGIC("Vertex ID = " << m_spfroot->GetVertexId());
     //
     // The root of the Shortest Path First tree is the router to which we are
-    // going to write the actual routing table entries.  The vertex corresponding
-    // to this router has a vertex ID which is the router ID of that node.  We're
-    // going to use this ID to discover which node it is that we're actually going
-    // to update.
+    // going to write the actual routing table entries: the router with the
+    // router ID of the root vertex.
     //
-    Ipv4Address routerId = m_spfroot->GetVertexId();
-
-    NS_LOG_LOGIC("Vertex ID = " << routerId);
+    if (!m_root)
+    {
+        NS_LOG_LOGIC("No router with ID " << m_spfroot->GetVertexId());
+        return;
+    }
+    NS_LOG_LOGIC("setting routes for node " << m_root->node->GetId());
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // Routing information is updated using the Ipv4 interface.  If the node is
+    // acting as an IP version 4 router, it should absolutely have an Ipv4 interface.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    NS_ASSERT_MSG(m_root->ipv4,
+                  "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                  "GetObject for <Ipv4> interface failed");
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to: the network LSA of a transit network.
+    //
+    GlobalRoutingLSA* lsa = v->GetLSA();
+    NS_ASSERT_MSG(lsa,
+                  "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask();
+    Ipv4Address tempip = lsa->GetLinkStateId();
+    tempip = tempip.CombineMask(tempmask);
+    const Ptr<Ipv4GlobalRouting>& gr = m_root->routing;
+    NS_ASSERT(gr);
+    // walk through all available exit directions due to ECMP,
+    // and add host route for each of the exit direction toward
+    // the vertex 'v'
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to GetObject for that interface.  If there's no GlobalRouter interface,
-        // the node in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
 
-        if (!rtr)
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Node " << m_root->node->GetId()
+                                   << " add network route to " << tempip << " using next hop "
+                                   << nextHop << " via interface " << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to
-            // GetObject for that interface.  If the node is acting as an IP version 4
-            // router, it should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            GlobalRoutingLSA* lsa = v->GetLSA();
-            NS_ASSERT_MSG(lsa,
-                          "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask();
-            Ipv4Address tempip = lsa->GetLinkStateId();
-            tempip = tempip.CombineMask(tempmask);
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all available exit directions due to ECMP,
-            // and add host route for each of the exit direction toward
-            // the vertex 'v'
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-
-                if (outIf >= 0)
-                {
-                    gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative " << outIf);
-                }
-            }
+            NS_LOG_LOGIC("(Route " << i << ") Node " << m_root->node->GetId()
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative " << outIf);
         }
     }
 }
@@ -20,6 +20,7 @@
 #include <map>
 #include <queue>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -28,7 +29,9 @@ namespace ns3
 const uint32_t SPF_INFINITY = 0xffffffff; //!< "infinite" distance between nodes
 
 class CandidateQueue;
+class Ipv4;
 class Ipv4GlobalRouting;
+class Node;
 
 /**
  * \ingroup globalrouting
@@ -632,9 +635,10 @@ class GlobalRouteManagerLSDB
      * @brief Set all LSA flags to an initialized state, for SPF computation
      *
      * This function walks the database and resets the status flags of all of the
-     * contained Link State Advertisements to LSA_SPF_NOT_EXPLORED.  This is done
-     * prior to each SPF calculation to reset the state of the SPFVertex structures
-     * that will reference the LSAs during the calculation.
+     * contained Link State Advertisements to LSA_SPF_NOT_EXPLORED.  The SPF
+     * calculations of GlobalRouteManagerImpl do not use these flags: they keep
+     * the status of the LSAs themselves, so that several calculations can share
+     * the database.
      *
      * @see GlobalRoutingLSA
      * @see SPFVertex
@@ -661,6 +665,14 @@ class GlobalRouteManagerLSDB
      */
     uint32_t GetNumExtLSAs() const;
 
+    /**
+     * @brief Get the Link State Advertisements other than the external ones.
+     *
+     * @returns The Router and Network Link State Advertisements, in increasing
+     * link state ID order.
+     */
+    std::vector<GlobalRoutingLSA*> GetLSAs() const;
+
   private:
     typedef std::map<Ipv4Address, GlobalRoutingLSA*>
         LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisements
@@ -670,6 +682,11 @@ class GlobalRouteManagerLSDB
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
     std::vector<GlobalRoutingLSA*>
         m_extdatabase; //!< database of External Link State Advertisements
+    /**
+     * The addresses of the Link State Advertisements with a TransitNetwork link
+     * record, by the link data of the record: the lowest address for each link data.
+     */
+    std::map<Ipv4Address, Ipv4Address> m_linkDataIndex;
 };
 
 /**
@@ -682,6 +699,25 @@ class GlobalRouteManagerLSDB
  * and finally configure each of the node's forwarding tables.
  *
  * The design is guided by OSPFv2 \RFC{2328} section 16.1.1 and quagga ospfd.
+ *
+ * The SPF calculations of the routers only read the LSDB and write the
+ * routes of their own router, so that InitializeRoutes() runs them on
+ * several threads, as set by the \c GlobalRoutingThreads global value.
+ *
+ * With the \c GlobalRoutingIncremental global value, the SPF tree of each
+ * router is kept after its routes are computed.  When the routes are
+ * computed again, after DeleteGlobalRoutes() and
+ * BuildGlobalRoutingDatabase(), e.g., because an interface went up or
+ * down, the transit links of the new LSDB are compared with those of the
+ * previous one.  A tree is reused when the Dijkstra calculation would
+ * only ignore the links that changed: the links removed or added
+ * between vertices of the tree which were already in the tree, or
+ * already candidates at a shorter distance, when the calculation reached
+ * them, away from the root and the first hops.  Its routes are then
+ * installed again from the new LSAs, without its SPF calculation, and
+ * they are the same as those of a full calculation.  The other trees
+ * are calculated again.  The trees take memory in the order of the
+ * number of routers times the number of vertices.
  */
 class GlobalRouteManagerImpl
 {
@@ -727,8 +763,164 @@ class GlobalRouteManagerImpl
     void DebugSPFCalculate(Ipv4Address root);
 
   private:
+    /** The objects of a router, to which its routes are written. */
+    struct RouterInfo
+    {
+        Ptr<Node> node;                 //!< The node.
+        Ptr<Ipv4> ipv4;                 //!< The IPv4 stack of the node.
+        Ptr<Ipv4GlobalRouting> routing; //!< The global routing protocol of the node.
+    };
+
+    /** The SPF tree of a router, as kept by the incremental calculation. */
+    struct SPFTree
+    {
+        /** A vertex of the tree. */
+        struct Vertex
+        {
+            Ipv4Address id;    //!< The link state ID of the LSA of the vertex.
+            bool network;      //!< Whether the vertex is a network vertex.
+            uint32_t distance; //!< The distance from the root.
+            uint32_t exits;    //!< The index of the first root exit direction of the vertex.
+            uint32_t nExits;   //!< The number of root exit directions of the vertex.
+            uint32_t parents;  //!< The index of the first parent of the vertex.
+            uint32_t nParents; //!< The number of parents of the vertex.
+        };
+
+        std::vector<Vertex> vertices; //!< The vertices, in the order they joined the tree.
+        std::vector<SPFVertex::NodeExit_t> exits; //!< The root exit directions of the vertices.
+        std::vector<uint32_t> parents;            //!< The indexes of the parents of the vertices.
+    };
+
+    /** A link from a vertex of the SPF calculation to another. */
+    struct TransitLink
+    {
+        Ipv4Address to;   //!< The link state ID of the destination vertex.
+        Ipv4Address data; //!< The link data.
+        uint32_t metric;  //!< The link metric, 0 from a network vertex.
+
+        /**
+         * \param other Another link.
+         * \returns Whether the links are the same.
+         */
+        bool operator==(const TransitLink& other) const = default;
+    };
+
+    /** The changes of the links of a vertex, from the previous LSDB to the current one. */
+    struct VertexChanges
+    {
+        /**
+         * Whether the LSA of the vertex was added, removed or changed its
+         * type, or the links kept by the vertex changed their order.
+         */
+        bool lsa{false};
+        std::vector<TransitLink> removed; //!< The links of the previous LSDB only.
+        std::vector<TransitLink> added;   //!< The links of the current LSDB only.
+    };
+
+    /**
+     * \brief Create a worker, calculating routes on another thread.
+     *
+     * The worker uses the LSDB, the routers, the trees and the changes
+     * of the manager.
+     *
+     * \param manager the manager
+     */
+    GlobalRouteManagerImpl(GlobalRouteManagerImpl* manager);
+
+    /**
+     * \brief Find the routers, from the NodeList.
+     */
+    void FindRouters();
+
+    /**
+     * \param routerId a router ID
+     * \returns the router, or nullptr if there is no such router
+     */
+    const RouterInfo* GetRouter(Ipv4Address routerId) const;
+
+    /**
+     * \brief Calculate the routes of a router: reuse its SPF tree if the
+     * changes of the LSDB do not affect it, or run its SPF calculation.
+     *
+     * \param root the router ID
+     */
+    void CalculateRoutes(Ipv4Address root);
+
+    /**
+     * \brief Get the transit links of the vertices of an LSDB, i.e., the
+     * links the SPF calculation follows.
+     *
+     * \param lsdb the LSDB
+     * \returns the LSA and the links of each vertex, in the order they
+     *          are examined, by link state ID
+     */
+    static std::map<Ipv4Address, std::pair<GlobalRoutingLSA*, std::vector<TransitLink>>>
+    GetTransitLinks(const GlobalRouteManagerLSDB& lsdb);
+
+    /**
+     * \brief Compare the transit links of the previous LSDB with those of
+     * the current one, into m_changes.
+     */
+    void FindLSDBChanges();
+
+    /**
+     * \brief Test if the changes of the LSDB may affect an SPF tree.
+     *
+     * \param tree the tree
+     * \returns true if the SPF calculation of the tree must run again
+     */
+    bool IsSPFTreeAffected(const SPFTree& tree) const;
+
+    /**
+     * \brief Install the routes of an SPF tree unaffected by the changes
+     * of the LSDB, with the LSAs of the current LSDB.
+     *
+     * \param tree the tree
+     */
+    void SPFReuse(const SPFTree& tree);
+
+    /**
+     * \brief Keep the SPF tree calculated, in m_tree.
+     *
+     * \param vertices the vertices, in the order they joined the tree
+     */
+    void SPFKeepTree(const std::vector<SPFVertex*>& vertices);
+
+    /**
+     * \brief Second stage of the SPF calculation: add the routes to the
+     * stub networks and the external routes, once the tree of transit
+     * vertices is built, and delete the tree.
+     */
+    void SPFSecondStage();
+
+    /**
+     * \param lsa an LSA
+     * \returns the status of the LSA in the current SPF calculation
+     */
+    GlobalRoutingLSA::SPFStatus GetLSAStatus(const GlobalRoutingLSA* lsa) const;
+
+    /**
+     * \brief Set the status of an LSA in the current SPF calculation.
+     *
+     * \param lsa the LSA
+     * \param status the status
+     */
+    void SetLSAStatus(const GlobalRoutingLSA* lsa, GlobalRoutingLSA::SPFStatus status);
+
     SPFVertex* m_spfroot;           //!< the root node
     GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+    GlobalRouteManagerImpl* m_manager; //!< the manager of a worker, or nullptr
+    const RouterInfo* m_root;          //!< the router at the root of the SPF calculation
+    /** The status of the LSAs in the current SPF calculation. */
+    std::unordered_map<const GlobalRoutingLSA*, GlobalRoutingLSA::SPFStatus> m_lsaStatus;
+    SPFTree* m_tree; //!< where to keep the SPF tree calculated, or nullptr
+    /** The routers, by router ID. */
+    std::unordered_map<Ipv4Address, RouterInfo, Ipv4AddressHash> m_routers;
+    GlobalRouteManagerLSDB* m_previousLsdb; //!< the LSDB the trees were calculated from, or nullptr
+    bool m_treesValid;                      //!< whether the trees were calculated from m_lsdb
+    std::map<Ipv4Address, SPFTree> m_trees; //!< the SPF trees, by router ID
+    /** The vertices whose links changed from m_previousLsdb to m_lsdb. */
+    std::unordered_map<Ipv4Address, VertexChanges, Ipv4AddressHash> m_changes;
 
     /**
      * \brief Test if a node is a stub, from an OSPF sense.
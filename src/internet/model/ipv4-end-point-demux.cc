@@ -13,6 +13,9 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace ns3
 {
 
@@ -41,14 +44,7 @@ bool
 Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_localPorts.contains(port);
 }
 
 bool
@@ -76,10 +72,7 @@ Ipv4EndPointDemux::Allocate()
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(Ipv4Address::GetAny(), port));
 }
 
 Ipv4EndPoint*
@@ -92,10 +85,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(address, port));
 }
 
 Ipv4EndPoint*
@@ -115,10 +105,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         NS_LOG_WARN("Duplicated endpoint.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(address, port));
 }
 
 Ipv4EndPoint*
@@ -129,11 +116,11 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto [begin, end] = m_index.equal_range({localAddress, localPort, peerAddress, peerPort});
+    for (auto i = begin; i != end; i++)
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        Ipv4EndPoint* endP = *i->second;
+        if (endP->GetBoundNetDevice() == boundNetDevice || !endP->GetBoundNetDevice())
         {
             NS_LOG_WARN("Duplicated endpoint.");
             return nullptr;
@@ -141,25 +128,18 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
     }
     auto endPoint = new Ipv4EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    return Insert(endPoint);
 }
 
 void
 Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this << endPoint);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto i = RemoveIndex(endPoint);
+    if (i != m_endPoints.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        delete endPoint;
+        m_endPoints.erase(i);
     }
 }
 
@@ -200,9 +180,55 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
     EndPoints retval4; // Exact match on all 4
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+
+    // The endpoints which may match are those with the local port, a local
+    // address equal to the destination address, to Any, or to the network
+    // address of the incoming interface, and a peer address equal to the
+    // source or to Any, with a peer port equal to the source port or to 0.
+    std::vector<Ipv4Address> localAddresses{daddr};
+    auto addLocalAddress = [&localAddresses](Ipv4Address address) {
+        if (std::find(localAddresses.begin(), localAddresses.end(), address) ==
+            localAddresses.end())
+        {
+            localAddresses.push_back(address);
+        }
+    };
+    addLocalAddress(Ipv4Address::GetAny());
+    if (incomingInterface)
+    {
+        for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
+        {
+            Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
+            addLocalAddress(addr.GetLocal().CombineMask(addr.GetMask()));
+        }
+    }
+    std::vector<std::pair<Ipv4Address, uint16_t>> peers;
+    for (Ipv4Address peerAddress : {saddr, Ipv4Address::GetAny()})
+    {
+        for (uint16_t peerPort : {sport, static_cast<uint16_t>(0)})
+        {
+            std::pair<Ipv4Address, uint16_t> peer{peerAddress, peerPort};
+            if (std::find(peers.begin(), peers.end(), peer) == peers.end())
+            {
+                peers.push_back(peer);
+            }
+        }
+    }
+    std::vector<Ipv4EndPoint*> candidates;
+    for (const auto& localAddress : localAddresses)
+    {
+        for (const auto& [peerAddress, peerPort] : peers)
+        {
+            auto [begin, end] = m_index.equal_range({localAddress, dport, peerAddress, peerPort});
+            for (auto i = begin; i != end; i++)
+            {
+                candidates.push_back(*i->second);
+            }
+        }
+    }
+
+    for (Ipv4EndPoint* endP : candidates)
     {
-        Ipv4EndPoint* endP = *i;
 
         NS_LOG_DEBUG("Looking at endpoint dport="
                      << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
@@ -361,6 +387,12 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport);
 
+    auto exact = m_index.find({daddr, dport, saddr, sport});
+    if (exact != m_index.end())
+    {
+        return *exact->second;
+    }
+
     // this code is a copy/paste version of an old BSD ip stack lookup
     // function.
     uint32_t genericity = 3;
@@ -395,6 +427,69 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
     return generic;
 }
 
+std::size_t
+Ipv4EndPointDemux::KeyHash::operator()(const Key& key) const
+{
+    uint64_t addresses =
+        (static_cast<uint64_t>(key.localAddress.Get()) << 32) | key.peerAddress.Get();
+    uint64_t ports = (static_cast<uint64_t>(key.localPort) << 16) | key.peerPort;
+    // multiply to spread the bits of the addresses over the whole hash
+    return std::hash<uint64_t>()((addresses ^ ports) * 0x9e3779b97f4a7c15ULL);
+}
+
+Ipv4EndPointDemux::Key
+Ipv4EndPointDemux::GetKey(const Ipv4EndPoint* endPoint)
+{
+    return {endPoint->GetLocalAddress(),
+            endPoint->GetLocalPort(),
+            endPoint->GetPeerAddress(),
+            endPoint->GetPeerPort()};
+}
+
+Ipv4EndPoint*
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    endPoint->m_demux = this;
+    m_endPoints.push_back(endPoint);
+    m_index.emplace(GetKey(endPoint), std::prev(m_endPoints.end()));
+    m_localPorts[endPoint->GetLocalPort()]++;
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+Ipv4EndPointDemux::EndPointsI
+Ipv4EndPointDemux::RemoveIndex(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    auto [begin, end] = m_index.equal_range(GetKey(endPoint));
+    for (auto i = begin; i != end; i++)
+    {
+        if (*i->second == endPoint)
+        {
+            EndPointsI position = i->second;
+            m_index.erase(i);
+            auto port = m_localPorts.find(endPoint->GetLocalPort());
+            if (--port->second == 0)
+            {
+                m_localPorts.erase(port);
+            }
+            return position;
+        }
+    }
+    return m_endPoints.end();
+}
+
+void
+Ipv4EndPointDemux::UpdateKey(Ipv4EndPoint* endPoint, const Key& key)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    EndPointsI position = RemoveIndex(endPoint);
+    NS_ASSERT_MSG(position != m_endPoints.end(), "Endpoint not allocated by this demux");
+    m_index.emplace(key, position);
+    m_localPorts[key.localPort]++;
+}
+
 uint16_t
 Ipv4EndPointDemux::AllocateEphemeralPort()
 {
@@ -15,6 +15,7 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -31,6 +32,12 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * The endpoints are indexed by a hash table of their local and peer
+ * addresses and ports, kept up to date as the endpoints are bound and
+ * connected, so that a lookup only probes the four-tuples which may match
+ * a packet (the exact one, and those with wildcard addresses or ports),
+ * rather than scanning all the endpoints.
  */
 
 class Ipv4EndPointDemux
@@ -160,6 +167,71 @@ class Ipv4EndPointDemux
     void DeAllocate(Ipv4EndPoint* endPoint);
 
   private:
+    friend class Ipv4EndPoint;
+
+    /**
+     * \brief The addresses and ports of an endpoint, by which it is indexed.
+     */
+    struct Key
+    {
+        Ipv4Address localAddress; //!< The local address.
+        uint16_t localPort;       //!< The local port.
+        Ipv4Address peerAddress;  //!< The peer address.
+        uint16_t peerPort;        //!< The peer port.
+
+        /**
+         * \brief Compare two keys.
+         * \param other the other key
+         * \return true if the addresses and ports are equal
+         */
+        bool operator==(const Key& other) const = default;
+    };
+
+    /**
+     * \brief Hash function of the keys.
+     */
+    struct KeyHash
+    {
+        /**
+         * \brief Hash a key.
+         * \param key the key
+         * \return the hash
+         */
+        std::size_t operator()(const Key& key) const;
+    };
+
+    /**
+     * \brief Get the key of an endpoint.
+     * \param endPoint the endpoint
+     * \return the current addresses and ports of the endpoint
+     */
+    static Key GetKey(const Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Add a new endpoint to the list and to the index.
+     * \param endPoint the endpoint
+     * \return the endpoint
+     */
+    Ipv4EndPoint* Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Remove an endpoint from the index.
+     * \param endPoint the endpoint
+     * \return the position of the endpoint in the list, or the end of the
+     * list if the endpoint is not in this demux
+     */
+    EndPointsI RemoveIndex(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Index an endpoint by its new addresses and ports.
+     *
+     * Called by the endpoint before its addresses or ports change.
+     *
+     * \param endPoint the endpoint
+     * \param key the new addresses and ports of the endpoint
+     */
+    void UpdateKey(Ipv4EndPoint* endPoint, const Key& key);
+
     /**
      * \brief Allocate an ephemeral port.
      * \returns the ephemeral port
@@ -185,6 +257,17 @@ class Ipv4EndPointDemux
      * \brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * \brief The positions of the IPv4 end points in the list, by their
+     * addresses and ports.
+     */
+    std::unordered_multimap<Key, EndPointsI, KeyHash> m_index;
+
+    /**
+     * \brief The number of IPv4 end points of each local port.
+     */
+    std::unordered_map<uint16_t, uint32_t> m_localPorts;
 };
 
 } // namespace ns3
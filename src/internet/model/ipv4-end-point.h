@@ -22,6 +22,7 @@ namespace ns3
 {
 
 class Header;
+class Ipv4EndPointDemux;
 class Packet;
 
 /**
@@ -180,6 +181,14 @@ class Ipv4EndPoint
     bool IsRxEnabled() const;
 
   private:
+    friend class Ipv4EndPointDemux;
+
+    /**
+     * \brief The demux which allocated the endpoint (if any), and indexes it
+     * by its addresses and ports.
+     */
+    Ipv4EndPointDemux* m_demux;
+
     /**
      * \brief The local address.
      */
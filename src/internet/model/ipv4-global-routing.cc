@@ -19,7 +19,9 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <iterator>
 #include <vector>
 
 namespace ns3
@@ -36,6 +38,16 @@ Ipv4GlobalRouting::GetTypeId()
         TypeId("ns3::Ipv4GlobalRouting")
             .SetParent<Object>()
             .SetGroupName("Internet")
+            .SetMemoryEstimator([](const ObjectBase* object) -> std::size_t {
+                auto routing = static_cast<const Ipv4GlobalRouting*>(object);
+                std::size_t routes = routing->m_hostRoutes.size() +
+                                     routing->m_networkRoutes.size() +
+                                     routing->m_ASexternalRoutes.size();
+                return routes * (sizeof(Ipv4RoutingTableEntry) + 3 * sizeof(void*)) +
+                       routing->m_hostFib.GetMemoryUsage() +
+                       routing->m_networkFib.GetMemoryUsage() +
+                       routing->m_externalFib.GetMemoryUsage();
+            })
             .AddAttribute("RandomEcmpRouting",
                           "Set to true if packets are randomly routed among ECMP; set to false for "
                           "using only one route consistently",
@@ -72,6 +84,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
     m_hostRoutes.push_back(route);
+    m_hostFib.Clear();
 }
 
 void
@@ -81,6 +94,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, interface);
     m_hostRoutes.push_back(route);
+    m_hostFib.Clear();
 }
 
 void
@@ -93,6 +107,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_networkRoutes.push_back(route);
+    m_networkFib.Clear();
 }
 
 void
@@ -102,6 +117,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     m_networkRoutes.push_back(route);
+    m_networkFib.Clear();
 }
 
 void
@@ -114,6 +130,25 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_ASexternalRoutes.push_back(route);
+    m_externalFib.Clear();
+}
+
+void
+Ipv4GlobalRouting::UpdateFib(const std::list<Ipv4RoutingTableEntry*>& routes, Fib& fib)
+{
+    if (fib.GetNValues() == routes.size())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(&routes << &fib);
+    fib.Clear();
+    uint32_t rank = 0;
+    for (auto route : routes)
+    {
+        Fib::Key key;
+        route->GetDestNetwork().Serialize(key.data());
+        fib.Insert(key, route->GetDestNetworkMask().GetPrefixLength(), {rank++, route});
+    }
 }
 
 Ptr<Ipv4Route>
@@ -126,66 +161,62 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
     RouteVec_t allRoutes;
 
-    NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
-    for (auto i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
-    {
-        NS_ASSERT((*i)->IsHost());
-        if ((*i)->GetDest() == dest)
+    Fib::Key key;
+    dest.Serialize(key.data());
+    auto onInterface = [this, oif](const FibEntry& entry) {
+        if (oif && oif != m_ipv4->GetNetDevice(entry.route->GetInterface()))
         {
-            if (oif)
-            {
-                if (oif != m_ipv4->GetNetDevice((*i)->GetInterface()))
-                {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
-                    continue;
-                }
-            }
-            allRoutes.push_back(*i);
-            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << *i);
+            NS_LOG_LOGIC("Not on requested interface, skipping");
+            return false;
         }
+        return true;
+    };
+    // the matching routes of the tries, from the longest prefix
+    std::vector<FibEntry> matches;
+    auto collect = [&matches, &onInterface](uint32_t, const std::vector<FibEntry>& entries) {
+        std::copy_if(entries.begin(), entries.end(), std::back_inserter(matches), onInterface);
+        return false;
+    };
+
+    NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
+    UpdateFib(m_hostRoutes, m_hostFib);
+    m_hostFib.VisitMatches(key, collect);
+    for (const auto& entry : matches)
+    {
+        NS_ASSERT(entry.route->IsHost());
+        allRoutes.push_back(entry.route);
+        NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << entry.route);
     }
     if (allRoutes.empty()) // if no host route is found
     {
+        // all the matching network routes, whatever their prefix length,
+        // in the order they were added
         NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
-        for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+        UpdateFib(m_networkRoutes, m_networkFib);
+        m_networkFib.VisitMatches(key, collect);
+        std::sort(matches.begin(), matches.end(), [](const FibEntry& a, const FibEntry& b) {
+            return a.rank < b.rank;
+        });
+        for (const auto& entry : matches)
         {
-            Ipv4Mask mask = (*j)->GetDestNetworkMask();
-            Ipv4Address entry = (*j)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
-            {
-                if (oif)
-                {
-                    if (oif != m_ipv4->GetNetDevice((*j)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
-                }
-                allRoutes.push_back(*j);
-                NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j);
-            }
+            allRoutes.push_back(entry.route);
+            NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << entry.route);
         }
     }
     if (allRoutes.empty()) // consider external if no host/network found
     {
-        for (auto k = m_ASexternalRoutes.begin(); k != m_ASexternalRoutes.end(); k++)
+        // the first matching external route
+        UpdateFib(m_ASexternalRoutes, m_externalFib);
+        m_externalFib.VisitMatches(key, collect);
+        auto first = std::min_element(matches.begin(),
+                                      matches.end(),
+                                      [](const FibEntry& a, const FibEntry& b) {
+                                          return a.rank < b.rank;
+                                      });
+        if (first != matches.end())
         {
-            Ipv4Mask mask = (*k)->GetDestNetworkMask();
-            Ipv4Address entry = (*k)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
-            {
-                NS_LOG_LOGIC("Found external route" << *k);
-                if (oif)
-                {
-                    if (oif != m_ipv4->GetNetDevice((*k)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
-                }
-                allRoutes.push_back(*k);
-                break;
-            }
+            NS_LOG_LOGIC("Found external route" << first->route);
+            allRoutes.push_back(first->route);
         }
     }
     if (!allRoutes.empty()) // if route(s) is found
@@ -288,6 +319,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
                 NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
                 delete *i;
                 m_hostRoutes.erase(i);
+                m_hostFib.Clear();
                 NS_LOG_LOGIC("Done removing host route "
                              << index << "; host route remaining size = " << m_hostRoutes.size());
                 return;
@@ -304,6 +336,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
             delete *j;
             m_networkRoutes.erase(j);
+            m_networkFib.Clear();
             NS_LOG_LOGIC("Done removing network route "
                          << index << "; network route remaining size = " << m_networkRoutes.size());
             return;
@@ -319,6 +352,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_ASexternalRoutes.size());
             delete *k;
             m_ASexternalRoutes.erase(k);
+            m_externalFib.Clear();
             NS_LOG_LOGIC("Done removing network route "
                          << index << "; network route remaining size = " << m_networkRoutes.size());
             return;
@@ -353,6 +387,9 @@ Ipv4GlobalRouting::DoDispose()
     {
         delete (*l);
     }
+    m_hostFib.Clear();
+    m_networkFib.Clear();
+    m_externalFib.Clear();
 
     Ipv4RoutingProtocol::DoDispose();
 }
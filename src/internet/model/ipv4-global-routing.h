@@ -10,6 +10,7 @@
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
+#include "prefix-trie.h"
 
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
@@ -254,6 +255,24 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     /// iterator of container of Ipv4RoutingTableEntry (routes to external AS)
     typedef std::list<Ipv4RoutingTableEntry*>::iterator ASExternalRoutesI;
 
+    /// A route, in a forwarding trie
+    struct FibEntry
+    {
+        uint32_t rank;                //!< The position of the route in its list.
+        Ipv4RoutingTableEntry* route; //!< The route.
+    };
+
+    /// A forwarding trie
+    typedef PrefixTrie<FibEntry, 4> Fib;
+
+    /**
+     * \brief Build the forwarding trie of a list of routes, if they
+     * changed since it was built.
+     * \param routes the routes
+     * \param fib the forwarding trie of the routes
+     */
+    static void UpdateFib(const std::list<Ipv4RoutingTableEntry*>& routes, Fib& fib);
+
     /**
      * \brief Lookup in the forwarding table for destination.
      * \param dest destination address
@@ -266,6 +285,12 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+    // The routes by prefix, cleared when the routes change, and built
+    // again by the next lookup
+    Fib m_hostFib;     //!< Routes to hosts, by address
+    Fib m_networkFib;  //!< Routes to networks, by prefix
+    Fib m_externalFib; //!< External routes, by prefix
+
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
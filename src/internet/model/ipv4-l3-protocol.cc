@@ -13,9 +13,11 @@
 #include "icmpv4-l4-protocol.h"
 #include "ipv4-header.h"
 #include "ipv4-interface.h"
+#include "ipv4-list-routing.h"
 #include "ipv4-raw-socket-impl.h"
 #include "ipv4-route.h"
 #include "loopback-net-device.h"
+#include "routing-memory-collector.h"
 
 #include "ns3/boolean.h"
 #include "ns3/callback.h"
@@ -25,6 +27,7 @@
 #include "ns3/node.h"
 #include "ns3/object-vector.h"
 #include "ns3/packet.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/socket.h"
 #include "ns3/string.h"
 #include "ns3/trace-source-accessor.h"
@@ -980,8 +983,16 @@ Ipv4L3Protocol::SendRealOut(Ptr<Ipv4Route> route, Ptr<Packet> packet, const Ipv4
     if (outInterface->IsUp())
     {
         NS_LOG_LOGIC("Send to " << targetLabel << " " << target);
-        if (packet->GetSize() + ipHeader.GetSerializedSize() > outInterface->GetDevice()->GetMtu())
+        // an aggregate of segments is split by the device, if it supports
+        // the segmentation offload, in segments fitting the MTU
+        SegmentationOffloadTag offload;
+        bool offloaded =
+            outDev->SupportsSegmentationOffload() && packet->PeekPacketTag(offload);
+        if (!offloaded &&
+            packet->GetSize() + ipHeader.GetSerializedSize() > outInterface->GetDevice()->GetMtu())
         {
+            // the fragments of an aggregate are not segments
+            packet->RemovePacketTag(offload);
             std::list<Ipv4PayloadHeaderPair> listFragments;
             DoFragmentation(packet, ipHeader, outInterface->GetDevice()->GetMtu(), listFragments);
             for (auto it = listFragments.begin(); it != listFragments.end(); it++)
@@ -1882,4 +1893,7 @@ Ipv4L3Protocol::HandleTimeout()
     m_timeoutEvent = Simulator::Schedule(difference, &Ipv4L3Protocol::HandleTimeout, this);
 }
 
+/** Instance registering the IPv4 routing protocols with MemoryReport. */
+static RoutingMemoryCollector<Ipv4, Ipv4ListRouting> g_ipv4RoutingMemoryCollector;
+
 } // namespace ns3
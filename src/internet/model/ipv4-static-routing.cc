@@ -42,7 +42,17 @@ Ipv4StaticRouting::GetTypeId()
     static TypeId tid = TypeId("ns3::Ipv4StaticRouting")
                             .SetParent<Ipv4RoutingProtocol>()
                             .SetGroupName("Internet")
-                            .AddConstructor<Ipv4StaticRouting>();
+                            .AddConstructor<Ipv4StaticRouting>()
+                            .SetMemoryEstimator([](const ObjectBase* object) -> std::size_t {
+                                auto routing = static_cast<const Ipv4StaticRouting*>(object);
+                                return routing->m_networkRoutes.size() *
+                                           (sizeof(NetworkRoutes::value_type) +
+                                            2 * sizeof(void*) + sizeof(Ipv4RoutingTableEntry)) +
+                                       routing->m_multicastRoutes.size() *
+                                           (3 * sizeof(void*) +
+                                            sizeof(Ipv4MulticastRoutingTableEntry)) +
+                                       routing->m_fib.GetMemoryUsage();
+                            });
     return tid;
 }
 
@@ -69,6 +79,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
     {
         auto routePtr = new Ipv4RoutingTableEntry(route);
         m_networkRoutes.emplace_back(routePtr, metric);
+        m_fib.Clear();
     }
 }
 
@@ -87,6 +98,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
         auto routePtr = new Ipv4RoutingTableEntry(route);
 
         m_networkRoutes.emplace_back(routePtr, metric);
+        m_fib.Clear();
     }
 }
 
@@ -142,6 +154,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv4Mask networkMask("240.0.0.0");
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
     m_networkRoutes.emplace_back(route, 0);
+    m_fib.Clear();
 }
 
 uint32_t
@@ -228,13 +241,28 @@ Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metr
     return false;
 }
 
+void
+Ipv4StaticRouting::UpdateFib()
+{
+    if (m_fib.GetNValues() == m_networkRoutes.size())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    m_fib.Clear();
+    for (const auto& [route, metric] : m_networkRoutes)
+    {
+        PrefixTrie<FibEntry, 4>::Key key;
+        route->GetDestNetwork().Serialize(key.data());
+        m_fib.Insert(key, route->GetDestNetworkMask().GetPrefixLength(), {route, metric});
+    }
+}
+
 Ptr<Ipv4Route>
 Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
 {
     NS_LOG_FUNCTION(this << dest << " " << oif);
     Ptr<Ipv4Route> rtentry = nullptr;
-    uint16_t longest_mask = 0;
-    uint32_t shortest_metric = 0xffffffff;
     /* when sending on local multicast, there have to be interface specified */
     if (dest.IsLocalMulticast())
     {
@@ -250,55 +278,47 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
         return rtentry;
     }
 
-    for (auto i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
-    {
-        Ipv4RoutingTableEntry* j = i->first;
-        uint32_t metric = i->second;
-        Ipv4Mask mask = (j)->GetDestNetworkMask();
-        uint16_t masklen = mask.GetPrefixLength();
-        Ipv4Address entry = (j)->GetDestNetwork();
-        NS_LOG_LOGIC("Searching for route to " << dest << ", checking against route to " << entry
-                                               << "/" << masklen);
-        if (mask.IsMatch(dest, entry))
+    // The longest prefix with a route on the interface, if any, and among
+    // its routes the first host route, or else the last one with the
+    // smallest metric
+    UpdateFib();
+    PrefixTrie<FibEntry, 4>::Key key;
+    dest.Serialize(key.data());
+    Ipv4RoutingTableEntry* route = nullptr;
+    m_fib.VisitMatches(key, [&](uint32_t masklen, const std::vector<FibEntry>& entries) {
+        uint32_t shortest_metric = 0xffffffff;
+        for (const auto& entry : entries)
         {
-            NS_LOG_LOGIC("Found global network route " << j << ", mask length " << masklen
-                                                       << ", metric " << metric);
-            if (oif)
+            NS_LOG_LOGIC("Found global network route " << entry.route << ", mask length "
+                                                       << masklen << ", metric " << entry.metric);
+            if (oif && oif != m_ipv4->GetNetDevice(entry.route->GetInterface()))
             {
-                if (oif != m_ipv4->GetNetDevice(j->GetInterface()))
-                {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
-                    continue;
-                }
-            }
-            if (masklen < longest_mask) // Not interested if got shorter mask
-            {
-                NS_LOG_LOGIC("Previous match longer, skipping");
+                NS_LOG_LOGIC("Not on requested interface, skipping");
                 continue;
             }
-            if (masklen > longest_mask) // Reset metric if longer masklen
+            if (masklen == 32)
             {
-                shortest_metric = 0xffffffff;
+                route = entry.route;
+                break;
             }
-            longest_mask = masklen;
-            if (metric > shortest_metric)
+            if (entry.metric > shortest_metric)
             {
                 NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
                 continue;
             }
-            shortest_metric = metric;
-            Ipv4RoutingTableEntry* route = (j);
-            uint32_t interfaceIdx = route->GetInterface();
-            rtentry = Create<Ipv4Route>();
-            rtentry->SetDestination(route->GetDest());
-            rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
-            rtentry->SetGateway(route->GetGateway());
-            rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
-            if (masklen == 32)
-            {
-                break;
-            }
+            shortest_metric = entry.metric;
+            route = entry.route;
         }
+        return route != nullptr;
+    });
+    if (route)
+    {
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv4Route>();
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
     }
     if (rtentry)
     {
@@ -448,6 +468,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
         {
             delete j->first;
             m_networkRoutes.erase(j);
+            m_fib.Clear();
             return;
         }
         tmp++;
@@ -581,6 +602,7 @@ Ipv4StaticRouting::DoDispose()
     {
         delete (j->first);
     }
+    m_fib.Clear();
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
     {
@@ -622,6 +644,7 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
         {
             delete it->first;
             it = m_networkRoutes.erase(it);
+            m_fib.Clear();
         }
         else
         {
@@ -667,6 +690,7 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
         {
             delete it->first;
             it = m_networkRoutes.erase(it);
+            m_fib.Clear();
         }
         else
         {
@@ -13,6 +13,7 @@
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
+#include "prefix-trie.h"
 
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
@@ -370,6 +371,19 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
     /// Iterator for container for the multicast routes
     typedef std::list<Ipv4MulticastRoutingTableEntry*>::iterator MulticastRoutesI;
 
+    /// A network route, in the forwarding trie
+    struct FibEntry
+    {
+        Ipv4RoutingTableEntry* route; //!< The route.
+        uint32_t metric;              //!< The metric of the route.
+    };
+
+    /**
+     * \brief Build the forwarding trie from the network routes, if they
+     * changed since it was built.
+     */
+    void UpdateFib();
+
     /**
      * \brief Checks if a route is already present in the forwarding table.
      * \param route route
@@ -400,6 +414,14 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * \brief the network routes, by prefix, in the order of m_networkRoutes.
+     *
+     * Cleared when the network routes change, and built again by the
+     * next lookup.
+     */
+    PrefixTrie<FibEntry, 4> m_fib;
+
     /**
      * \brief the forwarding table for multicast.
      */
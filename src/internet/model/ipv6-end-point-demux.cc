@@ -12,6 +12,9 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace ns3
 {
 
@@ -40,14 +43,7 @@ bool
 Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_localPorts.contains(port);
 }
 
 bool
@@ -75,10 +71,7 @@ Ipv6EndPointDemux::Allocate()
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(Ipv6Address::GetAny(), port));
 }
 
 Ipv6EndPoint*
@@ -91,10 +84,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(address, port));
 }
 
 Ipv6EndPoint*
@@ -114,10 +104,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         NS_LOG_WARN("Duplicated endpoint.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(address, port));
 }
 
 Ipv6EndPoint*
@@ -128,11 +115,11 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto [begin, end] = m_index.equal_range({localAddress, localPort, peerAddress, peerPort});
+    for (auto i = begin; i != end; i++)
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        Ipv6EndPoint* endP = *i->second;
+        if (endP->GetBoundNetDevice() == boundNetDevice || !endP->GetBoundNetDevice())
         {
             NS_LOG_WARN("Duplicated endpoint.");
             return nullptr;
@@ -140,25 +127,18 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
     }
     auto endPoint = new Ipv6EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    return Insert(endPoint);
 }
 
 void
 Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto i = RemoveIndex(endPoint);
+    if (i != m_endPoints.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        delete endPoint;
+        m_endPoints.erase(i);
     }
 }
 
@@ -182,9 +162,43 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
     EndPoints retval4; /* Exact match on all 4 */
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+
+    // The endpoints which may match are those with the local port, a local
+    // address equal to the destination address or to Any, and a peer address
+    // equal to the source or to Any, with a peer port equal to the source
+    // port or to 0.
+    std::vector<Ipv6Address> localAddresses{daddr};
+    if (daddr != Ipv6Address::GetAny())
+    {
+        localAddresses.push_back(Ipv6Address::GetAny());
+    }
+    std::vector<std::pair<Ipv6Address, uint16_t>> peers;
+    for (Ipv6Address peerAddress : {saddr, Ipv6Address::GetAny()})
+    {
+        for (uint16_t peerPort : {sport, static_cast<uint16_t>(0)})
+        {
+            std::pair<Ipv6Address, uint16_t> peer{peerAddress, peerPort};
+            if (std::find(peers.begin(), peers.end(), peer) == peers.end())
+            {
+                peers.push_back(peer);
+            }
+        }
+    }
+    std::vector<Ipv6EndPoint*> candidates;
+    for (const auto& localAddress : localAddresses)
+    {
+        for (const auto& [peerAddress, peerPort] : peers)
+        {
+            auto [begin, end] = m_index.equal_range({localAddress, dport, peerAddress, peerPort});
+            for (auto i = begin; i != end; i++)
+            {
+                candidates.push_back(*i->second);
+            }
+        }
+    }
+
+    for (Ipv6EndPoint* endP : candidates)
     {
-        Ipv6EndPoint* endP = *i;
 
         NS_LOG_DEBUG("Looking at endpoint dport="
                      << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
@@ -299,6 +313,12 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
 Ipv6EndPoint*
 Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport)
 {
+    auto exact = m_index.find({dst, dport, src, sport});
+    if (exact != m_index.end())
+    {
+        return *exact->second;
+    }
+
     uint32_t genericity = 3;
     Ipv6EndPoint* generic = nullptr;
 
@@ -337,6 +357,67 @@ Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src
     return generic;
 }
 
+std::size_t
+Ipv6EndPointDemux::KeyHash::operator()(const Key& key) const
+{
+    std::size_t hash = Ipv6AddressHash()(key.localAddress);
+    hash = hash * 31 + Ipv6AddressHash()(key.peerAddress);
+    return hash * 31 + ((static_cast<std::size_t>(key.localPort) << 16) | key.peerPort);
+}
+
+Ipv6EndPointDemux::Key
+Ipv6EndPointDemux::GetKey(const Ipv6EndPoint* endPoint)
+{
+    return {endPoint->GetLocalAddress(),
+            endPoint->GetLocalPort(),
+            endPoint->GetPeerAddress(),
+            endPoint->GetPeerPort()};
+}
+
+Ipv6EndPoint*
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    endPoint->m_demux = this;
+    m_endPoints.push_back(endPoint);
+    m_index.emplace(GetKey(endPoint), std::prev(m_endPoints.end()));
+    m_localPorts[endPoint->GetLocalPort()]++;
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+Ipv6EndPointDemux::EndPointsI
+Ipv6EndPointDemux::RemoveIndex(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    auto [begin, end] = m_index.equal_range(GetKey(endPoint));
+    for (auto i = begin; i != end; i++)
+    {
+        if (*i->second == endPoint)
+        {
+            EndPointsI position = i->second;
+            m_index.erase(i);
+            auto port = m_localPorts.find(endPoint->GetLocalPort());
+            if (--port->second == 0)
+            {
+                m_localPorts.erase(port);
+            }
+            return position;
+        }
+    }
+    return m_endPoints.end();
+}
+
+void
+Ipv6EndPointDemux::UpdateKey(Ipv6EndPoint* endPoint, const Key& key)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    EndPointsI position = RemoveIndex(endPoint);
+    NS_ASSERT_MSG(position != m_endPoints.end(), "Endpoint not allocated by this demux");
+    m_index.emplace(key, position);
+    m_localPorts[key.localPort]++;
+}
+
 uint16_t
 Ipv6EndPointDemux::AllocateEphemeralPort()
 {
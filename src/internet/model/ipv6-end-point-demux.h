@@ -15,6 +15,7 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -25,6 +26,11 @@ class Ipv6EndPoint;
  * \ingroup ipv6
  *
  * \brief Demultiplexer for end points.
+ *
+ * The endpoints are indexed by a hash table of their local and peer
+ * addresses and ports, kept up to date as the endpoints are bound and
+ * connected, so that a lookup only probes the four-tuples which may match
+ * a packet, rather than scanning all the endpoints.
  */
 class Ipv6EndPointDemux
 {
@@ -150,6 +156,71 @@ class Ipv6EndPointDemux
     EndPoints GetEndPoints() const;
 
   private:
+    friend class Ipv6EndPoint;
+
+    /**
+     * \brief The addresses and ports of an endpoint, by which it is indexed.
+     */
+    struct Key
+    {
+        Ipv6Address localAddress; //!< The local address.
+        uint16_t localPort;       //!< The local port.
+        Ipv6Address peerAddress;  //!< The peer address.
+        uint16_t peerPort;        //!< The peer port.
+
+        /**
+         * \brief Compare two keys.
+         * \param other the other key
+         * \return true if the addresses and ports are equal
+         */
+        bool operator==(const Key& other) const = default;
+    };
+
+    /**
+     * \brief Hash function of the keys.
+     */
+    struct KeyHash
+    {
+        /**
+         * \brief Hash a key.
+         * \param key the key
+         * \return the hash
+         */
+        std::size_t operator()(const Key& key) const;
+    };
+
+    /**
+     * \brief Get the key of an endpoint.
+     * \param endPoint the endpoint
+     * \return the current addresses and ports of the endpoint
+     */
+    static Key GetKey(const Ipv6EndPoint* endPoint);
+
+    /**
+     * \brief Add a new endpoint to the list and to the index.
+     * \param endPoint the endpoint
+     * \return the endpoint
+     */
+    Ipv6EndPoint* Insert(Ipv6EndPoint* endPoint);
+
+    /**
+     * \brief Remove an endpoint from the index.
+     * \param endPoint the endpoint
+     * \return the position of the endpoint in the list, or the end of the
+     * list if the endpoint is not in this demux
+     */
+    EndPointsI RemoveIndex(Ipv6EndPoint* endPoint);
+
+    /**
+     * \brief Index an endpoint by its new addresses and ports.
+     *
+     * Called by the endpoint before its addresses or ports change.
+     *
+     * \param endPoint the endpoint
+     * \param key the new addresses and ports of the endpoint
+     */
+    void UpdateKey(Ipv6EndPoint* endPoint, const Key& key);
+
     /**
      * \brief Allocate a ephemeral port.
      * \return a port
@@ -175,6 +246,17 @@ class Ipv6EndPointDemux
      * \brief A list of IPv6 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * \brief The positions of the IPv6 end points in the list, by their
+     * addresses and ports.
+     */
+    std::unordered_multimap<Key, EndPointsI, KeyHash> m_index;
+
+    /**
+     * \brief The number of IPv6 end points of each local port.
+     */
+    std::unordered_map<uint16_t, uint32_t> m_localPorts;
 };
 
 } /* namespace ns3 */
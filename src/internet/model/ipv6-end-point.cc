@@ -8,6 +8,8 @@
 
 #include "ipv6-end-point.h"
 
+#include "ipv6-end-point-demux.h"
+
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -18,7 +20,8 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("Ipv6EndPoint");
 
 Ipv6EndPoint::Ipv6EndPoint(Ipv6Address addr, uint16_t port)
-    : m_localAddr(addr),
+    : m_demux(nullptr),
+      m_localAddr(addr),
       m_localPort(port),
       m_peerAddr(Ipv6Address::GetAny()),
       m_peerPort(0),
@@ -46,6 +49,10 @@ Ipv6EndPoint::GetLocalAddress() const
 void
 Ipv6EndPoint::SetLocalAddress(Ipv6Address addr)
 {
+    if (m_demux != nullptr)
+    {
+        m_demux->UpdateKey(this, {addr, m_localPort, m_peerAddr, m_peerPort});
+    }
     m_localAddr = addr;
 }
 
@@ -58,6 +65,10 @@ Ipv6EndPoint::GetLocalPort() const
 void
 Ipv6EndPoint::SetLocalPort(uint16_t port)
 {
+    if (m_demux != nullptr)
+    {
+        m_demux->UpdateKey(this, {m_localAddr, port, m_peerAddr, m_peerPort});
+    }
     m_localPort = port;
 }
 
@@ -88,6 +99,10 @@ Ipv6EndPoint::GetBoundNetDevice() const
 void
 Ipv6EndPoint::SetPeer(Ipv6Address addr, uint16_t port)
 {
+    if (m_demux != nullptr)
+    {
+        m_demux->UpdateKey(this, {m_localAddr, m_localPort, addr, port});
+    }
     m_peerAddr = addr;
     m_peerPort = port;
 }
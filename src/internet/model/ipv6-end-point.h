@@ -22,6 +22,7 @@ namespace ns3
 {
 
 class Header;
+class Ipv6EndPointDemux;
 class Packet;
 
 /**
@@ -184,6 +185,14 @@ class Ipv6EndPoint
     bool IsRxEnabled() const;
 
   private:
+    friend class Ipv6EndPointDemux;
+
+    /**
+     * \brief The demux which allocated the endpoint (if any), and indexes it
+     * by its addresses and ports.
+     */
+    Ipv6EndPointDemux* m_demux;
+
     /**
      * \brief The local address.
      */
@@ -13,6 +13,7 @@
 #include "ipv6-extension-demux.h"
 #include "ipv6-extension.h"
 #include "ipv6-interface.h"
+#include "ipv6-list-routing.h"
 #include "ipv6-option-demux.h"
 #include "ipv6-option.h"
 #include "ipv6-raw-socket-factory-impl.h"
@@ -21,6 +22,7 @@
 #include "ipv6-routing-protocol.h"
 #include "loopback-net-device.h"
 #include "ndisc-cache.h"
+#include "routing-memory-collector.h"
 
 #include "ns3/boolean.h"
 #include "ns3/callback.h"
@@ -29,6 +31,7 @@
 #include "ns3/mac64-address.h"
 #include "ns3/node.h"
 #include "ns3/object-vector.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/traffic-control-layer.h"
 #include "ns3/uinteger.h"
@@ -1219,10 +1222,17 @@ Ipv6L3Protocol::SendRealOut(Ptr<Ipv6Route> route, Ptr<Packet> packet, const Ipv6
         targetMtu = dev->GetMtu();
     }
 
-    if (packet->GetSize() + ipHeader.GetSerializedSize() > targetMtu)
+    // An aggregate of segments is split by the device, if it supports the
+    // segmentation offload, in segments fitting the MTU.  Otherwise, it is
+    // fragmented, even by a router: its source does not know its path.
+    SegmentationOffloadTag offload;
+    bool aggregate = packet->PeekPacketTag(offload);
+    bool offloaded = aggregate && dev->SupportsSegmentationOffload();
+
+    if (!offloaded && packet->GetSize() + ipHeader.GetSerializedSize() > targetMtu)
     {
         // Router => drop
-        if (!fromMe)
+        if (!fromMe && !aggregate)
         {
             Ptr<Icmpv6L4Protocol> icmpv6 = GetIcmpv6();
             if (icmpv6)
@@ -1233,6 +1243,8 @@ Ipv6L3Protocol::SendRealOut(Ptr<Ipv6Route> route, Ptr<Packet> packet, const Ipv6
             return;
         }
 
+        // the fragments of an aggregate are not segments
+        packet->RemovePacketTag(offload);
         Ptr<Ipv6ExtensionDemux> ipv6ExtensionDemux = m_node->GetObject<Ipv6ExtensionDemux>();
 
         // To get specific method GetFragments from Ipv6ExtensionFragmentation
@@ -1810,4 +1822,7 @@ Ipv6L3Protocol::GetStrongEndSystemModel() const
     return m_strongEndSystemModel;
 }
 
+/** Instance registering the IPv6 routing protocols with MemoryReport. */
+static RoutingMemoryCollector<Ipv6, Ipv6ListRouting> g_ipv6RoutingMemoryCollector;
+
 } /* namespace ns3 */
@@ -33,7 +33,17 @@ Ipv6StaticRouting::GetTypeId()
     static TypeId tid = TypeId("ns3::Ipv6StaticRouting")
                             .SetParent<Ipv6RoutingProtocol>()
                             .SetGroupName("Internet")
-                            .AddConstructor<Ipv6StaticRouting>();
+                            .AddConstructor<Ipv6StaticRouting>()
+                            .SetMemoryEstimator([](const ObjectBase* object) -> std::size_t {
+                                auto routing = static_cast<const Ipv6StaticRouting*>(object);
+                                return routing->m_networkRoutes.size() *
+                                           (sizeof(NetworkRoutes::value_type) +
+                                            2 * sizeof(void*) + sizeof(Ipv6RoutingTableEntry)) +
+                                       routing->m_multicastRoutes.size() *
+                                           (3 * sizeof(void*) +
+                                            sizeof(Ipv6MulticastRoutingTableEntry)) +
+                                       routing->m_fib.GetMemoryUsage();
+                            });
     return tid;
 }
 
@@ -172,6 +182,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
     {
         auto routePtr = new Ipv6RoutingTableEntry(route);
         m_networkRoutes.emplace_back(routePtr, metric);
+        m_fib.Clear();
     }
 }
 
@@ -199,6 +210,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
     {
         auto routePtr = new Ipv6RoutingTableEntry(route);
         m_networkRoutes.emplace_back(routePtr, metric);
+        m_fib.Clear();
     }
 }
 
@@ -216,6 +228,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
     {
         auto routePtr = new Ipv6RoutingTableEntry(route);
         m_networkRoutes.emplace_back(routePtr, metric);
+        m_fib.Clear();
     }
 }
 
@@ -258,6 +271,7 @@ Ipv6StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv6Prefix networkMask = Ipv6Prefix(8);
     *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
     m_networkRoutes.emplace_back(route, 0);
+    m_fib.Clear();
 }
 
 uint32_t
@@ -368,13 +382,28 @@ Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metr
     return false;
 }
 
+void
+Ipv6StaticRouting::UpdateFib()
+{
+    if (m_fib.GetNValues() == m_networkRoutes.size())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    m_fib.Clear();
+    for (const auto& [route, metric] : m_networkRoutes)
+    {
+        PrefixTrie<FibEntry, 16>::Key key;
+        route->GetDestNetwork().GetBytes(key.data());
+        m_fib.Insert(key, route->GetDestNetworkPrefix().GetPrefixLength(), {route, metric});
+    }
+}
+
 Ptr<Ipv6Route>
 Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
 {
     NS_LOG_FUNCTION(this << dst << interface);
     Ptr<Ipv6Route> rtentry = nullptr;
-    uint16_t longestMask = 0;
-    uint32_t shortestMetric = 0xffffffff;
 
     /* when sending on link-local multicast, there have to be interface specified */
     if (dst.IsLinkLocalMulticast())
@@ -391,70 +420,61 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
         return rtentry;
     }
 
-    for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
-    {
-        Ipv6RoutingTableEntry* j = it->first;
-        uint32_t metric = it->second;
-        Ipv6Prefix mask = j->GetDestNetworkPrefix();
-        uint16_t maskLen = mask.GetPrefixLength();
-        Ipv6Address entry = j->GetDestNetwork();
-
-        NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << maskLen << ", metric "
-                                               << metric);
-
-        if (mask.IsMatch(dst, entry))
+    // The longest prefix with a route on the interface, if any, and among
+    // its routes the first host route, or else the last one with the
+    // smallest metric
+    UpdateFib();
+    PrefixTrie<FibEntry, 16>::Key key;
+    dst.GetBytes(key.data());
+    Ipv6RoutingTableEntry* route = nullptr;
+    m_fib.VisitMatches(key, [&](uint32_t maskLen, const std::vector<FibEntry>& entries) {
+        uint32_t shortestMetric = 0xffffffff;
+        for (const auto& entry : entries)
         {
-            NS_LOG_LOGIC("Found global network route " << *j << ", mask length " << maskLen
-                                                       << ", metric " << metric);
+            NS_LOG_LOGIC("Found global network route " << *entry.route << ", mask length "
+                                                       << maskLen << ", metric " << entry.metric);
 
             /* if interface is given, check the route will output on this interface */
-            if (!interface || interface == m_ipv6->GetNetDevice(j->GetInterface()))
+            if (interface && interface != m_ipv6->GetNetDevice(entry.route->GetInterface()))
             {
-                if (maskLen < longestMask)
-                {
-                    NS_LOG_LOGIC("Previous match longer, skipping");
-                    continue;
-                }
-
-                if (maskLen > longestMask)
-                {
-                    shortestMetric = 0xffffffff;
-                }
-
-                longestMask = maskLen;
-                if (metric > shortestMetric)
-                {
-                    NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
-                    continue;
-                }
-
-                shortestMetric = metric;
-                Ipv6RoutingTableEntry* route = j;
-                uint32_t interfaceIdx = route->GetInterface();
-                rtentry = Create<Ipv6Route>();
+                continue;
+            }
+            if (maskLen == 128)
+            {
+                route = entry.route;
+                break;
+            }
+            if (entry.metric > shortestMetric)
+            {
+                NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
+                continue;
+            }
+            shortestMetric = entry.metric;
+            route = entry.route;
+        }
+        return route != nullptr;
+    });
 
-                if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
-                {
-                    rtentry->SetSource(
-                        m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
-                }
-                else
-                {
-                    // Default route
-                    rtentry->SetSource(m_ipv6->SourceAddressSelection(
-                        interfaceIdx,
-                        route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
-                }
+    if (route)
+    {
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv6Route>();
 
-                rtentry->SetDestination(route->GetDest());
-                rtentry->SetGateway(route->GetGateway());
-                rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
-                if (maskLen == 128)
-                {
-                    break;
-                }
-            }
+        if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
+        {
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
+        }
+        else
+        {
+            // Default route
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(
+                interfaceIdx,
+                route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
         }
+
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
     }
 
     if (rtentry)
@@ -475,6 +495,7 @@ Ipv6StaticRouting::DoDispose()
         delete j->first;
     }
     m_networkRoutes.clear();
+    m_fib.Clear();
 
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
@@ -634,6 +655,7 @@ Ipv6StaticRouting::RemoveRoute(uint32_t index)
         {
             delete it->first;
             m_networkRoutes.erase(it);
+            m_fib.Clear();
             return;
         }
         tmp++;
@@ -657,6 +679,7 @@ Ipv6StaticRouting::RemoveRoute(Ipv6Address network,
         {
             delete it->first;
             m_networkRoutes.erase(it);
+            m_fib.Clear();
             return;
         }
     }
@@ -799,6 +822,7 @@ Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
         {
             delete it->first;
             it = m_networkRoutes.erase(it);
+            m_fib.Clear();
         }
         else
         {
@@ -837,6 +861,7 @@ Ipv6StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress
         {
             delete it->first;
             it = m_networkRoutes.erase(it);
+            m_fib.Clear();
         }
         else
         {
@@ -895,6 +920,7 @@ Ipv6StaticRouting::NotifyRemoveRoute(Ipv6Address dst,
             {
                 delete j->first;
                 j = m_networkRoutes.erase(j);
+                m_fib.Clear();
             }
             else
             {
@@ -12,6 +12,7 @@
 #include "ipv6-header.h"
 #include "ipv6-routing-protocol.h"
 #include "ipv6.h"
+#include "prefix-trie.h"
 
 #include "ns3/ipv6-address.h"
 #include "ns3/ptr.h"
@@ -295,6 +296,19 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
     /// Iterator for container for the multicast routes
     typedef std::list<Ipv6MulticastRoutingTableEntry*>::iterator MulticastRoutesI;
 
+    /// A network route, in the forwarding trie
+    struct FibEntry
+    {
+        Ipv6RoutingTableEntry* route; //!< The route.
+        uint32_t metric;              //!< The metric of the route.
+    };
+
+    /**
+     * \brief Build the forwarding trie from the network routes, if they
+     * changed since it was built.
+     */
+    void UpdateFib();
+
     /**
      * \brief Checks if a route is already present in the forwarding table.
      * \param route route
@@ -325,6 +339,14 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * \brief the network routes, by prefix, in the order of m_networkRoutes.
+     *
+     * Cleared when the network routes change, and built again by the
+     * next lookup.
+     */
+    PrefixTrie<FibEntry, 16> m_fib;
+
     /**
      * \brief the forwarding table for multicast.
      */
@@ -246,4 +246,10 @@ LoopbackNetDevice::SupportsSendFrom() const
     return true;
 }
 
+bool
+LoopbackNetDevice::SupportsSegmentationOffload() const
+{
+    return true;
+}
+
 } // namespace ns3
@@ -69,6 +69,7 @@ class LoopbackNetDevice : public NetDevice
 
     void SetPromiscReceiveCallback(PromiscReceiveCallback cb) override;
     bool SupportsSendFrom() const override;
+    bool SupportsSegmentationOffload() const override;
 
   protected:
     void DoDispose() override;
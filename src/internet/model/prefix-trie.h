@@ -0,0 +1,307 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PREFIX_TRIE_H
+#define PREFIX_TRIE_H
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup internet
+ * ns3::PrefixTrie declaration and implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup internet
+ *
+ * \brief A path-compressed binary trie of address prefixes, for the
+ * longest prefix match lookups of the routing protocols.
+ *
+ * The trie maps prefixes, i.e., the first bits of an address, to the
+ * values inserted with them.  Only the nodes holding values and the
+ * nodes where two prefixes diverge are stored, so that a lookup visits
+ * at most one node per prefix length on the path of the address, rather
+ * than every route of a routing table.
+ *
+ * The values of a prefix are kept in the order they are inserted.  There
+ * is no removal: the routing protocols rebuild their trie from their
+ * routing table after it changes.
+ *
+ * \tparam T \explicit The type of the values.
+ * \tparam Bytes \explicit The size of the addresses, e.g., 4 for IPv4.
+ */
+template <typename T, std::size_t Bytes>
+class PrefixTrie
+{
+  public:
+    /** An address, in network byte order. */
+    using Key = std::array<uint8_t, Bytes>;
+
+    /** The number of bits of an address. */
+    static constexpr uint32_t BITS = Bytes * 8;
+
+    PrefixTrie();
+
+    /**
+     * Insert a value for a prefix.
+     *
+     * \param [in] key The address of the prefix: its bits after the
+     *             prefix length are ignored.
+     * \param [in] length The prefix length, in bits.
+     * \param [in] value The value.
+     */
+    void Insert(const Key& key, uint32_t length, const T& value);
+
+    /**
+     * Remove all the values.
+     */
+    void Clear();
+
+    /**
+     * \returns The number of values inserted.
+     */
+    std::size_t GetNValues() const;
+
+    /**
+     * \returns The number of bytes allocated by the trie, approximately.
+     */
+    std::size_t GetMemoryUsage() const;
+
+    /**
+     * Visit the prefixes matching an address, from the longest one.
+     *
+     * The visitor is called with the length and the values of each
+     * prefix, and returns \c true to stop the lookup.
+     *
+     * \tparam F \deduced The visitor type.
+     * \param [in] key The address.
+     * \param [in] visit The visitor, of signature
+     *             bool (uint32_t length, const std::vector<T>& values).
+     */
+    template <typename F>
+    void VisitMatches(const Key& key, F visit) const;
+
+  private:
+    /** A node of the trie. */
+    struct Node
+    {
+        Key key;                           //!< The prefix, with the bits after it cleared.
+        uint32_t length;                   //!< The prefix length.
+        std::vector<T> values;             //!< The values of the prefix.
+        std::unique_ptr<Node> children[2]; //!< The longer prefixes, by their next bit.
+    };
+
+    /**
+     * Create a node.
+     * \param [in] key The prefix, with the bits after it cleared.
+     * \param [in] length The prefix length.
+     * \returns The node.
+     */
+    std::unique_ptr<Node> NewNode(const Key& key, uint32_t length);
+
+    /**
+     * \param [in] key An address.
+     * \param [in] i The index of a bit, from the most significant one.
+     * \returns The bit of the address.
+     */
+    static uint32_t GetBit(const Key& key, uint32_t i);
+
+    /**
+     * \param [in] key An address.
+     * \param [in] length A prefix length.
+     * \returns The address, with the bits after the prefix length cleared.
+     */
+    static Key Mask(Key key, uint32_t length);
+
+    /**
+     * \param [in] a An address.
+     * \param [in] b An address.
+     * \param [in] max The maximum length to compare.
+     * \returns The length of the common prefix of the addresses, up to max.
+     */
+    static uint32_t GetCommonLength(const Key& a, const Key& b, uint32_t max);
+
+    std::unique_ptr<Node> m_root; //!< The node of the empty prefix.
+    std::size_t m_nNodes;         //!< The number of nodes.
+    std::size_t m_nValues;        //!< The number of values.
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <typename T, std::size_t Bytes>
+PrefixTrie<T, Bytes>::PrefixTrie()
+    : m_nNodes(0),
+      m_nValues(0)
+{
+    m_root = NewNode(Key{}, 0);
+}
+
+template <typename T, std::size_t Bytes>
+void
+PrefixTrie<T, Bytes>::Insert(const Key& key, uint32_t length, const T& value)
+{
+    NS_ASSERT_MSG(length <= BITS, "Invalid prefix length " << length);
+    Key masked = Mask(key, length);
+    Node* node = m_root.get();
+    while (node->length != length)
+    {
+        std::unique_ptr<Node>& slot = node->children[GetBit(masked, node->length)];
+        if (!slot)
+        {
+            slot = NewNode(masked, length);
+            node = slot.get();
+            break;
+        }
+        Node* next = slot.get();
+        uint32_t common = GetCommonLength(masked, next->key, std::min(length, next->length));
+        if (common == next->length)
+        {
+            node = next;
+            continue;
+        }
+        // the prefixes diverge, or the prefix is shorter than the next one:
+        // insert a node where they diverge
+        std::unique_ptr<Node> split = NewNode(Mask(masked, common), common);
+        if (common < length)
+        {
+            auto& child = split->children[GetBit(masked, common)];
+            child = NewNode(masked, length);
+            node = child.get();
+        }
+        else
+        {
+            node = split.get();
+        }
+        split->children[GetBit(next->key, common)] = std::move(slot);
+        slot = std::move(split);
+        break;
+    }
+    node->values.push_back(value);
+    m_nValues++;
+}
+
+template <typename T, std::size_t Bytes>
+void
+PrefixTrie<T, Bytes>::Clear()
+{
+    if (m_nValues == 0 && m_nNodes == 1)
+    {
+        return;
+    }
+    m_nNodes = 0;
+    m_nValues = 0;
+    m_root = NewNode(Key{}, 0);
+}
+
+template <typename T, std::size_t Bytes>
+std::size_t
+PrefixTrie<T, Bytes>::GetNValues() const
+{
+    return m_nValues;
+}
+
+template <typename T, std::size_t Bytes>
+std::size_t
+PrefixTrie<T, Bytes>::GetMemoryUsage() const
+{
+    return m_nNodes * sizeof(Node) + m_nValues * sizeof(T);
+}
+
+template <typename T, std::size_t Bytes>
+template <typename F>
+void
+PrefixTrie<T, Bytes>::VisitMatches(const Key& key, F visit) const
+{
+    const Node* matches[BITS + 1];
+    uint32_t nMatches = 0;
+    const Node* node = m_root.get();
+    while (node != nullptr && GetCommonLength(key, node->key, node->length) == node->length)
+    {
+        if (!node->values.empty())
+        {
+            matches[nMatches++] = node;
+        }
+        if (node->length == BITS)
+        {
+            break;
+        }
+        node = node->children[GetBit(key, node->length)].get();
+    }
+    while (nMatches > 0)
+    {
+        nMatches--;
+        if (visit(matches[nMatches]->length, matches[nMatches]->values))
+        {
+            return;
+        }
+    }
+}
+
+template <typename T, std::size_t Bytes>
+std::unique_ptr<typename PrefixTrie<T, Bytes>::Node>
+PrefixTrie<T, Bytes>::NewNode(const Key& key, uint32_t length)
+{
+    m_nNodes++;
+    auto node = std::make_unique<Node>();
+    node->key = key;
+    node->length = length;
+    return node;
+}
+
+template <typename T, std::size_t Bytes>
+uint32_t
+PrefixTrie<T, Bytes>::GetBit(const Key& key, uint32_t i)
+{
+    return (key[i / 8] >> (7 - i % 8)) & 1;
+}
+
+template <typename T, std::size_t Bytes>
+typename PrefixTrie<T, Bytes>::Key
+PrefixTrie<T, Bytes>::Mask(Key key, uint32_t length)
+{
+    for (uint32_t i = 0; i < Bytes; i++)
+    {
+        if (length <= i * 8)
+        {
+            key[i] = 0;
+        }
+        else if (length < (i + 1) * 8)
+        {
+            key[i] &= static_cast<uint8_t>(0xff << ((i + 1) * 8 - length));
+        }
+    }
+    return key;
+}
+
+template <typename T, std::size_t Bytes>
+uint32_t
+PrefixTrie<T, Bytes>::GetCommonLength(const Key& a, const Key& b, uint32_t max)
+{
+    for (uint32_t i = 0; i < Bytes && i * 8 < max; i++)
+    {
+        auto diff = static_cast<uint8_t>(a[i] ^ b[i]);
+        if (diff != 0)
+        {
+            return std::min<uint32_t>(max, i * 8 + std::countl_zero(diff));
+        }
+    }
+    return max;
+}
+
+} // namespace ns3
+
+#endif /* PREFIX_TRIE_H */
@@ -0,0 +1,81 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ROUTING_MEMORY_COLLECTOR_H
+#define ROUTING_MEMORY_COLLECTOR_H
+
+#include "ns3/memory-report.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup internet
+ *
+ * \brief Add the routing protocols of the nodes, which their attributes
+ * do not reach, to the memory reports.
+ *
+ * The protocols of a list routing are added with the list.  A static
+ * instance registers the collector with MemoryReport, from its
+ * constructor.
+ *
+ * \tparam IP \explicit The IP protocol of the nodes, Ipv4 or Ipv6.
+ * \tparam LIST \explicit The list routing of the protocol.
+ */
+template <typename IP, typename LIST>
+class RoutingMemoryCollector
+{
+  public:
+    RoutingMemoryCollector()
+    {
+        MemoryReport::AddCollector(MakeCallback(&RoutingMemoryCollector::Collect));
+    }
+
+  private:
+    /**
+     * Add a routing protocol to a memory report, with the protocols of a
+     * list routing.
+     *
+     * \tparam ROUTING \deduced The routing protocol type.
+     * \param [in] report The memory report.
+     * \param [in] context The node id.
+     * \param [in] routing The routing protocol.
+     */
+    template <typename ROUTING>
+    static void Add(MemoryReport& report, uint32_t context, Ptr<ROUTING> routing)
+    {
+        report.AddObjects(context, routing);
+        if (auto list = DynamicCast<LIST>(routing))
+        {
+            for (uint32_t i = 0; i < list->GetNRoutingProtocols(); i++)
+            {
+                int16_t priority;
+                Add(report, context, list->GetRoutingProtocol(i, priority));
+            }
+        }
+    }
+
+    /**
+     * Add the routing protocols of the nodes to a memory report.
+     *
+     * \param [in] report The memory report.
+     */
+    static void Collect(MemoryReport& report)
+    {
+        for (auto it = NodeList::Begin(); it != NodeList::End(); ++it)
+        {
+            Ptr<IP> ip = (*it)->GetObject<IP>();
+            if (ip && ip->GetRoutingProtocol())
+            {
+                Add(report, (*it)->GetId(), ip->GetRoutingProtocol());
+            }
+        }
+    }
+};
+
+} // namespace ns3
+
+#endif /* ROUTING_MEMORY_COLLECTOR_H */
@@ -33,8 +33,10 @@
 #include "ns3/nstime.h"
 #include "ns3/object-map.h"
 #include "ns3/packet.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <unordered_map>
@@ -586,6 +588,11 @@ TcpL4Protocol::SendPacketV4(Ptr<Packet> packet,
                                   << packet->GetSize());
     // XXX outgoingHeader cannot be logged
 
+    // keep the payload of an aggregate, in case its device does not support
+    // the segmentation offload
+    SegmentationOffloadTag offload;
+    Ptr<Packet> aggregate = packet->PeekPacketTag(offload) ? packet->Copy() : nullptr;
+
     TcpHeader outgoingHeader = outgoing;
     /** \todo UrgentPointer */
     /* outgoingHeader.SetUrgentPointer (0); */
@@ -615,6 +622,14 @@ TcpL4Protocol::SendPacketV4(Ptr<Packet> packet,
             NS_LOG_ERROR("No IPV4 Routing Protocol");
             route = nullptr;
         }
+        if (aggregate && (!route || !route->GetOutputDevice()->SupportsSegmentationOffload()))
+        {
+            for (auto& [segment, header] : Segment(aggregate, outgoing))
+            {
+                SendPacketV4(segment, header, saddr, daddr, oif);
+            }
+            return;
+        }
         m_downTarget(packet, saddr, daddr, PROT_NUMBER, route);
     }
     else
@@ -645,6 +660,9 @@ TcpL4Protocol::SendPacketV6(Ptr<Packet> packet,
                            daddr.GetIpv4MappedAddress(),
                            oif));
     }
+    SegmentationOffloadTag offload;
+    Ptr<Packet> aggregate = packet->PeekPacketTag(offload) ? packet->Copy() : nullptr;
+
     TcpHeader outgoingHeader = outgoing;
     /** \todo UrgentPointer */
     /* outgoingHeader.SetUrgentPointer (0); */
@@ -674,6 +692,14 @@ TcpL4Protocol::SendPacketV6(Ptr<Packet> packet,
             NS_LOG_ERROR("No IPV6 Routing Protocol");
             route = nullptr;
         }
+        if (aggregate && (!route || !route->GetOutputDevice()->SupportsSegmentationOffload()))
+        {
+            for (auto& [segment, header] : Segment(aggregate, outgoing))
+            {
+                SendPacketV6(segment, header, saddr, daddr, oif);
+            }
+            return;
+        }
         m_downTarget6(packet, saddr, daddr, PROT_NUMBER, route);
     }
     else
@@ -682,6 +708,27 @@ TcpL4Protocol::SendPacketV6(Ptr<Packet> packet,
     }
 }
 
+std::vector<std::pair<Ptr<Packet>, TcpHeader>>
+TcpL4Protocol::Segment(Ptr<const Packet> payload, const TcpHeader& header)
+{
+    SegmentationOffloadTag offload;
+    bool found = payload->PeekPacketTag(offload);
+    NS_ASSERT_MSG(found && offload.GetSegmentSize() > 0, "Not an aggregate of segments");
+
+    std::vector<std::pair<Ptr<Packet>, TcpHeader>> segments;
+    uint32_t size = payload->GetSize();
+    for (uint32_t offset = 0; offset < size; offset += offload.GetSegmentSize())
+    {
+        Ptr<Packet> segment =
+            payload->CreateFragment(offset, std::min(offload.GetSegmentSize(), size - offset));
+        segment->RemovePacketTag(offload);
+        TcpHeader segmentHeader = header;
+        segmentHeader.SetSequenceNumber(header.GetSequenceNumber() + SequenceNumber32(offset));
+        segments.emplace_back(segment, segmentHeader);
+    }
+    return segments;
+}
+
 void
 TcpL4Protocol::SendPacket(Ptr<Packet> pkt,
                           const TcpHeader& outgoing,
@@ -17,6 +17,8 @@
 
 #include <stdint.h>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -61,6 +63,11 @@ class NetDevice;
  * and SHOULD checksum packets its receives from the socket layer going down
  * the stack, but currently checksumming is disabled.
  *
+ * The aggregates of segments sent by the sockets with segmentation offload
+ * (see the TsoMaxSegments attribute of TcpSocketBase) are sent down the stack
+ * as a whole if the output device supports the offload, and otherwise split
+ * here in the segments they stand for.
+ *
  * \see CreateSocket
  * \see NotifyNewAggregate
  * \see SendPacket
@@ -218,6 +225,17 @@ class TcpL4Protocol : public IpL4Protocol
                     const Address& daddr,
                     Ptr<NetDevice> oif = nullptr) const;
 
+    /**
+     * \brief Split an aggregate of segments, tagged with a SegmentationOffloadTag,
+     * in the segments it stands for.
+     *
+     * \param payload The payload of the aggregate
+     * \param header The TCP header of the aggregate
+     * \returns The payload and the TCP header of each segment
+     */
+    static std::vector<std::pair<Ptr<Packet>, TcpHeader>> Segment(Ptr<const Packet> payload,
+                                                                  const TcpHeader& header);
+
     /**
      * \brief Make a socket fully operational
      *
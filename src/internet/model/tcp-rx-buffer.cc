@@ -25,6 +25,14 @@ TcpRxBuffer::GetTypeId()
                             .SetParent<Object>()
                             .SetGroupName("Internet")
                             .AddConstructor<TcpRxBuffer>()
+                            .SetMemoryEstimator([](const ObjectBase* object) -> std::size_t {
+                                auto buffer = static_cast<const TcpRxBuffer*>(object);
+                                // the bytes of the packets are accounted
+                                // for by their buffers
+                                return buffer->m_data.size() *
+                                       (sizeof(decltype(m_data)::value_type) + 4 * sizeof(void*) +
+                                        sizeof(Packet));
+                            })
                             .AddTraceSource("NextRxSequence",
                                             "Next sequence number expected (RCV.NXT)",
                                             MakeTraceSourceAccessor(&TcpRxBuffer::m_nextRxSeq),
@@ -160,8 +168,13 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
             headSeq = tailSeq;
         }
     }
-    // Remove overlapped bytes from packet
-    auto i = m_data.begin();
+    // Remove overlapped bytes from packet. Only the last packet starting at,
+    // or before, headSeq can overlap it among the packets before headSeq.
+    auto i = m_data.upper_bound(headSeq);
+    if (i != m_data.begin())
+    {
+        --i;
+    }
     while (i != m_data.end() && i->first <= tailSeq)
     {
         SequenceNumber32 lastByteSeq = i->first + SequenceNumber32(i->second->GetSize());
@@ -210,7 +223,7 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
     NS_LOG_LOGIC("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize());
     // Update variables
     m_size += p->GetSize(); // Occupancy
-    for (i = m_data.begin(); i != m_data.end(); ++i)
+    for (i = m_data.lower_bound(m_nextRxSeq); i != m_data.end(); ++i)
     {
         if (i->first < m_nextRxSeq)
         {
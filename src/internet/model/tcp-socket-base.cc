@@ -46,6 +46,7 @@
 #include "ns3/object.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/simulation-singleton.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
@@ -184,6 +185,18 @@ TcpSocketBase::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&TcpSocketBase::m_limitedTx),
                           MakeBooleanChecker())
+            .AddAttribute("TsoMaxSegments",
+                          "Maximum number of segments sent down the stack as a single "
+                          "packet, with the segmentation offload (1 to disable it)",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&TcpSocketBase::m_tsoMaxSegments),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Gro",
+                          "Process the aggregates of segments received as single segments, "
+                          "rather than splitting them",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&TcpSocketBase::m_gro),
+                          MakeBooleanChecker())
             .AddAttribute("UseEcn",
                           "Parameter to set ECN functionality",
                           EnumValue(TcpSocketState::Off),
@@ -376,6 +389,8 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_delAckTimeout(sock.m_delAckTimeout),
       m_persistTimeout(sock.m_persistTimeout),
       m_cnTimeout(sock.m_cnTimeout),
+      m_tsoMaxSegments(sock.m_tsoMaxSegments),
+      m_gro(sock.m_gro),
       m_endPoint(nullptr),
       m_endPoint6(nullptr),
       m_node(sock.m_node),
@@ -1213,6 +1228,24 @@ TcpSocketBase::ForwardUp(Ptr<Packet> packet,
                          uint16_t port,
                          Ptr<Ipv4Interface> incomingInterface)
 {
+    SegmentationOffloadTag offload;
+    if (!m_gro && packet->PeekPacketTag(offload))
+    {
+        // process the segments of an aggregate one by one
+        TcpHeader tcpHeader;
+        packet->RemoveHeader(tcpHeader);
+        for (auto& [segment, segmentHeader] : TcpL4Protocol::Segment(packet, tcpHeader))
+        {
+            if (m_endPoint == nullptr)
+            {
+                break;
+            }
+            segment->AddHeader(segmentHeader);
+            ForwardUp(segment, header, port, incomingInterface);
+        }
+        return;
+    }
+
     NS_LOG_LOGIC("Socket " << this << " forward up " << m_endPoint->GetPeerAddress() << ":"
                            << m_endPoint->GetPeerPort() << " to " << m_endPoint->GetLocalAddress()
                            << ":" << m_endPoint->GetLocalPort());
@@ -1253,6 +1286,24 @@ TcpSocketBase::ForwardUp6(Ptr<Packet> packet,
                           uint16_t port,
                           Ptr<Ipv6Interface> incomingInterface)
 {
+    SegmentationOffloadTag offload;
+    if (!m_gro && packet->PeekPacketTag(offload))
+    {
+        // process the segments of an aggregate one by one
+        TcpHeader tcpHeader;
+        packet->RemoveHeader(tcpHeader);
+        for (auto& [segment, segmentHeader] : TcpL4Protocol::Segment(packet, tcpHeader))
+        {
+            if (m_endPoint6 == nullptr)
+            {
+                break;
+            }
+            segment->AddHeader(segmentHeader);
+            ForwardUp6(segment, header, port, incomingInterface);
+        }
+        return;
+    }
+
     NS_LOG_LOGIC("Socket " << this << " forward up " << m_endPoint6->GetPeerAddress() << ":"
                            << m_endPoint6->GetPeerPort() << " to " << m_endPoint6->GetLocalAddress()
                            << ":" << m_endPoint6->GetLocalPort());
@@ -2780,6 +2831,9 @@ TcpSocketBase::SendEmptyPacket(uint8_t flags)
 {
     NS_LOG_FUNCTION(this << static_cast<uint32_t>(flags));
 
+    // the segments aggregated so far are sent first
+    SendAggregate();
+
     if (m_endPoint == nullptr && m_endPoint6 == nullptr)
     {
         NS_LOG_WARN("Failed to send empty packet due to null endpoint");
@@ -3305,24 +3359,15 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
         }
     }
 
+    SendSegment(p, header, isRetransmission);
     if (m_endPoint)
     {
-        m_tcp->SendPacket(p,
-                          header,
-                          m_endPoint->GetLocalAddress(),
-                          m_endPoint->GetPeerAddress(),
-                          m_boundnetdevice);
         NS_LOG_DEBUG("Send segment of size "
                      << sz << " with remaining data " << remainingData << " via TcpL4Protocol to "
                      << m_endPoint->GetPeerAddress() << ". Header " << header);
     }
     else
     {
-        m_tcp->SendPacket(p,
-                          header,
-                          m_endPoint6->GetLocalAddress(),
-                          m_endPoint6->GetPeerAddress(),
-                          m_boundnetdevice);
         NS_LOG_DEBUG("Send segment of size "
                      << sz << " with remaining data " << remainingData << " via TcpL4Protocol to "
                      << m_endPoint6->GetPeerAddress() << ". Header " << header);
@@ -3345,7 +3390,11 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
     }
 
     // Notify the application of the data being sent unless this is a retransmit
-    if (!isRetransmission)
+    if (!isRetransmission && m_tsoBatching)
+    {
+        m_tsoDataSent += (seq + sz - m_tcb->m_highTxMark.Get());
+    }
+    else if (!isRetransmission)
     {
         Simulator::ScheduleNow(&TcpSocketBase::NotifyDataSent,
                                this,
@@ -3399,6 +3448,11 @@ TcpSocketBase::SendPendingData(bool withAck)
     uint32_t nPacketsSent = 0;
     uint32_t availableWindow = AvailableWindow();
 
+    // With the segmentation offload, the segments sent are aggregated, and
+    // the application is notified once of the data sent
+    bool batching = m_tsoBatching;
+    m_tsoBatching = m_tsoMaxSegments > 1;
+
     // RFC 6675, Section (C)
     // If cwnd - pipe >= 1 SMSS, the sender SHOULD transmit one or more
     // segments as follows:
@@ -3522,6 +3576,17 @@ TcpSocketBase::SendPendingData(bool withAck)
         // loop again!
     }
 
+    m_tsoBatching = batching;
+    if (!m_tsoBatching)
+    {
+        SendAggregate();
+        if (m_tsoDataSent > 0)
+        {
+            Simulator::ScheduleNow(&TcpSocketBase::NotifyDataSent, this, m_tsoDataSent);
+            m_tsoDataSent = 0;
+        }
+    }
+
     if (nPacketsSent > 0)
     {
         if (!m_sackEnabled)
@@ -3542,6 +3607,99 @@ TcpSocketBase::SendPendingData(bool withAck)
     return nPacketsSent;
 }
 
+void
+TcpSocketBase::SendSegment(Ptr<Packet> packet, const TcpHeader& header, bool isRetransmission)
+{
+    NS_LOG_FUNCTION(this << packet << header << isRetransmission);
+
+    // Only the new data is aggregated, in full-sized segments but the last
+    // one, with the same header as the first one but the sequence number.
+    // The aggregate must fit the IP total length, with the largest headers.
+    bool aggregable = m_tsoBatching && !isRetransmission &&
+                      (header.GetFlags() & (TcpHeader::SYN | TcpHeader::FIN | TcpHeader::RST)) == 0;
+    if (aggregable && m_tsoPacket)
+    {
+        uint32_t size = m_tsoPacket->GetSize();
+        if (size == m_tsoSegments * m_tcb->m_segmentSize &&
+            header.GetSequenceNumber() == m_tsoHeader.GetSequenceNumber() + size &&
+            header.GetFlags() == m_tsoHeader.GetFlags() &&
+            header.GetAckNumber() == m_tsoHeader.GetAckNumber() &&
+            header.GetWindowSize() == m_tsoHeader.GetWindowSize() &&
+            header.GetSerializedSize() == m_tsoHeader.GetSerializedSize() &&
+            size + packet->GetSize() <= 65535 - 20 - 60)
+        {
+            m_tsoPacket->AddAtEnd(packet);
+            if (++m_tsoSegments >= m_tsoMaxSegments)
+            {
+                SendAggregate();
+            }
+            return;
+        }
+    }
+    SendAggregate();
+    if (aggregable)
+    {
+        // the packet may be held by the trace sinks: append to a copy
+        m_tsoPacket = packet->Copy();
+        m_tsoHeader = header;
+        m_tsoSegments = 1;
+        return;
+    }
+
+    if (m_endPoint)
+    {
+        m_tcp->SendPacket(packet,
+                          header,
+                          m_endPoint->GetLocalAddress(),
+                          m_endPoint->GetPeerAddress(),
+                          m_boundnetdevice);
+    }
+    else
+    {
+        m_tcp->SendPacket(packet,
+                          header,
+                          m_endPoint6->GetLocalAddress(),
+                          m_endPoint6->GetPeerAddress(),
+                          m_boundnetdevice);
+    }
+}
+
+void
+TcpSocketBase::SendAggregate()
+{
+    if (!m_tsoPacket)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+
+    Ptr<Packet> packet = m_tsoPacket;
+    m_tsoPacket = nullptr;
+    if (m_tsoSegments > 1)
+    {
+        NS_LOG_DEBUG("Send an aggregate of " << m_tsoSegments << " segments of "
+                                             << packet->GetSize() << " bytes");
+        packet->AddPacketTag(SegmentationOffloadTag(m_tcb->m_segmentSize, packet->GetSize()));
+    }
+
+    if (m_endPoint)
+    {
+        m_tcp->SendPacket(packet,
+                          m_tsoHeader,
+                          m_endPoint->GetLocalAddress(),
+                          m_endPoint->GetPeerAddress(),
+                          m_boundnetdevice);
+    }
+    else if (m_endPoint6)
+    {
+        m_tcp->SendPacket(packet,
+                          m_tsoHeader,
+                          m_endPoint6->GetLocalAddress(),
+                          m_endPoint6->GetPeerAddress(),
+                          m_boundnetdevice);
+    }
+}
+
 uint32_t
 TcpSocketBase::UnAckDataCount() const
 {
@@ -3622,6 +3780,11 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     NS_LOG_DEBUG("Data segment, seq=" << tcpHeader.GetSequenceNumber()
                                       << " pkt size=" << p->GetSize());
 
+    // An aggregate, processed as a single segment, counts as its segments
+    // for the delayed ACKs
+    SegmentationOffloadTag offload;
+    uint32_t segments = p->RemovePacketTag(offload) ? offload.GetSegments() : 1;
+
     // Put into Rx buffer
     SequenceNumber32 expectedSeq = m_tcb->m_rxBuffer->NextRxSequence();
     if (!m_tcb->m_rxBuffer->Add(p, tcpHeader))
@@ -3678,7 +3841,8 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     }
     else
     { // In-sequence packet: ACK if delayed ack count allows
-        if (++m_delAckCount >= m_delAckMaxCount)
+        m_delAckCount += segments;
+        if (m_delAckCount >= m_delAckMaxCount)
         {
             m_delAckEvent.Cancel();
             m_delAckCount = 0;
@@ -11,6 +11,7 @@
 
 #include "ipv4-header.h"
 #include "ipv6-header.h"
+#include "tcp-header.h"
 #include "tcp-socket-state.h"
 #include "tcp-socket.h"
 
@@ -31,7 +32,6 @@ class Ipv6EndPoint;
 class Node;
 class Packet;
 class TcpL4Protocol;
-class TcpHeader;
 class TcpCongestionOps;
 class TcpRecoveryOps;
 class RttEstimator;
@@ -204,6 +204,27 @@ class RttHistory
  * you need more information. The reference paper is
  * https://dl.acm.org/citation.cfm?id=3067666.
  *
+ * Segmentation offload
+ * --------------------
+ *
+ * With the "TsoMaxSegments" attribute greater than 1, the consecutive
+ * full-sized segments of new data sent by SendPendingData are handed down
+ * to TcpL4Protocol as a single packet, with the header of the first one
+ * and a SegmentationOffloadTag, up to TsoMaxSegments of them and 64 KB.
+ * The state of the connection (the scoreboard, the RTT history, the rate
+ * sampling and the traces) is updated per segment, as without the offload:
+ * only the packets sent down the stack change.  The aggregate is split in
+ * its segments at the output device if it supports the offload (e.g., the
+ * PointToPointNetDevice transmits it at once, taking the time of all its
+ * segments), or by TcpL4Protocol otherwise.
+ *
+ * The receiver splits the aggregates in their segments before processing
+ * them, unless the "Gro" attribute is set: the aggregate is then processed
+ * as a single segment, as with the generic receive offload of Linux, and is
+ * acknowledged at once.  Fewer ACKs are then sent, each acknowledging more
+ * bytes, which the congestion controls counting the ACKs rather than the
+ * bytes acknowledged (e.g., the slow start of TcpNewReno) grow slower with.
+ *
  */
 class TcpSocketBase : public TcpSocket
 {
@@ -848,6 +869,21 @@ class TcpSocketBase : public TcpSocket
      */
     uint32_t SendPendingData(bool withAck = false);
 
+    /**
+     * \brief Send a segment to TcpL4Protocol, or append it to the aggregate
+     * of segments sent with the segmentation offload.
+     *
+     * \param packet the payload of the segment
+     * \param header the TCP header of the segment
+     * \param isRetransmission whether the segment is a retransmission
+     */
+    void SendSegment(Ptr<Packet> packet, const TcpHeader& header, bool isRetransmission);
+
+    /**
+     * \brief Send the aggregate of segments, if any, to TcpL4Protocol.
+     */
+    void SendAggregate();
+
     /**
      * \brief Extract at most maxSize bytes from the TxBuffer at sequence seq, add the
      *        TCP header, and send to TcpL4Protocol
@@ -1375,6 +1411,15 @@ class TcpSocketBase : public TcpSocket
     // History of RTT
     std::deque<RttHistory> m_history; //!< List of sent packet
 
+    // Segmentation offload
+    uint32_t m_tsoMaxSegments{1}; //!< Maximum number of segments of an aggregate
+    bool m_gro{false};            //!< Process the aggregates received as a single segment
+    bool m_tsoBatching{false};    //!< Whether the segments sent are aggregated
+    Ptr<Packet> m_tsoPacket;      //!< Payload of the aggregate being sent
+    TcpHeader m_tsoHeader;        //!< TCP header of the aggregate being sent
+    uint32_t m_tsoSegments{0};    //!< Number of segments of the aggregate being sent
+    uint32_t m_tsoDataSent{0};    //!< Bytes of new data sent, not yet notified
+
     // Connections to other layers of TCP/IP
     Ipv4EndPoint* m_endPoint{nullptr};  //!< the IPv4 endpoint
     Ipv6EndPoint* m_endPoint6{nullptr}; //!< the IPv6 endpoint
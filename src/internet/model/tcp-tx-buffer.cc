@@ -32,6 +32,16 @@ TcpTxBuffer::GetTypeId()
                             .SetParent<Object>()
                             .SetGroupName("Internet")
                             .AddConstructor<TcpTxBuffer>()
+                            .SetMemoryEstimator([](const ObjectBase* object) -> std::size_t {
+                                auto buffer = static_cast<const TcpTxBuffer*>(object);
+                                std::size_t items =
+                                    buffer->m_appList.size() + buffer->m_sentList.size();
+                                // the bytes of the packets are accounted
+                                // for by their buffers
+                                return items * (sizeof(TcpTxItem) + 3 * sizeof(void*)) +
+                                       buffer->m_sentIndex.size() *
+                                           (sizeof(SentIndex::value_type) + 4 * sizeof(void*));
+                            })
                             .AddTraceSource("UnackSequence",
                                             "First unacknowledged sequence number (SND.UNA)",
                                             MakeTraceSourceAccessor(&TcpTxBuffer::m_firstByteSeq),
@@ -50,7 +60,9 @@ TcpTxBuffer::TcpTxBuffer(uint32_t n)
     : m_maxBuffer(32768),
       m_size(0),
       m_sentSize(0),
-      m_firstByteSeq(n)
+      m_firstByteSeq(n),
+      m_lostUpTo(n),
+      m_retransUpTo(n)
 {
     m_rWndCallback = MakeNullCallback<uint32_t>();
 }
@@ -165,6 +177,8 @@ TcpTxBuffer::SetHeadSequence(const SequenceNumber32& seq)
     NS_ASSERT(m_sentList.empty());
     m_sackSeen = false;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostUpTo = seq;
+    m_retransUpTo = seq;
 }
 
 bool
@@ -280,12 +294,12 @@ TcpTxBuffer::GetNewSegment(uint32_t numBytes)
     TcpTxItem* item = GetPacketFromList(m_appList, startOfAppList, numBytes, startOfAppList);
     item->m_startSeq = startOfAppList;
 
-    // Move item from AppList to SentList (should be the first, not too complex)
-    auto it = std::find(m_appList.begin(), m_appList.end(), item);
-    NS_ASSERT(it != m_appList.end());
+    // Move item from AppList to SentList (it is the first of the AppList)
+    NS_ASSERT(!m_appList.empty() && m_appList.front() == item);
 
-    m_appList.erase(it);
-    m_sentList.insert(m_sentList.end(), item);
+    m_appList.pop_front();
+    m_sentList.push_back(item);
+    m_sentIndex.emplace_hint(m_sentIndex.end(), item->m_startSeq, std::prev(m_sentList.end()));
     m_sentSize += item->m_packet->GetSize();
 
     return item;
@@ -299,37 +313,32 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     NS_ASSERT(numBytes <= m_sentSize);
     NS_ASSERT(!m_sentList.empty());
 
-    auto it = m_sentList.begin();
+    auto it = FindSentItem(seq);
     bool listEdited = false;
     uint32_t s = numBytes;
 
     // Avoid to merge different packet for this retransmission if flags are
     // different.
-    for (; it != m_sentList.end(); ++it)
+    if (it != m_sentList.end() && (*it)->m_startSeq == seq)
     {
-        if ((*it)->m_startSeq == seq)
+        auto next = std::next(it);
+        if (next != m_sentList.end())
         {
-            auto next = it;
-            next++;
-            if (next != m_sentList.end())
+            // Next is not sacked and have the same value for m_lost ... there is the
+            // possibility to merge
+            if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-                // Next is not sacked and have the same value for m_lost ... there is the
-                // possibility to merge
-                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                    s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
-                }
-                else
-                {
-                    // Next is sacked... better to retransmit only the first segment
-                    s = std::min(s, (*it)->m_packet->GetSize());
-                }
+                s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
             }
             else
             {
+                // Next is sacked... better to retransmit only the first segment
                 s = std::min(s, (*it)->m_packet->GetSize());
             }
-            break;
+        }
+        else
+        {
+            s = std::min(s, (*it)->m_packet->GetSize());
         }
     }
 
@@ -391,7 +400,7 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                const SequenceNumber32& listStartFrom,
                                uint32_t numBytes,
                                const SequenceNumber32& seq,
-                               bool* listEdited) const
+                               bool* listEdited)
 {
     NS_LOG_FUNCTION(this << numBytes << seq);
 
@@ -425,14 +434,25 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     Ptr<Packet> currentPacket = nullptr;
     TcpTxItem* currentItem = nullptr;
     TcpTxItem* outItem = nullptr;
-    auto it = list.begin();
+    bool isSentList = (&list == &m_sentList);
+    PacketList::const_iterator it = list.begin();
     SequenceNumber32 beginOfCurrentPacket = listStartFrom;
 
+    if (isSentList)
+    {
+        // Start from the item holding seq, instead of walking the list
+        it = FindSentItem(seq);
+        if (it != list.end())
+        {
+            beginOfCurrentPacket = (*it)->m_startSeq;
+        }
+    }
+
     while (it != list.end())
     {
         currentItem = *it;
         currentPacket = currentItem->m_packet;
-        NS_ASSERT_MSG(list != m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
+        NS_ASSERT_MSG(!isSentList || currentItem->m_startSeq >= m_firstByteSeq,
                       "start: " << m_firstByteSeq
                                 << " currentItem start: " << currentItem->m_startSeq);
 
@@ -461,7 +481,12 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, seq - beginOfCurrentPacket);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstPartIt = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    AddToIndex(firstPartIt);
+                    AddToIndex(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -508,6 +533,10 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                     TcpTxItem* previous = *(--it);
 
                     list.erase(it);
+                    if (isSentList)
+                    {
+                        m_sentIndex.erase(currentItem->m_startSeq);
+                    }
 
                     MergeItems(previous, currentItem);
                     delete currentItem;
@@ -527,7 +556,12 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, numBytes);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstPartIt = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    AddToIndex(firstPartIt);
+                    AddToIndex(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -557,6 +591,10 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
 
             MergeItems(currentItem, next);
             list.erase(it);
+            if (isSentList)
+            {
+                m_sentIndex.erase(next->m_startSeq);
+            }
 
             delete next;
 
@@ -573,6 +611,33 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     return nullptr; // Silence compiler warning about lack of return value
 }
 
+TcpTxBuffer::PacketList::const_iterator
+TcpTxBuffer::FindSentItem(const SequenceNumber32& seq) const
+{
+    NS_LOG_FUNCTION(this << seq);
+
+    // The last item starting at, or before, seq
+    auto index = m_sentIndex.upper_bound(seq);
+    if (index == m_sentIndex.begin())
+    {
+        return m_sentList.end();
+    }
+    --index;
+
+    const TcpTxItem* item = *index->second;
+    if (seq < item->m_startSeq + item->m_packet->GetSize())
+    {
+        return index->second;
+    }
+    return m_sentList.end();
+}
+
+void
+TcpTxBuffer::AddToIndex(PacketList::const_iterator it)
+{
+    m_sentIndex.insert_or_assign((*it)->m_startSeq, it);
+}
+
 void
 TcpTxBuffer::MergeItems(TcpTxItem* t1, TcpTxItem* t2) const
 {
@@ -589,6 +654,8 @@ TcpTxBuffer::MergeItems(TcpTxItem* t1, TcpTxItem* t2) const
     // be updated in MarkTransmittedSegment.
     if (t1->m_retrans != t2->m_retrans)
     {
+        // The merged item is not retransmitted anymore
+        m_retransUpTo = m_firstByteSeq;
         if (t1->m_retrans)
         {
             auto self = const_cast<TcpTxBuffer*>(this);
@@ -640,16 +707,18 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked(const SequenceNumber32& ack) const
 {
     NS_LOG_FUNCTION(this);
-    for (const auto& it : m_sentList)
+
+    // Only the item before the one starting at ack can end at ack
+    auto index = m_sentIndex.lower_bound(ack);
+    if (index == m_sentIndex.begin())
     {
-        TcpTxItem* item = it;
-        Ptr<Packet> p = item->m_packet;
-        if (item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    --index;
+
+    const TcpTxItem* item = *index->second;
+    return item->m_startSeq + item->m_packet->GetSize() == ack && !item->m_sacked &&
+           item->m_retrans;
 }
 
 void
@@ -697,6 +766,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
 
             RemoveFromCounts(item, pktSize);
 
+            m_sentIndex.erase(item->m_startSeq);
             i = m_sentList.erase(i);
             NS_LOG_INFO("Removed " << *item << " lost: " << m_lostOut << " retrans: " << m_retrans
                                    << " sacked: " << m_sackedOut << ". Remaining data " << m_size);
@@ -715,7 +785,9 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             NS_LOG_INFO(*item);
             // PacketTags are preserved when fragmenting
             item->m_packet = item->m_packet->CreateFragment(offset, pktSize);
+            m_sentIndex.erase(item->m_startSeq);
             item->m_startSeq += offset;
+            AddToIndex(i);
             m_size -= offset;
             m_sentSize -= offset;
             m_firstByteSeq += offset;
@@ -745,6 +817,8 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             // when adding Reno dupacks in the count.
             head->m_sacked = false;
             m_sackedOut -= head->m_packet->GetSize();
+            m_lostUpTo = m_firstByteSeq;
+            m_retransUpTo = m_firstByteSeq;
             NS_LOG_INFO("Moving the SACK flag from the HEAD to another segment");
             AddRenoSack();
             MarkHeadAsLost();
@@ -761,6 +835,10 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
         m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
     }
 
+    // Keep the markers within the sent data, where the sequence numbers compare
+    m_lostUpTo = std::max(m_lostUpTo, m_firstByteSeq.Get());
+    m_retransUpTo = std::max(m_retransUpTo, m_firstByteSeq.Get());
+
     NS_LOG_DEBUG("Discarded up to " << seq << " lost: " << m_lostOut << " retrans: " << m_retrans
                                     << " sacked: " << m_sackedOut);
     NS_LOG_LOGIC("Buffer status after discarding data " << *this);
@@ -779,15 +857,20 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
 
     for (auto option_it = list.begin(); option_it != list.end(); ++option_it)
     {
-        auto item_it = m_sentList.begin();
-        SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
         if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
             NS_LOG_INFO("Not updating scoreboard, the option block is outside the sent list");
             return bytesSacked;
         }
 
+        // Start from the first item not before the block: the items before
+        // cannot be covered by it
+        auto index = m_sentIndex.lower_bound((*option_it).first);
+        auto item_it = (index == m_sentIndex.end()) ? m_sentList.end() : index->second;
+        SequenceNumber32 beginOfCurrentPacket = (item_it == m_sentList.end())
+                                                    ? m_firstByteSeq.Get() + m_sentSize
+                                                    : (*item_it)->m_startSeq;
+
         while (item_it != m_sentList.end())
         {
             uint32_t pktSize = (*item_it)->m_packet->GetSize();
@@ -869,7 +952,7 @@ TcpTxBuffer::UpdateLostCount()
 {
     NS_LOG_FUNCTION(this);
     uint32_t sacked = 0;
-    SequenceNumber32 beginOfCurrentPacket = m_highestSack.second;
+    SequenceNumber32 lostUpTo = m_lostUpTo;
     if (m_highestSack.first == m_sentList.end())
     {
         NS_LOG_INFO("Status before the update: " << *this
@@ -884,6 +967,12 @@ TcpTxBuffer::UpdateLostCount()
     for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
     {
         TcpTxItem* item = *it;
+        if (sacked >= m_dupAckThresh && item->m_startSeq < m_lostUpTo)
+        {
+            // This item, and the ones before, are already lost or sacked
+            break;
+        }
+
         if (item->m_sacked)
         {
             sacked++;
@@ -896,9 +985,14 @@ TcpTxBuffer::UpdateLostCount()
                 item->m_lost = true;
                 m_lostOut += item->m_packet->GetSize();
             }
+            else if (item->m_sacked && sacked == m_dupAckThresh)
+            {
+                // Every item before this one is going to be lost or sacked
+                lostUpTo = std::max(lostUpTo, item->m_startSeq);
+            }
         }
-        beginOfCurrentPacket -= item->m_packet->GetSize();
     }
+    m_lostUpTo = lostUpTo;
 
     if (sacked >= m_dupAckThresh)
     {
@@ -923,24 +1017,19 @@ TcpTxBuffer::IsLost(const SequenceNumber32& seq) const
         return false;
     }
 
-    // In theory, using a map and hints when inserting elements can improve
-    // performance
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    auto it = FindSentItem(seq);
+    if (it != m_sentList.end())
     {
-        // Search for the right iterator before calling IsLost()
-        if ((*it)->m_startSeq <= seq && seq < (*it)->m_startSeq + (*it)->m_packet->GetSize())
+        if ((*it)->m_lost)
         {
-            if ((*it)->m_lost)
-            {
-                NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
-                return true;
-            }
+            NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
+            return true;
+        }
 
-            if ((*it)->m_sacked)
-            {
-                NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
-                return false;
-            }
+        if ((*it)->m_sacked)
+        {
+            NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
+            return false;
         }
     }
 
@@ -968,12 +1057,23 @@ TcpTxBuffer::NextSeg(SequenceNumber32* seq, SequenceNumber32* seqHigh, bool isRe
     TcpTxItem* item;
     SequenceNumber32 seqPerRule3;
     bool isSeqPerRule3Valid = false;
-    SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
 
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    // The items before m_retransUpTo are retransmitted or sacked: start after them
+    auto it = FindSentItem(m_retransUpTo);
+    SequenceNumber32 beginOfCurrentPkt =
+        (it == m_sentList.end()) ? m_firstByteSeq.Get() + m_sentSize : (*it)->m_startSeq;
+    bool isRetransUpToFound = false;
+
+    for (; it != m_sentList.end(); ++it)
     {
         item = *it;
 
+        if (!isRetransUpToFound && !item->m_retrans && !item->m_sacked)
+        {
+            isRetransUpToFound = true;
+            m_retransUpTo = beginOfCurrentPkt;
+        }
+
         // Condition 1.a , 1.b , and 1.c
         if (!item->m_retrans && !item->m_sacked &&
             ((m_sackSeen && item->m_startSeq < m_highestSack.second) || !m_sackSeen))
@@ -997,6 +1097,11 @@ TcpTxBuffer::NextSeg(SequenceNumber32* seq, SequenceNumber32* seqHigh, bool isRe
         beginOfCurrentPkt += item->m_packet->GetSize();
     }
 
+    if (!isRetransUpToFound)
+    {
+        m_retransUpTo = beginOfCurrentPkt;
+    }
+
     /* (2) If no sequence number 'S2' per rule (1) exists but there
      *     exists available unsent data and the receiver's advertised
      *     window allows, the sequence range of one segment of up to SMSS
@@ -1207,6 +1312,8 @@ TcpTxBuffer::ResetRenoSack()
 
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
     m_sackSeen = false;
+    m_lostUpTo = m_firstByteSeq;
+    m_retransUpTo = m_firstByteSeq;
 }
 
 void
@@ -1230,6 +1337,7 @@ TcpTxBuffer::ResetSentList()
         m_appList.push_front(item);
         m_sentList.pop_back();
     }
+    m_sentIndex.clear();
 
     m_sentSize = 0;
     m_lostOut = 0;
@@ -1237,6 +1345,8 @@ TcpTxBuffer::ResetSentList()
     m_sackedOut = 0;
     m_sackSeen = false;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostUpTo = m_firstByteSeq;
+    m_retransUpTo = m_firstByteSeq;
 }
 
 void
@@ -1247,6 +1357,7 @@ TcpTxBuffer::ResetLastSegmentSent()
     {
         TcpTxItem* item = m_sentList.back();
 
+        m_sentIndex.erase(item->m_startSeq);
         m_sentList.pop_back();
         m_sentSize -= item->m_packet->GetSize();
         if (item->m_retrans)
@@ -1254,6 +1365,8 @@ TcpTxBuffer::ResetLastSegmentSent()
             m_retrans -= item->m_packet->GetSize();
         }
         m_appList.insert(m_appList.begin(), item);
+        m_lostUpTo = m_firstByteSeq;
+        m_retransUpTo = m_firstByteSeq;
     }
     ConsistencyCheck();
 }
@@ -1263,6 +1376,7 @@ TcpTxBuffer::SetSentListLost(bool resetSack)
 {
     NS_LOG_FUNCTION(this);
     m_retrans = 0;
+    m_retransUpTo = m_firstByteSeq;
 
     if (resetSack)
     {
@@ -1333,6 +1447,7 @@ TcpTxBuffer::DeleteRetransmittedFlagFromHead()
     {
         m_sentList.front()->m_retrans = false;
         m_retrans -= m_sentList.front()->m_packet->GetSize();
+        m_retransUpTo = m_firstByteSeq;
     }
     ConsistencyCheck();
 }
@@ -1342,6 +1457,9 @@ TcpTxBuffer::MarkHeadAsLost()
 {
     if (!m_sentList.empty())
     {
+        // The head is not retransmitted, nor sacked, anymore
+        m_retransUpTo = m_firstByteSeq;
+
         // If the head is sacked (reneging by the receiver the previously sent
         // information) we revert the sacked flag.
         // A sacked head means that we should advance SND.UNA.. so it's an error.
@@ -1444,6 +1562,20 @@ TcpTxBuffer::ConsistencyCheck() const
     NS_ASSERT_MSG(lost == m_lostOut, " Counted lost: " << lost << " stored lost: " << m_lostOut);
     NS_ASSERT_MSG(retrans == m_retrans,
                   " Counted retrans: " << retrans << " stored retrans: " << m_retrans);
+
+    NS_ASSERT_MSG(m_sentIndex.size() == m_sentList.size(),
+                  "Indexed items: " << m_sentIndex.size() << " sent items: " << m_sentList.size());
+    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    {
+        auto index = m_sentIndex.find((*it)->m_startSeq);
+        NS_ASSERT_MSG(index != m_sentIndex.end() && index->second == it,
+                      "Item " << **it << " not indexed");
+        NS_ASSERT_MSG((*it)->m_startSeq >= m_lostUpTo || (*it)->m_lost || (*it)->m_sacked,
+                      "Item " << **it << " before " << m_lostUpTo << " not lost");
+        NS_ASSERT_MSG((*it)->m_startSeq >= m_retransUpTo || (*it)->m_retrans ||
+                          (*it)->m_sacked,
+                      "Item " << **it << " before " << m_retransUpTo << " not retransmitted");
+    }
 }
 
 std::ostream&
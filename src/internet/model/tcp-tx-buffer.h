@@ -17,6 +17,9 @@
 #include "ns3/sequence-number.h"
 #include "ns3/traced-value.h"
 
+#include <list>
+#include <map>
+
 namespace ns3
 {
 class Packet;
@@ -60,8 +63,17 @@ class Packet;
  * associated with every segment sent. This is done through the use of the
  * class TcpTxItem: instead of storing a list of packets, we store a list of
  * TcpTxItem. Each item has different flags (check the corresponding
- * documentation) and maintaining the scoreboard is a matter of travelling the
- * list and set the SACK flag on the corresponding segment sent.
+ * documentation) and maintaining the scoreboard is a matter of finding the
+ * items covered by a SACK block and set the SACK flag on them.
+ *
+ * With large windows, the SentList holds tens of thousands of items, and
+ * walking it for each ACK dominates the cost of the connection. The items
+ * of the SentList are therefore also indexed by their starting sequence
+ * number, so that the item holding a sequence is found in logarithmic time
+ * (e.g., for a SACK block, a retransmission, or IsLost). The loss marking
+ * (UpdateLostCount) and NextSeg also remember up to which sequence the
+ * items are already lost, or retransmitted, so that they only visit the
+ * items whose flags may have changed since their previous call.
  *
  * Item properties
  * ---------------
@@ -417,8 +429,8 @@ class TcpTxBuffer : public Object
      * The {New}Reno cases, for now, are managed in TcpSocketBase through the
      * call to MarkHeadAsLost.
      * This function is, therefore, called after a SACK option has been received,
-     * and updates the lost count. It can be probably optimized by not walking
-     * the entire list, but a subset.
+     * and updates the lost count. The walk starts from the highest sacked
+     * item, and stops at m_lostUpTo once the items below are marked.
      *
      */
     void UpdateLostCount();
@@ -553,7 +565,24 @@ class TcpTxBuffer : public Object
                                  const SequenceNumber32& startingSeq,
                                  uint32_t numBytes,
                                  const SequenceNumber32& requestedSeq,
-                                 bool* listEdited = nullptr) const;
+                                 bool* listEdited = nullptr);
+
+    /**
+     * \brief Find the item of the SentList holding a sequence number
+     * \param seq Sequence
+     * \return an iterator to the item, or the end of the SentList
+     */
+    PacketList::const_iterator FindSentItem(const SequenceNumber32& seq) const;
+
+    /**
+     * \brief Index an item of the SentList by its starting sequence number
+     *
+     * The item replaces any item indexed with the same sequence number,
+     * e.g., the item it was split from.
+     *
+     * \param it Iterator to the item
+     */
+    void AddToIndex(PacketList::const_iterator it);
 
     /**
      * \brief Merge two TcpTxItem
@@ -602,6 +631,14 @@ class TcpTxBuffer : public Object
         m_firstByteSeq; //!< Sequence number of the first byte in data (SND.UNA)
     std::pair<PacketList::const_iterator, SequenceNumber32> m_highestSack; //!< Highest SACK byte
 
+    /// Index of the SentList items, by starting sequence number
+    typedef std::map<SequenceNumber32, PacketList::const_iterator> SentIndex;
+
+    SentIndex m_sentIndex;       //!< Items of the SentList, by starting sequence number
+    SequenceNumber32 m_lostUpTo; //!< The items starting before are lost or sacked
+    mutable SequenceNumber32
+        m_retransUpTo; //!< The items starting before are retransmitted or sacked
+
     uint32_t m_lostOut{0};   //!< Number of lost bytes
     uint32_t m_sackedOut{0}; //!< Number of sacked bytes
     uint32_t m_retrans{0};   //!< Number of retransmitted bytes
@@ -0,0 +1,254 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface-address.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup internet-test
+ * Ipv4EndPointDemux and Ipv6EndPointDemux test suite.
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check the endpoints found by an Ipv4EndPointDemux, as they are
+ * allocated, connected and deallocated.
+ */
+class Ipv4EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv4EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4EndPointDemuxTestCase::Ipv4EndPointDemuxTestCase()
+    : TestCase("Check the IPv4 endpoints looked up")
+{
+}
+
+void
+Ipv4EndPointDemuxTestCase::DoRun()
+{
+    Ipv4EndPointDemux demux;
+    auto interface = CreateObject<Ipv4Interface>();
+    interface->AddAddress(Ipv4InterfaceAddress("10.0.0.1", "255.255.255.0"));
+    Ipv4Address server("10.0.0.1");
+
+    // A listening socket and the connections it accepted
+    Ipv4EndPoint* listener = demux.Allocate(nullptr, Ipv4Address::GetAny(), 80);
+    std::vector<Ipv4EndPoint*> connections;
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        connections.push_back(
+            demux.Allocate(nullptr, server, 80, Ipv4Address(0x0a000100 + i), 1000 + i));
+    }
+    NS_TEST_ASSERT_MSG_EQ(demux.Allocate(nullptr, server, 80, "10.0.1.0", 1000),
+                          nullptr,
+                          "Duplicated endpoint");
+
+    for (uint32_t i = 0; i < connections.size(); i++)
+    {
+        Ipv4Address peer(0x0a000100 + i);
+        auto endPoints = demux.Lookup(server, 80, peer, 1000 + i, interface);
+        NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "One endpoint for connection " << i);
+        NS_TEST_ASSERT_MSG_EQ(endPoints.front(), connections[i], "Connection " << i);
+        NS_TEST_ASSERT_MSG_EQ(demux.SimpleLookup(server, 80, peer, 1000 + i),
+                              connections[i],
+                              "Connection " << i);
+    }
+    auto endPoints = demux.Lookup(server, 80, "10.0.2.1", 2000, interface);
+    NS_TEST_ASSERT_MSG_EQ((endPoints == Ipv4EndPointDemux::EndPoints{listener}),
+                          true,
+                          "New connection to the listener");
+    NS_TEST_ASSERT_MSG_EQ(demux.Lookup(server, 81, "10.0.2.1", 2000, interface).empty(),
+                          true,
+                          "No endpoint on another port");
+
+    // The endpoints with a peer port or a peer address left unspecified
+    // are candidates, and ranked below the listener, as by the linear scan
+    Ipv4EndPoint* anyPort = demux.Allocate(nullptr, server, 80, "10.0.4.1", 0);
+    Ipv4EndPoint* anyAddress = demux.Allocate(nullptr, server, 80, Ipv4Address::GetAny(), 4000);
+    NS_TEST_ASSERT_MSG_NE(anyPort, nullptr, "Endpoint (10.0.4.1, 0) allocated");
+    NS_TEST_ASSERT_MSG_NE(anyAddress, nullptr, "Endpoint (Any, 4000) allocated");
+    endPoints = demux.Lookup(server, 80, "10.0.4.1", 4000, interface);
+    NS_TEST_ASSERT_MSG_EQ((endPoints == Ipv4EndPointDemux::EndPoints{listener}),
+                          true,
+                          "Peers (10.0.4.1, 0) and (Any, 4000)");
+    Ipv4EndPoint* exact = demux.Allocate(nullptr, server, 80, "10.0.4.1", 4000);
+    endPoints = demux.Lookup(server, 80, "10.0.4.1", 4000, interface);
+    NS_TEST_ASSERT_MSG_EQ((endPoints == Ipv4EndPointDemux::EndPoints{exact}),
+                          true,
+                          "Exact peer preferred");
+    demux.DeAllocate(exact);
+    demux.DeAllocate(anyAddress);
+    demux.DeAllocate(anyPort);
+
+    // Disabled and deallocated endpoints are skipped
+    connections[1]->SetRxEnabled(false);
+    endPoints = demux.Lookup(server, 80, "10.0.1.1", 1001, interface);
+    NS_TEST_ASSERT_MSG_EQ((endPoints == Ipv4EndPointDemux::EndPoints{listener}),
+                          true,
+                          "Disabled endpoint skipped");
+    demux.DeAllocate(connections[2]);
+    endPoints = demux.Lookup(server, 80, "10.0.1.2", 1002, interface);
+    NS_TEST_ASSERT_MSG_EQ((endPoints == Ipv4EndPointDemux::EndPoints{listener}),
+                          true,
+                          "Deallocated endpoint removed");
+    NS_TEST_ASSERT_MSG_EQ(demux.GetAllEndPoints().size(), 100, "Endpoints left");
+
+    // A client socket, bound to an ephemeral port, then connected
+    Ipv4EndPoint* client = demux.Allocate();
+    uint16_t port = client->GetLocalPort();
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(port), true, "Ephemeral port allocated");
+    client->SetPeer("10.0.3.1", 443);
+    endPoints = demux.Lookup("10.0.0.7", port, "10.0.3.1", 443, interface);
+    NS_TEST_ASSERT_MSG_EQ((endPoints == Ipv4EndPointDemux::EndPoints{client}),
+                          true,
+                          "Client bound to any address");
+    client->SetLocalAddress(server);
+    NS_TEST_ASSERT_MSG_EQ(demux.Lookup("10.0.0.7", port, "10.0.3.1", 443, interface).empty(),
+                          true,
+                          "Client bound to another address");
+    endPoints = demux.Lookup(server, port, "10.0.3.1", 443, interface);
+    NS_TEST_ASSERT_MSG_EQ((endPoints == Ipv4EndPointDemux::EndPoints{client}),
+                          true,
+                          "Client bound to the server address");
+    NS_TEST_ASSERT_MSG_EQ(demux.Lookup(server, port, "10.0.3.2", 443, interface).empty(),
+                          true,
+                          "Another peer");
+    demux.DeAllocate(client);
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(port), false, "Ephemeral port released");
+
+    // A socket bound to the network address receives the subnet-directed broadcasts
+    Ipv4EndPoint* subnet = demux.Allocate(nullptr, "10.0.0.0", 5000);
+    endPoints = demux.Lookup("10.0.0.255", 5000, "10.0.0.2", 6000, interface);
+    NS_TEST_ASSERT_MSG_EQ((endPoints == Ipv4EndPointDemux::EndPoints{subnet}),
+                          true,
+                          "Subnet-directed broadcast");
+    NS_TEST_ASSERT_MSG_EQ(demux.Lookup("10.0.1.255", 5000, "10.0.0.2", 6000, interface).empty(),
+                          true,
+                          "Broadcast to another subnet");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check the endpoints found by an Ipv6EndPointDemux, as they are
+ * allocated, connected and deallocated.
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv6EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase()
+    : TestCase("Check the IPv6 endpoints looked up")
+{
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun()
+{
+    Ipv6EndPointDemux demux;
+    auto interface = CreateObject<Ipv6Interface>();
+    Ipv6Address server("2001:db8::1");
+
+    Ipv6EndPoint* listener = demux.Allocate(nullptr, Ipv6Address::GetAny(), 80);
+    std::vector<Ipv6EndPoint*> connections;
+    std::vector<Ipv6Address> peers;
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        peers.emplace_back(("2001:db8:1::" + std::to_string(i + 1)).c_str());
+        connections.push_back(demux.Allocate(nullptr, server, 80, peers[i], 1000 + i));
+    }
+    NS_TEST_ASSERT_MSG_EQ(demux.Allocate(nullptr, server, 80, peers[0], 1000),
+                          nullptr,
+                          "Duplicated endpoint");
+
+    for (uint32_t i = 0; i < connections.size(); i++)
+    {
+        auto endPoints = demux.Lookup(server, 80, peers[i], 1000 + i, interface);
+        NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "One endpoint for connection " << i);
+        NS_TEST_ASSERT_MSG_EQ(endPoints.front(), connections[i], "Connection " << i);
+        NS_TEST_ASSERT_MSG_EQ(demux.SimpleLookup(server, 80, peers[i], 1000 + i),
+                              connections[i],
+                              "Connection " << i);
+    }
+    demux.DeAllocate(connections[0]);
+    auto endPoints = demux.Lookup(server, 80, peers[0], 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ((endPoints == Ipv6EndPointDemux::EndPoints{listener}),
+                          true,
+                          "Deallocated endpoint removed");
+
+    Ipv6EndPoint* anyPort = demux.Allocate(nullptr, server, 80, "2001:db8:4::1", 0);
+    Ipv6EndPoint* anyAddress = demux.Allocate(nullptr, server, 80, Ipv6Address::GetAny(), 4000);
+    NS_TEST_ASSERT_MSG_NE(anyPort, nullptr, "Endpoint (2001:db8:4::1, 0) allocated");
+    NS_TEST_ASSERT_MSG_NE(anyAddress, nullptr, "Endpoint (Any, 4000) allocated");
+    endPoints = demux.Lookup(server, 80, "2001:db8:4::1", 4000, interface);
+    NS_TEST_ASSERT_MSG_EQ((endPoints == Ipv6EndPointDemux::EndPoints{listener}),
+                          true,
+                          "Peers (2001:db8:4::1, 0) and (Any, 4000)");
+    Ipv6EndPoint* exact = demux.Allocate(nullptr, server, 80, "2001:db8:4::1", 4000);
+    endPoints = demux.Lookup(server, 80, "2001:db8:4::1", 4000, interface);
+    NS_TEST_ASSERT_MSG_EQ((endPoints == Ipv6EndPointDemux::EndPoints{exact}),
+                          true,
+                          "Exact peer preferred");
+    demux.DeAllocate(exact);
+    demux.DeAllocate(anyAddress);
+    demux.DeAllocate(anyPort);
+
+    Ipv6EndPoint* client = demux.Allocate();
+    uint16_t port = client->GetLocalPort();
+    client->SetPeer("2001:db8:2::1", 443);
+    client->SetLocalAddress(server);
+    endPoints = demux.Lookup(server, port, "2001:db8:2::1", 443, interface);
+    NS_TEST_ASSERT_MSG_EQ((endPoints == Ipv6EndPointDemux::EndPoints{client}),
+                          true,
+                          "Connected client");
+    client->SetLocalPort(port + 1);
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(port), false, "Port changed");
+    NS_TEST_ASSERT_MSG_EQ(demux.Lookup(server, port, "2001:db8:2::1", 443, interface).empty(),
+                          true,
+                          "Port changed");
+    endPoints = demux.Lookup(server, port + 1, "2001:db8:2::1", 443, interface);
+    NS_TEST_ASSERT_MSG_EQ((endPoints == Ipv6EndPointDemux::EndPoints{client}),
+                          true,
+                          "Port changed");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief End point demux TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+  public:
+    EndPointDemuxTestSuite()
+        : TestSuite("end-point-demux", Type::UNIT)
+    {
+        AddTestCase(new Ipv4EndPointDemuxTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new Ipv6EndPointDemuxTestCase, TestCase::Duration::QUICK);
+    }
+};
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
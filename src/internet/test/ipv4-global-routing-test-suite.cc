@@ -5,6 +5,7 @@
 #include "ns3/boolean.h"
 #include "ns3/bridge-helper.h"
 #include "ns3/config.h"
+#include "ns3/global-value.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
@@ -30,6 +31,7 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <sstream>
 #include <vector>
 
 using namespace ns3;
@@ -1300,6 +1302,145 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check that the global routes computed on several threads, and
+ * incrementally after interface events, are those of a sequential full
+ * computation.
+ */
+class Ipv4GlobalRoutingRecomputeTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingRecomputeTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Recompute the routes.
+     * \param threads The number of threads.
+     * \param incremental Whether to reuse the SPF trees.
+     * \returns The routing tables of the nodes.
+     */
+    std::string Recompute(uint32_t threads, bool incremental);
+
+    NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+Ipv4GlobalRoutingRecomputeTestCase::Ipv4GlobalRoutingRecomputeTestCase()
+    : TestCase("Global routes recomputed on several threads and incrementally")
+{
+}
+
+std::string
+Ipv4GlobalRoutingRecomputeTestCase::Recompute(uint32_t threads, bool incremental)
+{
+    GlobalValue::Bind("GlobalRoutingThreads", UintegerValue(threads));
+    GlobalValue::Bind("GlobalRoutingIncremental", BooleanValue(incremental));
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+
+    std::ostringstream os;
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        Ptr<Ipv4GlobalRouting> routing =
+            m_nodes.Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4GlobalRouting>();
+        os << "node " << i << std::endl;
+        for (uint32_t j = 0; j < routing->GetNRoutes(); j++)
+        {
+            Ipv4RoutingTableEntry* route = routing->GetRoute(j);
+            os << route->GetDest() << "/" << route->GetDestNetworkMask().GetPrefixLength()
+               << " gw " << route->GetGateway() << " if " << route->GetInterface() << std::endl;
+        }
+    }
+    return os.str();
+}
+
+// A ring of point-to-point links with random chords and interface
+// metrics, so that the SPF trees have equal-cost paths.
+void
+Ipv4GlobalRoutingRecomputeTestCase::DoRun()
+{
+    const uint32_t nNodes = 24;
+    m_nodes.Create(nNodes);
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+    internet.SetRoutingHelper(ipv4RoutingHelper);
+    internet.Install(m_nodes);
+
+    // a linear congruential generator, for a reproducible topology
+    uint32_t seed = 1;
+    auto random = [&seed](uint32_t n) {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) % n;
+    };
+
+    SimpleNetDeviceHelper p2pHelper;
+    p2pHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.0.0", "255.255.255.252");
+    std::vector<std::pair<uint32_t, uint32_t>> links;
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        links.emplace_back(i, (i + 1) % nNodes);
+    }
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        uint32_t a = random(nNodes);
+        uint32_t b = random(nNodes);
+        if (a != b)
+        {
+            links.emplace_back(a, b);
+        }
+    }
+    // the interfaces of the links, by link
+    std::vector<std::pair<Ptr<Ipv4>, uint32_t>> interfaces;
+    for (const auto& [a, b] : links)
+    {
+        NetDeviceContainer devices =
+            p2pHelper.Install(NodeContainer(m_nodes.Get(a), m_nodes.Get(b)));
+        Ipv4InterfaceContainer ifs = ipv4.Assign(devices);
+        ipv4.NewNetwork();
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            ifs.Get(i).first->SetMetric(ifs.Get(i).second, 1 + random(3));
+        }
+        interfaces.push_back(ifs.Get(0));
+    }
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    std::string sequential = Recompute(1, false);
+    NS_TEST_ASSERT_MSG_EQ(Recompute(4, false), sequential, "Routes computed on 4 threads");
+    NS_TEST_ASSERT_MSG_EQ(Recompute(0, true), sequential, "Routes of the SPF trees kept");
+    NS_TEST_ASSERT_MSG_EQ(Recompute(1, true), sequential, "Routes of the SPF trees reused");
+
+    // Take links down and up again, one at a time: the routes of the trees
+    // reused are those of a full computation.
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        auto [ip, interface] = interfaces[random(interfaces.size())];
+        for (bool up : {false, true})
+        {
+            if (up)
+            {
+                ip->SetUp(interface);
+            }
+            else
+            {
+                ip->SetDown(interface);
+            }
+            std::string incremental = Recompute(i % 2 ? 4 : 1, true);
+            std::string full = Recompute(1, false);
+            NS_TEST_ASSERT_MSG_EQ(incremental, full, "Routes after the link " << i << " changed");
+            // compute the trees again, to reuse them after the next change
+            NS_TEST_ASSERT_MSG_EQ(Recompute(1, true), full, "Routes of the SPF trees kept");
+        }
+    }
+
+    Recompute(1, false);
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  *
@@ -1322,6 +1463,7 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new TwoBridgeTest, TestCase::Duration::QUICK);
     AddTestCase(new Ipv4DynamicGlobalRoutingTestCase, TestCase::Duration::QUICK);
     AddTestCase(new Ipv4GlobalRoutingSlash32TestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingRecomputeTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4GlobalRoutingTestSuite
@@ -0,0 +1,192 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/prefix-trie.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup internet-test
+ * PrefixTrie test suite.
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check the prefixes matched by a PrefixTrie against a linear
+ * search of the prefixes inserted.
+ *
+ * \tparam Bytes \explicit The size of the addresses.
+ */
+template <std::size_t Bytes>
+class PrefixTrieTestCase : public TestCase
+{
+  public:
+    PrefixTrieTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** The trie tested. */
+    using Trie = PrefixTrie<uint32_t, Bytes>;
+
+    /** A prefix inserted, with its value. */
+    struct Prefix
+    {
+        typename Trie::Key key; //!< The address of the prefix.
+        uint32_t length;        //!< The prefix length.
+        uint32_t value;         //!< The value.
+    };
+
+    /**
+     * \param [in] prefix A prefix.
+     * \param [in] key An address.
+     * \returns Whether the prefix matches the address.
+     */
+    static bool Matches(const Prefix& prefix, const typename Trie::Key& key);
+
+    /**
+     * \param [in] base An address.
+     * \param [in] length The number of bits to keep.
+     * \returns A random address, with the first bits of the base address.
+     */
+    typename Trie::Key RandomKey(const typename Trie::Key& base, uint32_t length);
+
+    uint32_t m_seed; //!< The state of the pseudo-random generator.
+};
+
+template <std::size_t Bytes>
+PrefixTrieTestCase<Bytes>::PrefixTrieTestCase()
+    : TestCase("Check the longest prefix matches of " + std::to_string(Bytes * 8) +
+               "-bit addresses"),
+      m_seed(1)
+{
+}
+
+template <std::size_t Bytes>
+bool
+PrefixTrieTestCase<Bytes>::Matches(const Prefix& prefix, const typename Trie::Key& key)
+{
+    for (uint32_t i = 0; i < prefix.length; i++)
+    {
+        uint8_t bit = 0x80 >> (i % 8);
+        if ((prefix.key[i / 8] & bit) != (key[i / 8] & bit))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <std::size_t Bytes>
+typename PrefixTrieTestCase<Bytes>::Trie::Key
+PrefixTrieTestCase<Bytes>::RandomKey(const typename Trie::Key& base, uint32_t length)
+{
+    typename Trie::Key key;
+    for (uint32_t i = 0; i < Bytes; i++)
+    {
+        // a linear congruential generator, for a reproducible test
+        m_seed = m_seed * 1103515245 + 12345;
+        key[i] = static_cast<uint8_t>(m_seed >> 16);
+    }
+    for (uint32_t i = 0; i < length; i++)
+    {
+        uint8_t bit = 0x80 >> (i % 8);
+        key[i / 8] = (key[i / 8] & ~bit) | (base[i / 8] & bit);
+    }
+    return key;
+}
+
+template <std::size_t Bytes>
+void
+PrefixTrieTestCase<Bytes>::DoRun()
+{
+    Trie trie;
+    std::vector<Prefix> prefixes;
+    typename Trie::Key base = RandomKey({}, 0);
+
+    // Nested and diverging prefixes, sharing the first bits of a base
+    // address, some of them inserted several times.
+    for (uint32_t i = 0; i < 500; i++)
+    {
+        uint32_t shared = m_seed % (Trie::BITS + 1);
+        typename Trie::Key key = RandomKey(base, shared);
+        uint32_t length = (m_seed >> 8) % (Trie::BITS + 1);
+        if (i % 10 == 9)
+        {
+            key = prefixes[i / 2].key;
+            length = prefixes[i / 2].length;
+        }
+        prefixes.push_back({key, length, i});
+        trie.Insert(key, length, i);
+    }
+    NS_TEST_ASSERT_MSG_EQ(trie.GetNValues(), prefixes.size(), "Values inserted");
+
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        typename Trie::Key key = RandomKey(base, m_seed % (Trie::BITS + 1));
+        std::vector<uint32_t> expected;
+        for (uint32_t length = Trie::BITS + 1; length-- > 0;)
+        {
+            for (const auto& prefix : prefixes)
+            {
+                if (prefix.length == length && Matches(prefix, key))
+                {
+                    expected.push_back(prefix.value);
+                }
+            }
+        }
+
+        std::vector<uint32_t> visited;
+        uint32_t lastLength = Trie::BITS + 1;
+        trie.VisitMatches(key, [&](uint32_t length, const std::vector<uint32_t>& values) {
+            NS_TEST_EXPECT_MSG_LT(length, lastLength, "Prefixes visited from the longest");
+            lastLength = length;
+            visited.insert(visited.end(), values.begin(), values.end());
+            return false;
+        });
+        NS_TEST_ASSERT_MSG_EQ((visited == expected), true, "Matches of address " << i);
+
+        // the lookup stops when the visitor returns true
+        uint32_t nVisits = 0;
+        trie.VisitMatches(key, [&](uint32_t, const std::vector<uint32_t>&) {
+            nVisits++;
+            return true;
+        });
+        NS_TEST_ASSERT_MSG_EQ(nVisits, (expected.empty() ? 0 : 1), "Lookup stopped");
+    }
+
+    std::size_t memory = trie.GetMemoryUsage();
+    trie.Clear();
+    NS_TEST_ASSERT_MSG_EQ(trie.GetNValues(), 0, "Trie cleared");
+    NS_TEST_ASSERT_MSG_LT(trie.GetMemoryUsage(), memory, "Trie cleared");
+    bool matched = false;
+    trie.VisitMatches(base, [&](uint32_t, const std::vector<uint32_t>&) {
+        matched = true;
+        return true;
+    });
+    NS_TEST_ASSERT_MSG_EQ(matched, false, "No match in an empty trie");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief PrefixTrie TestSuite
+ */
+class PrefixTrieTestSuite : public TestSuite
+{
+  public:
+    PrefixTrieTestSuite()
+        : TestSuite("prefix-trie", Type::UNIT)
+    {
+        AddTestCase(new PrefixTrieTestCase<4>, TestCase::Duration::QUICK);
+        AddTestCase(new PrefixTrieTestCase<16>, TestCase::Duration::QUICK);
+    }
+};
+
+static PrefixTrieTestSuite g_prefixTrieTestSuite; //!< Static variable for test initialization
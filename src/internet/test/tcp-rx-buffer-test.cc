@@ -31,6 +31,11 @@ class TcpRxBufferTestCase : public TestCase
      * \brief Test the SACK list update.
      */
     void TestUpdateSACKList();
+
+    /**
+     * \brief Test the reordering of many segments, with overlaps.
+     */
+    void TestReordering();
 };
 
 TcpRxBufferTestCase::TcpRxBufferTestCase()
@@ -42,6 +47,7 @@ void
 TcpRxBufferTestCase::DoRun()
 {
     TestUpdateSACKList();
+    TestReordering();
 }
 
 void
@@ -277,6 +283,46 @@ TcpRxBufferTestCase::TestUpdateSACKList()
     NS_TEST_ASSERT_MSG_EQ(sackList.size(), 0, "SACK list should contain no element");
 }
 
+void
+TcpRxBufferTestCase::TestReordering()
+{
+    TcpRxBuffer rxBuf;
+    uint32_t segmentSize = 100;
+    uint32_t segments = 1000;
+    rxBuf.SetMaxBufferSize(segments * segmentSize);
+    rxBuf.SetNextRxSequence(SequenceNumber32(1));
+    TcpHeader h;
+
+    // The segments after the first one, from the last
+    for (uint32_t i = segments - 1; i > 0; --i)
+    {
+        h.SetSequenceNumber(SequenceNumber32(1 + i * segmentSize));
+        NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(segmentSize), h), true, "Segment " << i);
+    }
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(), SequenceNumber32(1), "Hole at the head");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 0, "Hole at the head");
+
+    // A segment already received, and one overlapping two received ones
+    h.SetSequenceNumber(SequenceNumber32(1 + 500 * segmentSize));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(segmentSize), h), false, "Duplicate");
+    h.SetSequenceNumber(SequenceNumber32(1 + 500 * segmentSize + segmentSize / 2));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(segmentSize), h), false, "Overlap");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), (segments - 1) * segmentSize, "Buffered bytes");
+
+    // The first segment, with the beginning of the second one, fills the hole
+    h.SetSequenceNumber(SequenceNumber32(1));
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Add(Create<Packet>(segmentSize + 10), h), true, "Hole filled");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(),
+                          SequenceNumber32(1 + segments * segmentSize),
+                          "All the segments received");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), segments * segmentSize, "All the segments received");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackListSize(), 0, "No SACK block left");
+
+    Ptr<Packet> p = rxBuf.Extract(segments * segmentSize);
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), segments * segmentSize, "All the bytes extracted");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 0, "Empty buffer");
+}
+
 void
 TcpRxBufferTestCase::DoTeardown()
 {
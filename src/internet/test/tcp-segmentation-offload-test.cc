@@ -0,0 +1,353 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/error-model.h"
+#include "ns3/icmpv4-l4-protocol.h"
+#include "ns3/icmpv6-l4-protocol.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/node.h"
+#include "ns3/queue.h"
+#include "ns3/segmentation-offload-tag.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-socket-base.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup internet-test
+ * TCP segmentation offload test suite.
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief A SimpleNetDevice supporting the segmentation offload, with the
+ * largest MTU.
+ */
+class OffloadNetDevice : public SimpleNetDevice
+{
+  public:
+    OffloadNetDevice()
+    {
+        SetMtu(65535);
+    }
+
+    bool SupportsSegmentationOffload() const override
+    {
+        return true;
+    }
+};
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Send a stream with the segmentation offload, and check the
+ * packets sent down the stack, the segments received, and the data.
+ */
+class TcpSegmentationOffloadTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param tsoMaxSegments The maximum number of segments of an aggregate.
+     * \param offload Whether the devices support the offload.
+     * \param gro Whether the receiver processes the aggregates as a whole.
+     * \param useIpv6 Use IPv6 instead of IPv4.
+     */
+    TcpSegmentationOffloadTestCase(uint32_t tsoMaxSegments, bool offload, bool gro, bool useIpv6);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Add a SimpleNetDevice, on a channel, to a node.
+     * \param node The node.
+     * \param channel The channel.
+     * \param index The index of the node, for its address.
+     */
+    void AddDevice(Ptr<Node> node, Ptr<SimpleChannel> channel, uint32_t index);
+
+    /**
+     * \brief Client: send data.
+     * \param socket The socket.
+     * \param available Unused.
+     */
+    void Send(Ptr<Socket> socket, uint32_t available);
+
+    /**
+     * \brief Server: accept a connection.
+     * \param socket The socket.
+     * \param from The address of the client.
+     */
+    void Accept(Ptr<Socket> socket, const Address& from);
+
+    /**
+     * \brief Server: receive data.
+     * \param socket The socket.
+     */
+    void Receive(Ptr<Socket> socket);
+
+    /**
+     * \brief Count a packet sent down the stack by the client.
+     * \tparam T \deduced The IP protocol.
+     * \param packet The packet, with its headers.
+     * \param ip The IP protocol.
+     * \param interface The interface.
+     */
+    template <typename T>
+    void Sent(Ptr<const Packet> packet, Ptr<T> ip, uint32_t interface);
+
+    /**
+     * \brief Check a segment received by the server socket.
+     * \param packet The payload.
+     * \param header The TCP header.
+     * \param socket The socket.
+     */
+    void SegmentReceived(Ptr<const Packet> packet,
+                         const TcpHeader& header,
+                         Ptr<const TcpSocketBase> socket);
+
+    uint32_t m_tsoMaxSegments; //!< The maximum number of segments of an aggregate.
+    bool m_offload;            //!< Whether the devices support the offload.
+    bool m_gro;                //!< Whether the receiver processes the aggregates as a whole.
+    bool m_useIpv6;            //!< Use IPv6 instead of IPv4.
+
+    std::vector<uint8_t> m_txData; //!< The data sent.
+    std::vector<uint8_t> m_rxData; //!< The data received.
+    uint32_t m_txBytes;            //!< The bytes sent.
+    uint32_t m_aggregates;         //!< The aggregates sent down the stack.
+    uint32_t m_largestRxSegment;   //!< The largest payload received by the server socket.
+};
+
+TcpSegmentationOffloadTestCase::TcpSegmentationOffloadTestCase(uint32_t tsoMaxSegments,
+                                                               bool offload,
+                                                               bool gro,
+                                                               bool useIpv6)
+    : TestCase("Send a stream with TsoMaxSegments=" + std::to_string(tsoMaxSegments) +
+               (offload ? ", offload" : "") + (gro ? ", GRO" : "") + (useIpv6 ? ", IPv6" : "")),
+      m_tsoMaxSegments(tsoMaxSegments),
+      m_offload(offload),
+      m_gro(gro),
+      m_useIpv6(useIpv6)
+{
+}
+
+void
+TcpSegmentationOffloadTestCase::AddDevice(Ptr<Node> node,
+                                          Ptr<SimpleChannel> channel,
+                                          uint32_t index)
+{
+    Ptr<SimpleNetDevice> device;
+    if (m_offload)
+    {
+        device = CreateObject<OffloadNetDevice>();
+    }
+    else
+    {
+        device = CreateObject<SimpleNetDevice>();
+    }
+    device->SetAddress(Mac48Address::Allocate());
+    device->SetChannel(channel);
+    node->AddDevice(device);
+    if (m_useIpv6)
+    {
+        Ptr<Ipv6> ipv6 = node->GetObject<Ipv6>();
+        uint32_t interface = ipv6->AddInterface(device);
+        ipv6->AddAddress(interface,
+                         Ipv6InterfaceAddress(Ipv6Address(("2001:db8::" +
+                                                           std::to_string(index + 1))
+                                                              .c_str()),
+                                              Ipv6Prefix(64)));
+        ipv6->SetUp(interface);
+    }
+    else
+    {
+        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+        uint32_t interface = ipv4->AddInterface(device);
+        ipv4->AddAddress(interface,
+                         Ipv4InterfaceAddress(Ipv4Address(0x0a000001 + index), "255.255.255.0"));
+        ipv4->SetUp(interface);
+    }
+}
+
+void
+TcpSegmentationOffloadTestCase::Send(Ptr<Socket> socket, uint32_t available)
+{
+    while (m_txBytes < m_txData.size() && socket->GetTxAvailable() > 0)
+    {
+        uint32_t size = std::min<uint32_t>({static_cast<uint32_t>(m_txData.size()) - m_txBytes,
+                                            socket->GetTxAvailable(),
+                                            1000});
+        int sent = socket->Send(Create<Packet>(&m_txData[m_txBytes], size));
+        NS_TEST_ASSERT_MSG_GT(sent, 0, "Data sent");
+        m_txBytes += sent;
+        if (m_txBytes == m_txData.size())
+        {
+            socket->Close();
+        }
+    }
+}
+
+void
+TcpSegmentationOffloadTestCase::Accept(Ptr<Socket> socket, const Address& from)
+{
+    socket->SetRecvCallback(MakeCallback(&TcpSegmentationOffloadTestCase::Receive, this));
+    socket->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&TcpSegmentationOffloadTestCase::SegmentReceived, this));
+}
+
+void
+TcpSegmentationOffloadTestCase::Receive(Ptr<Socket> socket)
+{
+    Ptr<Packet> packet;
+    while ((packet = socket->Recv()))
+    {
+        SegmentationOffloadTag offload;
+        NS_TEST_EXPECT_MSG_EQ(packet->PeekPacketTag(offload), false, "Tag left on the data");
+        std::vector<uint8_t> data(packet->GetSize());
+        packet->CopyData(data.data(), data.size());
+        m_rxData.insert(m_rxData.end(), data.begin(), data.end());
+    }
+}
+
+template <typename T>
+void
+TcpSegmentationOffloadTestCase::Sent(Ptr<const Packet> packet, Ptr<T> ip, uint32_t interface)
+{
+    SegmentationOffloadTag offload;
+    if (packet->PeekPacketTag(offload))
+    {
+        m_aggregates++;
+        NS_TEST_EXPECT_MSG_EQ(m_offload, true, "Aggregate sent to a device without offload");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(offload.GetSegments(), m_tsoMaxSegments, "Segments");
+    }
+}
+
+void
+TcpSegmentationOffloadTestCase::SegmentReceived(Ptr<const Packet> packet,
+                                                const TcpHeader& header,
+                                                Ptr<const TcpSocketBase> socket)
+{
+    m_largestRxSegment = std::max(m_largestRxSegment, packet->GetSize());
+}
+
+void
+TcpSegmentationOffloadTestCase::DoRun()
+{
+    m_txData.resize(200000);
+    for (uint32_t i = 0; i < m_txData.size(); i++)
+    {
+        m_txData[i] = static_cast<uint8_t>(i * 7 + i / 256);
+    }
+    m_rxData.clear();
+    m_txBytes = 0;
+    m_aggregates = 0;
+    m_largestRxSegment = 0;
+
+    Ptr<Node> client = CreateObject<Node>();
+    Ptr<Node> server = CreateObject<Node>();
+    InternetStackHelper stack;
+    stack.SetIpv4StackInstall(!m_useIpv6);
+    stack.SetIpv6StackInstall(m_useIpv6);
+    stack.Install(client);
+    stack.Install(server);
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    AddDevice(client, channel, 0);
+    AddDevice(server, channel, 1);
+    if (m_useIpv6)
+    {
+        client->GetObject<Ipv6L3Protocol>()->TraceConnectWithoutContext(
+            "Tx",
+            MakeCallback(&TcpSegmentationOffloadTestCase::Sent<Ipv6>, this));
+    }
+    else
+    {
+        client->GetObject<Ipv4L3Protocol>()->TraceConnectWithoutContext(
+            "Tx",
+            MakeCallback(&TcpSegmentationOffloadTestCase::Sent<Ipv4>, this));
+    }
+
+    uint16_t port = 50000;
+    Address serverAddress;
+    Address anyAddress;
+    if (m_useIpv6)
+    {
+        serverAddress = Inet6SocketAddress("2001:db8::2", port);
+        anyAddress = Inet6SocketAddress(Ipv6Address::GetAny(), port);
+    }
+    else
+    {
+        serverAddress = InetSocketAddress("10.0.0.2", port);
+        anyAddress = InetSocketAddress(Ipv4Address::GetAny(), port);
+    }
+
+    Ptr<Socket> listener = server->GetObject<TcpSocketFactory>()->CreateSocket();
+    listener->SetAttribute("Gro", BooleanValue(m_gro));
+    listener->Bind(anyAddress);
+    listener->Listen();
+    listener->SetAcceptCallback(MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+                                MakeCallback(&TcpSegmentationOffloadTestCase::Accept, this));
+
+    Ptr<Socket> source = client->GetObject<TcpSocketFactory>()->CreateSocket();
+    source->SetAttribute("TsoMaxSegments", UintegerValue(m_tsoMaxSegments));
+    source->SetSendCallback(MakeCallback(&TcpSegmentationOffloadTestCase::Send, this));
+    source->Connect(serverAddress);
+    Send(source, 0);
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxData.size(), m_txData.size(), "Data received");
+    NS_TEST_EXPECT_MSG_EQ((m_rxData == m_txData), true, "Data received");
+
+    uint32_t segmentSize = 536;
+    bool aggregated = m_offload && m_tsoMaxSegments > 1;
+    NS_TEST_EXPECT_MSG_EQ((m_aggregates > 0), aggregated, "Aggregates sent");
+    NS_TEST_EXPECT_MSG_EQ((m_largestRxSegment > segmentSize),
+                          aggregated && m_gro,
+                          "Aggregates received as a whole");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief TCP segmentation offload TestSuite
+ */
+class TcpSegmentationOffloadTestSuite : public TestSuite
+{
+  public:
+    TcpSegmentationOffloadTestSuite()
+        : TestSuite("tcp-segmentation-offload", Type::UNIT)
+    {
+        for (bool useIpv6 : {false, true})
+        {
+            AddTestCase(new TcpSegmentationOffloadTestCase(1, true, true, useIpv6),
+                        TestCase::Duration::QUICK);
+            AddTestCase(new TcpSegmentationOffloadTestCase(8, true, false, useIpv6),
+                        TestCase::Duration::QUICK);
+            AddTestCase(new TcpSegmentationOffloadTestCase(8, true, true, useIpv6),
+                        TestCase::Duration::QUICK);
+            AddTestCase(new TcpSegmentationOffloadTestCase(8, false, true, useIpv6),
+                        TestCase::Duration::QUICK);
+        }
+    }
+};
+
+static TcpSegmentationOffloadTestSuite
+    g_tcpSegmentationOffloadTestSuite; //!< Static variable for test initialization
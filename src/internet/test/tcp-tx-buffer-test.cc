@@ -42,6 +42,8 @@ class TcpTxBufferTestCase : public TestCase
     /** \brief Test the logic of merging items in GetTransmittedSegment()
      * which is triggered by CopyFromSequence()*/
     void TestMergeItemsWhenGetTransmittedSegment();
+    /** \brief Test the scoreboard of a large window, with a hole every other segment */
+    void TestLargeWindow();
     /**
      * \brief Callback to provide a value of receiver window
      * \returns the receiver window size
@@ -89,6 +91,12 @@ TcpTxBufferTestCase::DoRun()
                         &TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment,
                         this);
 
+    /*
+     * Case for a large window: every other segment is sacked, one block per
+     * ACK, then the holes are retransmitted and acknowledged.
+     */
+    Simulator::Schedule(Seconds(0.0), &TcpTxBufferTestCase::TestLargeWindow, this);
+
     Simulator::Run();
     Simulator::Destroy();
 }
@@ -409,6 +417,71 @@ TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment()
     txBuf.CopyFromSequence(2000, SequenceNumber32(1));
 }
 
+void
+TcpTxBufferTestCase::TestLargeWindow()
+{
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+    SequenceNumber32 head(1);
+    txBuf->SetHeadSequence(head);
+    uint32_t segmentSize = 1000;
+    uint32_t segments = 10000;
+    txBuf->SetMaxBufferSize(segments * segmentSize);
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(3);
+
+    txBuf->Add(Create<Packet>(segments * segmentSize));
+    for (uint32_t i = 0; i < segments; ++i)
+    {
+        txBuf->CopyFromSequence(segmentSize, head + (segmentSize * i));
+    }
+
+    // The odd segments are received
+    for (uint32_t i = 1; i < segments; i += 2)
+    {
+        TcpOptionSack::SackList list;
+        list.emplace_back(head + (segmentSize * i), head + (segmentSize * (i + 1)));
+        NS_TEST_ASSERT_MSG_EQ(txBuf->Update(list), segmentSize, "Segment " << i << " not sacked");
+    }
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), segments / 2 * segmentSize, "Sacked bytes");
+
+    // An even segment is lost when 3 segments above it are sacked
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), (segments / 2 - 2) * segmentSize, "Lost bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(), 2 * segmentSize, "Bytes in flight");
+    for (uint32_t i = 0; i < segments; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(head + (segmentSize * i)),
+                              (i % 2 == 0 && i + 6 <= segments),
+                              "Segment " << i);
+    }
+
+    // The lost segments are retransmitted first, then the other holes
+    SequenceNumber32 seq;
+    SequenceNumber32 seqHigh;
+    for (uint32_t i = 0; i < segments; i += 2)
+    {
+        NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&seq, &seqHigh, true), true, "Hole " << i);
+        NS_TEST_ASSERT_MSG_EQ(seq, head + (segmentSize * i), "Hole " << i);
+        TcpTxItem* item = txBuf->CopyFromSequence(segmentSize, seq);
+        NS_TEST_ASSERT_MSG_EQ(item->GetSeqSize(), segmentSize, "Hole " << i);
+        NS_TEST_ASSERT_MSG_EQ(item->IsRetrans(), true, "Hole " << i);
+    }
+    NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&seq, &seqHigh, true), false, "No hole left");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetRetransmitsCount(),
+                          segments / 2 * segmentSize,
+                          "Retransmitted bytes");
+
+    // The retransmissions are acknowledged
+    for (uint32_t i = 0; i < segments; i += 2)
+    {
+        SequenceNumber32 ack = head + (segmentSize * (i + 1));
+        NS_TEST_ASSERT_MSG_EQ(txBuf->IsRetransmittedDataAcked(ack), true, "Hole " << i);
+        txBuf->DiscardUpTo(ack + segmentSize);
+    }
+    NS_TEST_ASSERT_MSG_EQ(txBuf->Size(), 0, "Data inside the buffer");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(), 0, "Bytes in flight");
+}
+
 void
 TcpTxBufferTestCase::TestTransmittedBlock()
 {
@@ -0,0 +1,321 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ * Implementation of class ns3::LogicalProcess.
+ */
+
+#include "logical-process.h"
+
+#include "ns3/assert.h"
+#include "ns3/event-impl.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("LogicalProcess");
+
+LogicalProcess::LogicalProcess(uint32_t id)
+    : m_id(id),
+      m_events(nullptr),
+      m_stop(false),
+      m_uid(EventId::UID::VALID),
+      m_currentUid(EventId::UID::INVALID),
+      m_currentTs(0),
+      m_currentContext(Simulator::NO_CONTEXT),
+      m_eventCount(0),
+      m_sendSeq(0),
+      m_windowStartTs(0),
+      m_windowStartUid(EventId::UID::INVALID),
+      // the logical process id takes the place of the system id in the
+      // packet uids, and the upper bits of the automatic stream indices
+      m_packetUid(static_cast<uint64_t>(id) << 32),
+      m_streamIndex(static_cast<uint64_t>(id) << 40)
+{
+    NS_LOG_FUNCTION(this << id);
+}
+
+LogicalProcess::~LogicalProcess()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+LogicalProcess::Dispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& message : m_mailbox)
+    {
+        message.event->Unref();
+    }
+    m_mailbox.clear();
+    if (m_events)
+    {
+        while (!m_events->IsEmpty())
+        {
+            Scheduler::Event next = m_events->RemoveNext();
+            next.impl->Unref();
+        }
+    }
+    m_events = nullptr;
+}
+
+void
+LogicalProcess::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+
+    if (m_events)
+    {
+        while (!m_events->IsEmpty())
+        {
+            Scheduler::Event next = m_events->RemoveNext();
+            scheduler->Insert(next);
+        }
+    }
+    m_events = scheduler;
+}
+
+uint32_t
+LogicalProcess::GetId() const
+{
+    return m_id;
+}
+
+EventId
+LogicalProcess::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_ASSERT_MSG(delay.IsPositive(), "LogicalProcess::Schedule(): Negative delay");
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = m_currentTs + delay.GetTimeStep();
+    ev.key.m_context = m_currentContext;
+    ev.key.m_uid = m_uid;
+    m_uid++;
+    m_events->Insert(ev);
+    return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+LogicalProcess::InsertEvent(uint64_t ts, uint32_t context, EventImpl* event)
+{
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = m_uid;
+    m_uid++;
+    m_events->Insert(ev);
+}
+
+void
+LogicalProcess::InsertEvent(const Scheduler::Event& ev)
+{
+    m_events->Insert(ev);
+}
+
+Scheduler::Event
+LogicalProcess::RemoveNextEvent()
+{
+    return m_events->RemoveNext();
+}
+
+void
+LogicalProcess::PostEvent(uint64_t ts,
+                          uint32_t context,
+                          uint32_t sender,
+                          uint64_t seq,
+                          EventImpl* event)
+{
+    std::unique_lock lock{m_mailboxMutex};
+    m_mailbox.push_back({ts, context, sender, seq, event});
+}
+
+uint64_t
+LogicalProcess::NextSendSequence()
+{
+    return m_sendSeq++;
+}
+
+void
+LogicalProcess::ReceiveMessages()
+{
+    std::vector<Message> messages;
+    {
+        std::unique_lock lock{m_mailboxMutex};
+        m_mailbox.swap(messages);
+    }
+    std::sort(messages.begin(), messages.end(), [](const Message& a, const Message& b) {
+        if (a.timestamp != b.timestamp)
+        {
+            return a.timestamp < b.timestamp;
+        }
+        if (a.sender != b.sender)
+        {
+            return a.sender < b.sender;
+        }
+        return a.seq < b.seq;
+    });
+    for (const auto& message : messages)
+    {
+        InsertEvent(message.timestamp, message.context, message.event);
+    }
+}
+
+void
+LogicalProcess::ProcessOneEvent()
+{
+    Scheduler::Event next = m_events->RemoveNext();
+
+    NS_ASSERT(next.key.m_ts >= m_currentTs);
+    m_eventCount++;
+
+    m_currentTs = next.key.m_ts;
+    m_currentContext = next.key.m_context;
+    m_currentUid = next.key.m_uid;
+    next.impl->Invoke();
+    next.impl->Unref();
+}
+
+void
+LogicalProcess::StartWindow()
+{
+    m_windowStartTs = m_currentTs;
+    m_windowStartUid = m_currentUid;
+}
+
+void
+LogicalProcess::ProcessUntil(const Scheduler::EventKey& windowEnd)
+{
+    Packet::SetUidCounter(&m_packetUid);
+    RngSeedManager::SetStreamIndexCounter(&m_streamIndex);
+    while (!m_stop && !m_events->IsEmpty() && m_events->PeekNext().key < windowEnd)
+    {
+        ProcessOneEvent();
+    }
+    Packet::SetUidCounter(nullptr);
+    RngSeedManager::SetStreamIndexCounter(nullptr);
+}
+
+Scheduler::EventKey
+LogicalProcess::NextKey() const
+{
+    if (m_events->IsEmpty())
+    {
+        return {std::numeric_limits<int64_t>::max(),
+                std::numeric_limits<uint32_t>::max(),
+                Simulator::NO_CONTEXT};
+    }
+    return m_events->PeekNext().key;
+}
+
+bool
+LogicalProcess::IsEmpty() const
+{
+    return m_events->IsEmpty();
+}
+
+void
+LogicalProcess::Stop()
+{
+    m_stop = true;
+}
+
+void
+LogicalProcess::ClearStop()
+{
+    m_stop = false;
+}
+
+Time
+LogicalProcess::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(m_currentTs);
+}
+
+uint64_t
+LogicalProcess::GetCurrentTs() const
+{
+    return m_currentTs;
+}
+
+void
+LogicalProcess::SetCurrentTs(uint64_t ts)
+{
+    m_currentTs = ts;
+}
+
+uint32_t
+LogicalProcess::GetContext() const
+{
+    return m_currentContext;
+}
+
+uint64_t
+LogicalProcess::GetEventCount() const
+{
+    return m_eventCount;
+}
+
+void
+LogicalProcess::SetNextUid(uint32_t uid)
+{
+    m_uid = uid;
+}
+
+uint32_t
+LogicalProcess::GetNextUid() const
+{
+    return m_uid;
+}
+
+void
+LogicalProcess::Remove(const EventId& id)
+{
+    if (IsExpired(id))
+    {
+        return;
+    }
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    m_events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+}
+
+bool
+LogicalProcess::IsExpired(const EventId& id) const
+{
+    return id.PeekEventImpl() == nullptr || id.GetTs() < m_currentTs ||
+           (id.GetTs() == m_currentTs && id.GetUid() <= m_currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+bool
+LogicalProcess::IsExpiredAtWindowStart(const EventId& id) const
+{
+    return id.PeekEventImpl() == nullptr || id.GetTs() < m_windowStartTs ||
+           (id.GetTs() == m_windowStartTs && id.GetUid() <= m_windowStartUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+} // namespace ns3
@@ -0,0 +1,248 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ * Declaration of class ns3::LogicalProcess.
+ */
+
+#ifndef NS3_LOGICAL_PROCESS_H
+#define NS3_LOGICAL_PROCESS_H
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/ptr.h"
+#include "ns3/scheduler.h"
+
+#include <mutex>
+#include <vector>
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup mtp
+ *
+ * \brief A partition of the simulation executed by a single thread at a time.
+ *
+ * Each logical process owns the event queue, the simulation clock and
+ * the event uid counter of a set of nodes, as well as the range of
+ * packet uids and random variable stream indices assigned while its
+ * events execute.  Events scheduled for a
+ * node owned by another logical process are posted to the mailbox of
+ * that process and only become visible to it at the next
+ * synchronization point, see ReceiveMessages().
+ */
+class LogicalProcess
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] id The logical process id.
+     */
+    LogicalProcess(uint32_t id);
+    /** Destructor. */
+    ~LogicalProcess();
+
+    /**
+     * Release all the pending events, including the ones still
+     * waiting in the mailbox.
+     */
+    void Dispose();
+
+    /**
+     * Set the scheduler used for the local event queue, moving the
+     * pending events to the new scheduler.
+     *
+     * \param [in] schedulerFactory The scheduler factory.
+     */
+    void SetScheduler(ObjectFactory schedulerFactory);
+
+    /** \return The logical process id. */
+    uint32_t GetId() const;
+
+    /**
+     * Schedule an event on this logical process, in the context of
+     * the event currently executing.
+     *
+     * \param [in] delay The delay relative to the current time.
+     * \param [in] event The event.
+     * \returns The event id.
+     */
+    EventId Schedule(const Time& delay, EventImpl* event);
+    /**
+     * Insert an event in the local event queue.
+     *
+     * \param [in] ts The absolute timestamp of the event.
+     * \param [in] context The event context.
+     * \param [in] event The event.
+     */
+    void InsertEvent(uint64_t ts, uint32_t context, EventImpl* event);
+    /**
+     * Insert an event in the local event queue with its original key.
+     * Used to migrate events between logical processes.
+     *
+     * \param [in] ev The event.
+     */
+    void InsertEvent(const Scheduler::Event& ev);
+    /**
+     * Remove the earliest event from the local event queue, without
+     * executing it.  Used to migrate events between logical processes.
+     *
+     * \returns The event.
+     */
+    Scheduler::Event RemoveNextEvent();
+    /**
+     * Post an event from another logical process.  May be called
+     * concurrently from any worker thread.
+     *
+     * \param [in] ts The absolute timestamp of the event.
+     * \param [in] context The event context.
+     * \param [in] sender The logical process sending the event.
+     * \param [in] seq The sender sequence number of the message.
+     * \param [in] event The event.
+     */
+    void PostEvent(uint64_t ts, uint32_t context, uint32_t sender, uint64_t seq, EventImpl* event);
+    /**
+     * \returns A new sequence number for a message sent by this
+     * logical process.
+     */
+    uint64_t NextSendSequence();
+    /**
+     * Move the posted events into the local event queue.
+     *
+     * The events are inserted in (timestamp, sender, sequence) order
+     * so that the uids they get, and thus the order they are executed
+     * in, do not depend on the thread interleaving.
+     */
+    void ReceiveMessages();
+
+    /**
+     * Record the current event, as seen by the other logical processes
+     * during the next time window, see IsExpiredAtWindowStart().
+     */
+    void StartWindow();
+    /**
+     * Process the events strictly before the end of a time window.
+     *
+     * The packet uids and stream indices of the calling thread are
+     * taken from the ranges of this logical process meanwhile.
+     *
+     * \param [in] windowEnd The key of the first event not processed.
+     */
+    void ProcessUntil(const Scheduler::EventKey& windowEnd);
+    /**
+     * Process the next event.
+     */
+    void ProcessOneEvent();
+
+    /**
+     * \returns The key of the next event, with the maximum time step
+     * if the event queue is empty.
+     */
+    Scheduler::EventKey NextKey() const;
+    /** \returns \c true if the local event queue is empty. */
+    bool IsEmpty() const;
+
+    /** Request this logical process to stop after the current event. */
+    void Stop();
+    /** Clear a previous stop request. */
+    void ClearStop();
+
+    /** \copydoc SimulatorImpl::Now */
+    Time Now() const;
+    /** \returns The timestamp of the current event, in time steps. */
+    uint64_t GetCurrentTs() const;
+    /**
+     * Set the current timestamp.
+     *
+     * \param [in] ts The timestamp, in time steps.
+     */
+    void SetCurrentTs(uint64_t ts);
+    /** \copydoc SimulatorImpl::GetContext */
+    uint32_t GetContext() const;
+    /** \returns The number of events processed by this logical process. */
+    uint64_t GetEventCount() const;
+    /**
+     * Set the uid to give to the next event scheduled locally.
+     *
+     * \param [in] uid The next uid.
+     */
+    void SetNextUid(uint32_t uid);
+    /** \returns The uid of the next event scheduled locally. */
+    uint32_t GetNextUid() const;
+
+    /** \copydoc SimulatorImpl::Remove */
+    void Remove(const EventId& id);
+    /** \copydoc SimulatorImpl::IsExpired */
+    bool IsExpired(const EventId& id) const;
+    /**
+     * Check if an event has expired, as seen from another logical
+     * process during a time window: the events executed since the
+     * start of the window are not expired yet, whatever the progress
+     * of the thread executing this logical process.
+     *
+     * \param [in] id The event.
+     * \returns \c true if the event has expired at the start of the window.
+     */
+    bool IsExpiredAtWindowStart(const EventId& id) const;
+
+  private:
+
+    /** An event posted by another logical process. */
+    struct Message
+    {
+        /** Absolute event timestamp. */
+        uint64_t timestamp;
+        /** The event context. */
+        uint32_t context;
+        /** The sending logical process. */
+        uint32_t sender;
+        /** The sender sequence number. */
+        uint64_t seq;
+        /** The event implementation. */
+        EventImpl* event;
+    };
+
+    /** The logical process id. */
+    uint32_t m_id;
+    /** The event priority queue. */
+    Ptr<Scheduler> m_events;
+    /** Events posted by other logical processes. */
+    std::vector<Message> m_mailbox;
+    /** Mutex protecting the mailbox. */
+    std::mutex m_mailboxMutex;
+    /** Flag calling for the end of the processing of the current window. */
+    bool m_stop;
+
+    /** Next event unique id. */
+    uint32_t m_uid;
+    /** Unique id of the current event. */
+    uint32_t m_currentUid;
+    /** Timestamp of the current event. */
+    uint64_t m_currentTs;
+    /** Execution context of the current event. */
+    uint32_t m_currentContext;
+    /** The event count. */
+    uint64_t m_eventCount;
+    /** Sequence number of the next message sent to another logical process. */
+    uint64_t m_sendSeq;
+    /** Timestamp of the current event at the start of the window. */
+    uint64_t m_windowStartTs;
+    /** Unique id of the current event at the start of the window. */
+    uint32_t m_windowStartUid;
+    /** Next packet uid. */
+    uint64_t m_packetUid;
+    /** Next random variable stream index. */
+    uint64_t m_streamIndex;
+};
+
+} // namespace ns3
+
+#endif /* NS3_LOGICAL_PROCESS_H */
@@ -0,0 +1,676 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ * Implementation of class ns3::MultithreadedSimulatorImpl.
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "logical-process.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/channel-list.h"
+#include "ns3/channel.h"
+#include "ns3/enum.h"
+#include "ns3/event-impl.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/simulation-context.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <numeric>
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+namespace
+{
+/**
+ * \ingroup mtp
+ * The logical process executed by the calling thread, or \c nullptr
+ * for the main thread outside of a window.
+ */
+thread_local LogicalProcess* g_currentLp = nullptr;
+
+/** The largest time step, used as "no event". */
+constexpr uint64_t MAX_TS = std::numeric_limits<int64_t>::max();
+} // namespace
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Mtp")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("MaxThreads",
+                          "The maximum number of threads executing the simulation; "
+                          "zero uses the number of hardware threads.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_maxThreads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("PartitionMode",
+                          "How nodes are assigned to logical processes.  Automatic "
+                          "puts nodes linked by a channel that cannot be cut (not "
+                          "point-to-point or without a positive delay) in the same "
+                          "logical process; SystemId uses the Node system id.",
+                          EnumValue(AUTOMATIC),
+                          MakeEnumAccessor<PartitionMode>(
+                              &MultithreadedSimulatorImpl::m_partitionMode),
+                          MakeEnumChecker(AUTOMATIC, "Automatic", SYSTEM_ID, "SystemId"));
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_partitioned(false),
+      m_partitionMode(AUTOMATIC),
+      m_lookahead(MAX_TS),
+      m_maxThreads(0),
+      m_stop(false),
+      m_inParallelPhase(false),
+      m_windowEnd{0, 0, 0},
+      m_generation(0),
+      m_phase(PHASE_EXIT),
+      m_busyWorkers(0),
+      m_nextLp(0)
+{
+    NS_LOG_FUNCTION(this);
+    m_mainThreadId = std::this_thread::get_id();
+    m_lps.push_back(std::make_unique<LogicalProcess>(0));
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& lp : m_lps)
+    {
+        lp->Dispose();
+    }
+    m_lps.clear();
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    m_schedulerFactory = schedulerFactory;
+    for (auto& lp : m_lps)
+    {
+        lp->SetScheduler(schedulerFactory);
+    }
+}
+
+// Logical processes share the address space: there is a single system
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+LogicalProcess*
+MultithreadedSimulatorImpl::GetCurrentLp() const
+{
+    return g_currentLp != nullptr ? g_currentLp : m_lps[0].get();
+}
+
+LogicalProcess*
+MultithreadedSimulatorImpl::GetLp(uint32_t context) const
+{
+    if (context < m_lpOfContext.size())
+    {
+        return m_lps[m_lpOfContext[context]].get();
+    }
+    return m_lps[0].get();
+}
+
+bool
+MultithreadedSimulatorImpl::IsCuttable(Ptr<Channel> channel, Time& delay)
+{
+    for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
+    {
+        if (!channel->GetDevice(i)->IsPointToPoint())
+        {
+            return false;
+        }
+    }
+    TimeValue value;
+    if (!channel->GetAttributeFailSafe("Delay", value))
+    {
+        return false;
+    }
+    delay = value.Get();
+    return delay.IsStrictlyPositive();
+}
+
+void
+MultithreadedSimulatorImpl::Partition()
+{
+    NS_LOG_FUNCTION(this);
+
+    uint32_t nNodes = NodeList::GetNNodes();
+    std::vector<uint32_t> key(nNodes);
+    if (m_partitionMode == SYSTEM_ID)
+    {
+        for (uint32_t i = 0; i < nNodes; ++i)
+        {
+            key[i] = NodeList::GetNode(i)->GetSystemId();
+        }
+    }
+    else
+    {
+        // union-find over the nodes linked by a channel that cannot be cut
+        std::iota(key.begin(), key.end(), 0);
+        auto find = [&key](uint32_t i) {
+            while (key[i] != i)
+            {
+                key[i] = key[key[i]];
+                i = key[i];
+            }
+            return i;
+        };
+        for (auto i = ChannelList::Begin(); i != ChannelList::End(); ++i)
+        {
+            Ptr<Channel> channel = *i;
+            Time delay;
+            if (channel->GetNDevices() < 2 || IsCuttable(channel, delay))
+            {
+                continue;
+            }
+            uint32_t root = find(channel->GetDevice(0)->GetNode()->GetId());
+            for (std::size_t j = 1; j < channel->GetNDevices(); ++j)
+            {
+                uint32_t other = find(channel->GetDevice(j)->GetNode()->GetId());
+                key[std::max(root, other)] = std::min(root, other);
+                root = std::min(root, other);
+            }
+        }
+        for (uint32_t i = 0; i < nNodes; ++i)
+        {
+            key[i] = find(i);
+        }
+    }
+
+    // number the logical processes in the order of their first node, so
+    // that the partition does not depend on anything but the topology.
+    std::map<uint32_t, uint32_t> lpOfKey;
+    m_lpOfContext.resize(nNodes);
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        auto it = lpOfKey.emplace(key[i], lpOfKey.size() + 1).first;
+        m_lpOfContext[i] = it->second;
+    }
+
+    m_lookahead = MAX_TS;
+    for (auto i = ChannelList::Begin(); i != ChannelList::End(); ++i)
+    {
+        Ptr<Channel> channel = *i;
+        bool crossing = false;
+        for (std::size_t j = 1; j < channel->GetNDevices(); ++j)
+        {
+            crossing |= m_lpOfContext[channel->GetDevice(j)->GetNode()->GetId()] !=
+                        m_lpOfContext[channel->GetDevice(0)->GetNode()->GetId()];
+        }
+        if (!crossing)
+        {
+            continue;
+        }
+        Time delay;
+        if (!IsCuttable(channel, delay))
+        {
+            NS_FATAL_ERROR("Channel " << channel->GetId()
+                                      << " links nodes with different system ids but is not a "
+                                         "point-to-point channel with a positive delay");
+        }
+        m_lookahead = std::min<uint64_t>(m_lookahead, delay.GetTimeStep());
+    }
+
+    uint32_t uid = m_lps[0]->GetNextUid();
+    uint64_t ts = m_lps[0]->GetCurrentTs();
+    for (uint32_t i = 1; i <= lpOfKey.size(); ++i)
+    {
+        m_lps.push_back(std::make_unique<LogicalProcess>(i));
+        m_lps.back()->SetScheduler(m_schedulerFactory);
+        // keep the uids of the events migrated below unique in each process
+        m_lps.back()->SetNextUid(uid);
+        m_lps.back()->SetCurrentTs(ts);
+    }
+
+    // move the events scheduled before the partition to their owner
+    std::vector<Scheduler::Event> global;
+    while (!m_lps[0]->IsEmpty())
+    {
+        Scheduler::Event ev = m_lps[0]->RemoveNextEvent();
+        LogicalProcess* lp = GetLp(ev.key.m_context);
+        if (lp == m_lps[0].get())
+        {
+            global.push_back(ev);
+        }
+        else
+        {
+            lp->InsertEvent(ev);
+        }
+    }
+    for (const auto& ev : global)
+    {
+        m_lps[0]->InsertEvent(ev);
+    }
+
+    m_partitioned = true;
+    NS_LOG_INFO("Partitioned " << nNodes << " nodes into " << lpOfKey.size()
+                               << " logical processes, lookahead " << TimeStep(m_lookahead));
+}
+
+void
+MultithreadedSimulatorImpl::StartWorkers()
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t nThreads = m_maxThreads;
+    if (nThreads == 0)
+    {
+        nThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+#ifndef NS3_MTP
+    // without atomic reference counts, packets cannot cross threads
+    nThreads = 1;
+#endif
+    nThreads = std::min<uint32_t>(nThreads, m_lps.size() - 1);
+    for (uint32_t i = 1; i < nThreads; ++i)
+    {
+        m_workers.emplace_back(&MultithreadedSimulatorImpl::WorkerLoop,
+                               this,
+                               m_generation,
+                               SimulationContext::GetCurrent());
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StopWorkers()
+{
+    NS_LOG_FUNCTION(this);
+    {
+        std::unique_lock lock{m_poolMutex};
+        m_phase = PHASE_EXIT;
+        m_generation++;
+    }
+    m_phaseStart.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
+void
+MultithreadedSimulatorImpl::WorkerLoop(uint64_t generation, SimulationContext* context)
+{
+    SimulationContext::SetCurrent(context);
+    while (true)
+    {
+        {
+            std::unique_lock lock{m_poolMutex};
+            m_phaseStart.wait(lock, [this, generation] { return m_generation != generation; });
+            generation = m_generation;
+            if (m_phase == PHASE_EXIT)
+            {
+                return;
+            }
+        }
+        DoPhase();
+        {
+            std::unique_lock lock{m_poolMutex};
+            if (--m_busyWorkers == 0)
+            {
+                m_phaseDone.notify_one();
+            }
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunPhase(Phase phase)
+{
+    {
+        std::unique_lock lock{m_poolMutex};
+        m_phase = phase;
+        // the first logical process is executed by the main thread only
+        m_nextLp = phase == PHASE_PROCESS ? 1 : 0;
+        m_busyWorkers = m_workers.size();
+        m_generation++;
+    }
+    m_phaseStart.notify_all();
+    DoPhase();
+    std::unique_lock lock{m_poolMutex};
+    m_phaseDone.wait(lock, [this] { return m_busyWorkers == 0; });
+}
+
+void
+MultithreadedSimulatorImpl::DoPhase()
+{
+    for (uint32_t i = m_nextLp++; i < m_lps.size(); i = m_nextLp++)
+    {
+        LogicalProcess* lp = m_lps[i].get();
+        g_currentLp = lp;
+        if (m_phase == PHASE_PROCESS)
+        {
+            lp->ProcessUntil(m_windowEnd);
+        }
+        else
+        {
+            lp->ReceiveMessages();
+        }
+        g_currentLp = nullptr;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+    if (!m_partitioned)
+    {
+        Partition();
+    }
+    m_stop = false;
+    for (auto& lp : m_lps)
+    {
+        lp->ClearStop();
+    }
+    StartWorkers();
+
+    LogicalProcess* global = m_lps[0].get();
+    while (true)
+    {
+        RunPhase(PHASE_RECEIVE);
+        if (m_stop)
+        {
+            break;
+        }
+        Scheduler::EventKey nextGlobal = global->NextKey();
+        Scheduler::EventKey nextLocal = {MAX_TS, 0, 0};
+        for (uint32_t i = 1; i < m_lps.size(); ++i)
+        {
+            nextLocal = std::min(nextLocal, m_lps[i]->NextKey());
+        }
+        if (nextGlobal.m_ts == MAX_TS && nextLocal.m_ts == MAX_TS)
+        {
+            break;
+        }
+        if (!(nextLocal < nextGlobal))
+        {
+            // events without context may touch any node: run them alone,
+            // after the events of the same timestamp with smaller uids,
+            // as the default simulator does, e.g., for Simulator::Stop()
+            global->ProcessOneEvent();
+            continue;
+        }
+        uint64_t end = m_lookahead >= MAX_TS - nextLocal.m_ts ? MAX_TS
+                                                              : nextLocal.m_ts + m_lookahead;
+        m_windowEnd = std::min(Scheduler::EventKey{end, 0, 0}, nextGlobal);
+        for (uint32_t i = 1; i < m_lps.size(); ++i)
+        {
+            m_lps[i]->StartWindow();
+        }
+        m_inParallelPhase = true;
+        RunPhase(PHASE_PROCESS);
+        m_inParallelPhase = false;
+    }
+
+    StopWorkers();
+
+    // leave the clock of the main thread at the latest processed event
+    for (uint32_t i = 1; i < m_lps.size(); ++i)
+    {
+        global->SetCurrentTs(std::max(global->GetCurrentTs(), m_lps[i]->GetCurrentTs()));
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    // the other logical processes complete the current window
+    GetCurrentLp()->Stop();
+    m_stop = true;
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    return Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    for (const auto& lp : m_lps)
+    {
+        if (!lp->IsEmpty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    return GetCurrentLp()->Schedule(delay, event);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(delay.IsPositive(), "ScheduleWithContext(): Negative delay");
+    NS_ASSERT_MSG(g_currentLp != nullptr || m_mainThreadId == std::this_thread::get_id(),
+                  "Events cannot be injected from a thread outside of the simulation");
+
+    LogicalProcess* current = GetCurrentLp();
+    LogicalProcess* target = GetLp(context);
+    uint64_t ts = current->GetCurrentTs() + delay.GetTimeStep();
+    if (target == current || !m_inParallelPhase)
+    {
+        target->InsertEvent(ts, context, event);
+        return;
+    }
+    // Events without context posted during a window are executed at
+    // the next synchronization point.
+    NS_ABORT_MSG_IF(target != m_lps[0].get() && ts < m_windowEnd.m_ts,
+                    "Event scheduled for context " << context << " with delay " << delay
+                                                   << " smaller than the lookahead "
+                                                   << TimeStep(m_lookahead));
+    target->PostEvent(ts, context, current->GetId(), current->NextSendSequence(), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    EventId id(Ptr<EventImpl>(event, false),
+               GetCurrentLp()->GetCurrentTs(),
+               0xffffffff,
+               EventId::UID::DESTROY);
+    std::unique_lock lock{m_destroyEventsMutex};
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return GetCurrentLp()->Now();
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    else
+    {
+        return TimeStep(id.GetTs() - GetCurrentLp()->GetCurrentTs());
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        std::unique_lock lock{m_destroyEventsMutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    LogicalProcess* lp = GetLp(id.GetContext());
+    NS_ASSERT_MSG(!m_inParallelPhase || lp == GetCurrentLp(),
+                  "Events can only be removed by the logical process which owns them");
+    lp->Remove(id);
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    LogicalProcess* lp = GetLp(id.GetContext());
+    if (m_inParallelPhase && lp != GetCurrentLp())
+    {
+        // the thread executing the other logical process may be anywhere
+        // in the window: only its state at the start of the window is
+        // deterministic
+        return lp->IsExpiredAtWindowStart(id);
+    }
+    return lp->IsExpired(id);
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return GetCurrentLp()->GetContext();
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t count = 0;
+    for (const auto& lp : m_lps)
+    {
+        count += lp->GetEventCount();
+    }
+    return count;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNLogicalProcesses() const
+{
+    return m_partitioned ? m_lps.size() - 1 : 0;
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead() const
+{
+    return TimeStep(m_lookahead);
+}
+
+} // namespace ns3
@@ -0,0 +1,224 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ * Declaration of class ns3::MultithreadedSimulatorImpl.
+ */
+
+#ifndef NS3_MULTITHREADED_SIMULATOR_IMPL_H
+#define NS3_MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/scheduler.h"
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+class Channel;
+class LogicalProcess;
+class SimulationContext;
+
+/**
+ * \ingroup simulator
+ * \ingroup mtp
+ *
+ * \brief Conservative parallel simulator implementation for shared-memory
+ * machines.
+ *
+ * At the first call to Run() the nodes are partitioned into logical
+ * processes, either by Node system id or automatically, and each
+ * logical process keeps its own event queue and clock.  The logical
+ * processes are executed by a pool of worker threads in time windows
+ * bounded by the lookahead, i.e. the smallest delay of a channel
+ * linking two logical processes.  Events without a node context are
+ * executed by the main thread between two windows, in (timestamp, uid)
+ * order with the events of the logical processes.
+ *
+ * Events are delivered between logical processes in a deterministic
+ * order, so that results depend neither on the thread scheduling nor
+ * on the number of threads.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** How nodes are assigned to logical processes. */
+    enum PartitionMode
+    {
+        /** One logical process per set of nodes tied by non-cuttable channels. */
+        AUTOMATIC,
+        /** One logical process per Node system id. */
+        SYSTEM_ID,
+    };
+
+    /** Default constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * \returns The number of logical processes the nodes have been
+     * partitioned into, zero before the first call to Run().
+     */
+    uint32_t GetNLogicalProcesses() const;
+    /**
+     * \returns The lookahead used to bound the time windows.
+     */
+    Time GetLookahead() const;
+
+  private:
+    void DoDispose() override;
+
+    /** The tasks executed by the worker threads. */
+    enum Phase
+    {
+        /** Process the events of the current window. */
+        PHASE_PROCESS,
+        /** Move the posted events into the event queues. */
+        PHASE_RECEIVE,
+        /** Terminate the worker thread. */
+        PHASE_EXIT,
+    };
+
+    /**
+     * Assign the nodes to logical processes, move the events scheduled
+     * so far to their logical process and compute the lookahead.
+     */
+    void Partition();
+    /**
+     * Check if the nodes attached to a channel can be assigned to
+     * different logical processes.
+     *
+     * \param [in] channel The channel.
+     * \param [out] delay The channel delay.
+     * \returns \c true if every device attached to the channel is
+     *          point-to-point and the channel has a positive delay.
+     */
+    static bool IsCuttable(Ptr<Channel> channel, Time& delay);
+
+    /** \returns The logical process of the calling thread. */
+    LogicalProcess* GetCurrentLp() const;
+    /**
+     * \param [in] context An event context.
+     * \returns The logical process owning the context.
+     */
+    LogicalProcess* GetLp(uint32_t context) const;
+
+    /** Start the worker threads. */
+    void StartWorkers();
+    /** Terminate and join the worker threads. */
+    void StopWorkers();
+    /**
+     * Main loop of a worker thread.
+     *
+     * \param [in] generation The phase generation when the worker was started.
+     * \param [in] context The simulation context of the thread which started the worker.
+     */
+    void WorkerLoop(uint64_t generation, SimulationContext* context);
+    /**
+     * Execute a phase on every logical process, using all the threads.
+     *
+     * \param [in] phase The phase to execute.
+     */
+    void RunPhase(Phase phase);
+    /**
+     * Take logical processes from the shared work index until none is
+     * left and execute the current phase on them.
+     */
+    void DoPhase();
+
+    /** Container type for the events to run at Simulator::Destroy() */
+    typedef std::list<EventId> DestroyEvents;
+    /** The container of events to run at Destroy. */
+    DestroyEvents m_destroyEvents;
+    /** Mutex to control access to the list of destroy events. */
+    std::mutex m_destroyEventsMutex;
+
+    /** The scheduler factory used to create the event queues. */
+    ObjectFactory m_schedulerFactory;
+    /**
+     * The logical processes.  The first one executes the events without
+     * a node context.
+     */
+    std::vector<std::unique_ptr<LogicalProcess>> m_lps;
+    /** The logical process of each context (node id). */
+    std::vector<uint32_t> m_lpOfContext;
+    /** Whether the nodes have been partitioned. */
+    bool m_partitioned;
+    /** The partition mode. */
+    PartitionMode m_partitionMode;
+    /** The lookahead, in time steps. */
+    uint64_t m_lookahead;
+    /** Maximum number of threads, zero for the hardware concurrency. */
+    uint32_t m_maxThreads;
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+    /** Whether the worker threads are processing a window. */
+    bool m_inParallelPhase;
+    /** Key of the first event after the current window. */
+    Scheduler::EventKey m_windowEnd;
+
+    /** The worker threads. */
+    std::vector<std::thread> m_workers;
+    /** Mutex protecting the worker pool state. */
+    std::mutex m_poolMutex;
+    /** Signals the start of a phase to the workers. */
+    std::condition_variable m_phaseStart;
+    /** Signals the end of a phase to the main thread. */
+    std::condition_variable m_phaseDone;
+    /** Incremented at the start of each phase. */
+    uint64_t m_generation;
+    /** The current phase. */
+    Phase m_phase;
+    /** Number of workers which did not complete the current phase. */
+    uint32_t m_busyWorkers;
+    /** Index of the next logical process to execute the phase on. */
+    std::atomic<uint32_t> m_nextLp;
+};
+
+} // namespace ns3
+
+#endif /* NS3_MULTITHREADED_SIMULATOR_IMPL_H */
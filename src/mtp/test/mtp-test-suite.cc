@@ -0,0 +1,409 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/config.h"
+#include "ns3/enum.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp-tests
+ * Multithreaded simulator test suite.
+ */
+
+/**
+ * \ingroup mtp
+ * \defgroup mtp-tests Multithreaded simulator tests
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup mtp-tests
+ *
+ * A ring of nodes linked by point-to-point channels with distinct
+ * delays, plus a shared (non point-to-point) channel.  Each node
+ * forwards every packet it receives to the next node of the ring
+ * until the packet has done a fixed number of hops.  Each node also
+ * schedules a probe event, whose expiry the other nodes check.
+ */
+class MtpRingScenario
+{
+  public:
+    /** One packet reception: time, hop count, origin node. */
+    typedef std::tuple<int64_t, uint32_t, uint32_t> Record;
+    /**
+     * The values observed at a reception: packet uid, random value,
+     * and whether the probe of another node has expired.
+     */
+    typedef std::tuple<uint64_t, double, bool> Observation;
+
+    /**
+     * Build the scenario.
+     *
+     * \param nNodes Number of nodes in the ring.
+     */
+    MtpRingScenario(uint32_t nNodes);
+
+    /** Run the simulation, then destroy it. */
+    void Run();
+
+    /** Receptions recorded by each node. */
+    std::vector<std::vector<Record>> m_records;
+    /** Values observed by each node. */
+    std::vector<std::vector<Observation>> m_observations;
+
+  private:
+    /**
+     * Send a packet from a node to the next node of the ring.
+     *
+     * \param node The sending node.
+     * \param hops The number of hops done so far.
+     * \param origin The node which originated the packet.
+     */
+    void Send(uint32_t node, uint32_t hops, uint32_t origin);
+    /**
+     * Receive callback.
+     *
+     * \param device The receiving device.
+     * \param packet The packet.
+     * \param protocol The protocol number, used to carry the hop count.
+     * \param from The sender address.
+     * \returns true
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    /** Probe event, which does nothing. */
+    static void Probe();
+
+    NodeContainer m_nodes;                  //!< The nodes.
+    std::vector<EventId> m_probes;          //!< The probe event of each node.
+    std::vector<Ptr<NetDevice>> m_txDevice; //!< Device of each node towards the next one.
+    std::vector<Address> m_nextAddress;     //!< Address of the next node.
+    static constexpr uint16_t MAX_HOPS = 50; //!< Hops done by each packet.
+};
+
+MtpRingScenario::MtpRingScenario(uint32_t nNodes)
+    : m_records(nNodes),
+      m_observations(nNodes),
+      m_probes(nNodes),
+      m_txDevice(nNodes),
+      m_nextAddress(nNodes)
+{
+    m_nodes.Create(nNodes);
+    SimpleNetDeviceHelper helper;
+    helper.SetNetDevicePointToPointMode(true);
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        uint32_t next = (i + 1) % nNodes;
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        channel->SetAttribute("Delay", TimeValue(MicroSeconds(1000 + 100 * i)));
+        NetDeviceContainer devices =
+            helper.Install(NodeContainer(m_nodes.Get(i), m_nodes.Get(next)), channel);
+        devices.Get(1)->SetReceiveCallback(MakeCallback(&MtpRingScenario::Receive, this));
+        m_txDevice[i] = devices.Get(0);
+        m_nextAddress[i] = devices.Get(1)->GetAddress();
+    }
+    // a shared channel between the first three nodes, which must end up
+    // in the same logical process
+    SimpleNetDeviceHelper shared;
+    shared.Install(NodeContainer(m_nodes.Get(0), m_nodes.Get(1), m_nodes.Get(2)));
+
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        Simulator::ScheduleWithContext(i, MicroSeconds(i), &MtpRingScenario::Send, this, i, 0, i);
+    }
+}
+
+void
+MtpRingScenario::Run()
+{
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+void
+MtpRingScenario::Probe()
+{
+}
+
+void
+MtpRingScenario::Send(uint32_t node, uint32_t hops, uint32_t origin)
+{
+    if (hops == 0)
+    {
+        // the probes are written in the first window, and only read by
+        // the other nodes in later ones
+        m_probes[node] = Simulator::Schedule(MilliSeconds(5) + MicroSeconds(100 * node), &Probe);
+    }
+    Ptr<Packet> packet = Create<Packet>(100 + origin);
+    m_txDevice[node]->Send(packet, m_nextAddress[node], hops);
+}
+
+bool
+MtpRingScenario::Receive(Ptr<NetDevice> device,
+                         Ptr<const Packet> packet,
+                         uint16_t protocol,
+                         const Address& from)
+{
+    uint32_t node = device->GetNode()->GetId();
+    uint32_t origin = packet->GetSize() - 100;
+    m_records[node].emplace_back(Simulator::Now().GetTimeStep(), protocol, origin);
+    if (Simulator::Now() > MilliSeconds(3))
+    {
+        auto random = CreateObject<UniformRandomVariable>();
+        bool expired = Simulator::IsExpired(m_probes[(node + 3) % m_probes.size()]);
+        m_observations[node].emplace_back(packet->GetUid(), random->GetValue(), expired);
+    }
+    if (protocol + 1 < MAX_HOPS)
+    {
+        // local processing delay, executed in the context of the node
+        Simulator::Schedule(MicroSeconds((node * 7) % 5),
+                            &MtpRingScenario::Send,
+                            this,
+                            node,
+                            protocol + 1,
+                            origin);
+    }
+    return true;
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * Check that the multithreaded simulator produces the same receptions
+ * as the default simulator, for any number of threads.
+ */
+class MtpRingTestCase : public TestCase
+{
+  public:
+    MtpRingTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Run the ring scenario.
+     *
+     * \param simulatorType The simulator implementation.
+     * \param threads The maximum number of threads.
+     * \param [out] observations The values observed by each node.
+     * \returns The receptions recorded by each node.
+     */
+    std::vector<std::vector<MtpRingScenario::Record>> RunScenario(
+        std::string simulatorType,
+        uint32_t threads,
+        std::vector<std::vector<MtpRingScenario::Observation>>& observations);
+};
+
+MtpRingTestCase::MtpRingTestCase()
+    : TestCase("Check the multithreaded simulator against the default simulator")
+{
+}
+
+std::vector<std::vector<MtpRingScenario::Record>>
+MtpRingTestCase::RunScenario(std::string simulatorType,
+                             uint32_t threads,
+                             std::vector<std::vector<MtpRingScenario::Observation>>& observations)
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue(simulatorType));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue(threads));
+    MtpRingScenario scenario(8);
+    scenario.Run();
+    observations = scenario.m_observations;
+    return scenario.m_records;
+}
+
+void
+MtpRingTestCase::DoRun()
+{
+    std::vector<std::vector<MtpRingScenario::Observation>> unused;
+    std::vector<std::vector<MtpRingScenario::Observation>> oneThreadObservations;
+    std::vector<std::vector<MtpRingScenario::Observation>> fourThreadsObservations;
+    auto reference = RunScenario("ns3::DefaultSimulatorImpl", 0, unused);
+    auto oneThread = RunScenario("ns3::MultithreadedSimulatorImpl", 1, oneThreadObservations);
+    auto fourThreads = RunScenario("ns3::MultithreadedSimulatorImpl", 4, fourThreadsObservations);
+
+    for (std::size_t i = 0; i < reference.size(); ++i)
+    {
+        // each of the 8 packets is received 50 times around the 8 nodes ring
+        NS_TEST_EXPECT_MSG_EQ(reference[i].size(), 50, "Node " << i);
+        NS_TEST_EXPECT_MSG_EQ(oneThread[i].size(), reference[i].size(), "Node " << i);
+        NS_TEST_EXPECT_MSG_EQ((oneThread[i] == fourThreads[i]),
+                              true,
+                              "Node " << i << " depends on the number of threads");
+        NS_TEST_EXPECT_MSG_EQ(oneThreadObservations[i].empty(), false, "Node " << i);
+        // packet uids, random streams and expiry of the events of other
+        // logical processes
+        NS_TEST_EXPECT_MSG_EQ((oneThreadObservations[i] == fourThreadsObservations[i]),
+                              true,
+                              "Node " << i << " observations depend on the number of threads");
+        // events with equal timestamps may execute in a different
+        // order than with the default simulator
+        std::sort(reference[i].begin(), reference[i].end());
+        std::sort(oneThread[i].begin(), oneThread[i].end());
+        NS_TEST_EXPECT_MSG_EQ((oneThread[i] == reference[i]),
+                              true,
+                              "Node " << i << " differs from the default simulator");
+    }
+}
+
+void
+MtpRingTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+    Config::Reset();
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * Check the partition of the nodes and the lookahead.
+ */
+class MtpPartitionTestCase : public TestCase
+{
+  public:
+    MtpPartitionTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+MtpPartitionTestCase::MtpPartitionTestCase()
+    : TestCase("Check the partition of the nodes into logical processes")
+{
+}
+
+void
+MtpPartitionTestCase::DoRun()
+{
+    Config::SetGlobal("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    NS_TEST_EXPECT_MSG_EQ(impl->GetNLogicalProcesses(), 0, "Not partitioned before Run()");
+
+    MtpRingScenario scenario(8);
+    // inspect the implementation actually used by the simulator
+    Simulator::Run();
+    Ptr<SimulatorImpl> current = Simulator::GetImplementation();
+    Ptr<MultithreadedSimulatorImpl> mtp = DynamicCast<MultithreadedSimulatorImpl>(current);
+    NS_TEST_ASSERT_MSG_NE(mtp, nullptr, "Unexpected simulator implementation");
+    // nodes 0, 1 and 2 share a channel, the others are alone
+    NS_TEST_EXPECT_MSG_EQ(mtp->GetNLogicalProcesses(), 6, "Unexpected number of partitions");
+    // the shared channel removes the 1.0 and 1.1 ms links from the cut
+    NS_TEST_EXPECT_MSG_EQ(mtp->GetLookahead(), MicroSeconds(1200), "Unexpected lookahead");
+    Simulator::Destroy();
+}
+
+void
+MtpPartitionTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * Check that an event scheduled with Simulator::Stop() is ordered with
+ * the events of the nodes of the same timestamp as with the default
+ * simulator: the ones scheduled before it are executed, the ones
+ * scheduled after it are not.
+ */
+class MtpStopTestCase : public TestCase
+{
+  public:
+    MtpStopTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Run the ring scenario, stopped at 3 ms.
+     *
+     * \param simulatorType The simulator implementation.
+     * \returns Whether each event at 3 ms was executed.
+     */
+    std::vector<uint32_t> RunScenario(std::string simulatorType);
+};
+
+MtpStopTestCase::MtpStopTestCase()
+    : TestCase("Check the order of Simulator::Stop() and the events of the nodes")
+{
+}
+
+std::vector<uint32_t>
+MtpStopTestCase::RunScenario(std::string simulatorType)
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue(simulatorType));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue(4));
+    // one element per event, since the nodes may execute them concurrently
+    std::vector<uint32_t> executed(9, 0);
+    MtpRingScenario scenario(8);
+    for (uint32_t i = 3; i < 8; ++i)
+    {
+        Simulator::ScheduleWithContext(i, MilliSeconds(3), [&executed, i] { executed[i] = 1; });
+    }
+    Simulator::Stop(MilliSeconds(3));
+    Simulator::ScheduleWithContext(5, MilliSeconds(3), [&executed] { executed[8] = 1; });
+    scenario.Run();
+    return executed;
+}
+
+void
+MtpStopTestCase::DoRun()
+{
+    auto reference = RunScenario("ns3::DefaultSimulatorImpl");
+    auto executed = RunScenario("ns3::MultithreadedSimulatorImpl");
+    NS_TEST_EXPECT_MSG_EQ((reference == std::vector<uint32_t>{0, 0, 0, 1, 1, 1, 1, 1, 0}),
+                          true,
+                          "Only the events scheduled before Stop() are executed");
+    NS_TEST_EXPECT_MSG_EQ((executed == reference), true, "Events executed at the stop time");
+}
+
+void
+MtpStopTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+    Config::Reset();
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * \brief The multithreaded simulator Test Suite.
+ */
+class MtpTestSuite : public TestSuite
+{
+  public:
+    MtpTestSuite()
+        : TestSuite("mtp", Type::UNIT)
+    {
+        AddTestCase(new MtpRingTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new MtpPartitionTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new MtpStopTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+/// Static variable for test initialization.
+static MtpTestSuite g_mtpTestSuite;
@@ -0,0 +1,75 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "binary-trace-helper.h"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryTraceHelper");
+
+Ptr<BinaryTraceFile>
+BinaryTraceHelper::CreatePacketEventFile(std::string filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    auto file = Create<BinaryTraceFile>(filename,
+                                        "PacketEvents",
+                                        std::vector<BinaryTraceFile::Column>{
+                                            {"node", BinaryTraceFile::UINT64},
+                                            {"device", BinaryTraceFile::UINT64},
+                                            {"event", BinaryTraceFile::UINT64},
+                                            {"uid", BinaryTraceFile::UINT64},
+                                            {"size", BinaryTraceFile::UINT64},
+                                        });
+    NS_ABORT_MSG_IF(file->Fail(), "Unable to open binary trace file " << filename);
+    return file;
+}
+
+void
+BinaryTraceHelper::EnablePacketEvents(Ptr<BinaryTraceFile> file, Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << file << device);
+    uint32_t node = device->GetNode()->GetId();
+    uint32_t index = device->GetIfIndex();
+    auto sink = [&file, node, index](PacketEvent event) {
+        return MakeBoundCallback(&PacketEventSink, file, node, index, static_cast<uint8_t>(event));
+    };
+
+    PointerValue queue;
+    if (device->GetAttributeFailSafe("TxQueue", queue) && queue.Get<Object>())
+    {
+        queue.Get<Object>()->TraceConnectWithoutContext("Enqueue", sink(ENQUEUE));
+        queue.Get<Object>()->TraceConnectWithoutContext("Dequeue", sink(DEQUEUE));
+        queue.Get<Object>()->TraceConnectWithoutContext("Drop", sink(DROP));
+    }
+    device->TraceConnectWithoutContext("MacTxDrop", sink(DROP));
+    device->TraceConnectWithoutContext("PhyRxDrop", sink(DROP));
+    device->TraceConnectWithoutContext("MacRx", sink(RECEIVE));
+}
+
+void
+BinaryTraceHelper::EnablePacketEvents(Ptr<BinaryTraceFile> file, NetDeviceContainer devices)
+{
+    for (auto i = devices.Begin(); i != devices.End(); ++i)
+    {
+        EnablePacketEvents(file, *i);
+    }
+}
+
+void
+BinaryTraceHelper::PacketEventSink(Ptr<BinaryTraceFile> file,
+                                   uint32_t node,
+                                   uint32_t device,
+                                   uint8_t event,
+                                   Ptr<const Packet> packet)
+{
+    file->Write(Simulator::Now(), {node, device, event, packet->GetUid(), packet->GetSize()});
+}
+
+} // namespace ns3
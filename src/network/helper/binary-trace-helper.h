@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef BINARY_TRACE_HELPER_H
+#define BINARY_TRACE_HELPER_H
+
+#include "net-device-container.h"
+
+#include "ns3/binary-trace-file.h"
+#include "ns3/packet.h"
+
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Trace the packet events of net devices to binary trace files.
+ *
+ * This is the binary counterpart of the ascii traces of the device
+ * helpers: each enqueue, dequeue and drop of the transmission queue of a
+ * device, each drop at the reception, and each packet received by the
+ * device is written as a record with the columns \c node (the node id),
+ * \c device (the device index in the node), \c event (a PacketEvent),
+ * \c uid (the packet uid) and \c size (the packet size):
+ * \code{.cpp}
+ * BinaryTraceHelper binary;
+ * Ptr<BinaryTraceFile> file = binary.CreatePacketEventFile("packets.btr");
+ * binary.EnablePacketEvents(file, devices);
+ * \endcode
+ *
+ * Any device with a \c TxQueue attribute, or \c MacRx, \c MacTxDrop or
+ * \c PhyRxDrop trace sources, such as the point-to-point, CSMA and simple
+ * net devices, can be traced.
+ */
+class BinaryTraceHelper
+{
+  public:
+    /** The packet events. */
+    enum PacketEvent : uint8_t
+    {
+        ENQUEUE = 0, //!< Enqueued in the transmission queue ('+' of the ascii traces).
+        DEQUEUE = 1, //!< Dequeued from the transmission queue ('-').
+        DROP = 2,    //!< Dropped by the queue, or by the device ('d').
+        RECEIVE = 3, //!< Received by the device ('r').
+    };
+
+    /**
+     * Create a binary trace file for packet events.
+     *
+     * \param [in] filename The file name.
+     * \returns The file.
+     */
+    Ptr<BinaryTraceFile> CreatePacketEventFile(std::string filename);
+
+    /**
+     * Write the packet events of a device to a file.
+     *
+     * \param [in] file A file created by CreatePacketEventFile().
+     * \param [in] device The device.
+     */
+    void EnablePacketEvents(Ptr<BinaryTraceFile> file, Ptr<NetDevice> device);
+
+    /**
+     * Write the packet events of devices to a file.
+     *
+     * \param [in] file A file created by CreatePacketEventFile().
+     * \param [in] devices The devices.
+     */
+    void EnablePacketEvents(Ptr<BinaryTraceFile> file, NetDeviceContainer devices);
+
+    /**
+     * The trace sink of the packet events.
+     *
+     * \param [in] file The file.
+     * \param [in] node The node id.
+     * \param [in] device The device index.
+     * \param [in] event The PacketEvent.
+     * \param [in] packet The packet.
+     */
+    static void PacketEventSink(Ptr<BinaryTraceFile> file,
+                                uint32_t node,
+                                uint32_t device,
+                                uint8_t event,
+                                Ptr<const Packet> packet);
+};
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_HELPER_H */
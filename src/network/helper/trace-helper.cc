@@ -64,6 +64,17 @@ PcapHelper::CreateFile(std::string filename,
     return file;
 }
 
+Ptr<PcapNgFile>
+PcapHelper::CreatePcapNgFile(std::string filename)
+{
+    NS_LOG_FUNCTION(filename);
+
+    Ptr<PcapNgFile> file = CreateObject<PcapNgFile>();
+    file->Open(filename);
+    NS_ABORT_MSG_IF(file->Fail(), "Unable to Open " << filename);
+    return file;
+}
+
 std::string
 PcapHelper::GetFilenameFromDevice(std::string prefix, Ptr<NetDevice> device, bool useObjectNames)
 {
@@ -168,6 +179,13 @@ PcapHelper::SinkWithHeader(Ptr<PcapFileWrapper> file, const Header& header, Ptr<
     file->Write(Simulator::Now(), header, p);
 }
 
+void
+PcapHelper::PcapNgSink(Ptr<PcapNgFile> file, uint32_t interface, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(file << interface << p);
+    file->Write(interface, Simulator::Now(), p);
+}
+
 AsciiTraceHelper::AsciiTraceHelper()
 {
     NS_LOG_FUNCTION_NOARGS();
@@ -13,6 +13,7 @@
 #include "ns3/assert.h"
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/pcap-file-wrapper.h"
+#include "ns3/pcapng-file.h"
 #include "ns3/simulator.h"
 
 namespace ns3
@@ -115,6 +116,32 @@ class PcapHelper
     template <typename T>
     void HookDefaultSink(Ptr<T> object, std::string traceName, Ptr<PcapFileWrapper> file);
 
+    /**
+     * @brief Create a pcapng file, to capture the packets of several devices
+     * in a single file.
+     *
+     * @param filename file name
+     * @returns a smart pointer to the pcapng file
+     */
+    Ptr<PcapNgFile> CreatePcapNgFile(std::string filename);
+
+    /**
+     * @brief Add an interface to a pcapng file, and hook a trace source to
+     * the trace sink writing the packets of the interface
+     *
+     * @param object object
+     * @param traceName trace source name
+     * @param file pcapng file
+     * @param dataLinkType data link type of packet data
+     * @param interfaceName name of the interface in the file
+     */
+    template <typename T>
+    void HookPcapNgSink(Ptr<T> object,
+                        std::string traceName,
+                        Ptr<PcapNgFile> file,
+                        DataLinkType dataLinkType,
+                        std::string interfaceName);
+
   private:
     /**
      * The basic default trace sink.
@@ -140,6 +167,15 @@ class PcapHelper
     static void SinkWithHeader(Ptr<PcapFileWrapper> file,
                                const Header& header,
                                Ptr<const Packet> p);
+
+    /**
+     * The trace sink writing the packets of an interface to a pcapng file.
+     *
+     * @param file the file to write to
+     * @param interface the interface in the file
+     * @param p the packet to write
+     */
+    static void PcapNgSink(Ptr<PcapNgFile> file, uint32_t interface, Ptr<const Packet> p);
 };
 
 template <typename T>
@@ -152,6 +188,22 @@ PcapHelper::HookDefaultSink(Ptr<T> object, std::string tracename, Ptr<PcapFileWr
                   "PcapHelper::HookDefaultSink():  Unable to hook \"" << tracename << "\"");
 }
 
+template <typename T>
+void
+PcapHelper::HookPcapNgSink(Ptr<T> object,
+                           std::string tracename,
+                           Ptr<PcapNgFile> file,
+                           DataLinkType dataLinkType,
+                           std::string interfaceName)
+{
+    uint32_t interface = file->AddInterface(dataLinkType, interfaceName);
+    bool result = object->TraceConnectWithoutContext(
+        tracename,
+        MakeBoundCallback(&PcapNgSink, file, interface));
+    NS_ASSERT_MSG(result == true,
+                  "PcapHelper::HookPcapNgSink():  Unable to hook \"" << tracename << "\"");
+}
+
 /**
  * \brief Manage ASCII trace files for device models
  *
@@ -43,9 +43,16 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
+#ifdef NS3_MTP
+thread_local uint32_t Buffer::g_recommendedStart = 0;
+#else
 uint32_t Buffer::g_recommendedStart = 0;
+#endif
+thread_local Buffer::PoolStatistics Buffer::g_poolStatistics = {};
 #ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
+/* Each thread has its own free list, so that buffers can be created and
+ * destroyed by several threads without locks.
+ * The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
  *  - uninitialized means that no one has created a buffer yet
  *    so no one has created the associated free list (it is created
@@ -53,6 +60,8 @@ uint32_t Buffer::g_recommendedStart = 0;
  *  - initialized means that the free list exists and is valid
  *  - destroyed means that the static destructors of this compilation unit
  *    have run so, the free list has been cleared from its content
+ * (the destructors of the thread local variables of a thread run at its
+ * exit, and before the static destructors for the main thread).
  * The key is that in destroyed state, we are careful not re-create it
  * which is a typical weakness of lazy evaluation schemes which use
  * '0' as a special value to indicate both un-initialized and destroyed.
@@ -68,9 +77,9 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+thread_local uint32_t Buffer::g_maxSize = 0;
+thread_local Buffer::FreeList* Buffer::g_freeList = nullptr;
+thread_local Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor()
 {
@@ -82,8 +91,9 @@ Buffer::LocalStaticDestructor::~LocalStaticDestructor()
             Buffer::Deallocate(*i);
         }
         delete g_freeList;
-        g_freeList = DESTROYED;
+        g_poolStatistics.pooled = 0;
     }
+    g_freeList = DESTROYED;
 }
 
 void
@@ -91,8 +101,15 @@ Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
+    g_poolStatistics.releases++;
+    g_poolStatistics.live--;
     g_maxSize = std::max(g_maxSize, data->m_size);
+    if (IS_UNINITIALIZED(g_freeList))
+    {
+        // first buffer released by a thread which never created one
+        g_freeList = new Buffer::FreeList();
+        (void)&g_localStaticDestructor;
+    }
     /* feed into free list */
     if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
     {
@@ -102,6 +119,7 @@ Buffer::Recycle(Buffer::Data* data)
     {
         NS_ASSERT(IS_INITIALIZED(g_freeList));
         g_freeList->push_back(data);
+        g_poolStatistics.pooled++;
     }
 }
 
@@ -109,10 +127,15 @@ Buffer::Data*
 Buffer::Create(uint32_t dataSize)
 {
     NS_LOG_FUNCTION(dataSize);
+    g_poolStatistics.allocations++;
+    g_poolStatistics.live++;
+    g_poolStatistics.peak = std::max(g_poolStatistics.peak, g_poolStatistics.live);
     /* try to find a buffer correctly sized. */
     if (IS_UNINITIALIZED(g_freeList))
     {
         g_freeList = new Buffer::FreeList();
+        // construct the destructor of this thread's free list
+        (void)&g_localStaticDestructor;
     }
     else if (IS_INITIALIZED(g_freeList))
     {
@@ -120,9 +143,11 @@ Buffer::Create(uint32_t dataSize)
         {
             Buffer::Data* data = g_freeList->back();
             g_freeList->pop_back();
+            g_poolStatistics.pooled--;
             if (data->m_size >= dataSize)
             {
                 data->m_count = 1;
+                g_poolStatistics.hits++;
                 return data;
             }
             Buffer::Deallocate(data);
@@ -138,6 +163,8 @@ Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
+    g_poolStatistics.releases++;
+    g_poolStatistics.live--;
     Deallocate(data);
 }
 
@@ -145,10 +172,29 @@ Buffer::Data*
 Buffer::Create(uint32_t size)
 {
     NS_LOG_FUNCTION(size);
+    g_poolStatistics.allocations++;
+    g_poolStatistics.live++;
+    g_poolStatistics.peak = std::max(g_poolStatistics.peak, g_poolStatistics.live);
     return Allocate(size);
 }
 #endif /* BUFFER_FREE_LIST */
 
+Buffer::PoolStatistics
+Buffer::GetPoolStatistics()
+{
+    return g_poolStatistics;
+}
+
+void
+Buffer::ResetPoolStatistics()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    g_poolStatistics.allocations = 0;
+    g_poolStatistics.hits = 0;
+    g_poolStatistics.releases = 0;
+    g_poolStatistics.peak = g_poolStatistics.live;
+}
+
 constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
 
 Buffer::Data*
@@ -166,6 +212,7 @@ Buffer::Allocate(uint32_t reqSize)
     auto data = reinterpret_cast<Buffer::Data*>(b);
     data->m_size = reqSize;
     data->m_count = 1;
+    g_poolStatistics.bytes += size;
     return data;
 }
 
@@ -174,6 +221,7 @@ Buffer::Deallocate(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
+    g_poolStatistics.bytes -= data->m_size - 1 + sizeof(Buffer::Data);
     auto buf = reinterpret_cast<uint8_t*>(data);
     delete[] buf;
 }
@@ -255,8 +303,7 @@ Buffer::operator=(const Buffer& o)
     if (m_data != o.m_data)
     {
         // not assignment to self.
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Recycle(m_data);
         }
@@ -278,8 +325,7 @@ Buffer::~Buffer()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         Recycle(m_data);
     }
@@ -304,7 +350,13 @@ Buffer::AddAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+    // the dirty area of a shared buffer may be concurrently extended by
+    // another thread: never write in place into a shared buffer.
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+#endif
     if (m_start >= start && !isDirty)
     {
         /* enough space in the buffer and not dirty.
@@ -322,8 +374,7 @@ Buffer::AddAtStart(uint32_t start)
         uint32_t newSize = GetInternalSize() + start;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -350,7 +401,12 @@ Buffer::AddAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+    // see Buffer::AddAtStart
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+#endif
     if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
     {
         /* enough space in buffer and not dirty
@@ -368,8 +424,7 @@ Buffer::AddAtEnd(uint32_t end)
         uint32_t newSize = GetInternalSize() + end;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -391,20 +446,56 @@ Buffer::AddAtEnd(uint32_t end)
     NS_ASSERT(CheckInternalState());
 }
 
+void
+Buffer::Detach()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(CheckInternalState());
+    Buffer::Data* newData = Buffer::Create(GetInternalSize());
+    memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
+    if (--m_data->m_count == 0)
+    {
+        Buffer::Recycle(m_data);
+    }
+    m_data = newData;
+
+    m_zeroAreaStart -= m_start;
+    m_zeroAreaEnd -= m_start;
+    m_end -= m_start;
+    m_start = 0;
+
+    m_data->m_dirtyStart = m_start;
+    m_data->m_dirtyEnd = m_end;
+    m_maxZeroAreaStart = std::max(m_maxZeroAreaStart, m_zeroAreaStart);
+    NS_ASSERT(CheckInternalState());
+}
+
 void
 Buffer::AddAtEnd(const Buffer& o)
 {
     NS_LOG_FUNCTION(this << &o);
 
-    if (m_data->m_count == 1 && (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
-        m_end == m_data->m_dirtyEnd && o.m_start == o.m_zeroAreaStart &&
-        o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
+    if ((m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
+        o.m_start == o.m_zeroAreaStart && o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
     {
         /**
          * This is an optimization which kicks in when
          * we attempt to aggregate two buffers which contain
          * adjacent zero areas.
          */
+#ifdef NS3_MTP
+        // see Buffer::AddAtStart
+        bool isDirty = m_data->m_count > 1;
+#else
+        // a shared buffer can grow in place only if no other buffer uses
+        // the bytes after its end
+        bool isDirty = m_data->m_count > 1 && m_end != m_data->m_dirtyEnd;
+#endif
+        if (isDirty || m_data == o.m_data)
+        {
+            // copy the bytes before the zero area, typically headers
+            Detach();
+        }
         if (m_zeroAreaStart == m_zeroAreaEnd)
         {
             m_zeroAreaStart = m_end;
@@ -424,11 +515,30 @@ Buffer::AddAtEnd(const Buffer& o)
         return;
     }
 
-    *this = CreateFullCopy();
-    AddAtEnd(o.GetSize());
-    Buffer::Iterator destStart = End();
-    destStart.Prev(o.GetSize());
-    destStart.Write(o.Begin(), o.End());
+    // A buffer has a single zero area: keep the larger one, and write
+    // the other one as real bytes.
+    if (m_zeroAreaEnd - m_zeroAreaStart >= o.m_zeroAreaEnd - o.m_zeroAreaStart)
+    {
+        if (m_data == o.m_data)
+        {
+            Detach();
+        }
+        AddAtEnd(o.GetSize());
+        Buffer::Iterator destStart = End();
+        destStart.Prev(o.GetSize());
+        destStart.Write(o.Begin(), o.End());
+    }
+    else
+    {
+        Buffer tmp = o;
+        if (tmp.m_data == m_data)
+        {
+            tmp.Detach();
+        }
+        tmp.AddAtStart(GetSize());
+        tmp.Begin().Write(Begin(), End());
+        *this = tmp;
+    }
     NS_ASSERT(CheckInternalState());
 }
 
@@ -821,27 +931,32 @@ Buffer::Iterator::Write(Iterator start, Iterator end)
     NS_ASSERT(m_data != start.m_data);
     uint32_t size = end.m_current - start.m_current;
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    // the destination bytes are all on the same side of our zero area
+    uint8_t* to = &m_data[m_current];
+    if (m_current > m_zeroStart)
+    {
+        to -= m_zeroEnd - m_zeroStart;
+    }
+    m_current += size;
     if (start.m_current <= start.m_zeroStart)
     {
         uint32_t toCopy = std::min(size, start.m_zeroStart - start.m_current);
-        memcpy(&m_data[m_current], &start.m_data[start.m_current], toCopy);
+        memcpy(to, &start.m_data[start.m_current], toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     if (start.m_current <= start.m_zeroEnd)
     {
         uint32_t toCopy = std::min(size, start.m_zeroEnd - start.m_current);
-        memset(&m_data[m_current], 0, toCopy);
+        memset(to, 0, toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
     uint8_t* from = &start.m_data[start.m_current - (start.m_zeroEnd - start.m_zeroStart)];
-    uint8_t* to = &m_data[m_current];
     memcpy(to, from, toCopy);
-    m_current += toCopy;
 }
 
 void
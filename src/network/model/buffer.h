@@ -14,6 +14,10 @@
 #include <stdint.h>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 #define BUFFER_FREE_LIST 1
 
 namespace ns3
@@ -517,6 +521,12 @@ class Buffer
      * Add bytes at the end of the Buffer.
      * Any call to this method invalidates any Iterator
      * pointing to this Buffer.
+     *
+     * The zero areas of the two buffers are never copied when they are
+     * adjacent (this buffer ends with its zero area, or has none, and
+     * \p o starts with its zero area), including when either buffer
+     * is a fragment sharing its bytes with other buffers.  Otherwise
+     * only the smaller of the two zero areas is written as real bytes.
      */
     void AddAtEnd(const Buffer& o);
     /**
@@ -601,6 +611,38 @@ class Buffer
      */
     uint32_t CopyData(uint8_t* buffer, uint32_t size) const;
 
+    /**
+     * Allocation counters of the buffer data storages, for the calling
+     * thread.
+     *
+     * Each thread keeps its own free list of released storages, so that
+     * threads create and destroy buffers without synchronization.  A
+     * storage is released to the free list of the thread which drops its
+     * last reference, which may not be the thread which created it: the
+     * live counts of the threads then only add up to the number of
+     * storages in use in the process.
+     */
+    struct PoolStatistics
+    {
+        uint64_t allocations; //!< Number of storages created.
+        uint64_t hits;        //!< Number of storages reused from the free list.
+        uint64_t releases;    //!< Number of storages released.
+        int64_t live;         //!< Number of storages created minus the ones released.
+        int64_t peak;         //!< Maximum of live since the last reset.
+        uint64_t pooled;      //!< Number of storages in the free list.
+        int64_t bytes;        //!< Size of the storages allocated, live or pooled.
+    };
+
+    /**
+     * \returns The buffer data storage counters of the calling thread.
+     */
+    static PoolStatistics GetPoolStatistics();
+    /**
+     * Reset the allocation, hit and release counters of the calling
+     * thread, and set its peak to the current live count.
+     */
+    static void ResetPoolStatistics();
+
     /**
      * \brief Copy constructor
      * \param o the buffer to copy
@@ -654,7 +696,11 @@ class Buffer
          * The reference count of an instance of this data structure.
          * Each buffer which references an instance holds a count.
          */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /**
          * the size of the m_data field below.
          */
@@ -688,6 +734,11 @@ class Buffer
      * \brief Transform a "Virtual byte buffer" into a "Real byte buffer"
      */
     void TransformIntoRealBuffer() const;
+    /**
+     * \brief Move the bytes of the buffer, but not its zero area, to a
+     * new buffer data storage which is not shared with other buffers.
+     */
+    void Detach();
     /**
      * \brief Checks the internal buffer structures consistency
      *
@@ -756,9 +807,14 @@ class Buffer
     /**
      * location in a newly-allocated buffer where you should start
      * writing data. i.e., m_start should be initialized to this
-     * value.
+     * value. With multithreaded simulation support (NS3_MTP) each
+     * thread keeps its own heuristic.
      */
+#ifdef NS3_MTP
+    static thread_local uint32_t g_recommendedStart;
+#else
     static uint32_t g_recommendedStart;
+#endif
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -791,10 +847,15 @@ class Buffer
         ~LocalStaticDestructor();
     };
 
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
+    /// Max observed data size, per thread
+    static thread_local uint32_t g_maxSize;
+    /// Buffer data container, per thread
+    static thread_local FreeList* g_freeList;
+    /// Releases the buffer data container at thread exit
+    static thread_local LocalStaticDestructor g_localStaticDestructor;
 #endif
+    /// Allocation counters, per thread
+    static thread_local PoolStatistics g_poolStatistics;
 };
 
 } // namespace ns3
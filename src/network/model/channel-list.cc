@@ -12,6 +12,7 @@
 #include "ns3/config.h"
 #include "ns3/log.h"
 #include "ns3/object-vector.h"
+#include "ns3/simulation-context.h"
 #include "ns3/simulator.h"
 
 namespace ns3
@@ -119,7 +120,10 @@ Ptr<ChannelListPriv>*
 ChannelListPriv::DoGet()
 {
     NS_LOG_FUNCTION_NOARGS();
-    static Ptr<ChannelListPriv> ptr = nullptr;
+    static Ptr<ChannelListPriv> global = nullptr;
+    SimulationContext* context = SimulationContext::GetCurrent();
+    Ptr<ChannelListPriv>& ptr =
+        context != nullptr ? *context->GetSingleton<Ptr<ChannelListPriv>>() : global;
     if (!ptr)
     {
         ptr = CreateObject<ChannelListPriv>();
@@ -356,6 +356,16 @@ class NetDevice : public Object
      * \return true if this interface supports a bridging mode, false otherwise.
      */
     virtual bool SupportsSendFrom() const = 0;
+
+    /**
+     * The aggregates of segments, tagged with a SegmentationOffloadTag,
+     * are only sent to the NetDevices supporting the segmentation offload:
+     * such a device accounts for the segments an aggregate stands for.
+     *
+     * eturn true if this interface supports the segmentation offload,
+     *         false otherwise (the default).
+     */
+    virtual bool SupportsSegmentationOffload() const;
 };
 
 } // namespace ns3
@@ -9,12 +9,18 @@
 
 #include "node-list.h"
 
+#include "buffer.h"
+#include "channel-list.h"
+#include "channel.h"
 #include "node.h"
+#include "packet-metadata.h"
 
 #include "ns3/assert.h"
 #include "ns3/config.h"
 #include "ns3/log.h"
+#include "ns3/memory-report.h"
 #include "ns3/object-vector.h"
+#include "ns3/simulation-context.h"
 #include "ns3/simulator.h"
 
 namespace ns3
@@ -122,7 +128,10 @@ Ptr<NodeListPriv>*
 NodeListPriv::DoGet()
 {
     NS_LOG_FUNCTION_NOARGS();
-    static Ptr<NodeListPriv> ptr = nullptr;
+    static Ptr<NodeListPriv> global = nullptr;
+    SimulationContext* context = SimulationContext::GetCurrent();
+    Ptr<NodeListPriv>& ptr =
+        context != nullptr ? *context->GetSingleton<Ptr<NodeListPriv>>() : global;
     if (!ptr)
     {
         ptr = CreateObject<NodeListPriv>();
@@ -250,4 +259,62 @@ NodeList::GetNNodes()
     return NodeListPriv::Get()->GetNNodes();
 }
 
+namespace
+{
+
+/**
+ * \ingroup network
+ * Add the nodes, the channels and the packets to a memory report.
+ *
+ * The channels, and the objects reachable from them, such as the
+ * propagation models, are added first, without a context.  The objects
+ * reachable from each node are then added in the context of the node id.
+ * The packet buffers and metadata are those allocated by the calling
+ * thread.
+ *
+ * \param [in] report The memory report.
+ */
+void
+CollectNetworkMemory(MemoryReport& report)
+{
+    NS_LOG_FUNCTION(&report);
+    for (auto it = ChannelList::Begin(); it != ChannelList::End(); ++it)
+    {
+        report.AddObjects(Simulator::NO_CONTEXT, *it);
+    }
+    for (auto it = NodeList::Begin(); it != NodeList::End(); ++it)
+    {
+        report.AddObjects((*it)->GetId(), *it);
+    }
+    Buffer::PoolStatistics buffers = Buffer::GetPoolStatistics();
+    report.Add(Simulator::NO_CONTEXT,
+               "ns3::Buffer",
+               std::max<int64_t>(buffers.bytes, 0),
+               std::max<int64_t>(buffers.live, 0) + buffers.pooled);
+    PacketMetadata::PoolStatistics metadata = PacketMetadata::GetPoolStatistics();
+    report.Add(Simulator::NO_CONTEXT,
+               "ns3::PacketMetadata",
+               std::max<int64_t>(metadata.bytes, 0),
+               std::max<int64_t>(metadata.live, 0) + metadata.pooled);
+}
+
+/**
+ * \ingroup network
+ * Register CollectNetworkMemory() with MemoryReport, from the constructor
+ * of its static instance.
+ */
+class NetworkMemoryCollector
+{
+  public:
+    NetworkMemoryCollector()
+    {
+        MemoryReport::AddCollector(MakeCallback(&CollectNetworkMemory));
+    }
+};
+
+/** Instance registering CollectNetworkMemory(). */
+NetworkMemoryCollector g_networkMemoryCollector;
+
+} // namespace
+
 } // namespace ns3
@@ -15,6 +15,7 @@
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
+#include <algorithm>
 #include <list>
 #include <utility>
 
@@ -25,10 +26,13 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
+bool PacketMetadata::m_compact = false;
 bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
-uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+thread_local uint32_t PacketMetadata::m_maxSize = 0;
+thread_local uint16_t PacketMetadata::m_chunkUid = 0;
+thread_local PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+thread_local bool PacketMetadata::m_freeListDestroyed = false;
+thread_local PacketMetadata::PoolStatistics PacketMetadata::m_poolStatistics = {};
 
 PacketMetadata::DataFreeList::~DataFreeList()
 {
@@ -37,7 +41,9 @@ PacketMetadata::DataFreeList::~DataFreeList()
     {
         PacketMetadata::Deallocate(*i);
     }
-    PacketMetadata::m_enable = false;
+    // the metadata released later by this thread bypass the free list
+    PacketMetadata::m_freeListDestroyed = true;
+    PacketMetadata::m_poolStatistics.pooled = 0;
 }
 
 void
@@ -62,6 +68,135 @@ PacketMetadata::EnableChecking()
     m_enableChecking = true;
 }
 
+void
+PacketMetadata::SetCompact(bool compact)
+{
+    NS_LOG_FUNCTION(compact);
+    m_compact = compact;
+}
+
+void
+PacketMetadata::Materialize()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(IsCompact());
+    uint16_t count = m_head;
+    CompactItem compactItems[COMPACT_ITEMS];
+    for (uint16_t i = 0; i < count; i++)
+    {
+        compactItems[i] = GetCompactItem(i);
+    }
+    if (m_data != nullptr && --m_data->m_count == 0)
+    {
+        PacketMetadata::Recycle(m_data);
+    }
+    m_data = PacketMetadata::Create(10);
+    memset(m_data->m_data, 0xff, 4);
+    m_head = 0xffff;
+    m_tail = 0xffff;
+    m_used = 0;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        const CompactItem& compactItem = compactItems[i];
+        PacketMetadata::SmallItem item;
+        item.next = 0xffff;
+        item.prev = m_tail;
+        item.typeUid = compactItem.tid << 1;
+        item.size = compactItem.size;
+        item.chunkUid = compactItem.chunkUid;
+        uint16_t written = AddSmall(&item);
+        UpdateTail(written);
+    }
+    NS_ASSERT(IsStateOk());
+}
+
+void
+PacketMetadata::PrepareCompactWrite()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(IsCompact());
+    if (m_data != nullptr && m_data->m_count == 1)
+    {
+        return;
+    }
+    Data* data = PacketMetadata::Create(COMPACT_ITEMS * sizeof(CompactItem));
+    if (m_data != nullptr)
+    {
+        memcpy(data->m_data, m_data->m_data, m_head * sizeof(CompactItem));
+        // shared, hence not released
+        m_data->m_count--;
+    }
+    m_data = data;
+}
+
+void
+PacketMetadata::AddCompact(uint32_t uid, uint32_t size, bool atStart)
+{
+    NS_LOG_FUNCTION(this << uid << size << atStart);
+    NS_ASSERT(IsCompact());
+    if (m_head == COMPACT_ITEMS)
+    {
+        Materialize();
+        PacketMetadata::SmallItem item;
+        item.next = atStart ? m_head : 0xffff;
+        item.prev = atStart ? 0xffff : m_tail;
+        item.typeUid = uid;
+        item.size = size;
+        item.chunkUid = m_chunkUid;
+        m_chunkUid++;
+        uint16_t written = AddSmall(&item);
+        if (atStart)
+        {
+            UpdateHead(written);
+        }
+        else
+        {
+            UpdateTail(written);
+        }
+        return;
+    }
+    PrepareCompactWrite();
+    if (atStart)
+    {
+        memmove(m_data->m_data + sizeof(CompactItem),
+                m_data->m_data,
+                m_head * sizeof(CompactItem));
+    }
+    CompactItem item;
+    item.size = size;
+    item.tid = uid >> 1;
+    item.chunkUid = m_chunkUid;
+    m_chunkUid++;
+    SetCompactItem(atStart ? 0 : m_head, item);
+    m_head++;
+}
+
+bool
+PacketMetadata::RemoveCompact(uint32_t uid, uint32_t size, bool atStart)
+{
+    NS_LOG_FUNCTION(this << uid << size << atStart);
+    NS_ASSERT(IsCompact());
+    if (m_head == 0)
+    {
+        return false;
+    }
+    CompactItem item = GetCompactItem(atStart ? 0 : m_head - 1);
+    if (static_cast<uint32_t>(item.tid << 1) != uid || item.size != size)
+    {
+        return false;
+    }
+    if (atStart)
+    {
+        PrepareCompactWrite();
+        memmove(m_data->m_data,
+                m_data->m_data + sizeof(CompactItem),
+                (m_head - 1) * sizeof(CompactItem));
+    }
+    // the copies sharing the array keep the items after the last one
+    m_head--;
+    return true;
+}
+
 void
 PacketMetadata::ReserveCopy(uint32_t size)
 {
@@ -69,8 +204,7 @@ PacketMetadata::ReserveCopy(uint32_t size)
     PacketMetadata::Data* newData = PacketMetadata::Create(m_used + size);
     memcpy(newData->m_data, m_data->m_data, m_used);
     newData->m_dirtyEnd = m_used;
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -88,13 +222,23 @@ PacketMetadata::ReserveCopy(uint32_t size)
     }
 }
 
+bool
+PacketMetadata::IsSharedDataClean() const
+{
+#ifdef NS3_MTP
+    // the dirty area of shared data may be concurrently extended by another thread
+    return m_head == 0xffff || m_data->m_count == 1;
+#else
+    return m_head == 0xffff || m_data->m_count == 1 || m_data->m_dirtyEnd == m_used;
+#endif
+}
+
 void
 PacketMetadata::Reserve(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     NS_ASSERT(m_data != nullptr);
-    if (m_data->m_size >= m_used + size &&
-        (m_head == 0xffff || m_data->m_count == 1 || m_data->m_dirtyEnd == m_used))
+    if (m_data->m_size >= m_used + size && IsSharedDataClean())
     {
         /* enough room, not dirty. */
     }
@@ -125,6 +269,10 @@ bool
 PacketMetadata::IsStateOk() const
 {
     NS_LOG_FUNCTION(this);
+    if (IsCompact())
+    {
+        return m_head <= COMPACT_ITEMS && (m_head == 0 || m_data != nullptr);
+    }
     bool ok = m_used <= m_data->m_size;
     ok &= IsPointerOk(m_head);
     ok &= IsPointerOk(m_tail);
@@ -373,8 +521,7 @@ PacketMetadata::AddSmall(const PacketMetadata::SmallItem* item)
     uint32_t typeUidSize = GetUleb128Size(item->typeUid);
     uint32_t sizeSize = GetUleb128Size(item->size);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2;
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+    if (m_used + n > m_data->m_size || !IsSharedDataClean())
     {
         ReserveCopy(n);
     }
@@ -410,8 +557,7 @@ PacketMetadata::AddBig(uint32_t next,
     uint32_t fragEndSize = GetUleb128Size(extraItem->fragmentEnd);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+    if (m_used + n > m_data->m_size || !IsSharedDataClean())
     {
         ReserveCopy(n);
     }
@@ -493,6 +639,11 @@ PacketMetadata::ReplaceTail(PacketMetadata::SmallItem* item,
 
     // create a copy of the packet without its tail.
     PacketMetadata h(m_packetUid, 0);
+    if (h.IsCompact())
+    {
+        // the items below are added to the linked list
+        h.Materialize();
+    }
     uint16_t current = m_head;
     while (current != 0xffff && current != m_tail)
     {
@@ -561,14 +712,19 @@ PacketMetadata::Create(uint32_t size)
     {
         m_maxSize = size;
     }
-    while (!m_freeList.empty())
+    m_poolStatistics.allocations++;
+    m_poolStatistics.live++;
+    m_poolStatistics.peak = std::max(m_poolStatistics.peak, m_poolStatistics.live);
+    while (!m_freeListDestroyed && !m_freeList.empty())
     {
         PacketMetadata::Data* data = m_freeList.back();
         m_freeList.pop_back();
+        m_poolStatistics.pooled--;
         if (data->m_size >= size)
         {
             NS_LOG_LOGIC("create found size=" << data->m_size);
             data->m_count = 1;
+            m_poolStatistics.hits++;
             return data;
         }
         NS_LOG_LOGIC("create dealloc size=" << data->m_size);
@@ -582,13 +738,15 @@ void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    if (!m_enable)
+    NS_ASSERT(data->m_count == 0);
+    m_poolStatistics.releases++;
+    m_poolStatistics.live--;
+    if (!m_enable || m_freeListDestroyed)
     {
         PacketMetadata::Deallocate(data);
         return;
     }
     NS_LOG_LOGIC("recycle size=" << data->m_size << ", list=" << m_freeList.size());
-    NS_ASSERT(data->m_count == 0);
     if (m_freeList.size() > 1000 || data->m_size < m_maxSize)
     {
         PacketMetadata::Deallocate(data);
@@ -596,9 +754,26 @@ PacketMetadata::Recycle(PacketMetadata::Data* data)
     else
     {
         m_freeList.push_back(data);
+        m_poolStatistics.pooled++;
     }
 }
 
+PacketMetadata::PoolStatistics
+PacketMetadata::GetPoolStatistics()
+{
+    return m_poolStatistics;
+}
+
+void
+PacketMetadata::ResetPoolStatistics()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_poolStatistics.allocations = 0;
+    m_poolStatistics.hits = 0;
+    m_poolStatistics.releases = 0;
+    m_poolStatistics.peak = m_poolStatistics.live;
+}
+
 PacketMetadata::Data*
 PacketMetadata::Allocate(uint32_t n)
 {
@@ -614,6 +789,7 @@ PacketMetadata::Allocate(uint32_t n)
     data->m_size = n;
     data->m_count = 1;
     data->m_dirtyEnd = 0;
+    m_poolStatistics.bytes += size;
     return data;
 }
 
@@ -621,6 +797,7 @@ void
 PacketMetadata::Deallocate(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
+    m_poolStatistics.bytes -= sizeof(Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE;
     auto buf = (uint8_t*)data;
     delete[] buf;
 }
@@ -653,6 +830,11 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    if (IsCompact())
+    {
+        AddCompact(uid, size, true);
+        return;
+    }
 
     PacketMetadata::SmallItem item;
     item.next = m_head;
@@ -675,6 +857,14 @@ PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    if (IsCompact())
+    {
+        if (!RemoveCompact(uid, size, true) && m_enableChecking)
+        {
+            NS_FATAL_ERROR("Removing unexpected header.");
+        }
+        return;
+    }
     PacketMetadata::SmallItem item;
     PacketMetadata::ExtraItem extraItem;
     uint32_t read = ReadItems(m_head, &item, &extraItem);
@@ -720,6 +910,12 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    if (IsCompact())
+    {
+        AddCompact(uid, size, false);
+        NS_ASSERT(IsStateOk());
+        return;
+    }
     PacketMetadata::SmallItem item;
     item.next = 0xffff;
     item.prev = m_tail;
@@ -742,6 +938,14 @@ PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    if (IsCompact())
+    {
+        if (!RemoveCompact(uid, size, false) && m_enableChecking)
+        {
+            NS_FATAL_ERROR("Removing unexpected trailer.");
+        }
+        return;
+    }
     PacketMetadata::SmallItem item;
     PacketMetadata::ExtraItem extraItem;
     uint32_t read = ReadItems(m_tail, &item, &extraItem);
@@ -786,7 +990,7 @@ PacketMetadata::AddAtEnd(const PacketMetadata& o)
         m_metadataSkipped = true;
         return;
     }
-    if (m_tail == 0xffff)
+    if (IsCompact() ? m_head == 0 : m_tail == 0xffff)
     {
         // We have no items so 'AddAtEnd' is
         // equivalent to self-assignment.
@@ -794,12 +998,28 @@ PacketMetadata::AddAtEnd(const PacketMetadata& o)
         NS_ASSERT(IsStateOk());
         return;
     }
+    if (o.IsCompact())
+    {
+        if (o.m_head == 0)
+        {
+            // we have nothing to append.
+            return;
+        }
+        PacketMetadata full = o;
+        full.Materialize();
+        AddAtEnd(full);
+        return;
+    }
     if (o.m_head == 0xffff)
     {
         NS_ASSERT(o.m_tail == 0xffff);
         // we have nothing to append.
         return;
     }
+    if (IsCompact())
+    {
+        Materialize();
+    }
     NS_ASSERT(m_head != 0xffff && m_tail != 0xffff);
 
     // We read the current tail because we are going to append
@@ -873,8 +1093,31 @@ PacketMetadata::RemoveAtStart(uint32_t start)
         m_metadataSkipped = true;
         return;
     }
-    NS_ASSERT(m_data != nullptr);
     uint32_t leftToRemove = start;
+    if (IsCompact())
+    {
+        uint16_t removed = 0;
+        while (removed < m_head && GetCompactItem(removed).size <= leftToRemove)
+        {
+            leftToRemove -= GetCompactItem(removed).size;
+            removed++;
+        }
+        if (removed > 0)
+        {
+            PrepareCompactWrite();
+            memmove(m_data->m_data,
+                    m_data->m_data + removed * sizeof(CompactItem),
+                    (m_head - removed) * sizeof(CompactItem));
+            m_head -= removed;
+        }
+        if (leftToRemove == 0)
+        {
+            return;
+        }
+        // the first item becomes a fragment
+        Materialize();
+    }
+    NS_ASSERT(m_data != nullptr);
     uint16_t current = m_head;
     while (current != 0xffff && leftToRemove > 0)
     {
@@ -900,6 +1143,11 @@ PacketMetadata::RemoveAtStart(uint32_t start)
         {
             // fragment the list item.
             PacketMetadata fragment(m_packetUid, 0);
+            if (fragment.IsCompact())
+            {
+                // the items below are added to the linked list
+                fragment.Materialize();
+            }
             extraItem.fragmentStart += leftToRemove;
             leftToRemove = 0;
             uint16_t written = fragment.AddBig(0xffff, fragment.m_tail, &item, &extraItem);
@@ -934,9 +1182,22 @@ PacketMetadata::RemoveAtEnd(uint32_t end)
         m_metadataSkipped = true;
         return;
     }
-    NS_ASSERT(m_data != nullptr);
-
     uint32_t leftToRemove = end;
+    if (IsCompact())
+    {
+        while (m_head > 0 && GetCompactItem(m_head - 1).size <= leftToRemove)
+        {
+            leftToRemove -= GetCompactItem(m_head - 1).size;
+            m_head--;
+        }
+        if (leftToRemove == 0)
+        {
+            return;
+        }
+        // the last item becomes a fragment
+        Materialize();
+    }
+    NS_ASSERT(m_data != nullptr);
     uint16_t current = m_tail;
     while (current != 0xffff && leftToRemove > 0)
     {
@@ -962,6 +1223,11 @@ PacketMetadata::RemoveAtEnd(uint32_t end)
         {
             // fragment the list item.
             PacketMetadata fragment(m_packetUid, 0);
+            if (fragment.IsCompact())
+            {
+                // the items below are added to the linked list
+                fragment.Materialize();
+            }
             NS_ASSERT(extraItem.fragmentEnd > leftToRemove);
             extraItem.fragmentEnd -= leftToRemove;
             leftToRemove = 0;
@@ -993,6 +1259,14 @@ PacketMetadata::GetTotalSize() const
 {
     NS_LOG_FUNCTION(this);
     uint32_t totalSize = 0;
+    if (IsCompact())
+    {
+        for (uint16_t i = 0; i < m_head; i++)
+        {
+            totalSize += GetCompactItem(i).size;
+        }
+        return totalSize;
+    }
     uint16_t current = m_head;
     uint16_t tail = m_tail;
     while (current != 0xffff)
@@ -1028,7 +1302,7 @@ PacketMetadata::BeginItem(Buffer buffer) const
 PacketMetadata::ItemIterator::ItemIterator(const PacketMetadata* metadata, Buffer buffer)
     : m_metadata(metadata),
       m_buffer(buffer),
-      m_current(metadata->m_head),
+      m_current(metadata->IsCompact() ? 0 : metadata->m_head),
       m_offset(0),
       m_hasReadTail(false)
 {
@@ -1039,6 +1313,10 @@ bool
 PacketMetadata::ItemIterator::HasNext() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_metadata->IsCompact())
+    {
+        return m_current < m_metadata->m_head;
+    }
     if (m_current == 0xffff)
     {
         return false;
@@ -1057,12 +1335,25 @@ PacketMetadata::ItemIterator::Next()
     PacketMetadata::Item item;
     PacketMetadata::SmallItem smallItem;
     PacketMetadata::ExtraItem extraItem;
-    m_metadata->ReadItems(m_current, &smallItem, &extraItem);
-    if (m_current == m_metadata->m_tail)
+    if (m_metadata->IsCompact())
+    {
+        // a whole item of this packet
+        CompactItem compactItem = m_metadata->GetCompactItem(m_current);
+        smallItem.typeUid = compactItem.tid << 1;
+        smallItem.size = compactItem.size;
+        extraItem.fragmentStart = 0;
+        extraItem.fragmentEnd = compactItem.size;
+        m_current++;
+    }
+    else
     {
-        m_hasReadTail = true;
+        m_metadata->ReadItems(m_current, &smallItem, &extraItem);
+        if (m_current == m_metadata->m_tail)
+        {
+            m_hasReadTail = true;
+        }
+        m_current = smallItem.next;
     }
-    m_current = smallItem.next;
     uint32_t uid = (smallItem.typeUid & 0xfffffffe) >> 1;
     item.tid.SetUid(uid);
     item.currentTrimmedFromStart = extraItem.fragmentStart;
@@ -1117,6 +1408,12 @@ PacketMetadata::GetSerializedSize() const
     {
         return totalSize;
     }
+    if (IsCompact())
+    {
+        PacketMetadata full = *this;
+        full.Materialize();
+        return full.GetSerializedSize();
+    }
 
     PacketMetadata::SmallItem item;
     PacketMetadata::ExtraItem extraItem;
@@ -1150,6 +1447,12 @@ uint32_t
 PacketMetadata::Serialize(uint8_t* buffer, uint32_t maxSize) const
 {
     NS_LOG_FUNCTION(this << &buffer << maxSize);
+    if (IsCompact())
+    {
+        PacketMetadata full = *this;
+        full.Materialize();
+        return full.Serialize(buffer, maxSize);
+    }
     uint8_t* start = buffer;
 
     buffer = AddToRawU64(m_packetUid, start, buffer, maxSize);
@@ -1256,6 +1559,10 @@ uint32_t
 PacketMetadata::Deserialize(const uint8_t* buffer, uint32_t size)
 {
     NS_LOG_FUNCTION(this << &buffer << size);
+    if (IsCompact())
+    {
+        Materialize();
+    }
     const uint8_t* start = buffer;
     uint32_t desSize = size - 4;
 
@@ -14,10 +14,15 @@
 #include "ns3/callback.h"
 #include "ns3/type-id.h"
 
+#include <cstring>
 #include <limits>
 #include <stdint.h>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -65,6 +70,16 @@ class Trailer;
  * integers, and some others as variable-size 32-bit integers.
  * The variable-size 32 bit integers are stored using the uleb128
  * encoding.
+ *
+ * In compact mode (see SetCompact()), the whole headers, trailers and
+ * payload of a packet are recorded in a small array of type ids and
+ * sizes, which is enough for the common Add/RemoveHeader and
+ * Add/RemoveTrailer operations and for the ItemIterator.  The array is
+ * stored in the data buffer, which is only allocated with the first
+ * item, and shared by the copies of the packet until one of them
+ * changes it.  The linked list is only built, from the array, when an
+ * operation needs it: fragmentation, concatenation, serialization, or
+ * more items than the array holds.
  */
 class PacketMetadata
 {
@@ -145,7 +160,7 @@ class PacketMetadata
       private:
         const PacketMetadata* m_metadata; //!< pointer to the metadata
         Buffer m_buffer;                  //!< buffer the metadata refers to
-        uint16_t m_current;               //!< current position
+        uint16_t m_current;               //!< current position, or item index in compact mode
         uint32_t m_offset;                //!< offset
         bool m_hasReadTail;               //!< true if the metadata tail has been read
     };
@@ -158,6 +173,45 @@ class PacketMetadata
      * \brief Enable the packet metadata checking
      */
     static void EnableChecking();
+    /**
+     * \brief Enable or disable the compact mode of the packet metadata
+     *
+     * The mode applies to the instances created afterwards, and does
+     * not change the history they record.
+     *
+     * \param compact true to record the items of new packets in a
+     *        compact array until a fragmentation or concatenation
+     */
+    static void SetCompact(bool compact);
+
+    /**
+     * Allocation counters of the metadata storages, for the calling
+     * thread.
+     *
+     * Each thread keeps its own free list of released storages.  A
+     * storage is released to the free list of the thread which drops its
+     * last reference, which may not be the thread which created it.
+     */
+    struct PoolStatistics
+    {
+        uint64_t allocations; //!< Number of storages created.
+        uint64_t hits;        //!< Number of storages reused from the free list.
+        uint64_t releases;    //!< Number of storages released.
+        int64_t live;         //!< Number of storages created minus the ones released.
+        int64_t peak;         //!< Maximum of live since the last reset.
+        uint64_t pooled;      //!< Number of storages in the free list.
+        int64_t bytes;        //!< Size of the storages allocated, live or pooled.
+    };
+
+    /**
+     * \returns The metadata storage counters of the calling thread.
+     */
+    static PoolStatistics GetPoolStatistics();
+    /**
+     * Reset the allocation, hit and release counters of the calling
+     * thread, and set its peak to the current live count.
+     */
+    static void ResetPoolStatistics();
 
     /**
      * \brief Constructor
@@ -415,7 +469,11 @@ class PacketMetadata
     struct Data
     {
         /** number of references to this struct Data instance. */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /** size (in bytes) of m_data buffer below */
         uint32_t m_size;
         /** max of the m_used field over all objects which reference this struct Data instance */
@@ -499,7 +557,7 @@ class PacketMetadata
     };
 
     /**
-     * \brief Class to hold all the metadata
+     * \brief Free list of the metadata storages of a thread
      */
     class DataFreeList : public std::vector<Data*>
     {
@@ -590,6 +648,12 @@ class PacketMetadata
      */
     void AppendValueExtra(uint32_t value, uint8_t* buffer);
 
+    /**
+     * \brief Check if new items can be written in place after m_used
+     * \returns true if the data is not shared or if no other instance
+     *          wrote past m_used
+     */
+    bool IsSharedDataClean() const;
     /**
      * \brief Reserve space
      * \param n space to reserve
@@ -617,12 +681,72 @@ class PacketMetadata
     uint32_t ReadItems(uint16_t current,
                        PacketMetadata::SmallItem* item,
                        PacketMetadata::ExtraItem* extraItem) const;
+    /**
+     * An item of the array of the compact mode: a whole header, trailer
+     * or payload added to this packet.
+     */
+    struct CompactItem
+    {
+        uint32_t size;     //!< the item size
+        uint16_t tid;      //!< the TypeId uid of the header or trailer, or 0 for payload
+        uint16_t chunkUid; //!< the chunk uid, as in SmallItem::chunkUid
+    };
+
+    /// Size of the array of the compact mode
+    static constexpr uint8_t COMPACT_ITEMS = 6;
+    /// Value of m_used in compact mode
+    static constexpr uint32_t COMPACT = 0xffffffff;
+
     /**
      * \brief Add an header
      * \param uid header's uid to add
      * \param size header serialized size
      */
     void DoAddHeader(uint32_t uid, uint32_t size);
+    /**
+     * \brief Check if the metadata is recorded in the compact array
+     * \returns true if the linked list of items has not been built
+     */
+    inline bool IsCompact() const;
+    /**
+     * \brief Build the linked list of items from the compact array
+     */
+    void Materialize();
+    /**
+     * \brief Read an item of the compact array
+     * \param index the item index
+     * \returns the item
+     */
+    inline CompactItem GetCompactItem(uint16_t index) const;
+    /**
+     * \brief Write an item of the compact array
+     *
+     * The array must have been prepared with PrepareCompactWrite().
+     *
+     * \param index the item index
+     * \param item the item
+     */
+    inline void SetCompactItem(uint16_t index, const CompactItem& item);
+    /**
+     * \brief Allocate the compact array, or copy it if it is shared, before
+     * changing it
+     */
+    void PrepareCompactWrite();
+    /**
+     * \brief Add an item to the compact array, or to the linked list if full
+     * \param uid the item uid, as in SmallItem::typeUid
+     * \param size the item size
+     * \param atStart true to add the item before the others
+     */
+    void AddCompact(uint32_t uid, uint32_t size, bool atStart);
+    /**
+     * \brief Remove the first or last item of the compact array
+     * \param uid the expected item uid, as in SmallItem::typeUid
+     * \param size the expected item size
+     * \param atStart true to remove the first item
+     * \returns false if the item is not the expected one
+     */
+    bool RemoveCompact(uint32_t uid, uint32_t size, bool atStart);
     /**
      * \brief Check if the metadata state is ok
      * \returns true if the internal state is ok
@@ -664,9 +788,14 @@ class PacketMetadata
      */
     static void Deallocate(PacketMetadata::Data* data);
 
-    static DataFreeList m_freeList; //!< the metadata data storage
-    static bool m_enable;           //!< Enable the packet metadata
-    static bool m_enableChecking;   //!< Enable the packet metadata checking
+    static thread_local DataFreeList m_freeList; //!< the free metadata storages of each thread
+    /// Whether the free list of the thread has been destroyed, at its exit
+    static thread_local bool m_freeListDestroyed;
+    /// Allocation counters, per thread
+    static thread_local PoolStatistics m_poolStatistics;
+    static bool m_enable;         //!< Enable the packet metadata
+    static bool m_enableChecking; //!< Enable the packet metadata checking
+    static bool m_compact;        //!< Record the items of new instances in a compact array
 
     /**
      * Set to true when adding metadata to a packet is skipped because
@@ -675,8 +804,8 @@ class PacketMetadata
      */
     static bool m_metadataSkipped;
 
-    static uint32_t m_maxSize;  //!< maximum metadata size
-    static uint16_t m_chunkUid; //!< Chunk Uid
+    static thread_local uint32_t m_maxSize; //!< maximum metadata size, per thread
+    static thread_local uint16_t m_chunkUid; //!< Chunk Uid, per thread
 
     Data* m_data; //!< Metadata storage
     /*
@@ -684,9 +813,9 @@ class PacketMetadata
          ^             |
           \---(prev)---|
      */
-    uint16_t m_head;      //!< list head
+    uint16_t m_head;      //!< list head, or number of items in compact mode
     uint16_t m_tail;      //!< list tail
-    uint32_t m_used;      //!< used portion
+    uint32_t m_used;      //!< used portion, or COMPACT in compact mode
     uint64_t m_packetUid; //!< packet Uid
 };
 
@@ -696,13 +825,16 @@ namespace ns3
 {
 
 PacketMetadata::PacketMetadata(uint64_t uid, uint32_t size)
-    : m_data(PacketMetadata::Create(10)),
-      m_head(0xffff),
+    : m_data(m_compact ? nullptr : PacketMetadata::Create(10)),
+      m_head(m_compact ? 0 : 0xffff),
       m_tail(0xffff),
-      m_used(0),
+      m_used(m_compact ? COMPACT : 0),
       m_packetUid(uid)
 {
-    memset(m_data->m_data, 0xff, 4);
+    if (m_data != nullptr)
+    {
+        memset(m_data->m_data, 0xff, 4);
+    }
     if (size > 0)
     {
         DoAddHeader(0, size);
@@ -716,9 +848,11 @@ PacketMetadata::PacketMetadata(const PacketMetadata& o)
       m_used(o.m_used),
       m_packetUid(o.m_packetUid)
 {
-    NS_ASSERT(m_data != nullptr);
-    NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
-    m_data->m_count++;
+    if (m_data != nullptr)
+    {
+        NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
+        m_data->m_count++;
+    }
 }
 
 PacketMetadata&
@@ -727,15 +861,15 @@ PacketMetadata::operator=(const PacketMetadata& o)
     if (m_data != o.m_data)
     {
         // not self assignment
-        NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (m_data != nullptr && --m_data->m_count == 0)
         {
             PacketMetadata::Recycle(m_data);
         }
         m_data = o.m_data;
-        NS_ASSERT(m_data != nullptr);
-        m_data->m_count++;
+        if (m_data != nullptr)
+        {
+            m_data->m_count++;
+        }
     }
     m_head = o.m_head;
     m_tail = o.m_tail;
@@ -746,14 +880,33 @@ PacketMetadata::operator=(const PacketMetadata& o)
 
 PacketMetadata::~PacketMetadata()
 {
-    NS_ASSERT(m_data != nullptr);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (m_data != nullptr && --m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
 }
 
+bool
+PacketMetadata::IsCompact() const
+{
+    return m_used == COMPACT;
+}
+
+PacketMetadata::CompactItem
+PacketMetadata::GetCompactItem(uint16_t index) const
+{
+    // the data buffer is not aligned for the items
+    CompactItem item;
+    memcpy(&item, m_data->m_data + index * sizeof(CompactItem), sizeof(CompactItem));
+    return item;
+}
+
+void
+PacketMetadata::SetCompactItem(uint16_t index, const CompactItem& item)
+{
+    memcpy(m_data->m_data + index * sizeof(CompactItem), &item, sizeof(CompactItem));
+}
+
 } // namespace ns3
 
 #endif /* PACKET_METADATA_H */
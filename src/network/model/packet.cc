@@ -19,7 +19,12 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+#ifdef NS3_MTP
+std::atomic<uint32_t> Packet::m_globalUid = 0;
+#else
+thread_local uint32_t Packet::m_globalUid = 0;
+#endif
+thread_local uint64_t* Packet::m_uidCounter = nullptr;
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -135,10 +140,9 @@ Packet::Packet()
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(AllocateUid(), 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
@@ -175,10 +179,9 @@ Packet::Packet(uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -202,10 +205,9 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
@@ -588,6 +590,14 @@ Packet::EnablePrinting()
     PacketMetadata::Enable();
 }
 
+void
+Packet::EnableCompactPrinting()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    PacketMetadata::Enable();
+    PacketMetadata::SetCompact(true);
+}
+
 void
 Packet::EnableChecking()
 {
@@ -595,6 +605,22 @@ Packet::EnableChecking()
     PacketMetadata::EnableChecking();
 }
 
+void
+Packet::SetUidCounter(uint64_t* counter)
+{
+    m_uidCounter = counter;
+}
+
+uint64_t
+Packet::AllocateUid()
+{
+    if (m_uidCounter != nullptr)
+    {
+        return (*m_uidCounter)++;
+    }
+    return static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++;
+}
+
 uint32_t
 Packet::GetSerializedSize() const
 {
@@ -24,6 +24,10 @@
 
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -514,6 +518,17 @@ class Packet : public SimpleRefCount<Packet>
      * simulation setup and before any packet is created.
      */
     static void EnablePrinting();
+    /**
+     * \brief Enable printing packets metadata, in compact mode.
+     *
+     * Like EnablePrinting(), but the metadata of each packet is
+     * recorded in a small array of header and trailer types,
+     * and the full history is only built when the packet is
+     * fragmented, concatenated with another packet, or serialized.
+     * This makes the metadata much cheaper for packets which only
+     * get headers and trailers added and removed.
+     */
+    static void EnableCompactPrinting();
     /**
      * \brief Enable packets metadata checking.
      *
@@ -526,6 +541,20 @@ class Packet : public SimpleRefCount<Packet>
      */
     static void EnableChecking();
 
+    /**
+     * \brief Set the counter giving the uids of the packets created by
+     * the calling thread.
+     *
+     * By default, the upper 32 bits of a packet uid hold the system id
+     * and the lower 32 bits a counter of the packets created.  A
+     * parallel simulator sets a counter per partition, so that the uids
+     * do not depend on the interleaving of its threads.
+     *
+     * \param [in] counter The counter, incremented for each packet, or
+     *             \c nullptr to use the default counter.
+     */
+    static void SetUidCounter(uint64_t* counter);
+
     /**
      * \brief Returns number of bytes required for packet
      * serialization.
@@ -776,6 +805,11 @@ class Packet : public SimpleRefCount<Packet>
      */
     uint32_t Deserialize(const uint8_t* buffer, uint32_t size);
 
+    /**
+     * \returns A new packet uid.
+     */
+    static uint64_t AllocateUid();
+
     Buffer m_buffer;               //!< the packet buffer (it's actual contents)
     ByteTagList m_byteTagList;     //!< the ByteTag list
     PacketTagList m_packetTagList; //!< the packet's Tag list
@@ -784,7 +818,12 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-    static uint32_t m_globalUid; //!< Global counter of packets Uid
+#ifdef NS3_MTP
+    static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
+#else
+    static thread_local uint32_t m_globalUid; //!< Counter of packets Uid, per thread
+#endif
+    static thread_local uint64_t* m_uidCounter; //!< Counter set by SetUidCounter(), per thread
 };
 
 /**
@@ -0,0 +1,372 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/binary-trace-file.h"
+#include "ns3/binary-trace-helper.h"
+#include "ns3/data-rate.h"
+#include "ns3/mac48-address.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Binary trace file test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that BinaryTraceReader reads the records written to a
+ * BinaryTraceFile, seeks times, and reads unclosed files.
+ */
+class BinaryTraceFileTestCase : public TestCase
+{
+  public:
+    BinaryTraceFileTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Read a file, and check its records.
+     * \param [in] filename The file name.
+     * \param [in] records The number of records expected.
+     */
+    void CheckRecords(const std::string& filename, uint32_t records);
+
+    /**
+     * The time of a record.
+     * \param [in] i The record number.
+     * \returns The time of the record.
+     */
+    static Time GetRecordTime(uint32_t i);
+};
+
+BinaryTraceFileTestCase::BinaryTraceFileTestCase()
+    : TestCase("Check BinaryTraceFile and BinaryTraceReader")
+{
+}
+
+Time
+BinaryTraceFileTestCase::GetRecordTime(uint32_t i)
+{
+    return MicroSeconds(10 * i + i % 7);
+}
+
+void
+BinaryTraceFileTestCase::CheckRecords(const std::string& filename, uint32_t records)
+{
+    BinaryTraceReader reader(filename);
+    NS_TEST_ASSERT_MSG_EQ(reader.Fail(), false, "Cannot read " << filename);
+    NS_TEST_ASSERT_MSG_EQ(reader.GetSchema(), "Test", "Schema name");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetColumns().size(), 3, "Number of columns");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetColumnIndex("ratio"), 2, "Column index");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetNRecords(), records, "Number of records");
+
+    uint32_t i = 0;
+    while (reader.Read())
+    {
+        NS_TEST_ASSERT_MSG_EQ(reader.GetTime(), GetRecordTime(i), "Time of record " << i);
+        NS_TEST_ASSERT_MSG_EQ(reader.GetInt64(0), 1000 - int64_t(i) * i, "Signed value " << i);
+        NS_TEST_ASSERT_MSG_EQ(reader.GetUint64(1),
+                              ((i % 2) ? UINT64_MAX - i : i),
+                              "Unsigned value " << i);
+        NS_TEST_ASSERT_MSG_EQ(reader.GetDouble(2), i / 3.0, "Double value " << i);
+        i++;
+    }
+    NS_TEST_ASSERT_MSG_EQ(i, records, "Records read");
+
+    // Seek a time between two records, then an exact one
+    reader.Seek(GetRecordTime(records / 2) - NanoSeconds(1));
+    NS_TEST_ASSERT_MSG_EQ(reader.Read(), true, "Read after seek");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetTime(), GetRecordTime(records / 2), "Seek between records");
+    reader.Seek(GetRecordTime(1001));
+    NS_TEST_ASSERT_MSG_EQ(reader.Read(), true, "Read after seek");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetTime(), GetRecordTime(1001), "Seek a record");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetDouble(2), 1001 / 3.0, "Double value after seek");
+    reader.Seek(Seconds(1000));
+    NS_TEST_ASSERT_MSG_EQ(reader.Read(), false, "Read after seek past the end");
+}
+
+void
+BinaryTraceFileTestCase::DoRun()
+{
+    const uint32_t records = 2500;
+    std::string filename = CreateTempDirFilename("binary-trace-test.btr");
+    {
+        auto file = Create<BinaryTraceFile>(
+            filename,
+            "Test",
+            std::vector<BinaryTraceFile::Column>{{"signed", BinaryTraceFile::INT64},
+                                                 {"unsigned", BinaryTraceFile::UINT64},
+                                                 {"ratio", BinaryTraceFile::DOUBLE}},
+            1000);
+        for (uint32_t i = 0; i < records; ++i)
+        {
+            file->Write(GetRecordTime(i),
+                        {1000 - int64_t(i) * i, (i % 2) ? UINT64_MAX - i : uint64_t(i), i / 3.0});
+        }
+        NS_TEST_ASSERT_MSG_EQ(file->Fail(), false, "Cannot write " << filename);
+    }
+    CheckRecords(filename, records);
+
+    // The same file without its index, as if the writer had not closed it
+    std::ifstream in(filename, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    uint64_t index = 0;
+    for (int i = 7; i >= 0; --i)
+    {
+        index = (index << 8) | static_cast<uint8_t>(bytes[bytes.size() - 16 + i]);
+    }
+    std::string unclosed = CreateTempDirFilename("binary-trace-test-unclosed.btr");
+    std::ofstream(unclosed, std::ios::binary).write(bytes.data(), index);
+    CheckRecords(unclosed, records);
+
+    // A truncated last block is skipped
+    std::ofstream(unclosed, std::ios::binary).write(bytes.data(), index - 1);
+    CheckRecords(unclosed, 2000);
+
+    std::remove(filename.c_str());
+    std::remove(unclosed.c_str());
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that BinaryTraceHelper writes the packet events of devices.
+ */
+class BinaryTraceHelperTestCase : public TestCase
+{
+  public:
+    BinaryTraceHelperTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BinaryTraceHelperTestCase::BinaryTraceHelperTestCase()
+    : TestCase("Check BinaryTraceHelper")
+{
+}
+
+void
+BinaryTraceHelperTestCase::DoRun()
+{
+    NodeContainer nodes(2);
+    SimpleNetDeviceHelper simple;
+    simple.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mbps")));
+    NetDeviceContainer devices = simple.Install(nodes);
+
+    std::string filename = CreateTempDirFilename("binary-trace-helper-test.btr");
+    BinaryTraceHelper binary;
+    Ptr<BinaryTraceFile> file = binary.CreatePacketEventFile(filename);
+    binary.EnablePacketEvents(file, devices);
+
+    const uint32_t packets = 10;
+    for (uint32_t i = 0; i < packets; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(i), [&devices, i]() {
+            devices.Get(0)->Send(Create<Packet>(100 + i), devices.Get(1)->GetAddress(), 0x800);
+        });
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+    file->Close();
+
+    BinaryTraceReader reader(filename);
+    NS_TEST_ASSERT_MSG_EQ(reader.GetSchema(), "PacketEvents", "Schema name");
+    uint32_t node = reader.GetColumnIndex("node");
+    uint32_t event = reader.GetColumnIndex("event");
+    uint32_t size = reader.GetColumnIndex("size");
+    uint32_t enqueued = 0;
+    uint32_t dequeued = 0;
+    while (reader.Read())
+    {
+        NS_TEST_ASSERT_MSG_EQ(reader.GetUint64(node), 0, "Event of the receiving node");
+        if (reader.GetUint64(event) == BinaryTraceHelper::ENQUEUE)
+        {
+            NS_TEST_ASSERT_MSG_EQ(reader.GetUint64(size), 100 + enqueued, "Packet size");
+            enqueued++;
+        }
+        else if (reader.GetUint64(event) == BinaryTraceHelper::DEQUEUE)
+        {
+            dequeued++;
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(enqueued, packets, "Enqueue events");
+    NS_TEST_ASSERT_MSG_EQ(dequeued, packets, "Dequeue events");
+    std::remove(filename.c_str());
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that utils/read-binary-trace.py reads the records written
+ * to a BinaryTraceFile.
+ *
+ * The test is skipped when python3 or the script are not found.
+ */
+class BinaryTraceScriptTestCase : public TestCase
+{
+  public:
+    BinaryTraceScriptTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Read a trace with the Python script.
+     *
+     * \param [in] filename The trace file.
+     * \param [in] options The options of the script.
+     * \returns The lines printed by the script, or an empty vector on error.
+     */
+    std::vector<std::string> RunScript(const std::string& filename, const std::string& options);
+
+    std::string m_script; //!< The path of the script.
+};
+
+BinaryTraceScriptTestCase::BinaryTraceScriptTestCase()
+    : TestCase("Check the Python reader of binary trace files")
+{
+}
+
+std::vector<std::string>
+BinaryTraceScriptTestCase::RunScript(const std::string& filename, const std::string& options)
+{
+    std::string output = CreateTempDirFilename("binary-trace-script.csv");
+    std::string command =
+        "python3 " + m_script + " " + filename + " " + options + " > " + output + " 2>&1";
+    std::vector<std::string> lines;
+    if (std::system(command.c_str()) == 0)
+    {
+        std::ifstream is(output);
+        for (std::string line; std::getline(is, line);)
+        {
+            lines.push_back(line);
+        }
+    }
+    std::remove(output.c_str());
+    return lines;
+}
+
+void
+BinaryTraceScriptTestCase::DoRun()
+{
+    m_script = std::string(NS_TEST_SOURCEDIR) + "/../../../utils/read-binary-trace.py";
+    if (!std::ifstream(m_script).good() || std::system("python3 --version > /dev/null 2>&1") != 0)
+    {
+        std::cout << "Skipping " << GetName() << ": python3 or " << m_script << " not found"
+                  << std::endl;
+        return;
+    }
+
+    // Several blocks, with negative, large unsigned and double values
+    const uint32_t records = 2500;
+    auto getTime = [](uint32_t i) { return MicroSeconds(10 * i + i % 7); };
+    std::string filename = CreateTempDirFilename("binary-trace-script.btr");
+    {
+        auto file = Create<BinaryTraceFile>(
+            filename,
+            "Test",
+            std::vector<BinaryTraceFile::Column>{{"signed", BinaryTraceFile::INT64},
+                                                 {"unsigned", BinaryTraceFile::UINT64},
+                                                 {"ratio", BinaryTraceFile::DOUBLE}},
+            1000);
+        for (uint32_t i = 0; i < records; ++i)
+        {
+            file->Write(getTime(i),
+                        {1000 - int64_t(i) * i, (i % 2) ? UINT64_MAX - i : uint64_t(i), i / 3.0});
+        }
+    }
+
+    // The whole file, then a time range across two blocks
+    for (uint32_t first : {0, 990})
+    {
+        uint32_t last = first == 0 ? records : 1010;
+        std::string options;
+        if (first != 0)
+        {
+            options = "--start " + std::to_string(getTime(first).GetSeconds()) + " --stop " +
+                      std::to_string(getTime(last).GetSeconds());
+        }
+        std::vector<std::string> lines = RunScript(filename, options);
+        NS_TEST_ASSERT_MSG_EQ(lines.size(), 1 + last - first, "Lines printed for " << options);
+        NS_TEST_ASSERT_MSG_EQ(lines[0], "time,signed,unsigned,ratio", "Header");
+        for (uint32_t i = first; i < last; ++i)
+        {
+            std::istringstream is(lines[1 + i - first]);
+            std::string time;
+            std::string value;
+            std::string ratio;
+            std::getline(is, time, ',');
+            NS_TEST_ASSERT_MSG_EQ_TOL(std::stod(time),
+                                      getTime(i).GetSeconds(),
+                                      1e-12,
+                                      "Time of record " << i);
+            std::getline(is, value, ',');
+            NS_TEST_ASSERT_MSG_EQ(std::stoll(value), 1000 - int64_t(i) * i, "Signed value " << i);
+            std::getline(is, value, ',');
+            NS_TEST_ASSERT_MSG_EQ(value.find('-'), std::string::npos, "Unsigned value " << i);
+            NS_TEST_ASSERT_MSG_EQ(std::stoull(value),
+                                  ((i % 2) ? UINT64_MAX - i : i),
+                                  "Unsigned value " << i);
+            std::getline(is, ratio);
+            NS_TEST_ASSERT_MSG_EQ(std::stod(ratio), i / 3.0, "Double value " << i);
+        }
+    }
+    std::remove(filename.c_str());
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Binary trace file test suite.
+ */
+class BinaryTraceTestSuite : public TestSuite
+{
+  public:
+    BinaryTraceTestSuite();
+};
+
+BinaryTraceTestSuite::BinaryTraceTestSuite()
+    : TestSuite("binary-trace", Type::UNIT)
+{
+    AddTestCase(new BinaryTraceFileTestCase());
+    AddTestCase(new BinaryTraceHelperTestCase());
+    AddTestCase(new BinaryTraceScriptTestCase());
+}
+
+/**
+ * \ingroup network-test
+ * BinaryTraceTestSuite instance variable.
+ */
+static BinaryTraceTestSuite g_binaryTraceTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
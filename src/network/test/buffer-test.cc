@@ -11,6 +11,9 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/test.h"
 
+#include <thread>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -384,6 +387,219 @@ BufferTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check the concatenation of fragments sharing their bytes, against
+ * a reference model.
+ */
+class BufferConcatenationTest : public TestCase
+{
+  public:
+    BufferConcatenationTest();
+
+  private:
+    void DoRun() override;
+
+    /** A buffer and its expected content. */
+    struct Entry
+    {
+        Buffer buffer;                //!< The buffer.
+        std::vector<uint8_t> content; //!< The expected content.
+    };
+
+    /**
+     * Create a buffer with a header, a zero area and a trailer.
+     *
+     * \param [in] header The header size.
+     * \param [in] zeroes The zero area size.
+     * \param [in] trailer The trailer size.
+     * \returns The buffer and its expected content.
+     */
+    Entry CreateEntry(uint32_t header, uint32_t zeroes, uint32_t trailer);
+    /**
+     * \param [in] buffer The buffer.
+     * \returns The content of the buffer.
+     */
+    std::vector<uint8_t> GetContent(const Buffer& buffer) const;
+
+    Ptr<UniformRandomVariable> m_random; //!< Random sizes and bytes.
+};
+
+BufferConcatenationTest::BufferConcatenationTest()
+    : TestCase("Buffer concatenation of shared fragments")
+{
+}
+
+BufferConcatenationTest::Entry
+BufferConcatenationTest::CreateEntry(uint32_t header, uint32_t zeroes, uint32_t trailer)
+{
+    Entry entry{Buffer(zeroes), std::vector<uint8_t>(header + zeroes + trailer, 0)};
+    entry.buffer.AddAtStart(header);
+    Buffer::Iterator i = entry.buffer.Begin();
+    for (uint32_t j = 0; j < header; ++j)
+    {
+        entry.content[j] = m_random->GetInteger(1, 255);
+        i.WriteU8(entry.content[j]);
+    }
+    entry.buffer.AddAtEnd(trailer);
+    i = entry.buffer.End();
+    i.Prev(trailer);
+    for (uint32_t j = header + zeroes; j < entry.content.size(); ++j)
+    {
+        entry.content[j] = m_random->GetInteger(1, 255);
+        i.WriteU8(entry.content[j]);
+    }
+    return entry;
+}
+
+std::vector<uint8_t>
+BufferConcatenationTest::GetContent(const Buffer& buffer) const
+{
+    std::vector<uint8_t> content(buffer.GetSize());
+    buffer.CopyData(content.data(), content.size());
+    return content;
+}
+
+void
+BufferConcatenationTest::DoRun()
+{
+    m_random = CreateObject<UniformRandomVariable>();
+
+    // fragments of a packet with a virtual payload are concatenated
+    // without writing the payload
+    Entry packet = CreateEntry(20, 1000, 0);
+    Buffer first = packet.buffer.CreateFragment(0, 520);
+    Buffer second = packet.buffer.CreateFragment(520, 500);
+    first.AddAtEnd(second);
+    NS_TEST_EXPECT_MSG_EQ((GetContent(first) == packet.content), true, "Bad concatenation");
+    // only the 20 bytes header is serialized, besides the 3 lengths
+    NS_TEST_EXPECT_MSG_EQ(first.GetSerializedSize(), 32, "Payload written as real bytes");
+    NS_TEST_EXPECT_MSG_EQ((GetContent(packet.buffer) == packet.content),
+                          true,
+                          "Original buffer modified");
+
+    // random fragmentations and concatenations, checking all the
+    // buffers after each operation
+    std::vector<Entry> entries;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        entries.push_back(CreateEntry(m_random->GetInteger(0, 40),
+                                      m_random->GetInteger(0, 1000),
+                                      m_random->GetInteger(0, 8)));
+    }
+    for (uint32_t step = 0; step < 2000; ++step)
+    {
+        Entry& a = entries[m_random->GetInteger(0, entries.size() - 1)];
+        Entry& b = entries[m_random->GetInteger(0, entries.size() - 1)];
+        switch (m_random->GetInteger(0, 3))
+        {
+        case 0: {
+            // replace a by a fragment of b
+            uint32_t start = m_random->GetInteger(0, b.content.size());
+            uint32_t length = m_random->GetInteger(0, b.content.size() - start);
+            a.buffer = b.buffer.CreateFragment(start, length);
+            a.content.assign(b.content.begin() + start, b.content.begin() + start + length);
+            break;
+        }
+        case 1:
+        case 2: {
+            if (&a == &b || a.content.size() + b.content.size() > 10000)
+            {
+                break;
+            }
+            a.buffer.AddAtEnd(b.buffer);
+            a.content.insert(a.content.end(), b.content.begin(), b.content.end());
+            break;
+        }
+        default:
+            // start again from a new buffer
+            a = CreateEntry(m_random->GetInteger(0, 40),
+                            m_random->GetInteger(0, 1000),
+                            m_random->GetInteger(0, 8));
+            break;
+        }
+        for (const auto& entry : entries)
+        {
+            NS_TEST_ASSERT_MSG_EQ((GetContent(entry.buffer) == entry.content),
+                                  true,
+                                  "Bad buffer content at step " << step);
+        }
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check the per-thread free lists of the buffer data storages.
+ */
+class BufferPoolTest : public TestCase
+{
+  public:
+    BufferPoolTest();
+
+  private:
+    void DoRun() override;
+};
+
+BufferPoolTest::BufferPoolTest()
+    : TestCase("Per-thread buffer free lists")
+{
+}
+
+void
+BufferPoolTest::DoRun()
+{
+    const uint32_t n = 10;
+    std::vector<Buffer> buffers;
+    Buffer::PoolStatistics first{};
+    Buffer::PoolStatistics second{};
+    Buffer::PoolStatistics third{};
+
+    // a new thread starts with an empty free list
+    std::thread creator([&]() {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            buffers.emplace_back(100);
+        }
+        first = Buffer::GetPoolStatistics();
+        buffers.clear();
+        second = Buffer::GetPoolStatistics();
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            buffers.emplace_back(100);
+        }
+        third = Buffer::GetPoolStatistics();
+    });
+    creator.join();
+
+    NS_TEST_EXPECT_MSG_EQ(first.allocations, n, "Bad allocation count");
+    NS_TEST_EXPECT_MSG_EQ(first.hits, 0, "The free list should be empty");
+    NS_TEST_EXPECT_MSG_EQ(first.live, n, "Bad live count");
+    NS_TEST_EXPECT_MSG_EQ(second.releases, n, "Bad release count");
+    NS_TEST_EXPECT_MSG_EQ(second.live, 0, "Bad live count");
+    NS_TEST_EXPECT_MSG_EQ(second.pooled, n, "The released storages should be kept");
+    NS_TEST_EXPECT_MSG_EQ(third.allocations, 2 * n, "Bad allocation count");
+    NS_TEST_EXPECT_MSG_EQ(third.hits, n, "The storages should be reused");
+    NS_TEST_EXPECT_MSG_EQ(third.pooled, 0, "The free list should be empty");
+    NS_TEST_EXPECT_MSG_EQ(third.peak, n, "Bad peak count");
+
+    // buffers created by a thread and released by another one
+    Buffer::PoolStatistics released{};
+    std::thread releaser([&]() {
+        buffers.clear();
+        released = Buffer::GetPoolStatistics();
+    });
+    releaser.join();
+
+    NS_TEST_EXPECT_MSG_EQ(released.allocations, 0, "Bad allocation count");
+    NS_TEST_EXPECT_MSG_EQ(released.releases, n, "Bad release count");
+    NS_TEST_EXPECT_MSG_EQ(released.live, -static_cast<int64_t>(n), "Bad live count");
+    NS_TEST_EXPECT_MSG_EQ(released.pooled, n, "The released storages should be kept");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -400,6 +616,8 @@ BufferTestSuite::BufferTestSuite()
     : TestSuite("buffer", Type::UNIT)
 {
     AddTestCase(new BufferTest, TestCase::Duration::QUICK);
+    AddTestCase(new BufferConcatenationTest, TestCase::Duration::QUICK);
+    AddTestCase(new BufferPoolTest, TestCase::Duration::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
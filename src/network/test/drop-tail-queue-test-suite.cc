@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: GPL-2.0-only
  */
 
+#include "ns3/buffer.h"
 #include "ns3/drop-tail-queue.h"
+#include "ns3/memory-report.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 
@@ -76,6 +78,47 @@ DropTailQueueTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(packet, nullptr, "There are really no packets in there");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the memory of the packets of a queue is accounted for
+ * by their buffers only, with the size of their storage.
+ */
+class DropTailQueueMemoryTestCase : public TestCase
+{
+  public:
+    DropTailQueueMemoryTestCase();
+    void DoRun() override;
+};
+
+DropTailQueueMemoryTestCase::DropTailQueueMemoryTestCase()
+    : TestCase("Check the memory accounted for by a drop tail queue")
+{
+}
+
+void
+DropTailQueueMemoryTestCase::DoRun()
+{
+    Ptr<DropTailQueue<Packet>> small = CreateObject<DropTailQueue<Packet>>();
+    Ptr<DropTailQueue<Packet>> large = CreateObject<DropTailQueue<Packet>>();
+    uint64_t empty = MemoryReport::GetObjectBytes(small);
+    int64_t buffers = Buffer::GetPoolStatistics().bytes;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        small->Enqueue(Create<Packet>(10));
+        // zero-filled payloads are not stored
+        large->Enqueue(Create<Packet>(100000));
+    }
+    NS_TEST_EXPECT_MSG_GT(MemoryReport::GetObjectBytes(small), empty, "Entries accounted for");
+    NS_TEST_EXPECT_MSG_EQ(MemoryReport::GetObjectBytes(large),
+                          MemoryReport::GetObjectBytes(small),
+                          "Packet bytes accounted for by the queue");
+    NS_TEST_EXPECT_MSG_LT(Buffer::GetPoolStatistics().bytes - buffers,
+                          100000,
+                          "Zero-filled bytes accounted for by the buffers");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -89,6 +132,7 @@ class DropTailQueueTestSuite : public TestSuite
         : TestSuite("drop-tail-queue", Type::UNIT)
     {
         AddTestCase(new DropTailQueueTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new DropTailQueueMemoryTestCase(), TestCase::Duration::QUICK);
     }
 };
 
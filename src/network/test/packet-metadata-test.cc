@@ -14,6 +14,8 @@
 #include <cstdarg>
 #include <iostream>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 using namespace ns3;
 
@@ -315,7 +317,11 @@ HistoryTrailer<N>::Deserialize(Buffer::Iterator start)
 class PacketMetadataTest : public TestCase
 {
   public:
-    PacketMetadataTest();
+    /**
+     * Constructor
+     * \param compact Whether to test the compact mode of the metadata
+     */
+    PacketMetadataTest(bool compact);
     ~PacketMetadataTest() override;
     /**
      * Checks the packet header and trailer history
@@ -325,6 +331,7 @@ class PacketMetadataTest : public TestCase
      */
     void CheckHistory(Ptr<Packet> p, uint32_t n, ...);
     void DoRun() override;
+    void DoTeardown() override;
 
   private:
     /**
@@ -333,10 +340,13 @@ class PacketMetadataTest : public TestCase
      * \return The packet with the header added.
      */
     Ptr<Packet> DoAddHeader(Ptr<Packet> p);
+
+    bool m_compact; //!< Whether to test the compact mode of the metadata
 };
 
-PacketMetadataTest::PacketMetadataTest()
-    : TestCase("Packet metadata")
+PacketMetadataTest::PacketMetadataTest(bool compact)
+    : TestCase(compact ? "Packet metadata, compact mode" : "Packet metadata"),
+      m_compact(compact)
 {
 }
 
@@ -465,10 +475,17 @@ PacketMetadataTest::DoAddHeader(Ptr<Packet> p)
     return p;
 }
 
+void
+PacketMetadataTest::DoTeardown()
+{
+    PacketMetadata::SetCompact(false);
+}
+
 void
 PacketMetadataTest::DoRun()
 {
     PacketMetadata::Enable();
+    PacketMetadata::SetCompact(m_compact);
 
     Ptr<Packet> p = Create<Packet>(0);
     Ptr<Packet> p1 = Create<Packet>(0);
@@ -868,6 +885,82 @@ PacketMetadataTest::DoRun()
     NS_TEST_EXPECT_MSG_EQ(msg,
                           std::string("hello world"),
                           "Could not find original data in received packet");
+
+    // more items than the array of the compact mode
+    p = Create<Packet>(10);
+    ADD_HEADER(p, 1);
+    ADD_HEADER(p, 2);
+    ADD_HEADER(p, 3);
+    ADD_TRAILER(p, 4);
+    ADD_TRAILER(p, 5);
+    CHECK_HISTORY(p, 6, 3, 2, 1, 10, 4, 5);
+    ADD_HEADER(p, 6);
+    ADD_TRAILER(p, 7);
+    CHECK_HISTORY(p, 8, 6, 3, 2, 1, 10, 4, 5, 7);
+    REM_HEADER(p, 6);
+    REM_TRAILER(p, 7);
+    REM_HEADER(p, 3);
+    CHECK_HISTORY(p, 5, 2, 1, 10, 4, 5);
+
+    p = Create<Packet>(10);
+    ADD_HEADER(p, 1);
+    ADD_HEADER(p, 2);
+    ADD_TRAILER(p, 4);
+    ADD_TRAILER(p, 5);
+    p->RemoveAtStart(3);
+    p->RemoveAtEnd(5);
+    CHECK_HISTORY(p, 2, 10, 4);
+    p->RemoveAtEnd(2);
+    CHECK_HISTORY(p, 2, 10, 2);
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check the allocation counters of the per-thread metadata free lists.
+ */
+class PacketMetadataPoolTest : public TestCase
+{
+  public:
+    PacketMetadataPoolTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketMetadataPoolTest::PacketMetadataPoolTest()
+    : TestCase("Per-thread metadata free lists")
+{
+}
+
+void
+PacketMetadataPoolTest::DoRun()
+{
+    const uint32_t n = 10;
+    std::vector<PacketMetadata> metadata;
+    PacketMetadata::PoolStatistics created{};
+    PacketMetadata::PoolStatistics released{};
+
+    std::thread creator([&]() {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            metadata.emplace_back(i, 100);
+        }
+        created = PacketMetadata::GetPoolStatistics();
+    });
+    creator.join();
+    std::thread releaser([&]() {
+        metadata.clear();
+        released = PacketMetadata::GetPoolStatistics();
+    });
+    releaser.join();
+
+    NS_TEST_EXPECT_MSG_EQ(created.allocations, n, "Bad allocation count");
+    NS_TEST_EXPECT_MSG_EQ(created.live, n, "Bad live count");
+    NS_TEST_EXPECT_MSG_EQ(created.peak, n, "Bad peak count");
+    NS_TEST_EXPECT_MSG_EQ(released.releases, n, "Bad release count");
+    NS_TEST_EXPECT_MSG_EQ(released.live, -static_cast<int64_t>(n), "Bad live count");
 }
 
 /**
@@ -885,7 +978,9 @@ class PacketMetadataTestSuite : public TestSuite
 PacketMetadataTestSuite::PacketMetadataTestSuite()
     : TestSuite("packet-metadata", Type::UNIT)
 {
-    AddTestCase(new PacketMetadataTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketMetadataTest(false), TestCase::Duration::QUICK);
+    AddTestCase(new PacketMetadataTest(true), TestCase::Duration::QUICK);
+    AddTestCase(new PacketMetadataPoolTest, TestCase::Duration::QUICK);
 }
 
 static PacketMetadataTestSuite g_packetMetadataTest; //!< Static variable for test initialization
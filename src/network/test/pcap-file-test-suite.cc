@@ -4,15 +4,22 @@
  * Author:  Craig Dowell (craigdo@ee.washington.edu)
  */
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
+#include "ns3/packet.h"
 #include "ns3/pcap-file.h"
+#include "ns3/pcapng-file.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <vector>
 
 using namespace ns3;
 
@@ -1364,6 +1371,170 @@ DiffTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the buffered and asynchronous modes
+ * of PcapFile write the same file as the default mode.
+ */
+class BufferedWriteTestCase : public TestCase
+{
+  public:
+    BufferedWriteTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Write a pcap file.
+     * \param filename The file name.
+     * \param blockSize The block size, or 0 to not buffer the records.
+     * \param asynchronous Whether to write the blocks on the background thread.
+     * \returns The content of the file.
+     */
+    std::string WriteFile(std::string filename, uint32_t blockSize, bool asynchronous);
+};
+
+BufferedWriteTestCase::BufferedWriteTestCase()
+    : TestCase("Check that buffered PcapFile writes the same file")
+{
+}
+
+std::string
+BufferedWriteTestCase::WriteFile(std::string filename, uint32_t blockSize, bool asynchronous)
+{
+    std::vector<uint8_t> data(1500);
+    {
+        PcapFile f;
+        f.Open(filename, std::ios::out);
+        f.SetBuffering(blockSize, asynchronous);
+        f.Init(1, 1000);
+        for (uint32_t i = 0; i < 1000; ++i)
+        {
+            uint32_t size = (i * 37) % data.size();
+            for (uint32_t j = 0; j < size; ++j)
+            {
+                data[j] = i + j;
+            }
+            // Alternate the raw data and the packets, both truncated to the snap length
+            if (i % 2)
+            {
+                f.Write(i, i * 3, data.data(), size);
+            }
+            else
+            {
+                f.Write(i, i * 3, Create<Packet>(data.data(), size));
+            }
+        }
+        NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Write must not fail");
+    }
+    std::ifstream in(filename, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::remove(filename.c_str());
+    return content;
+}
+
+void
+BufferedWriteTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("buffered.pcap");
+    std::string expected = WriteFile(filename, 0, false);
+    NS_TEST_ASSERT_MSG_GT(expected.size(), 24, "Packets must be written");
+    NS_TEST_EXPECT_MSG_EQ((WriteFile(filename, 4096, false) == expected),
+                          true,
+                          "Buffered file must not differ");
+    NS_TEST_EXPECT_MSG_EQ((WriteFile(filename, 4096, true) == expected),
+                          true,
+                          "Asynchronous file must not differ");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that PcapNgFile writes the blocks of the
+ * interfaces and of their packets.
+ */
+class PcapNgFileTestCase : public TestCase
+{
+  public:
+    PcapNgFileTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PcapNgFileTestCase::PcapNgFileTestCase()
+    : TestCase("Check that PcapNgFile writes the interfaces and packets")
+{
+}
+
+void
+PcapNgFileTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("interfaces.pcapng");
+    {
+        Ptr<PcapNgFile> f = CreateObject<PcapNgFile>();
+        f->SetAttribute("BlockSize", UintegerValue(512));
+        f->SetAttribute("Asynchronous", BooleanValue(true));
+        f->Open(filename);
+        NS_TEST_ASSERT_MSG_EQ(f->Fail(), false, "Open (" << filename << ") returns error");
+        NS_TEST_EXPECT_MSG_EQ(f->AddInterface(1, "eth"), 0, "First interface");
+        NS_TEST_EXPECT_MSG_EQ(f->AddInterface(9, "ppp", 10), 1, "Second interface");
+        for (uint32_t i = 0; i < 100; ++i)
+        {
+            f->Write(i % 2, NanoSeconds(i * 1000000001ULL), Create<Packet>(i));
+        }
+        NS_TEST_EXPECT_MSG_EQ(f->GetNInterfaces(), 2, "Number of interfaces");
+        NS_TEST_EXPECT_MSG_EQ(f->Fail(), false, "Write must not fail");
+    }
+
+    std::ifstream in(filename, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    auto get32 = [&content](std::size_t offset) {
+        uint32_t value;
+        std::memcpy(&value, content.data() + offset, sizeof(value));
+        return value;
+    };
+
+    std::vector<uint32_t> types;
+    uint32_t packets = 0;
+    std::size_t offset = 0;
+    while (offset + 12 <= content.size())
+    {
+        uint32_t type = get32(offset);
+        uint32_t length = get32(offset + 4);
+        NS_TEST_ASSERT_MSG_EQ(length % 4, 0, "Block length must be padded");
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(offset + length, content.size(), "Truncated block");
+        NS_TEST_ASSERT_MSG_EQ(get32(offset + length - 4), length, "Trailing block length");
+        types.push_back(type);
+        if (type == 6)
+        {
+            uint32_t interface = get32(offset + 8);
+            uint64_t timestamp = (uint64_t(get32(offset + 12)) << 32) | get32(offset + 16);
+            uint32_t inclLen = get32(offset + 20);
+            uint32_t origLen = get32(offset + 24);
+            NS_TEST_EXPECT_MSG_EQ(interface, packets % 2, "Packet interface");
+            NS_TEST_EXPECT_MSG_EQ(timestamp, packets * 1000000001ULL, "Packet timestamp");
+            NS_TEST_EXPECT_MSG_EQ(origLen, packets, "Packet length");
+            NS_TEST_EXPECT_MSG_EQ(inclLen,
+                                  (interface == 1 ? std::min(origLen, 10U) : origLen),
+                                  "Captured length");
+            packets++;
+        }
+        offset += length;
+    }
+    NS_TEST_EXPECT_MSG_EQ(offset, content.size(), "Trailing bytes");
+    NS_TEST_ASSERT_MSG_EQ(types.size(), 103, "Number of blocks");
+    NS_TEST_EXPECT_MSG_EQ(types[0], 0x0a0d0d0a, "Section header block");
+    NS_TEST_EXPECT_MSG_EQ(get32(8), 0x1a2b3c4d, "Byte order magic");
+    NS_TEST_EXPECT_MSG_EQ(types[1], 1, "First interface description block");
+    NS_TEST_EXPECT_MSG_EQ(types[2], 1, "Second interface description block");
+    NS_TEST_EXPECT_MSG_EQ(packets, 100, "Number of packets");
+    std::remove(filename.c_str());
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1387,6 +1558,8 @@ PcapFileTestSuite::PcapFileTestSuite()
     AddTestCase(new RecordHeaderTestCase, TestCase::Duration::QUICK);
     AddTestCase(new ReadFileTestCase, TestCase::Duration::QUICK);
     AddTestCase(new DiffTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BufferedWriteTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new PcapNgFileTestCase, TestCase::Duration::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,564 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "binary-trace-file.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryTraceFile");
+
+namespace
+{
+
+/** The magic number at the start of a binary trace file. */
+const char FILE_MAGIC[] = "NS3BTRC1";
+
+/** The magic number at the end of the index of a binary trace file. */
+const char INDEX_MAGIC[] = "NS3BTIDX";
+
+/** The size of the magic numbers. */
+constexpr std::size_t MAGIC_SIZE = 8;
+
+/** The size of a block header. */
+constexpr std::size_t BLOCK_HEADER_SIZE = 24;
+
+/** The size of an index entry. */
+constexpr std::size_t INDEX_ENTRY_SIZE = 28;
+
+/**
+ * Append an integer in little endian order.
+ * \param [in,out] buffer The buffer.
+ * \param [in] value The integer.
+ * \param [in] size The number of bytes.
+ */
+void
+PutLittleEndian(std::string& buffer, uint64_t value, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        buffer.push_back(static_cast<char>(value >> (8 * i)));
+    }
+}
+
+/**
+ * Read an integer in little endian order.
+ * \param [in] data The bytes.
+ * \param [in] size The number of bytes.
+ * \returns The integer.
+ */
+uint64_t
+GetLittleEndian(const char* data, std::size_t size)
+{
+    uint64_t value = 0;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * Append a name, as its length followed by its characters.
+ * \param [in,out] buffer The buffer.
+ * \param [in] name The name.
+ */
+void
+PutName(std::string& buffer, const std::string& name)
+{
+    PutLittleEndian(buffer, name.size(), 4);
+    buffer.append(name);
+}
+
+/**
+ * Append the zigzag LEB128 encoding of the difference of two values.
+ * \param [in,out] buffer The buffer.
+ * \param [in] value The value.
+ * \param [in] previous The previous value.
+ */
+void
+PutDelta(std::string& buffer, uint64_t value, uint64_t previous)
+{
+    auto delta = static_cast<int64_t>(value - previous);
+    uint64_t zigzag = (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63);
+    while (zigzag >= 0x80)
+    {
+        buffer.push_back(static_cast<char>(zigzag | 0x80));
+        zigzag >>= 7;
+    }
+    buffer.push_back(static_cast<char>(zigzag));
+}
+
+/**
+ * Decode a value encoded by PutDelta().
+ * \param [in,out] data The next byte to decode, advanced past the value.
+ * \param [in] end The end of the data.
+ * \param [in] previous The previous value.
+ * \param [out] value The value.
+ * \returns \c false if the data ends before the value.
+ */
+bool
+GetDelta(const char*& data, const char* end, uint64_t previous, uint64_t& value)
+{
+    uint64_t zigzag = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        if (data == end)
+        {
+            return false;
+        }
+        auto byte = static_cast<uint8_t>(*data++);
+        zigzag |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (byte < 0x80)
+        {
+            value = previous + ((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Get the number of time steps per second of the current time resolution.
+ * \returns The number of time steps per second.
+ */
+int64_t
+GetStepsPerSecond()
+{
+    return Seconds(1).GetTimeStep();
+}
+
+} // unnamed namespace
+
+BinaryTraceFile::BinaryTraceFile(std::string filename,
+                                 std::string schema,
+                                 std::vector<Column> columns,
+                                 uint32_t blockRecords)
+    : m_file(filename, std::ios::out | std::ios::binary),
+      m_columns(std::move(columns)),
+      m_blockRecords(blockRecords)
+{
+    NS_LOG_FUNCTION(this << filename << schema << blockRecords);
+    NS_ABORT_MSG_IF(m_blockRecords == 0, "Empty blocks");
+    m_times.reserve(m_blockRecords);
+    m_values.reserve(static_cast<std::size_t>(m_blockRecords) * m_columns.size());
+
+    std::string header(FILE_MAGIC, MAGIC_SIZE);
+    PutLittleEndian(header, GetStepsPerSecond(), 8);
+    PutName(header, schema);
+    PutLittleEndian(header, m_columns.size(), 4);
+    for (const auto& column : m_columns)
+    {
+        header.push_back(static_cast<char>(column.type));
+        PutName(header, column.name);
+    }
+    m_file.write(header.data(), header.size());
+}
+
+BinaryTraceFile::~BinaryTraceFile()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+const std::vector<BinaryTraceFile::Column>&
+BinaryTraceFile::GetColumns() const
+{
+    return m_columns;
+}
+
+bool
+BinaryTraceFile::Fail() const
+{
+    return m_file.fail();
+}
+
+void
+BinaryTraceFile::Write(Time time, std::initializer_list<Value> values)
+{
+    NS_ASSERT_MSG(values.size() == m_columns.size(),
+                  "Record of " << values.size() << " values for " << m_columns.size()
+                               << " columns");
+    NS_ASSERT_MSG(m_file.is_open(), "Writing to a closed binary trace file");
+    m_times.push_back(time.GetTimeStep());
+    for (const auto& value : values)
+    {
+        m_values.push_back(value.GetBits());
+    }
+    if (m_times.size() == m_blockRecords)
+    {
+        Flush();
+    }
+}
+
+void
+BinaryTraceFile::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_times.empty())
+    {
+        return;
+    }
+
+    std::size_t records = m_times.size();
+    std::size_t columns = m_columns.size();
+    m_block.clear();
+    m_block.append(BLOCK_HEADER_SIZE, '\0');
+    uint64_t previous = 0;
+    for (auto time : m_times)
+    {
+        PutDelta(m_block, time, previous);
+        previous = time;
+    }
+    for (std::size_t c = 0; c < columns; ++c)
+    {
+        previous = 0;
+        for (std::size_t r = 0; r < records; ++r)
+        {
+            uint64_t value = m_values[r * columns + c];
+            if (m_columns[c].type == DOUBLE)
+            {
+                PutLittleEndian(m_block, value, 8);
+            }
+            else
+            {
+                PutDelta(m_block, value, previous);
+                previous = value;
+            }
+        }
+    }
+
+    std::string header;
+    PutLittleEndian(header, records, 4);
+    PutLittleEndian(header, m_block.size() - BLOCK_HEADER_SIZE, 4);
+    PutLittleEndian(header, m_times.front(), 8);
+    PutLittleEndian(header, m_times.back(), 8);
+    m_block.replace(0, BLOCK_HEADER_SIZE, header);
+
+    m_index.push_back({static_cast<uint64_t>(m_file.tellp()),
+                       m_times.front(),
+                       m_times.back(),
+                       static_cast<uint32_t>(records)});
+    m_file.write(m_block.data(), m_block.size());
+    m_times.clear();
+    m_values.clear();
+}
+
+void
+BinaryTraceFile::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_file.is_open())
+    {
+        return;
+    }
+    Flush();
+    std::string index;
+    for (const auto& block : m_index)
+    {
+        PutLittleEndian(index, block.offset, 8);
+        PutLittleEndian(index, block.first, 8);
+        PutLittleEndian(index, block.last, 8);
+        PutLittleEndian(index, block.records, 4);
+    }
+    PutLittleEndian(index, m_file.tellp(), 8);
+    index.append(INDEX_MAGIC, MAGIC_SIZE);
+    m_file.write(index.data(), index.size());
+    m_file.close();
+}
+
+BinaryTraceReader::BinaryTraceReader(std::string filename)
+    : m_file(filename, std::ios::in | std::ios::binary),
+      m_fail(true),
+      m_stepsPerSecond(0),
+      m_block(NO_BLOCK),
+      m_next(0)
+{
+    NS_LOG_FUNCTION(this << filename);
+
+    // Header
+    char magic[MAGIC_SIZE];
+    char buffer[8];
+    if (!m_file.read(magic, MAGIC_SIZE) || std::memcmp(magic, FILE_MAGIC, MAGIC_SIZE) != 0 ||
+        !m_file.read(buffer, 8))
+    {
+        return;
+    }
+    m_stepsPerSecond = static_cast<int64_t>(GetLittleEndian(buffer, 8));
+    auto readName = [this, &buffer](std::string& name) {
+        if (!m_file.read(buffer, 4))
+        {
+            return false;
+        }
+        name.resize(GetLittleEndian(buffer, 4));
+        return static_cast<bool>(m_file.read(name.data(), name.size()));
+    };
+    if (m_stepsPerSecond <= 0 || !readName(m_schema) || !m_file.read(buffer, 4))
+    {
+        return;
+    }
+    uint64_t columns = GetLittleEndian(buffer, 4);
+    for (uint64_t c = 0; c < columns; ++c)
+    {
+        BinaryTraceFile::Column column;
+        if (!m_file.read(buffer, 1) || static_cast<uint8_t>(buffer[0]) > BinaryTraceFile::DOUBLE)
+        {
+            return;
+        }
+        column.type = static_cast<BinaryTraceFile::ColumnType>(buffer[0]);
+        if (!readName(column.name))
+        {
+            return;
+        }
+        m_columns.push_back(column);
+    }
+    uint64_t blocks = m_file.tellg();
+
+    // Index, or the complete blocks of an unclosed file
+    m_file.seekg(0, std::ios::end);
+    uint64_t size = m_file.tellg();
+    bool indexed = false;
+    if (size >= blocks + 16)
+    {
+        char trailer[16];
+        m_file.seekg(size - 16);
+        m_file.read(trailer, 16);
+        uint64_t offset = GetLittleEndian(trailer, 8);
+        if (std::memcmp(trailer + 8, INDEX_MAGIC, MAGIC_SIZE) == 0 && offset >= blocks &&
+            (size - 16 - offset) % INDEX_ENTRY_SIZE == 0)
+        {
+            std::string index(size - 16 - offset, '\0');
+            m_file.seekg(offset);
+            m_file.read(index.data(), index.size());
+            for (std::size_t i = 0; i < index.size(); i += INDEX_ENTRY_SIZE)
+            {
+                const char* entry = index.data() + i;
+                m_index.push_back({GetLittleEndian(entry, 8),
+                                   static_cast<int64_t>(GetLittleEndian(entry + 8, 8)),
+                                   static_cast<int64_t>(GetLittleEndian(entry + 16, 8)),
+                                   static_cast<uint32_t>(GetLittleEndian(entry + 24, 4))});
+            }
+            indexed = static_cast<bool>(m_file);
+        }
+    }
+    if (!indexed)
+    {
+        NS_LOG_LOGIC("no index, scanning the blocks");
+        m_index.clear();
+        m_file.clear();
+        uint64_t offset = blocks;
+        char header[BLOCK_HEADER_SIZE];
+        while (offset + BLOCK_HEADER_SIZE <= size)
+        {
+            m_file.seekg(offset);
+            m_file.read(header, BLOCK_HEADER_SIZE);
+            uint64_t next = offset + BLOCK_HEADER_SIZE + GetLittleEndian(header + 4, 4);
+            if (!m_file || next > size)
+            {
+                break;
+            }
+            m_index.push_back({offset,
+                               static_cast<int64_t>(GetLittleEndian(header + 8, 8)),
+                               static_cast<int64_t>(GetLittleEndian(header + 16, 8)),
+                               static_cast<uint32_t>(GetLittleEndian(header, 4))});
+            offset = next;
+        }
+        m_file.clear();
+    }
+    m_block = NO_BLOCK;
+    m_fail = false;
+}
+
+bool
+BinaryTraceReader::Fail() const
+{
+    return m_fail;
+}
+
+std::string
+BinaryTraceReader::GetSchema() const
+{
+    return m_schema;
+}
+
+const std::vector<BinaryTraceFile::Column>&
+BinaryTraceReader::GetColumns() const
+{
+    return m_columns;
+}
+
+uint32_t
+BinaryTraceReader::GetColumnIndex(const std::string& name) const
+{
+    auto it = std::find_if(m_columns.begin(), m_columns.end(), [&name](const auto& column) {
+        return column.name == name;
+    });
+    NS_ABORT_MSG_IF(it == m_columns.end(), "No column " << name << " in " << m_schema);
+    return it - m_columns.begin();
+}
+
+uint64_t
+BinaryTraceReader::GetNRecords() const
+{
+    uint64_t records = 0;
+    for (const auto& block : m_index)
+    {
+        records += block.records;
+    }
+    return records;
+}
+
+bool
+BinaryTraceReader::LoadBlock(std::size_t block)
+{
+    NS_LOG_FUNCTION(this << block);
+    m_block = block;
+    m_next = 0;
+    m_times.clear();
+    m_values.clear();
+    if (block >= m_index.size())
+    {
+        return false;
+    }
+    auto fail = [this]() {
+        NS_LOG_LOGIC("truncated block " << m_block);
+        m_times.clear();
+        m_values.clear();
+        return false;
+    };
+
+    char header[BLOCK_HEADER_SIZE];
+    m_file.seekg(m_index[block].offset);
+    m_file.read(header, BLOCK_HEADER_SIZE);
+    std::size_t records = GetLittleEndian(header, 4);
+    std::string data(GetLittleEndian(header + 4, 4), '\0');
+    m_file.read(data.data(), data.size());
+    if (!m_file)
+    {
+        m_file.clear();
+        return fail();
+    }
+
+    const char* next = data.data();
+    const char* end = next + data.size();
+    std::size_t columns = m_columns.size();
+    m_times.resize(records);
+    m_values.resize(records * columns);
+    uint64_t previous = 0;
+    uint64_t value;
+    for (std::size_t r = 0; r < records; ++r)
+    {
+        if (!GetDelta(next, end, previous, value))
+        {
+            return fail();
+        }
+        m_times[r] = static_cast<int64_t>(value);
+        previous = value;
+    }
+    for (std::size_t c = 0; c < columns; ++c)
+    {
+        previous = 0;
+        for (std::size_t r = 0; r < records; ++r)
+        {
+            if (m_columns[c].type == BinaryTraceFile::DOUBLE)
+            {
+                if (end - next < 8)
+                {
+                    return fail();
+                }
+                value = GetLittleEndian(next, 8);
+                next += 8;
+            }
+            else if (!GetDelta(next, end, previous, value))
+            {
+                return fail();
+            }
+            m_values[r * columns + c] = value;
+            previous = value;
+        }
+    }
+    return true;
+}
+
+void
+BinaryTraceReader::Seek(Time time)
+{
+    NS_LOG_FUNCTION(this << time);
+    int64_t steps = GetStepsPerSecond();
+    int64_t step = time.GetTimeStep();
+    step = (steps >= m_stepsPerSecond) ? step / (steps / m_stepsPerSecond)
+                                       : step * (m_stepsPerSecond / steps);
+
+    auto block = std::partition_point(m_index.begin(), m_index.end(), [step](const auto& b) {
+        return b.last < step;
+    });
+    if (!LoadBlock(block - m_index.begin()))
+    {
+        return;
+    }
+    m_next = std::lower_bound(m_times.begin(), m_times.end(), step) - m_times.begin();
+}
+
+bool
+BinaryTraceReader::Read()
+{
+    if (m_next < m_times.size())
+    {
+        m_next++;
+        return true;
+    }
+    std::size_t block = (m_block == NO_BLOCK) ? 0 : m_block + 1;
+    while (LoadBlock(block))
+    {
+        if (!m_times.empty())
+        {
+            m_next = 1;
+            return true;
+        }
+        block++;
+    }
+    return false;
+}
+
+Time
+BinaryTraceReader::GetTime() const
+{
+    NS_ASSERT_MSG(m_next > 0, "No record read");
+    int64_t steps = GetStepsPerSecond();
+    int64_t step = m_times[m_next - 1];
+    return TimeStep((steps >= m_stepsPerSecond) ? step * (steps / m_stepsPerSecond)
+                                                : step / (m_stepsPerSecond / steps));
+}
+
+int64_t
+BinaryTraceReader::GetInt64(uint32_t column) const
+{
+    return static_cast<int64_t>(GetUint64(column));
+}
+
+uint64_t
+BinaryTraceReader::GetUint64(uint32_t column) const
+{
+    NS_ASSERT_MSG(m_next > 0, "No record read");
+    NS_ASSERT_MSG(column < m_columns.size(), "No column " << column);
+    return m_values[(m_next - 1) * m_columns.size() + column];
+}
+
+double
+BinaryTraceReader::GetDouble(uint32_t column) const
+{
+    double value;
+    uint64_t bits = GetUint64(column);
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace ns3
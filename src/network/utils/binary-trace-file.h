@@ -0,0 +1,309 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef BINARY_TRACE_FILE_H
+#define BINARY_TRACE_FILE_H
+
+#include "ns3/nstime.h"
+#include "ns3/simple-ref-count.h"
+
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief A trace file of fixed schema binary records, written in
+ * compressed column blocks and indexed by time.
+ *
+ * Each record has a time, and one value per column of the schema given
+ * at the creation of the file.  The records are buffered, and written
+ * in blocks of a fixed number of records.  In a block, the values of
+ * each column are stored together, the integers as the variable length
+ * encoding of their difference with the previous value.  Counters,
+ * identifiers and times thus mostly take one or two bytes.  When the
+ * file is closed, an index of the time span of each block is appended,
+ * which BinaryTraceReader uses to seek a time.  The files are read by
+ * BinaryTraceReader, or by utils/read-binary-trace.py in Python.
+ *
+ * Writing a record only copies its values, so that tracing to a binary
+ * trace file costs much less than formatting text to an
+ * OutputStreamWrapper:
+ * \code{.cpp}
+ * void
+ * TraceSink(Ptr<BinaryTraceFile> file, uint32_t nodeId, Ptr<const Packet> packet)
+ * {
+ *     file->Write(Simulator::Now(), {nodeId, packet->GetUid(), packet->GetSize()});
+ * }
+ * \endcode
+ *
+ * The file format, with all the integers in little endian order, is:
+ * - a header: the 8 bytes "NS3BTRC1", the number of time steps per
+ *   second (int64), the schema name, the number of columns (uint32) and,
+ *   for each column, its type (uint8) and its name.  A name is its
+ *   length (uint32) followed by its characters;
+ * - the blocks: the number of records (uint32), the size of the data
+ *   (uint32), the times of the first and last records (int64), and the
+ *   data.  The data is the column of the times in time steps, followed
+ *   by the columns of the schema.  The INT64 and UINT64 columns, and the
+ *   times, store the zigzag LEB128 encoding of the difference of each
+ *   value with the previous one in the block, the first one with 0.  The
+ *   DOUBLE columns store the 8 bytes of each value;
+ * - the index: for each block, its offset in the file (uint64), the
+ *   times of its first and last records (int64) and its number of
+ *   records (uint32), followed by the offset of the index (uint64) and
+ *   the 8 bytes "NS3BTIDX".  A file whose writer did not close it has no
+ *   index; its complete blocks can still be read.
+ */
+class BinaryTraceFile : public SimpleRefCount<BinaryTraceFile>
+{
+  public:
+    /** The type of the values of a column. */
+    enum ColumnType : uint8_t
+    {
+        INT64 = 0,  //!< Signed integers.
+        UINT64 = 1, //!< Unsigned integers.
+        DOUBLE = 2, //!< Floating point numbers.
+    };
+
+    /** A column of the schema. */
+    struct Column
+    {
+        std::string name; //!< The column name.
+        ColumnType type;  //!< The type of the values.
+    };
+
+    /** A value of a record, stored as its 64 bits. */
+    class Value
+    {
+      public:
+        /**
+         * Construct from an integer.
+         * \tparam T \deduced The integer type.
+         * \param [in] value The value.
+         */
+        template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+        Value(T value)
+            : m_bits(static_cast<uint64_t>(value))
+        {
+        }
+
+        /**
+         * Construct from a floating point number.
+         * \param [in] value The value.
+         */
+        Value(double value)
+        {
+            std::memcpy(&m_bits, &value, sizeof(m_bits));
+        }
+
+        /**
+         * Get the bits of the value.
+         * \returns The 64 bits of the value.
+         */
+        uint64_t GetBits() const
+        {
+            return m_bits;
+        }
+
+      private:
+        uint64_t m_bits; //!< The value bits.
+    };
+
+    /**
+     * Create a binary trace file.
+     *
+     * \param [in] filename The file name.
+     * \param [in] schema The name of the schema, e.g., the trace source.
+     * \param [in] columns The columns of the records, after the time.
+     * \param [in] blockRecords The number of records of a block.
+     */
+    BinaryTraceFile(std::string filename,
+                    std::string schema,
+                    std::vector<Column> columns,
+                    uint32_t blockRecords = 4096);
+    /** Destructor: closes the file. */
+    ~BinaryTraceFile();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    BinaryTraceFile(const BinaryTraceFile&) = delete;
+    BinaryTraceFile& operator=(const BinaryTraceFile&) = delete;
+
+    /**
+     * Write a record.
+     *
+     * \param [in] time The record time, usually Simulator::Now().  The
+     *             index assumes that the times do not decrease.
+     * \param [in] values The values of the columns, in the schema order.
+     */
+    void Write(Time time, std::initializer_list<Value> values);
+
+    /**
+     * Write the buffered records, as a last, possibly smaller, block.
+     */
+    void Flush();
+
+    /**
+     * Flush the records, and write the index.  No record can be written
+     * after this.
+     */
+    void Close();
+
+    /**
+     * \returns The columns of the records, after the time.
+     */
+    const std::vector<Column>& GetColumns() const;
+
+    /**
+     * \returns \c true if the underlying stream failed.
+     */
+    bool Fail() const;
+
+  private:
+    /** The time span and position of a block. */
+    struct BlockIndex
+    {
+        uint64_t offset;  //!< The block offset in the file.
+        int64_t first;    //!< The time of the first record.
+        int64_t last;     //!< The time of the last record.
+        uint32_t records; //!< The number of records.
+    };
+
+    std::ofstream m_file;            //!< The output file.
+    std::vector<Column> m_columns;   //!< The columns after the time.
+    uint32_t m_blockRecords;         //!< The number of records of a full block.
+    std::vector<int64_t> m_times;    //!< The times of the buffered records.
+    std::vector<uint64_t> m_values;  //!< The values of the buffered records, by column.
+    std::string m_block;             //!< The block being encoded.
+    std::vector<BlockIndex> m_index; //!< The blocks written.
+};
+
+/**
+ * \ingroup network
+ *
+ * \brief Read the records of a BinaryTraceFile.
+ *
+ * \code{.cpp}
+ * BinaryTraceReader reader("packets.btr");
+ * uint32_t size = reader.GetColumnIndex("size");
+ * reader.Seek(Seconds(10));
+ * while (reader.Read() && reader.GetTime() < Seconds(20))
+ * {
+ *     bytes += reader.GetUint64(size);
+ * }
+ * \endcode
+ */
+class BinaryTraceReader
+{
+  public:
+    /**
+     * Open a binary trace file.
+     *
+     * The reader fails if the file cannot be read or has an unknown format.
+     *
+     * \param [in] filename The file name.
+     */
+    BinaryTraceReader(std::string filename);
+
+    /**
+     * \returns \c true if the file could not be read.
+     */
+    bool Fail() const;
+
+    /**
+     * \returns The schema name.
+     */
+    std::string GetSchema() const;
+
+    /**
+     * \returns The columns of the records, after the time.
+     */
+    const std::vector<BinaryTraceFile::Column>& GetColumns() const;
+
+    /**
+     * Get the index of a column.
+     *
+     * \param [in] name The column name.
+     * \returns The index of the column, as given to the BinaryTraceFile.
+     */
+    uint32_t GetColumnIndex(const std::string& name) const;
+
+    /**
+     * \returns The number of records in the file.
+     */
+    uint64_t GetNRecords() const;
+
+    /**
+     * Position the reader before the first record at or after a time.
+     *
+     * \param [in] time The time.
+     */
+    void Seek(Time time);
+
+    /**
+     * Read the next record.
+     *
+     * \returns \c false at the end of the file.
+     */
+    bool Read();
+
+    /**
+     * \returns The time of the record read.
+     */
+    Time GetTime() const;
+
+    /**
+     * Get a value of the record read.
+     * \param [in] column The column index.
+     * \returns The value.
+     * @{
+     */
+    int64_t GetInt64(uint32_t column) const;
+    uint64_t GetUint64(uint32_t column) const;
+    double GetDouble(uint32_t column) const;
+    /** @} */
+
+  private:
+    /**
+     * Load and decode a block.
+     * \param [in] block The index of the block.
+     * \returns \c false if the block cannot be read.
+     */
+    bool LoadBlock(std::size_t block);
+
+    /** The loaded block before the first Read(). */
+    static constexpr std::size_t NO_BLOCK = std::numeric_limits<std::size_t>::max();
+
+    /** The time span and position of a block. */
+    struct BlockIndex
+    {
+        uint64_t offset;  //!< The block offset in the file.
+        int64_t first;    //!< The time of the first record.
+        int64_t last;     //!< The time of the last record.
+        uint32_t records; //!< The number of records.
+    };
+
+    std::ifstream m_file;                          //!< The input file.
+    bool m_fail;                                   //!< Whether the file could not be read.
+    int64_t m_stepsPerSecond;                      //!< The time steps per second of the file.
+    std::string m_schema;                          //!< The schema name.
+    std::vector<BinaryTraceFile::Column> m_columns; //!< The columns after the time.
+    std::vector<BlockIndex> m_index;               //!< The blocks of the file.
+    std::size_t m_block;                           //!< The index of the loaded block.
+    std::size_t m_next;                            //!< The next record of the loaded block.
+    std::vector<int64_t> m_times;                  //!< The times of the loaded block.
+    std::vector<uint64_t> m_values;                //!< The values of the loaded block, by column.
+};
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_FILE_H */
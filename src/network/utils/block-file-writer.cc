@@ -0,0 +1,278 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "block-file-writer.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup network
+ * ns3::BlockFileWriter implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BlockFileWriter");
+
+namespace
+{
+
+/**
+ * \ingroup network
+ * The room left after the block size in a block, for the record which
+ * fills it: the largest pcap record, with its headers.
+ */
+constexpr std::size_t RECORD_ROOM = 65536 + 64;
+
+/**
+ * \ingroup network
+ * The blocks a writer can have in flight before it waits for the
+ * background thread.
+ */
+constexpr uint32_t MAX_IN_FLIGHT = 4;
+
+/**
+ * \ingroup network
+ * \brief The background thread writing the blocks of the asynchronous
+ * BlockFileWriter instances.
+ *
+ * The thread writes the blocks in the order they are submitted, so that
+ * the blocks of each stream are written in order.  It is never stopped:
+ * the writers flush their blocks when they are destroyed, and the
+ * instance outlives the writers which are static objects.
+ */
+class BlockWriterThread
+{
+  public:
+    /** A block allocation. */
+    struct Block
+    {
+        std::unique_ptr<char[]> data; //!< The bytes.
+        std::size_t capacity;         //!< The size allocated.
+    };
+
+    /**
+     * Get the thread, starting it at the first call.
+     * \returns The thread.
+     */
+    static BlockWriterThread* Get()
+    {
+        static BlockWriterThread* thread = new BlockWriterThread();
+        return thread;
+    }
+
+    /**
+     * Queue a block to write, waiting if the writer has too many blocks
+     * in flight.
+     *
+     * \param [in] writer The writer of the block.
+     * \param [in] stream The stream to write the block to.
+     * \param [in] block The block.
+     * \param [in] size The number of bytes of the block.
+     * \param [in] capacity The capacity needed for the next block.
+     * \returns A spare block of the capacity, or an empty block.
+     */
+    Block Submit(const BlockFileWriter* writer,
+                 std::ostream* stream,
+                 Block block,
+                 std::size_t size,
+                 std::size_t capacity)
+    {
+        std::unique_lock lock(m_mutex);
+        m_done.wait(lock, [this, writer]() {
+            auto it = m_inFlight.find(writer);
+            return it == m_inFlight.end() || it->second < MAX_IN_FLIGHT;
+        });
+        m_jobs.push_back({writer, stream, std::move(block), size});
+        m_inFlight[writer]++;
+        m_work.notify_one();
+
+        auto spare = std::find_if(m_spare.begin(), m_spare.end(), [capacity](const Block& b) {
+            return b.capacity >= capacity;
+        });
+        if (spare == m_spare.end())
+        {
+            return {nullptr, 0};
+        }
+        Block next = std::move(*spare);
+        m_spare.erase(spare);
+        return next;
+    }
+
+    /**
+     * Wait for the blocks of a writer to be written.
+     * \param [in] writer The writer.
+     */
+    void Wait(const BlockFileWriter* writer)
+    {
+        std::unique_lock lock(m_mutex);
+        m_done.wait(lock, [this, writer]() { return m_inFlight.count(writer) == 0; });
+    }
+
+  private:
+    /** A block to write. */
+    struct Job
+    {
+        const BlockFileWriter* writer; //!< The writer of the block.
+        std::ostream* stream;          //!< The stream to write the block to.
+        Block block;                   //!< The block.
+        std::size_t size;              //!< The number of bytes of the block.
+    };
+
+    /** The spare blocks kept for reuse. */
+    static constexpr std::size_t MAX_SPARE = 16;
+
+    BlockWriterThread()
+    {
+        std::thread(&BlockWriterThread::Run, this).detach();
+    }
+
+    /** Write the blocks queued. */
+    void Run()
+    {
+        std::unique_lock lock(m_mutex);
+        while (true)
+        {
+            m_work.wait(lock, [this]() { return !m_jobs.empty(); });
+            Job job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            lock.unlock();
+            job.stream->write(job.block.data.get(), job.size);
+            lock.lock();
+            if (m_spare.size() < MAX_SPARE)
+            {
+                m_spare.push_back(std::move(job.block));
+            }
+            auto it = m_inFlight.find(job.writer);
+            if (--it->second == 0)
+            {
+                m_inFlight.erase(it);
+            }
+            m_done.notify_all();
+        }
+    }
+
+    std::mutex m_mutex;                //!< Protects the members below.
+    std::condition_variable m_work;    //!< Notified when a block is queued.
+    std::condition_variable m_done;    //!< Notified when a block is written.
+    std::deque<Job> m_jobs;            //!< The blocks to write.
+    std::vector<Block> m_spare;        //!< The blocks written, for reuse.
+    std::unordered_map<const BlockFileWriter*, uint32_t> m_inFlight; //!< Blocks per writer.
+};
+
+} // namespace
+
+BlockFileWriter::BlockFileWriter()
+    : m_stream(nullptr),
+      m_blockSize(0),
+      m_asynchronous(false),
+      m_block(),
+      m_size(0),
+      m_capacity(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+BlockFileWriter::~BlockFileWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Detach();
+}
+
+void
+BlockFileWriter::Attach(std::ostream* stream, std::size_t blockSize, bool asynchronous)
+{
+    NS_LOG_FUNCTION(this << stream << blockSize << asynchronous);
+    Detach();
+    m_stream = stream;
+    m_blockSize = blockSize;
+    m_asynchronous = asynchronous && blockSize > 0;
+}
+
+void
+BlockFileWriter::Detach()
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+    m_stream = nullptr;
+}
+
+void
+BlockFileWriter::Append(const void* data, std::size_t size)
+{
+    std::memcpy(Reserve(size), data, size);
+}
+
+void
+BlockFileWriter::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_stream == nullptr || !IsBuffered())
+    {
+        return;
+    }
+    if (m_size > 0)
+    {
+        Submit();
+    }
+    Wait();
+    m_stream->flush();
+}
+
+void
+BlockFileWriter::Wait() const
+{
+    if (m_asynchronous)
+    {
+        BlockWriterThread::Get()->Wait(this);
+    }
+}
+
+void
+BlockFileWriter::Submit()
+{
+    NS_LOG_FUNCTION(this << m_size);
+    if (!m_asynchronous)
+    {
+        m_stream->write(m_block.get(), m_size);
+        m_size = 0;
+        return;
+    }
+    auto spare = BlockWriterThread::Get()->Submit(this,
+                                                  m_stream,
+                                                  {std::move(m_block), m_capacity},
+                                                  m_size,
+                                                  m_blockSize + RECORD_ROOM);
+    m_block = std::move(spare.data);
+    m_capacity = spare.capacity;
+    m_size = 0;
+}
+
+void
+BlockFileWriter::Grow(std::size_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    std::size_t capacity = std::max({size, 2 * m_capacity, m_blockSize + RECORD_ROOM});
+    std::unique_ptr<char[]> block(new char[capacity]);
+    if (m_size > 0)
+    {
+        std::memcpy(block.get(), m_block.get(), m_size);
+    }
+    m_block = std::move(block);
+    m_capacity = capacity;
+}
+
+} // namespace ns3
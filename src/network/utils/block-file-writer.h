@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef BLOCK_FILE_WRITER_H
+#define BLOCK_FILE_WRITER_H
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Batch the records written to a stream into large blocks, and
+ * optionally write the blocks on a background thread.
+ *
+ * The trace files write a few small records per packet.  Writing each of
+ * them to their stream costs a call into the stream buffer per field, and
+ * a system call each time the stream buffer fills up.  A BlockFileWriter
+ * instead lets the file serialize its records directly into a memory
+ * block, with Reserve(), and writes the block to the stream once it
+ * reaches the block size.
+ *
+ * With the asynchronous mode, the full blocks are handed over to a
+ * background thread, shared by all the writers, which writes them while
+ * the simulation goes on.  A writer holds at most a few blocks in flight,
+ * so that a simulation producing records faster than the disk can store
+ * them waits for the disk rather than using more memory.  The stream must
+ * not be used directly before Flush() returns.
+ *
+ * With a block size of 0, the default, the writer is not buffered, and
+ * the file writes its records to its stream itself.
+ */
+class BlockFileWriter
+{
+  public:
+    BlockFileWriter();
+    /** Destructor: flushes the blocks. */
+    ~BlockFileWriter();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    BlockFileWriter(const BlockFileWriter&) = delete;
+    BlockFileWriter& operator=(const BlockFileWriter&) = delete;
+
+    /**
+     * Set the stream written, and the buffering of the records.
+     *
+     * The blocks buffered for the previous stream, if any, are flushed.
+     *
+     * \param [in] stream The stream to write the blocks to.
+     * \param [in] blockSize The size of the blocks, or 0 to not buffer.
+     * \param [in] asynchronous Whether to write the blocks on the background thread.
+     */
+    void Attach(std::ostream* stream, std::size_t blockSize, bool asynchronous);
+
+    /**
+     * Flush the blocks, and forget the stream.
+     */
+    void Detach();
+
+    /**
+     * \returns \c true if the records are buffered.
+     */
+    bool IsBuffered() const;
+
+    /**
+     * Reserve room for bytes at the end of the current block.
+     *
+     * The pointer returned is valid until the next call of a method of
+     * the writer.
+     *
+     * \param [in] size The number of bytes.
+     * \returns A pointer to the bytes to write.
+     */
+    char* Reserve(std::size_t size);
+
+    /**
+     * Append bytes at the end of the current block.
+     *
+     * \param [in] data The bytes.
+     * \param [in] size The number of bytes.
+     */
+    void Append(const void* data, std::size_t size);
+
+    /**
+     * Mark the end of a record: the block is written if it is full.
+     */
+    void Commit();
+
+    /**
+     * Write the current block, wait for the blocks in flight to be
+     * written, and flush the stream.
+     */
+    void Flush();
+
+    /**
+     * Wait for the blocks in flight to be written.
+     */
+    void Wait() const;
+
+  private:
+    /** Write the current block, or hand it over to the background thread. */
+    void Submit();
+
+    /**
+     * Grow the current block.
+     * \param [in] size The number of bytes needed in the block.
+     */
+    void Grow(std::size_t size);
+
+    std::ostream* m_stream;          //!< The stream written.
+    std::size_t m_blockSize;         //!< The size of a full block, or 0.
+    bool m_asynchronous;             //!< Whether the blocks are written by the background thread.
+    std::unique_ptr<char[]> m_block; //!< The block being filled, left uninitialized.
+    std::size_t m_size;              //!< The number of bytes in the block.
+    std::size_t m_capacity;          //!< The size of the block allocated.
+};
+
+inline bool
+BlockFileWriter::IsBuffered() const
+{
+    return m_blockSize > 0;
+}
+
+inline char*
+BlockFileWriter::Reserve(std::size_t size)
+{
+    if (m_size + size > m_capacity)
+    {
+        Grow(m_size + size);
+    }
+    char* data = m_block.get() + m_size;
+    m_size += size;
+    return data;
+}
+
+inline void
+BlockFileWriter::Commit()
+{
+    if (m_size >= m_blockSize)
+    {
+        Submit();
+    }
+}
+
+} // namespace ns3
+
+#endif /* BLOCK_FILE_WRITER_H */
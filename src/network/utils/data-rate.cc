@@ -227,7 +227,7 @@ Time
 DataRate::CalculateBitsTxTime(uint32_t bits) const
 {
     NS_LOG_FUNCTION(this << bits);
-    return Seconds(int64x64_t(bits) / m_bps);
+    return Time::FromRatio(bits, m_bps, Time::S);
 }
 
 uint64_t
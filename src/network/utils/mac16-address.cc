@@ -24,7 +24,7 @@ NS_LOG_COMPONENT_DEFINE("Mac16Address");
 
 ATTRIBUTE_HELPER_CPP(Mac16Address);
 
-uint64_t Mac16Address::m_allocationIndex = 0;
+thread_local uint64_t Mac16Address::m_allocationIndex = 0;
 
 Mac16Address::Mac16Address(const char* str)
 {
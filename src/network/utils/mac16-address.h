@@ -217,8 +217,8 @@ class Mac16Address
      */
     friend std::istream& operator>>(std::istream& is, Mac16Address& address);
 
-    static uint64_t m_allocationIndex; //!< Address allocation index
-    uint8_t m_address[2]{0};           //!< Address value
+    static thread_local uint64_t m_allocationIndex; //!< Address allocation index, per thread
+    uint8_t m_address[2]{0};                        //!< Address value
 };
 
 ATTRIBUTE_HELPER_HEADER(Mac16Address);
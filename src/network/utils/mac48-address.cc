@@ -23,7 +23,7 @@ NS_LOG_COMPONENT_DEFINE("Mac48Address");
 
 ATTRIBUTE_HELPER_CPP(Mac48Address);
 
-uint64_t Mac48Address::m_allocationIndex = 0;
+thread_local uint64_t Mac48Address::m_allocationIndex = 0;
 
 Mac48Address::Mac48Address(const char* str)
 {
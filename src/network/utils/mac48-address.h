@@ -201,8 +201,8 @@ class Mac48Address
      */
     friend std::istream& operator>>(std::istream& is, Mac48Address& address);
 
-    static uint64_t m_allocationIndex; //!< Address allocation index
-    uint8_t m_address[6]{0};           //!< Address value
+    static thread_local uint64_t m_allocationIndex; //!< Address allocation index, per thread
+    uint8_t m_address[6]{0};                        //!< Address value
 };
 
 ATTRIBUTE_HELPER_HEADER(Mac48Address);
@@ -23,7 +23,7 @@ NS_LOG_COMPONENT_DEFINE("Mac64Address");
 
 ATTRIBUTE_HELPER_CPP(Mac64Address);
 
-uint64_t Mac64Address::m_allocationIndex = 0;
+thread_local uint64_t Mac64Address::m_allocationIndex = 0;
 
 Mac64Address::Mac64Address(const char* str)
 {
@@ -168,8 +168,8 @@ class Mac64Address
      */
     friend std::istream& operator>>(std::istream& is, Mac64Address& address);
 
-    static uint64_t m_allocationIndex; //!< Address allocation index
-    uint8_t m_address[8]{0};           //!< Address value
+    static thread_local uint64_t m_allocationIndex; //!< Address allocation index, per thread
+    uint8_t m_address[8]{0};                        //!< Address value
 };
 
 /**
@@ -17,7 +17,7 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Mac8Address");
 
-uint8_t Mac8Address::m_allocationIndex = 0;
+thread_local uint8_t Mac8Address::m_allocationIndex = 0;
 
 Mac8Address::Mac8Address(uint8_t addr)
     : m_address(addr)
@@ -119,8 +119,8 @@ class Mac8Address
     static void ResetAllocationIndex();
 
   private:
-    static uint8_t m_allocationIndex; //!< Address allocation index
-    uint8_t m_address{255};           //!< The address.
+    static thread_local uint8_t m_allocationIndex; //!< Address allocation index, per thread
+    uint8_t m_address{255};                        //!< The address.
 
     /**
      * Get the Mac8Address type.
@@ -37,6 +37,18 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
+                          MakeBooleanChecker())
+            .AddAttribute("BlockSize",
+                          "Size of the blocks in which the packets written are buffered, "
+                          "or 0 to write each packet to the file (default).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_blockSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Asynchronous",
+                          "Whether the blocks of buffered packets are written by a "
+                          "background thread.  Only used with a BlockSize.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_asynchronous),
                           MakeBooleanChecker());
     return tid;
 }
@@ -85,6 +97,10 @@ PcapFileWrapper::Open(const std::string& filename, std::ios::openmode mode)
 {
     NS_LOG_FUNCTION(this << filename << mode);
     m_file.Open(filename, mode);
+    if (mode & std::ios::out)
+    {
+        m_file.SetBuffering(m_blockSize, m_asynchronous);
+    }
 }
 
 void
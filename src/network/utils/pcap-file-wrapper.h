@@ -211,9 +211,11 @@ class PcapFileWrapper : public Object
     uint32_t GetDataLinkType();
 
   private:
-    PcapFile m_file;    //!< Pcap file
-    uint32_t m_snapLen; //!< max length of saved packets
-    bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    PcapFile m_file;      //!< Pcap file
+    uint32_t m_snapLen;   //!< max length of saved packets
+    bool m_nanosecMode;   //!< Timestamps in nanosecond mode
+    uint32_t m_blockSize; //!< Size of the blocks of buffered records
+    bool m_asynchronous;  //!< Write the blocks on a background thread
 };
 
 } // namespace ns3
@@ -60,6 +60,7 @@ bool
 PcapFile::Fail() const
 {
     NS_LOG_FUNCTION(this);
+    m_writer.Wait();
     return m_file.fail();
 }
 
@@ -81,9 +82,17 @@ void
 PcapFile::Close()
 {
     NS_LOG_FUNCTION(this);
+    m_writer.Flush();
     m_file.close();
 }
 
+void
+PcapFile::SetBuffering(uint32_t blockSize, bool asynchronous)
+{
+    NS_LOG_FUNCTION(this << blockSize << asynchronous);
+    m_writer.Attach(&m_file, blockSize, asynchronous);
+}
+
 uint32_t
 PcapFile::GetMagic()
 {
@@ -198,8 +207,9 @@ PcapFile::WriteFileHeader()
     NS_LOG_FUNCTION(this);
     //
     // If we're initializing the file, we need to write the pcap file header
-    // at the start of the file.
+    // at the start of the file, after the buffered records if any.
     //
+    m_writer.Flush();
     m_file.seekp(0, std::ios::beg);
 
     //
@@ -417,6 +427,16 @@ PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
         Swap(&header, &header);
     }
 
+    if (m_writer.IsBuffered())
+    {
+        char* out = m_writer.Reserve(16);
+        std::memcpy(out, &header.m_tsSec, sizeof(header.m_tsSec));
+        std::memcpy(out + 4, &header.m_tsUsec, sizeof(header.m_tsUsec));
+        std::memcpy(out + 8, &header.m_inclLen, sizeof(header.m_inclLen));
+        std::memcpy(out + 12, &header.m_origLen, sizeof(header.m_origLen));
+        return inclLen;
+    }
+
     //
     // Watch out for memory alignment differences between machines, so write
     // them all individually.
@@ -434,6 +454,12 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const uint8_t* const data, uint
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << &data << totalLen);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalLen);
+    if (m_writer.IsBuffered())
+    {
+        m_writer.Append(data, inclLen);
+        m_writer.Commit();
+        return;
+    }
     m_file.write((const char*)data, inclLen);
     NS_BUILD_DEBUG(m_file.flush());
 }
@@ -443,6 +469,13 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << p);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, p->GetSize());
+    if (m_writer.IsBuffered())
+    {
+        // Copy the captured bytes only, from the packet buffer into the block
+        p->CopyData(reinterpret_cast<uint8_t*>(m_writer.Reserve(inclLen)), inclLen);
+        m_writer.Commit();
+        return;
+    }
     p->CopyData(&m_file, inclLen);
     NS_BUILD_DEBUG(m_file.flush());
 }
@@ -459,6 +492,14 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const Header& header, Ptr<const
     headerBuffer.AddAtStart(headerSize);
     header.Serialize(headerBuffer.Begin());
     uint32_t toCopy = std::min(headerSize, inclLen);
+    if (m_writer.IsBuffered())
+    {
+        auto out = reinterpret_cast<uint8_t*>(m_writer.Reserve(inclLen));
+        headerBuffer.CopyData(out, toCopy);
+        p->CopyData(out + toCopy, inclLen - toCopy);
+        m_writer.Commit();
+        return;
+    }
     headerBuffer.CopyData(&m_file, toCopy);
     inclLen -= toCopy;
     p->CopyData(&m_file, inclLen);
@@ -9,6 +9,8 @@
 #ifndef PCAP_FILE_H
 #define PCAP_FILE_H
 
+#include "block-file-writer.h"
+
 #include "ns3/ptr.h"
 
 #include <fstream>
@@ -75,6 +77,22 @@ class PcapFile
      */
     void Close();
 
+    /**
+     * Buffer the records written to the file.
+     *
+     * The records are serialized into blocks of memory, the packet data
+     * being copied from the packet buffers directly into the block, and
+     * each block is written to the file when full.  With the asynchronous
+     * mode, the blocks are written by a background thread (see
+     * BlockFileWriter).  The file content is the same as without
+     * buffering, but only up to date after Close().
+     *
+     * \param blockSize The size of the blocks, or 0 to write each record
+     * to the file stream directly (the default).
+     * \param asynchronous Whether to write the blocks on a background thread.
+     */
+    void SetBuffering(uint32_t blockSize, bool asynchronous = false);
+
     /**
      * Initialize the pcap file associated with this object.  This file must have
      * been previously opened with write permissions.
@@ -364,6 +382,7 @@ class PcapFile
 
     std::string m_filename;      //!< file name
     std::fstream m_file;         //!< file stream
+    BlockFileWriter m_writer;    //!< buffered writer of the records
     PcapFileHeader m_fileHeader; //!< file header
     bool m_swapMode;             //!< swap mode
     bool m_nanosecMode;          //!< nanosecond timestamp mode
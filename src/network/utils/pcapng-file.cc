@@ -0,0 +1,250 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "pcapng-file.h"
+
+#include "pcap-file.h"
+
+#include "ns3/boolean.h"
+#include "ns3/buffer.h"
+#include "ns3/fatal-impl.h"
+#include "ns3/header.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cstring>
+
+/**
+ * \file
+ * \ingroup network
+ * ns3::PcapNgFile implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PcapNgFile");
+
+NS_OBJECT_ENSURE_REGISTERED(PcapNgFile);
+
+namespace
+{
+
+const uint32_t SECTION_HEADER_BLOCK = 0x0a0d0d0a; //!< Section header block type.
+const uint32_t INTERFACE_DESCRIPTION_BLOCK = 1;   //!< Interface description block type.
+const uint32_t ENHANCED_PACKET_BLOCK = 6;         //!< Enhanced packet block type.
+const uint32_t BYTE_ORDER_MAGIC = 0x1a2b3c4d;     //!< Byte order of the section.
+const uint16_t OPTION_END = 0;                    //!< End of the options.
+const uint16_t OPTION_IF_NAME = 2;                //!< Interface name option.
+const uint16_t OPTION_IF_TSRESOL = 9;             //!< Interface time resolution option.
+const uint8_t TSRESOL_NANOSECONDS = 9;            //!< Timestamps in 10^-9 seconds.
+const uint32_t PACKET_BLOCK_OVERHEAD = 32;        //!< Enhanced packet block fields.
+
+/**
+ * Pad a length to a multiple of 4 bytes.
+ * \param [in] length The length.
+ * \returns The padded length.
+ */
+uint32_t
+Pad(uint32_t length)
+{
+    return (length + 3) & ~3U;
+}
+
+/**
+ * Write a value in the byte order of the machine.
+ * \tparam T \deduced The value type.
+ * \param [in] out Where to write the value.
+ * \param [in] value The value.
+ * \returns Where to write the next value.
+ */
+template <typename T>
+char*
+Put(char* out, T value)
+{
+    std::memcpy(out, &value, sizeof(value));
+    return out + sizeof(value);
+}
+
+} // namespace
+
+TypeId
+PcapNgFile::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::PcapNgFile")
+            .SetParent<Object>()
+            .SetGroupName("Network")
+            .AddConstructor<PcapNgFile>()
+            .AddAttribute("CaptureSize",
+                          "Maximum length of captured packets of the interfaces (cf. pcap "
+                          "snaplen), unless given when the interface is added",
+                          UintegerValue(PcapFile::SNAPLEN_DEFAULT),
+                          MakeUintegerAccessor(&PcapNgFile::m_snapLen),
+                          MakeUintegerChecker<uint32_t>(0, PcapFile::SNAPLEN_DEFAULT))
+            .AddAttribute("BlockSize",
+                          "Size of the blocks in which the packets written are buffered, "
+                          "or 0 to write each packet to the file (default).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PcapNgFile::m_blockSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Asynchronous",
+                          "Whether the blocks of buffered packets are written by a "
+                          "background thread.  Only used with a BlockSize.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapNgFile::m_asynchronous),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+PcapNgFile::PcapNgFile()
+{
+    NS_LOG_FUNCTION(this);
+    FatalImpl::RegisterStream(&m_file);
+}
+
+PcapNgFile::~PcapNgFile()
+{
+    NS_LOG_FUNCTION(this);
+    FatalImpl::UnregisterStream(&m_file);
+    Close();
+}
+
+bool
+PcapNgFile::Fail() const
+{
+    NS_LOG_FUNCTION(this);
+    m_writer.Wait();
+    return m_file.fail();
+}
+
+void
+PcapNgFile::Open(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    m_file.open(filename, std::ios::out | std::ios::binary);
+    m_writer.Attach(&m_file, m_blockSize, m_asynchronous);
+    m_snapLens.clear();
+
+    const uint32_t length = 28;
+    char* out = m_writer.Reserve(length);
+    out = Put(out, SECTION_HEADER_BLOCK);
+    out = Put(out, length);
+    out = Put(out, BYTE_ORDER_MAGIC);
+    out = Put<uint16_t>(out, 1); // Major version
+    out = Put<uint16_t>(out, 0); // Minor version
+    out = Put<int64_t>(out, -1); // Unspecified section length
+    Put(out, length);
+    m_writer.Commit();
+}
+
+void
+PcapNgFile::Close()
+{
+    NS_LOG_FUNCTION(this);
+    m_writer.Detach();
+    m_file.close();
+}
+
+uint32_t
+PcapNgFile::AddInterface(uint16_t dataLinkType, const std::string& name, uint32_t snapLen)
+{
+    NS_LOG_FUNCTION(this << dataLinkType << name << snapLen);
+    if (snapLen == std::numeric_limits<uint32_t>::max())
+    {
+        snapLen = m_snapLen;
+    }
+    m_snapLens.push_back(snapLen);
+
+    const auto nameLength = static_cast<uint16_t>(std::min<std::size_t>(name.size(), 0xfff0));
+    const uint32_t nameOption = nameLength > 0 ? 4 + Pad(nameLength) : 0;
+    const uint32_t length = 16 + nameOption + 8 + 4 + 4;
+    char* out = m_writer.Reserve(length);
+    char* end = out + length;
+    out = Put(out, INTERFACE_DESCRIPTION_BLOCK);
+    out = Put(out, length);
+    out = Put(out, dataLinkType);
+    out = Put<uint16_t>(out, 0); // Reserved
+    out = Put(out, snapLen);
+    if (nameOption > 0)
+    {
+        out = Put(out, OPTION_IF_NAME);
+        out = Put(out, nameLength);
+        std::memset(out, 0, Pad(nameLength));
+        std::memcpy(out, name.data(), nameLength);
+        out += Pad(nameLength);
+    }
+    out = Put(out, OPTION_IF_TSRESOL);
+    out = Put<uint16_t>(out, 1);
+    out = Put(out, TSRESOL_NANOSECONDS);
+    out = Put<uint8_t>(out, 0); // Padding
+    out = Put<uint16_t>(out, 0);
+    out = Put(out, OPTION_END);
+    out = Put<uint16_t>(out, 0);
+    Put(out, length);
+    NS_ASSERT(out + 4 == end);
+    m_writer.Commit();
+    return m_snapLens.size() - 1;
+}
+
+uint32_t
+PcapNgFile::GetNInterfaces() const
+{
+    return m_snapLens.size();
+}
+
+uint8_t*
+PcapNgFile::WritePacketBlock(uint32_t interface, Time t, uint32_t totalLen, uint32_t& inclLen)
+{
+    NS_ASSERT_MSG(interface < m_snapLens.size(), "Unknown interface " << interface);
+    inclLen = std::min(totalLen, m_snapLens[interface]);
+    const uint32_t length = PACKET_BLOCK_OVERHEAD + Pad(inclLen);
+    const auto timestamp = static_cast<uint64_t>(t.GetNanoSeconds());
+
+    char* out = m_writer.Reserve(length);
+    char* data = out + PACKET_BLOCK_OVERHEAD - 4;
+    out = Put(out, ENHANCED_PACKET_BLOCK);
+    out = Put(out, length);
+    out = Put(out, interface);
+    out = Put(out, static_cast<uint32_t>(timestamp >> 32));
+    out = Put(out, static_cast<uint32_t>(timestamp));
+    out = Put(out, inclLen);
+    Put(out, totalLen);
+
+    // The padding and the trailing length, after the packet data
+    std::memset(data + inclLen, 0, Pad(inclLen) - inclLen);
+    Put(data + Pad(inclLen), length);
+    return reinterpret_cast<uint8_t*>(data);
+}
+
+void
+PcapNgFile::Write(uint32_t interface, Time t, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << interface << t << p);
+    uint32_t inclLen;
+    uint8_t* data = WritePacketBlock(interface, t, p->GetSize(), inclLen);
+    p->CopyData(data, inclLen);
+    m_writer.Commit();
+}
+
+void
+PcapNgFile::Write(uint32_t interface, Time t, const Header& header, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << interface << t << &header << p);
+    uint32_t headerSize = header.GetSerializedSize();
+    uint32_t inclLen;
+    uint8_t* data = WritePacketBlock(interface, t, headerSize + p->GetSize(), inclLen);
+
+    Buffer headerBuffer;
+    headerBuffer.AddAtStart(headerSize);
+    header.Serialize(headerBuffer.Begin());
+    uint32_t toCopy = std::min(headerSize, inclLen);
+    headerBuffer.CopyData(data, toCopy);
+    p->CopyData(data + toCopy, inclLen - toCopy);
+    m_writer.Commit();
+}
+
+} // namespace ns3
@@ -0,0 +1,137 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PCAPNG_FILE_H
+#define PCAPNG_FILE_H
+
+#include "block-file-writer.h"
+
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class Header;
+class Packet;
+
+/**
+ * \ingroup network
+ *
+ * \brief A pcapng file, capturing the packets of several interfaces.
+ *
+ * A pcap file holds the packets of a single interface, so that a
+ * simulation tracing a thousand devices writes a thousand files.  The
+ * pcapng format (see the IETF draft-ietf-opsawg-pcapng) describes each
+ * interface, with its own data link type and snap length, in a block of
+ * the file, and tags each packet with its interface.  A
+ * PcapNgFile writes such a file, which Wireshark and tcpdump read:
+ * \code{.cpp}
+ * Ptr<PcapNgFile> file = CreateObject<PcapNgFile>();
+ * file->Open("capture.pcapng");
+ * uint32_t interface = file->AddInterface(PcapHelper::DLT_PPP, "node 0 device 1");
+ * file->Write(interface, Simulator::Now(), packet);
+ * \endcode
+ *
+ * The files are written in the byte order of the machine, with a time
+ * resolution of a nanosecond.  Like PcapFileWrapper, the records can be
+ * buffered in blocks (see BlockFileWriter) with the BlockSize and
+ * Asynchronous attributes.
+ */
+class PcapNgFile : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    PcapNgFile();
+    ~PcapNgFile() override;
+
+    /**
+     * \return true if the 'fail' bit is set in the underlying stream, false otherwise.
+     */
+    bool Fail() const;
+
+    /**
+     * Create a pcapng file, and write its section header.
+     *
+     * \param filename The file name.
+     */
+    void Open(const std::string& filename);
+
+    /**
+     * Write the buffered records, and close the file.
+     */
+    void Close();
+
+    /**
+     * Describe an interface, whose packets can then be written to the file.
+     *
+     * \param dataLinkType The data link type of the packets, e.g.,
+     * PcapHelper::DLT_EN10MB.
+     * \param name The name of the interface.
+     * \param snapLen The maximum size of the packets written, or the
+     * "CaptureSize" attribute by default.
+     * \returns The identifier of the interface.
+     */
+    uint32_t AddInterface(uint16_t dataLinkType,
+                          const std::string& name,
+                          uint32_t snapLen = std::numeric_limits<uint32_t>::max());
+
+    /**
+     * \returns The number of interfaces of the file.
+     */
+    uint32_t GetNInterfaces() const;
+
+    /**
+     * \brief Write the next packet to the file.
+     *
+     * \param interface The identifier of the interface.
+     * \param t Packet timestamp as ns3::Time.
+     * \param p Packet to write to the file.
+     */
+    void Write(uint32_t interface, Time t, Ptr<const Packet> p);
+
+    /**
+     * \brief Write the next packet to the file, after a header.
+     *
+     * \param interface The identifier of the interface.
+     * \param t Packet timestamp as ns3::Time.
+     * \param header The header to write before the packet.
+     * \param p Packet to write to the file.
+     */
+    void Write(uint32_t interface, Time t, const Header& header, Ptr<const Packet> p);
+
+  private:
+    /**
+     * Reserve an enhanced packet block, and write its header.
+     *
+     * \param interface The identifier of the interface.
+     * \param t The packet timestamp.
+     * \param totalLen The length of the packet.
+     * \param [out] inclLen The number of bytes of the packet to write.
+     * \returns Where to write the packet bytes.
+     */
+    uint8_t* WritePacketBlock(uint32_t interface, Time t, uint32_t totalLen, uint32_t& inclLen);
+
+    std::ofstream m_file;             //!< The file stream.
+    BlockFileWriter m_writer;         //!< The writer of the blocks.
+    std::vector<uint32_t> m_snapLens; //!< The snap lengths of the interfaces.
+    uint32_t m_snapLen;               //!< The default snap length.
+    uint32_t m_blockSize;             //!< The size of the blocks of buffered records.
+    bool m_asynchronous;              //!< Write the blocks on a background thread.
+};
+
+} // namespace ns3
+
+#endif /* PCAPNG_FILE_H */
@@ -452,6 +452,12 @@ Queue<Item, Container>::GetTypeId()
         TypeId(name)
             .SetParent<QueueBase>()
             .SetGroupName("Network")
+            .SetMemoryEstimator([](const ObjectBase* object) -> std::size_t {
+                // the container entries: the bytes of the packets are
+                // accounted for by their buffers
+                auto queue = static_cast<const Queue<Item, Container>*>(object);
+                return queue->GetNPackets() * (sizeof(Ptr<Item>) + 2 * sizeof(void*));
+            })
             .AddTraceSource("Enqueue",
                             "Enqueue a packet in the queue.",
                             MakeTraceSourceAccessor(&Queue<Item, Container>::m_traceEnqueue),
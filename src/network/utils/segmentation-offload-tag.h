@@ -0,0 +1,81 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SEGMENTATION_OFFLOAD_TAG_H
+#define SEGMENTATION_OFFLOAD_TAG_H
+
+#include "ns3/tag.h"
+
+/**
+ * \file
+ * \ingroup network
+ * ns3::SegmentationOffloadTag declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Packet tag of an aggregate of transport segments, to be split in
+ * segments of a given size at the transmit boundary of the NetDevice.
+ *
+ * A transport protocol with segmentation offload sends the payload of
+ * consecutive segments in a single packet, with the header of the first
+ * one, and tags it with the size of the segments and of the payload.  A
+ * NetDevice supporting the offload (see
+ * NetDevice::SupportsSegmentationOffload()) transmits the aggregate as the
+ * segments it stands for, each with a copy of the headers: e.g., the
+ * PointToPointNetDevice accounts for the serialization time of all of
+ * them.  The other NetDevices never see the aggregates: the transport
+ * protocol splits them before sending them to such a device.
+ */
+class SegmentationOffloadTag : public Tag
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer buf) const override;
+    void Deserialize(TagBuffer buf) override;
+    void Print(std::ostream& os) const override;
+
+    SegmentationOffloadTag();
+
+    /**
+     * Constructs a SegmentationOffloadTag.
+     *
+     * \param segmentSize The payload size of the segments, but the last one.
+     * \param payloadSize The payload size of the aggregate.
+     */
+    SegmentationOffloadTag(uint32_t segmentSize, uint32_t payloadSize);
+
+    /**
+     * \returns The payload size of the segments, but the last one.
+     */
+    uint32_t GetSegmentSize() const;
+
+    /**
+     * \returns The payload size of the aggregate.
+     */
+    uint32_t GetPayloadSize() const;
+
+    /**
+     * \returns The number of segments of the aggregate.
+     */
+    uint32_t GetSegments() const;
+
+  private:
+    uint32_t m_segmentSize; //!< The payload size of the segments
+    uint32_t m_payloadSize; //!< The payload size of the aggregate
+};
+
+} // namespace ns3
+
+#endif /* SEGMENTATION_OFFLOAD_TAG_H */
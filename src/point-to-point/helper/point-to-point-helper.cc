@@ -91,6 +91,29 @@ PointToPointHelper::EnablePcapInternal(std::string prefix,
     pcapHelper.HookDefaultSink<PointToPointNetDevice>(device, "PromiscSniffer", file);
 }
 
+Ptr<PcapNgFile>
+PointToPointHelper::EnablePcapNg(std::string filename, NetDeviceContainer devices)
+{
+    PcapHelper pcapHelper;
+    Ptr<PcapNgFile> file = pcapHelper.CreatePcapNgFile(filename);
+    for (auto i = devices.Begin(); i != devices.End(); ++i)
+    {
+        Ptr<PointToPointNetDevice> device = (*i)->GetObject<PointToPointNetDevice>();
+        if (!device)
+        {
+            NS_LOG_INFO("Device " << *i << " not of type ns3::PointToPointNetDevice");
+            continue;
+        }
+        pcapHelper.HookPcapNgSink<PointToPointNetDevice>(
+            device,
+            "PromiscSniffer",
+            file,
+            PcapHelper::DLT_PPP,
+            pcapHelper.GetFilenameFromDevice("node", device));
+    }
+    return file;
+}
+
 void
 PointToPointHelper::EnableAsciiInternal(Ptr<OutputStreamWrapper> stream,
                                         std::string prefix,
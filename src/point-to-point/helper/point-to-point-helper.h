@@ -142,6 +142,20 @@ class PointToPointHelper : public PcapHelperForDevice, public AsciiTraceHelperFo
      */
     NetDeviceContainer Install(std::string aNode, std::string bNode);
 
+    /**
+     * \brief Capture the packets of point to point devices in a single
+     * pcapng file.
+     *
+     * Each device is an interface of the file, named after its node and
+     * device like the files of EnablePcap(), which writes a file per device.
+     * The PcapNgFile attributes select the buffering of the file.
+     *
+     * \param filename The name of the pcapng file.
+     * \param devices The devices whose packets are captured.
+     * \return The pcapng file.
+     */
+    Ptr<PcapNgFile> EnablePcapNg(std::string filename, NetDeviceContainer devices);
+
   private:
     /**
      * \brief Enable pcap output the indicated net device.
@@ -15,6 +15,7 @@
 #include "ns3/mac48-address.h"
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
@@ -239,6 +240,19 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     m_phyTxBeginTrace(m_currentPkt);
 
     Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
+    SegmentationOffloadTag tag;
+    if (p->PeekPacketTag(tag) && tag.GetSegments() > 1 && p->GetSize() > tag.GetPayloadSize())
+    {
+        //
+        // An aggregate of segments is transmitted as a whole: it is received
+        // when its last segment would be, each segment with its own copy of
+        // the headers and its interframe gap.
+        //
+        uint32_t segments = tag.GetSegments();
+        uint32_t headers = p->GetSize() - tag.GetPayloadSize();
+        txTime = m_bps.CalculateBytesTxTime(p->GetSize() + (segments - 1) * headers) +
+                 (segments - 1) * m_tInterframeGap;
+    }
     Time txCompleteTime = txTime + m_tInterframeGap;
 
     NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
@@ -597,6 +611,13 @@ PointToPointNetDevice::SupportsSendFrom() const
     return false;
 }
 
+bool
+PointToPointNetDevice::SupportsSegmentationOffload() const
+{
+    NS_LOG_FUNCTION(this);
+    return true;
+}
+
 void
 PointToPointNetDevice::DoMpiReceive(Ptr<Packet> p)
 {
@@ -10,6 +10,7 @@
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/point-to-point-net-device.h"
+#include "ns3/segmentation-offload-tag.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
@@ -128,6 +129,99 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \brief Test class for the segmentation offload of the PointToPoint model
+ *
+ * It sends an aggregate of segments, and checks that it is received as a
+ * whole, when its last segment would be.
+ */
+class PointToPointOffloadTest : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     */
+    PointToPointOffloadTest();
+
+    /**
+     * \brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * \brief Callback function which records the received packet
+     *
+     * \param dev The receiving device.
+     * \param pkt The received packet.
+     * \param mode The protocol mode used.
+     * \param sender The sender address.
+     *
+     * \return A boolean indicating packet handled properly.
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    Ptr<const Packet> m_recvdPacket; //!< received packet
+    Time m_recvdTime;                //!< time the packet was received
+};
+
+PointToPointOffloadTest::PointToPointOffloadTest()
+    : TestCase("PointToPoint segmentation offload")
+{
+}
+
+bool
+PointToPointOffloadTest::RxPacket(Ptr<NetDevice> dev,
+                                  Ptr<const Packet> pkt,
+                                  uint16_t mode,
+                                  const Address& sender)
+{
+    m_recvdPacket = pkt;
+    m_recvdTime = Simulator::Now();
+    return true;
+}
+
+void
+PointToPointOffloadTest::DoRun()
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+
+    devA->Attach(channel);
+    devA->SetAddress(Mac48Address::Allocate());
+    devA->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    devA->SetDataRate(DataRate("8Mbps"));
+    devA->SetInterframeGap(MicroSeconds(10));
+    devB->Attach(channel);
+    devB->SetAddress(Mac48Address::Allocate());
+    devB->SetQueue(CreateObject<DropTailQueue<Packet>>());
+
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+
+    devB->SetReceiveCallback(MakeCallback(&PointToPointOffloadTest::RxPacket, this));
+    NS_TEST_ASSERT_MSG_EQ(devA->SupportsSegmentationOffload(), true, "Offload supported");
+
+    // 3 segments of 1000, 1000 and 500 bytes, each with 40 bytes of headers
+    Ptr<Packet> p = Create<Packet>(2540);
+    p->AddPacketTag(SegmentationOffloadTag(1000, 2500));
+    Simulator::Schedule(Seconds(1.0), [=]() { devA->Send(p, devA->GetBroadcast(), 0x800); });
+
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_NE(m_recvdPacket, nullptr, "Aggregate received");
+    NS_TEST_EXPECT_MSG_EQ(m_recvdPacket->GetSize(), 2540, "Aggregate received as a whole");
+    // each segment with its headers and the PPP header, at 1 byte per
+    // microsecond, and the interframe gaps between the segments
+    Time expected = Seconds(1.0) + MicroSeconds(2500 + 3 * (40 + 2)) + 2 * MicroSeconds(10);
+    NS_TEST_EXPECT_MSG_EQ(m_recvdTime, expected, "Aggregate received with its last segment");
+
+    Simulator::Destroy();
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -144,6 +238,7 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointOffloadTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
@@ -0,0 +1,245 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core
+ * Benchmark of the Config path resolution on a large object graph.
+ *
+ * The object graph mimics the nodes of a large simulation: a root list
+ * of nodes, each with a list of devices, each with a PHY holding a
+ * trace source.  The benchmark times the usual ways of connecting a
+ * trace sink to every PHY at startup: one Config::Connect() per node,
+ * and a single Config::Connect() with wildcards.
+ */
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/** A PHY, with a trace source. */
+class BenchPhy : public Object
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid =
+            TypeId("ns3::BenchPhy")
+                .SetParent<Object>()
+                .SetGroupName("Core")
+                .AddConstructor<BenchPhy>()
+                .AddTraceSource("State",
+                                "The state of the PHY.",
+                                MakeTraceSourceAccessor(&BenchPhy::m_state),
+                                "ns3::TracedValueCallback::Uint32");
+        return tid;
+    }
+
+    TracedValue<uint32_t> m_state; //!< The state.
+};
+
+/** A device, with a PHY. */
+class BenchDevice : public Object
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::BenchDevice")
+                                .SetParent<Object>()
+                                .SetGroupName("Core")
+                                .AddConstructor<BenchDevice>()
+                                .AddAttribute("Phy",
+                                              "The PHY.",
+                                              PointerValue(),
+                                              MakePointerAccessor(&BenchDevice::m_phy),
+                                              MakePointerChecker<BenchPhy>());
+        return tid;
+    }
+
+    Ptr<BenchPhy> m_phy; //!< The PHY.
+};
+
+/** A node, with a list of devices. */
+class BenchNode : public Object
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::BenchNode")
+                                .SetParent<Object>()
+                                .SetGroupName("Core")
+                                .AddConstructor<BenchNode>()
+                                .AddAttribute("DeviceList",
+                                              "The devices.",
+                                              ObjectVectorValue(),
+                                              MakeObjectVectorAccessor(&BenchNode::m_devices),
+                                              MakeObjectVectorChecker<BenchDevice>());
+        return tid;
+    }
+
+    std::vector<Ptr<BenchDevice>> m_devices; //!< The devices.
+};
+
+/** The root list of nodes. */
+class BenchNodeList : public Object
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::BenchNodeList")
+                                .SetParent<Object>()
+                                .SetGroupName("Core")
+                                .AddConstructor<BenchNodeList>()
+                                .AddAttribute("BenchNodeList",
+                                              "The nodes.",
+                                              ObjectVectorValue(),
+                                              MakeObjectVectorAccessor(&BenchNodeList::m_nodes),
+                                              MakeObjectVectorChecker<BenchNode>());
+        return tid;
+    }
+
+    std::vector<Ptr<BenchNode>> m_nodes; //!< The nodes.
+};
+
+/**
+ * A trace sink.
+ * \param [in] oldValue The previous state.
+ * \param [in] newValue The new state.
+ */
+static void
+StateChanged(uint32_t oldValue, uint32_t newValue)
+{
+}
+
+/**
+ * A trace sink, with the context.
+ * \param [in] context The path of the trace source.
+ * \param [in] oldValue The previous state.
+ * \param [in] newValue The new state.
+ */
+static void
+StateChangedWithContext(std::string context, uint32_t oldValue, uint32_t newValue)
+{
+}
+
+/**
+ * Time a function.
+ * \param [in] f The function.
+ * \returns The wall clock time taken (s).
+ */
+template <typename F>
+double
+WallClock(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nodes = 1000;
+    uint32_t devices = 2;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the Config path resolution on a large object graph.");
+    cmd.AddValue("nodes", "number of nodes", nodes);
+    cmd.AddValue("devices", "number of devices per node", devices);
+    cmd.Parse(argc, argv);
+
+    Ptr<BenchNodeList> list = CreateObject<BenchNodeList>();
+    for (uint32_t i = 0; i < nodes; ++i)
+    {
+        Ptr<BenchNode> node = CreateObject<BenchNode>();
+        for (uint32_t j = 0; j < devices; ++j)
+        {
+            Ptr<BenchDevice> device = CreateObject<BenchDevice>();
+            device->m_phy = CreateObject<BenchPhy>();
+            node->m_devices.push_back(device);
+        }
+        list->m_nodes.push_back(node);
+    }
+    Config::RegisterRootNamespaceObject(list);
+
+    LOG("bench-config: Benchmark Config path resolution");
+    LOG("  Nodes:                        " << nodes);
+    LOG("  Devices per node:             " << devices);
+    LOG("");
+    LOG(std::left << std::setw(48) << "Operation" << std::setw(12) << "Time (s)"
+                  << "Matches");
+
+    auto report = [](const std::string& operation, double time, uint64_t matches) {
+        LOG(std::left << std::setw(48) << operation << std::setw(12) << time << matches);
+    };
+
+    uint64_t matches = 0;
+    double time = WallClock([&]() {
+        for (uint32_t i = 0; i < nodes; ++i)
+        {
+            std::string path =
+                "/BenchNodeList/" + std::to_string(i) + "/DeviceList/*/Phy/State";
+            matches += Config::LookupMatches(path.substr(0, path.rfind('/'))).GetN();
+            Config::ConnectWithoutContext(path, MakeCallback(&StateChanged));
+        }
+    });
+    report("Connect per node", time, matches);
+
+    matches = 0;
+    time = WallClock([&]() {
+        std::string path = "/BenchNodeList/*/DeviceList/*/Phy/State";
+        matches += Config::LookupMatches("/BenchNodeList/*/DeviceList/*/Phy").GetN();
+        Config::ConnectWithoutContext(path, MakeCallback(&StateChanged));
+    });
+    report("Connect with wildcards", time, matches);
+
+    matches = 0;
+    time = WallClock([&]() {
+        std::string path = "/BenchNodeList/*/DeviceList/*/$ns3::BenchDevice/Phy/State";
+        matches +=
+            Config::LookupMatches("/BenchNodeList/*/DeviceList/*/$ns3::BenchDevice/Phy").GetN();
+        Config::Connect(path, MakeCallback(&StateChangedWithContext));
+    });
+    report("Connect with wildcards and GetObject", time, matches);
+
+    matches = 0;
+    time = WallClock([&]() {
+        for (uint32_t i = 0; i < nodes; i += 10)
+        {
+            matches +=
+                Config::LookupMatches("/BenchNodeList/[" + std::to_string(i) + "-" +
+                                      std::to_string(i + 9) + "]/DeviceList/0/Phy")
+                    .GetN();
+        }
+    });
+    report("Lookup ranges of 10 nodes", time, matches);
+
+    Config::UnregisterRootNamespaceObject(list);
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+/**
+ * \file
+ * \ingroup core
+ * Benchmark of Object::GetObject() on aggregates of various sizes.
+ *
+ * Each aggregate mimics a node with its protocols and models: objects
+ * of distinct types, each deriving from an intermediate base class.
+ * The benchmark looks them all up in turn, as the protocol stacks do
+ * when they process a packet.
+ */
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/** Maximum number of aggregated objects. */
+constexpr uint32_t MAX_AGGREGATES = 16;
+
+/** The intermediate base class of the aggregated objects. */
+class BenchComponentBase : public Object
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid =
+            TypeId("ns3::BenchComponentBase").SetParent<Object>().SetGroupName("Core");
+        return tid;
+    }
+};
+
+/**
+ * An aggregated object.
+ *
+ * \tparam N \explicit The index of the type.
+ */
+template <uint32_t N>
+class BenchComponent : public BenchComponentBase
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::BenchComponent" + std::to_string(N))
+                                .SetParent<BenchComponentBase>()
+                                .SetGroupName("Core")
+                                .AddConstructor<BenchComponent<N>>();
+        return tid;
+    }
+};
+
+/**
+ * Create an aggregate.
+ *
+ * \tparam I \deduced The indexes of the types.
+ * \param [in] size The number of objects.
+ * \returns The first object of the aggregate.
+ */
+template <uint32_t... I>
+Ptr<Object>
+CreateAggregate(uint32_t size, std::integer_sequence<uint32_t, I...>)
+{
+    Ptr<Object> first = CreateObject<BenchComponent<0>>();
+    (
+        [&] {
+            if (I > 0 && I < size)
+            {
+                first->AggregateObject(CreateObject<BenchComponent<I>>());
+            }
+        }(),
+        ...);
+    return first;
+}
+
+/**
+ * Look up each object of an aggregate once.
+ *
+ * \tparam I \deduced The indexes of the types.
+ * \param [in] object An object of the aggregate.
+ * \param [in] size The number of objects.
+ * \returns The number of objects found.
+ */
+template <uint32_t... I>
+uint32_t
+LookupAll(const Ptr<Object>& object, uint32_t size, std::integer_sequence<uint32_t, I...>)
+{
+    uint32_t found = 0;
+    ((found += (I < size && object->GetObject<BenchComponent<I>>())), ...);
+    return found;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t lookups = 10000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark Object::GetObject() on aggregates of various sizes.");
+    cmd.AddValue("lookups", "number of lookups per aggregate size", lookups);
+    cmd.Parse(argc, argv);
+
+    LOG("bench-object: Benchmark Object::GetObject()");
+    LOG("  Lookups per size:             " << lookups);
+    LOG("");
+    LOG(std::left << std::setw(12) << "Aggregates" << std::setw(16) << "Time (s)"
+                  << "Per call (ns)");
+
+    auto sequence = std::make_integer_sequence<uint32_t, MAX_AGGREGATES>();
+    for (uint32_t size = 1; size <= MAX_AGGREGATES; size *= 2)
+    {
+        Ptr<Object> object = CreateAggregate(size, sequence);
+        uint64_t rounds = lookups / size;
+        uint64_t found = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < rounds; ++i)
+        {
+            found += LookupAll(object, size, sequence);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        NS_ABORT_MSG_IF(found != rounds * size, "Object not found");
+        LOG(std::left << std::setw(12) << size << std::setw(16) << elapsed.count()
+                      << elapsed.count() * 1e9 / (rounds * size));
+        object->Dispose();
+    }
+
+    return 0;
+}
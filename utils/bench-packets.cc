@@ -371,6 +371,7 @@ main(int argc, char* argv[])
     uint32_t n = 0;
     uint32_t minIterations = 1;
     bool enablePrinting = false;
+    bool compactPrinting = false;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark Packet class");
@@ -379,8 +380,20 @@ main(int argc, char* argv[])
                  "number of subiterations to minimize iteration time over",
                  minIterations);
     cmd.AddValue("enable-printing", "enable packet printing", enablePrinting);
+    cmd.AddValue("compact-printing",
+                 "enable packet printing with compact metadata",
+                 compactPrinting);
     cmd.Parse(argc, argv);
 
+    if (compactPrinting)
+    {
+        Packet::EnableCompactPrinting();
+    }
+    else if (enablePrinting)
+    {
+        Packet::EnablePrinting();
+    }
+
     if (n == 0)
     {
         std::cerr << "Error-- number of packets must be specified "
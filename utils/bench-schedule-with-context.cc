@@ -0,0 +1,178 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core
+ * Stress benchmark of Simulator::ScheduleWithContext() from other threads.
+ *
+ * Several producer threads, like the reader threads of FdNetDevice or
+ * TapBridge, inject events as fast as they can into a running
+ * simulation, while the main thread executes them.
+ */
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/**
+ * One benchmark run: start the producers, then execute their events.
+ */
+class Bench
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] producers The number of producer threads.
+     * \param [in] events The number of events scheduled by each producer.
+     */
+    Bench(uint32_t producers, uint64_t events);
+
+    /**
+     * Run the benchmark.
+     *
+     * \param [out] produce The wall clock time taken by the slowest producer (s).
+     * \param [out] total The wall clock time until all the events are executed (s).
+     */
+    void Run(double& produce, double& total);
+
+  private:
+    /**
+     * Producer thread.
+     *
+     * \param [in] context The context of the events, identifying the producer.
+     */
+    void Produce(uint32_t context);
+    /** Executed for each event injected by a producer. */
+    void Receive();
+    /** Keep the simulation alive until all the events are received. */
+    void Tick();
+
+    uint32_t m_producers;               //!< Number of producer threads.
+    uint64_t m_events;                  //!< Events scheduled by each producer.
+    uint64_t m_received;                //!< Events received.
+    std::atomic<bool> m_go;             //!< Start flag of the producers.
+    std::vector<double> m_produceTimes; //!< Wall clock time of each producer.
+};
+
+Bench::Bench(uint32_t producers, uint64_t events)
+    : m_producers(producers),
+      m_events(events),
+      m_received(0),
+      m_go(false),
+      m_produceTimes(producers, 0)
+{
+}
+
+void
+Bench::Produce(uint32_t context)
+{
+    while (!m_go.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < m_events; ++i)
+    {
+        Simulator::ScheduleWithContext(context, NanoSeconds(1), &Bench::Receive, this);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    m_produceTimes[context] = elapsed.count();
+}
+
+void
+Bench::Receive()
+{
+    m_received++;
+}
+
+void
+Bench::Tick()
+{
+    m_go.store(true, std::memory_order_release);
+    if (m_received == m_producers * m_events)
+    {
+        Simulator::Stop();
+        return;
+    }
+    Simulator::Schedule(NanoSeconds(1), &Bench::Tick, this);
+}
+
+void
+Bench::Run(double& produce, double& total)
+{
+    Simulator::Schedule(Seconds(0), &Bench::Tick, this);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < m_producers; ++i)
+    {
+        threads.emplace_back(&Bench::Produce, this, i);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    Simulator::Destroy();
+
+    produce = *std::max_element(m_produceTimes.begin(), m_produceTimes.end());
+    total = elapsed.count();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t producers = 4;
+    uint64_t events = 1000000;
+    uint32_t runs = 3;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark Simulator::ScheduleWithContext() from several threads.\n"
+              "\n"
+              "Each producer thread schedules events as fast as it can,\n"
+              "while the main thread runs the simulation and executes them.");
+    cmd.AddValue("producers", "number of producer threads", producers);
+    cmd.AddValue("events", "number of events scheduled by each producer", events);
+    cmd.AddValue("runs", "number of runs", runs);
+    cmd.Parse(argc, argv);
+
+    LOG("bench-schedule-with-context: Benchmark cross-thread event scheduling");
+    LOG("  Producer threads:             " << producers);
+    LOG("  Events per producer:          " << events);
+    LOG("  Hardware threads:             " << std::thread::hardware_concurrency());
+    LOG("");
+    LOG(std::left << std::setw(12) << "Run #" << std::setw(12) << "Produce (s)" << std::setw(16)
+                  << "Inject (ev/s)" << std::setw(12) << "Total (s)" << std::setw(16)
+                  << "Execute (ev/s)");
+
+    double sumRate = 0;
+    for (uint32_t run = 0; run < runs; ++run)
+    {
+        double produce = 0;
+        double total = 0;
+        Bench(producers, events).Run(produce, total);
+        double count = static_cast<double>(producers) * events;
+        LOG(std::left << std::setw(12) << run << std::setw(12) << produce << std::setw(16)
+                      << count / produce << std::setw(12) << total << std::setw(16)
+                      << count / total);
+        sumRate += count / produce;
+    }
+    LOG("Average injection rate: " << sumRate / runs << " ev/s");
+
+    return 0;
+}
@@ -196,6 +196,8 @@ class BenchSuite
   private:
     /** Print the table header. */
     void Header() const;
+    /** Print the event pool counters. */
+    void LogPool() const;
 
     /** Statistics from a single phase, init or run. */
     struct PhaseResult
@@ -228,8 +230,9 @@ class BenchSuite
         void Log(T label) const;
     }; // struct Result
 
-    std::string m_scheduler;       /**< Descriptive string for the scheduler. */
-    std::vector<Result> m_results; /**< Store for the run results. */
+    std::string m_scheduler;          /**< Descriptive string for the scheduler. */
+    std::vector<Result> m_results;    /**< Store for the run results. */
+    EventImpl::PoolStatistics m_pool; /**< Event pool counters over the data runs. */
 
 }; // BenchSuite
 
@@ -284,6 +287,7 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
     DEB("priming");
     auto prime = bench.Run();
     Result::Bench(prime).Log("prime");
+    EventImpl::ResetPoolStatistics();
 
     // Perform the actual runs
     for (uint64_t i = 0; i < runs; i++)
@@ -292,6 +296,7 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
         m_results.push_back(Result::Bench(run));
         m_results.back().Log(i);
     }
+    m_pool = EventImpl::GetPoolStatistics();
 
     Simulator::Destroy();
 
@@ -317,11 +322,20 @@ BenchSuite::Header() const
                           << std::right << std::setw(g_fwidth) << " " << std::setfill(' '));
 }
 
+void
+BenchSuite::LogPool() const
+{
+    double hitRate = m_pool.allocations ? 100.0 * m_pool.hits / m_pool.allocations : 0;
+    LOG("Event pool: " << m_pool.allocations << " allocations, " << m_pool.hits << " hits ("
+                       << hitRate << "%), " << m_pool.pooled << " free events");
+}
+
 void
 BenchSuite::Log() const
 {
     if (m_results.size() < 2)
     {
+        LogPool();
         LOG("");
         return;
     }
@@ -371,29 +385,77 @@ BenchSuite::Log() const
 
     average.Log("average");
     stdev.Log("stdev");
+    LogPool();
 
     LOG("");
 
 } // BenchSuite::Log()
 
+/**
+ *  Create a DeterministicRandomVariable replaying a sequence of delays
+ *  drawn from a mixture of two exponential distributions.
+ *
+ *  \param [in] shortMean The mean of the short delays (ns).
+ *  \param [in] longMean The mean of the long delays (ns).
+ *  \param [in] longProbability The probability of a long delay.
+ *  \returns The RandomVariableStream.
+ */
+Ptr<RandomVariableStream>
+GetMixtureStream(double shortMean, double longMean, double longProbability)
+{
+    auto shortRv = CreateObject<ExponentialRandomVariable>();
+    shortRv->SetAttribute("Mean", DoubleValue(shortMean));
+    shortRv->SetAttribute("Bound", DoubleValue(0));
+    auto longRv = CreateObject<ExponentialRandomVariable>();
+    longRv->SetAttribute("Mean", DoubleValue(longMean));
+    longRv->SetAttribute("Bound", DoubleValue(0));
+    auto choice = CreateObject<UniformRandomVariable>();
+
+    // replayed in a loop by the DeterministicRandomVariable
+    std::vector<double> nsValues(1000000);
+    for (auto& value : nsValues)
+    {
+        value = choice->GetValue() < longProbability ? longRv->GetValue() : shortRv->GetValue();
+    }
+    auto drv = CreateObject<DeterministicRandomVariable>();
+    drv->SetValueArray(nsValues);
+    return drv;
+}
+
 /**
  *  Create a RandomVariableStream to generate next event delays.
  *
- *  If the \p filename parameter is empty a default exponential time
- *  distribution will be used, with mean delay of 100 ns.
+ *  If the \p filename parameter is empty the \p distribution is used:
+ *  - `exp`: exponential time distribution, with mean delay of 100 ns;
+ *  - `bimodal`: 90% of the delays with mean 1 us (e.g. MAC slot timers)
+ *    and 10% with mean 1 s (e.g. application timers);
+ *  - `bursty`: bursts of near-simultaneous events (mean 2 ns apart)
+ *    separated by gaps with mean 100 us.
  *
  *  If the \p filename is `-` standard input will be used.
  *
  *  \param [in] filename The delay interval source file name.
+ *  \param [in] distribution The delay distribution, if no \p filename.
  *  \returns The RandomVariableStream.
  */
 Ptr<RandomVariableStream>
-GetRandomStream(std::string filename)
+GetRandomStream(std::string filename, std::string distribution)
 {
     Ptr<RandomVariableStream> stream = nullptr;
 
-    if (filename.empty())
+    if (filename.empty() && distribution == "bimodal")
+    {
+        LOG("  Event time distribution:      bimodal exponential, 1 us / 1 s");
+        stream = GetMixtureStream(1000, 1e9, 0.1);
+    }
+    else if (filename.empty() && distribution == "bursty")
+    {
+        LOG("  Event time distribution:      bursty, 2 ns / 100 us");
+        stream = GetMixtureStream(2, 1e5, 0.02);
+    }
+    else if (filename.empty())
     {
+        NS_ABORT_MSG_IF(distribution != "exp", "Unknown distribution " << distribution);
         LOG("  Event time distribution:      default exponential");
         auto erv = CreateObject<ExponentialRandomVariable>();
         erv->SetAttribute("Mean", DoubleValue(100));
@@ -449,11 +511,14 @@ main(int argc, char* argv[])
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
+    bool schedQuad = false;
+    bool schedLadder = false;
 
     uint64_t pop = 100000;
     uint64_t total = 1000000;
     uint64_t runs = 1;
     std::string filename = "";
+    std::string distribution = "exp";
     bool calRev = false;
 
     CommandLine cmd(__FILE__);
@@ -461,6 +526,7 @@ main(int argc, char* argv[])
               "\n"
               "Event intervals are taken from one of:\n"
               "  an exponential distribution, with mean 100 ns,\n"
+              "  a bimodal or bursty distribution, given by the --dist argument,\n"
               "  an ascii file, given by the --file=\"<filename>\" argument,\n"
               "  or standard input, by the argument --file=\"-\"\n"
               "In the case of either --file form, the input is expected\n"
@@ -471,14 +537,17 @@ main(int argc, char* argv[])
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderQueueScheduler", schedLadder);
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
+    cmd.AddValue("quad", "use QuadHeapScheduler", schedQuad);
     cmd.AddValue("debug", "enable debugging output", g_debug);
     cmd.AddValue("pop", "event population size", pop);
     cmd.AddValue("total", "total number of events to run", total);
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
+    cmd.AddValue("dist", "event time distribution: exp, bimodal or bursty", distribution);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
     cmd.Parse(argc, argv);
 
@@ -494,15 +563,15 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = schedQuad = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ || schedQuad))
     {
         schedMap = true;
     }
 
-    auto eventStream = GetRandomStream(filename);
+    auto eventStream = GetRandomStream(filename, distribution);
 
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
@@ -521,6 +590,11 @@ main(int argc, char* argv[])
         factory.SetTypeId("ns3::HeapScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderQueueScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
     if (schedList)
     {
         factory.SetTypeId("ns3::ListScheduler");
@@ -542,6 +616,11 @@ main(int argc, char* argv[])
         factory.SetTypeId("ns3::PriorityQueueScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedQuad)
+    {
+        factory.SetTypeId("ns3::QuadHeapScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
 
     return 0;
 }
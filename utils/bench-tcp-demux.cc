@@ -0,0 +1,114 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * \file
+ * \ingroup internet
+ * Benchmark of the demultiplexing of the TCP segments to their sockets,
+ * with many concurrent connections.
+ *
+ * Client nodes, linked to a server node, open the connections to a
+ * PacketSink, each with a BulkSendApplication sending a few segments, so
+ * that the server holds one socket per connection, and each client node
+ * up to \c --perClient of them.  The wall clock time per packet received
+ * by the TCP of the nodes is printed: run with several \c --connections
+ * values to see how the cost of a packet grows with the number of
+ * sockets.
+ */
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/** Number of packets received by the TCP of the nodes. */
+static uint64_t g_packets = 0;
+
+/**
+ * Count a packet received by the IPv4 layer of a node.
+ * \param [in] packet The packet.
+ * \param [in] ipv4 The IPv4 layer.
+ * \param [in] interface The interface.
+ */
+static void
+Receive(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+    g_packets++;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t connections = 1000;
+    uint32_t perClient = 10000;
+    uint32_t bytes = 20000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("connections", "The number of TCP connections", connections);
+    cmd.AddValue("perClient", "The maximum number of connections of a client node", perClient);
+    cmd.AddValue("bytes", "The number of bytes sent on each connection", bytes);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(perClient == 0 || perClient > 16000,
+                    "A client node has up to 16000 ephemeral ports");
+    uint32_t nClients = (connections + perClient - 1) / perClient;
+
+    Ptr<Node> server = CreateObject<Node>();
+    NodeContainer clients(nClients);
+    InternetStackHelper stack;
+    stack.Install(server);
+    stack.Install(clients);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("10us"));
+    Ipv4AddressHelper addresses("10.1.0.0", "255.255.255.0");
+    std::vector<Ipv4Address> serverAddresses;
+    for (uint32_t i = 0; i < nClients; i++)
+    {
+        NetDeviceContainer devices = p2p.Install(server, clients.Get(i));
+        serverAddresses.push_back(addresses.Assign(devices).GetAddress(0));
+        addresses.NewNetwork();
+    }
+
+    uint16_t port = 9;
+    PacketSinkHelper sink("ns3::TcpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
+    sink.Install(server);
+
+    for (uint32_t i = 0; i < connections; i++)
+    {
+        BulkSendHelper source("ns3::TcpSocketFactory",
+                              InetSocketAddress(serverAddresses[i / perClient], port));
+        source.SetAttribute("MaxBytes", UintegerValue(bytes));
+        ApplicationContainer apps = source.Install(clients.Get(i / perClient));
+        // open the connections over the first 10 ms: they then share the
+        // link, and all of them stay open until the end of the transfers
+        apps.Start(NanoSeconds(i * 10000000ULL / connections));
+    }
+
+    Config::ConnectWithoutContext("/NodeList/*/$ns3::Ipv4L3Protocol/Rx", MakeCallback(&Receive));
+
+    LOG("connections: " << connections << ", client nodes: " << nClients
+                        << ", bytes per connection: " << bytes);
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    Simulator::Destroy();
+
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    LOG("packets: " << g_packets << ", wall clock: " << std::fixed << std::setprecision(3)
+                    << seconds << " s, per packet: " << std::setprecision(2)
+                    << seconds * 1e6 / g_packets << " us");
+    return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * \file
+ * \ingroup core
+ * Benchmark of firing a TracedCallback with various numbers of sinks.
+ *
+ * The trace source mimics the packet trace sources of the network
+ * devices (MacTx, PhyRxBegin...), which pass a smart pointer and
+ * are fired for every packet, whether or not a sink is connected.
+ */
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/** Number of times a sink was called. */
+static uint64_t g_calls = 0;
+
+/**
+ * A trace sink.
+ * \param [in] object The traced object.
+ * \param [in] size The traced size.
+ */
+static void
+Sink(Ptr<const Object> object, uint32_t size)
+{
+    g_calls += size;
+}
+
+/**
+ * A trace sink, with the context.
+ * \param [in] context The path of the trace source.
+ * \param [in] object The traced object.
+ * \param [in] size The traced size.
+ */
+static void
+SinkWithContext(std::string context, Ptr<const Object> object, uint32_t size)
+{
+    g_calls += size;
+}
+
+/**
+ * Fire a trace source.
+ * \param [in] trace The trace source.
+ * \param [in] object The traced object.
+ * \param [in] fires The number of times to fire it.
+ * \returns The time per fire (ns).
+ */
+static double
+Fire(const TracedCallback<Ptr<const Object>, uint32_t>& trace,
+     Ptr<const Object> object,
+     uint64_t fires)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < fires; ++i)
+    {
+        trace(object, 1);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() * 1e9 / fires;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t fires = 10000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark firing a TracedCallback with 0, 1 and 4 sinks.");
+    cmd.AddValue("fires", "number of times each trace source is fired", fires);
+    cmd.Parse(argc, argv);
+
+    LOG("bench-traced-callback: Benchmark TracedCallback::operator()");
+    LOG("  Fires:                        " << fires);
+    LOG("");
+    LOG(std::left << std::setw(12) << "Sinks" << std::setw(20) << "No context (ns)"
+                  << "Context (ns)");
+
+    Ptr<Object> object = CreateObject<Object>();
+    for (uint32_t sinks : {0, 1, 4})
+    {
+        TracedCallback<Ptr<const Object>, uint32_t> trace;
+        TracedCallback<Ptr<const Object>, uint32_t> traceWithContext;
+        for (uint32_t i = 0; i < sinks; ++i)
+        {
+            trace.ConnectWithoutContext(MakeCallback(&Sink));
+            traceWithContext.Connect(MakeCallback(&SinkWithContext),
+                                     "/NodeList/" + std::to_string(i) + "/DeviceList/0/MacTx");
+        }
+        g_calls = 0;
+        double withoutContext = Fire(trace, object, fires);
+        double withContext = Fire(traceWithContext, object, fires);
+        NS_ABORT_MSG_IF(g_calls != 2 * sinks * fires, "Sinks not called");
+        LOG(std::left << std::setw(12) << sinks << std::setw(20) << withoutContext
+                      << withContext);
+    }
+
+    return 0;
+}
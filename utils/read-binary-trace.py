@@ -0,0 +1,174 @@
+#! /usr/bin/env python3
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+"""
+Read the binary trace files written by ns3::BinaryTraceFile.
+
+The BinaryTrace class can be used by post-processing scripts:
+
+    with BinaryTrace("packets.btr") as trace:
+        for time, node, device, event, uid, size in trace.records(start=10.0, stop=20.0):
+            ...
+
+As a program, print the records as comma-separated values:
+
+    ./utils/read-binary-trace.py packets.btr --start 10 --stop 20
+
+The file format is described in src/network/utils/binary-trace-file.h.
+"""
+
+import argparse
+import bisect
+import mmap
+import struct
+import sys
+
+FILE_MAGIC = b"NS3BTRC1"
+INDEX_MAGIC = b"NS3BTIDX"
+BLOCK_HEADER = struct.Struct("<IIqq")
+INDEX_ENTRY = struct.Struct("<QqqI")
+INT64, UINT64, DOUBLE = 0, 1, 2
+
+
+def _read_varint(data, pos):
+    """Decode a zigzag LEB128 difference; return (delta, next position)."""
+    result = 0
+    shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        result |= (byte & 0x7F) << shift
+        if byte < 0x80:
+            return (result >> 1) ^ -(result & 1), pos
+        shift += 7
+
+
+class BinaryTrace:
+    """A binary trace file: its schema, and the time span of its blocks."""
+
+    def __init__(self, filename):
+        # Map the file rather than reading it: the blocks are only paged in
+        # when their records are read, so that a time range of a large
+        # trace is read without loading the whole file.
+        with open(filename, "rb") as f:
+            try:
+                self._data = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+            except (OSError, ValueError):
+                # empty files and pipes cannot be mapped
+                self._data = f.read()
+        data = self._data
+        if data[:8] != FILE_MAGIC:
+            self.close()
+            raise ValueError(f"{filename} is not a binary trace file")
+        (self.steps_per_second,) = struct.unpack_from("<q", data, 8)
+        pos = 16
+        self.schema, pos = self._read_name(pos)
+        (count,) = struct.unpack_from("<I", data, pos)
+        pos += 4
+        self.columns = []
+        self.types = []
+        for _ in range(count):
+            self.types.append(data[pos])
+            name, pos = self._read_name(pos + 1)
+            self.columns.append(name)
+        self._blocks = self._read_index(pos)
+
+    def _read_name(self, pos):
+        (length,) = struct.unpack_from("<I", self._data, pos)
+        pos += 4
+        return self._data[pos : pos + length].decode(), pos + length
+
+    def _read_index(self, start):
+        """Return the (offset, first, last, records) of the blocks."""
+        data = self._data
+        if len(data) >= start + 16 and data[-8:] == INDEX_MAGIC:
+            (offset,) = struct.unpack_from("<Q", data, len(data) - 16)
+            size = len(data) - 16 - offset
+            if offset >= start and size % INDEX_ENTRY.size == 0:
+                return [
+                    INDEX_ENTRY.unpack_from(data, offset + i)
+                    for i in range(0, size, INDEX_ENTRY.size)
+                ]
+        # No index: scan the complete blocks
+        blocks = []
+        offset = start
+        while offset + BLOCK_HEADER.size <= len(data):
+            records, size, first, last = BLOCK_HEADER.unpack_from(data, offset)
+            if offset + BLOCK_HEADER.size + size > len(data):
+                break
+            blocks.append((offset, first, last, records))
+            offset += BLOCK_HEADER.size + size
+        return blocks
+
+    def _read_block(self, offset):
+        """Return the times (in seconds) and the columns of a block."""
+        data = self._data
+        records, size, _, _ = BLOCK_HEADER.unpack_from(data, offset)
+        pos = offset + BLOCK_HEADER.size
+        columns = []
+        for kind in [INT64] + self.types:
+            values = []
+            if kind == DOUBLE:
+                values = list(struct.unpack_from(f"<{records}d", data, pos))
+                pos += 8 * records
+            else:
+                value = 0
+                for _ in range(records):
+                    delta, pos = _read_varint(data, pos)
+                    value = (value + delta) & 0xFFFFFFFFFFFFFFFF
+                    values.append(value)
+                if kind == INT64:
+                    values = [v - (1 << 64) if v >= 1 << 63 else v for v in values]
+            columns.append(values)
+        times = [t / self.steps_per_second for t in columns[0]]
+        return times, columns[1:]
+
+    def close(self):
+        """Unmap the file."""
+        if isinstance(self._data, mmap.mmap):
+            self._data.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __len__(self):
+        return sum(block[3] for block in self._blocks)
+
+    def records(self, start=None, stop=None):
+        """Yield the records (time in seconds, then the values) in [start, stop)."""
+        first = 0
+        if start is not None:
+            step = start * self.steps_per_second
+            first = bisect.bisect_left([block[2] for block in self._blocks], step)
+        for offset, block_first, _, _ in self._blocks[first:]:
+            if stop is not None and block_first >= stop * self.steps_per_second:
+                return
+            times, columns = self._read_block(offset)
+            for i, time in enumerate(times):
+                if start is not None and time < start:
+                    continue
+                if stop is not None and time >= stop:
+                    return
+                yield (time,) + tuple(column[i] for column in columns)
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description="Print the records of a binary trace file")
+    parser.add_argument("filename", help="the binary trace file")
+    parser.add_argument("--start", type=float, help="the start time, in seconds")
+    parser.add_argument("--stop", type=float, help="the stop time, in seconds")
+    args = parser.parse_args(argv)
+
+    with BinaryTrace(args.filename) as trace:
+        print(",".join(["time"] + trace.columns))
+        for record in trace.records(args.start, args.stop):
+            print(",".join(repr(value) for value in record))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))